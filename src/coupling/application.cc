@@ -44,6 +44,10 @@
 #include "system/asserts.hh"                           // for ASSERT_PERMANENT, msg
 #include "system/logger.hh"                            // for Logger, operat...
 #include "system/system.hh"                            // for SystemInfo
+#include "coupling/generic_assembly.hh"                // for AssemblyThreadNumber
+#include "fields/formula_jit.hh"                       // for FormulaJit
+#include "io/output_vtk.hh"                            // for OutputVTK
+#include "io/msh_basereader.hh"                        // for BaseMeshReader
 
 
 
@@ -340,7 +344,12 @@ void Application::parse_cmd_line(const int argc, char ** argv) {
         ("profiler_path,profiler-path", po::value< string >(), "Path to the profiler file")
         ("input_format", po::value< string >(), "Writes full structure of the main input file into given file.")
 		("petsc_redirect", po::value<string>(), "Redirect all PETSc stdout and stderr to given file.")
-		("yaml_balance", "Redirect balance output to YAML format too (simultaneously with the selected balance output format).");
+		("yaml_balance", "Redirect balance output to YAML format too (simultaneously with the selected balance output format).")
+		("assembly_threads", po::value< unsigned int >(), "Number of threads evaluating integrals of assemblies on each MPI process (default 1).")
+		("patch_cache_budget", po::value< unsigned int >(), "Size of memory in kB targeted by field value caches of one assembly patch, should correspond to L2 or L3 cache (default 1024).")
+		("formula_jit", po::value< string >(), "Compile scalar formulas of FieldFormula to native code, stores compiled formulas to given directory.")
+		("output_threads", po::value< unsigned int >(), "Number of threads compressing binary VTK output on each MPI process (default 1).")
+		("input_prefetch", po::value< unsigned int >(), "Size of memory in MB for time frames of input data read in advance by background thread on each MPI process (default 0, no prefetch).");
 
 
 
@@ -452,6 +461,21 @@ void Application::parse_cmd_line(const int argc, char ** argv) {
     // preserves output of balance in YAML format
     if (vm.count("yaml_balance")) Balance::set_yaml_output();
 
+    // number of threads used in assemblies allowing threaded evaluation of integrals
+    if (vm.count("assembly_threads")) AssemblyThreadNumber::set( vm["assembly_threads"].as<unsigned int>() );
+
+    // memory targeted by field value caches, determines size of assembly patches
+    if (vm.count("patch_cache_budget")) CacheMapByteBudget::set( 1024 * std::size_t(vm["patch_cache_budget"].as<unsigned int>()) );
+
+    // enable compilation of formulas
+    if (vm.count("formula_jit")) FormulaJit::set_cache_dir( vm["formula_jit"].as<string>() );
+
+    // number of threads compressing binary VTK output
+    if (vm.count("output_threads")) OutputVTK::set_compression_threads( vm["output_threads"].as<unsigned int>() );
+
+    // memory of input data frames read in advance
+    if (vm.count("input_prefetch")) BaseMeshReader::set_prefetch_memory_limit( (std::size_t)vm["input_prefetch"].as<unsigned int>() * 1024 * 1024 );
+
     string input_dir;
     string output_dir;
     if (vm.count("input_dir")) {
@@ -19,6 +19,7 @@
 #define ASSEMBLY_BASE_HH_
 
 
+#include <mutex>
 #include "coupling/generic_assembly.hh"
 #include "quadrature/quadrature_lib.hh"
 #include "fields/eval_points.hh"
@@ -40,7 +41,8 @@ public:
     typedef typename GenericAssemblyBase::BoundaryIntegralData BoundaryIntegralData;
 
 	/// Constructor
-	AssemblyBase(unsigned int quad_order) {
+	AssemblyBase(unsigned int quad_order)
+	: shared_data_mutex_(nullptr) {
         quad_ = new QGauss(dim, 2*quad_order);
         quad_low_ = new QGauss(dim-1, 2*quad_order);
 	}
@@ -100,6 +102,22 @@ public:
        	}
     }
 
+    /**
+     * Share integrals created by other assembly object of same dimension.
+     *
+     * Used by copies of assembly object evaluating integrals in separate threads (see GenericAssembly).
+     * Method replaces call of create_integrals, so new subsets are not added to EvalPoints.
+     */
+    void share_integrals(const AssemblyBase<dim> &other) {
+        active_integrals_ = other.active_integrals_;
+        integrals_ = other.integrals_;
+    }
+
+    /// Set mutex guarding data shared by threads of assembly (linear systems, balance, ...).
+    void set_shared_data_mutex(std::mutex *mutex) {
+        shared_data_mutex_ = mutex;
+    }
+
     /// Return BulkPoint range of appropriate dimension
     inline Range< BulkPoint > bulk_points(unsigned int element_patch_idx) const {
         return integrals_.bulk_->points(element_patch_idx, element_cache_map_);
@@ -177,7 +195,7 @@ protected:
 	 * Be aware if you use this constructor. Quadrature objects must be initialized manually in descendant.
 	 */
 	AssemblyBase()
-	: quad_(nullptr), quad_low_(nullptr) {}
+	: quad_(nullptr), quad_low_(nullptr), shared_data_mutex_(nullptr) {}
 
     /// Print update flags to string format.
     std::string print_update_flags(UpdateFlags u) const {
@@ -186,11 +204,24 @@ protected:
         return s.str();
     }
 
+    /**
+     * Lock data shared by threads of assembly.
+     *
+     * Descendants allowing threaded assembly (see ThreadSafeIntegrals) must hold returned lock
+     * during each write to linear systems, balance and other objects shared between threads.
+     * In serial assembly returned lock doesn't own any mutex.
+     */
+    inline std::unique_lock<std::mutex> lock_shared_data() const {
+        if (shared_data_mutex_ == nullptr) return std::unique_lock<std::mutex>();
+        return std::unique_lock<std::mutex>(*shared_data_mutex_);
+    }
+
     Quadrature *quad_;                                     ///< Quadrature used in assembling methods.
     Quadrature *quad_low_;                                 ///< Quadrature used in assembling methods (dim-1).
     int active_integrals_;                                 ///< Holds mask of active integrals.
     DimIntegrals integrals_;                               ///< Set of used integrals.
     ElementCacheMap *element_cache_map_;                   ///< ElementCacheMap shared with GenericAssembly object.
+    std::mutex *shared_data_mutex_;                        ///< Mutex shared by threads of assembly, nullptr in serial assembly.
 };
 
 
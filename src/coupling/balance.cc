@@ -16,12 +16,15 @@
  * @brief   Mass balance
  */
 
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <unordered_map>
 
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
 #include "system/index_types.hh"
 
 #include <petscmat.h>
@@ -355,16 +358,36 @@ void Balance::lazy_initialize()
             break;
         }
 
+        // time of a record line is the first number on the line, header and comment lines have no time
+        auto csv_line_time = [](const std::string &line) -> double {
+            std::size_t pos = line.find_first_not_of(" \t\"");
+            if (pos == std::string::npos || line[pos] == '#') return std::numeric_limits<double>::quiet_NaN();
+            const char *begin = line.c_str() + pos;
+            char *end;
+            double time = std::strtod(begin, &end);
+            return (end == begin) ? std::numeric_limits<double>::quiet_NaN() : time;
+        };
+        if (output_format_ == legacy && Checkpoint::is_restart())
+            WarningOut() << "Balance output in legacy format is not continued on restart, file is rewritten.\n";
+
         balance_output_file_ = input_record_.val<FilePath>("file", FilePath(default_file_name, FilePath::output_file));
         try {
-            balance_output_file_.open_stream(output_);
+            if (output_format_ == legacy)
+                balance_output_file_.open_stream(output_);
+            else
+                open_output_stream(balance_output_file_, output_, csv_line_time);
         } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, input_record_)
 
 
         // set file name of YAML output
         if (do_yaml_output_) {
         	string yaml_file_name = file_prefix_ + "_balance.yaml";
-        	FilePath(yaml_file_name, FilePath::output_file).open_stream(output_yaml_);
+        	open_output_stream(FilePath(yaml_file_name, FilePath::output_file), output_yaml_,
+        	        [](const std::string &line) -> double {
+        	            const std::string time_key = "  - time: ";
+        	            if (line.compare(0, time_key.size(), time_key) != 0) return std::numeric_limits<double>::quiet_NaN();
+        	            return std::strtod(line.c_str() + time_key.size(), nullptr);
+        	        });
         }
     }
 
@@ -715,6 +738,8 @@ void Balance::output()
     ASSERT(allocation_done_);
     if (! balance_on_) return;
     if (! is_current() ) return;
+    // records up to the restart time are already in the file
+    if (Checkpoint::before_restart(time_->t())) return;
     
 	// gather results from processes and sum them up
     const unsigned int n_quant = quantities_.size();
@@ -853,6 +878,57 @@ void Balance::output()
 }
 
 
+void Balance::open_output_stream(const FilePath &file_path, std::ofstream &stream,
+		std::function<double(const std::string &)> line_time)
+{
+	std::string content;
+	if (Checkpoint::is_restart()) {
+		double coef = time_->get_coef();
+		content = Checkpoint::restart_output_content(string(file_path),
+				[&line_time, coef](const std::string &line) { return line_time(line) * coef; });
+	}
+	file_path.open_stream(stream);
+	stream << content;
+}
+
+
+void Balance::save_state(Checkpoint &checkpoint, const std::string &prefix)
+{
+	if (! allocation_done_) return;
+	if (rank_ == 0) {
+		output_.flush();
+		if (do_yaml_output_) output_yaml_.flush();
+	}
+
+	checkpoint.save(prefix + "/initial_mass", initial_mass_);
+	checkpoint.save(prefix + "/integrated_sources", integrated_sources_);
+	checkpoint.save(prefix + "/integrated_fluxes", integrated_fluxes_);
+	checkpoint.save(prefix + "/increment_fluxes", increment_fluxes_);
+	checkpoint.save(prefix + "/increment_sources", increment_sources_);
+	checkpoint.save(prefix + "/state", { last_time_, (double)initial_, (double)output_line_counter_, (double)output_yaml_header_ });
+}
+
+
+void Balance::load_state(const Checkpoint &checkpoint, const std::string &prefix)
+{
+	if (! allocation_done_) return;
+	unsigned int n_cumulative = increment_sources_.size();
+	initial_mass_ = checkpoint.load(prefix + "/initial_mass");
+	integrated_sources_ = checkpoint.load(prefix + "/integrated_sources");
+	integrated_fluxes_ = checkpoint.load(prefix + "/integrated_fluxes");
+	increment_fluxes_ = checkpoint.load(prefix + "/increment_fluxes");
+	increment_sources_ = checkpoint.load(prefix + "/increment_sources");
+	ASSERT_PERMANENT_EQ(increment_sources_.size(), n_cumulative).error("Balance quantities differ from the checkpoint.");
+
+	const std::vector<double> &state = checkpoint.load(prefix + "/state");
+	ASSERT_PERMANENT_EQ(state.size(), 4);
+	last_time_ = state[0];
+	initial_ = (state[1] != 0.0);
+	output_line_counter_ = (unsigned int)state[2];
+	output_yaml_header_ = (state[3] != 0.0);
+}
+
+
 void Balance::output_legacy(double time)
 {
 	// write output only on process #0
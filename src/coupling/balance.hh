@@ -20,6 +20,7 @@
 
 
 #include <fstream>              // for ofstream
+#include <functional>           // for function
 #include <string>               // for string
 #include <vector>               // for vector
 #include <unordered_map>        // for unordered_map
@@ -32,6 +33,7 @@
 #include "tools/time_marks.hh"  // for TimeMark, TimeMark::Type
 #include "system/index_types.hh" // for LongIdx
 
+class Checkpoint;
 class Mesh;
 class TimeGovernor;
 class DOFHandlerMultiDim;
@@ -386,6 +388,15 @@ public:
 	/// Perform output to file for given time instant.
 	void output();
 
+	/**
+	 * Store cumulative quantities and state of output files to the checkpoint,
+	 * output files are flushed so they contain all records up to the checkpoint time.
+	 */
+	void save_state(Checkpoint &checkpoint, const std::string &prefix);
+
+	/// Restore state stored by @p save_state.
+	void load_state(const Checkpoint &checkpoint, const std::string &prefix);
+
 private:
 	/// Size of column in output (used if delimiter is space)
 	static const unsigned int output_column_width = 20;
@@ -407,6 +418,13 @@ private:
 	/// Perform output in yaml format
 	void output_yaml(double time);
 
+	/**
+	 * Open output file and in the case of restart write back its records up to the restart time.
+	 * Function @p line_time returns time of a line of the file in output units, or NaN.
+	 */
+	void open_output_stream(const FilePath &file_path, std::ofstream &stream,
+			std::function<double(const std::string &)> line_time);
+
 	/// Return part of output represented by zero values. Count of zero values is given by cnt parameter.
 	std::string csv_zero_vals(unsigned int cnt, char delimiter);
 
@@ -28,6 +28,8 @@
 #include "fields/bc_field.hh"
 #include "tools/unit_converter.hh"
 #include "tools/unit_si.hh"
+#include "coupling/balance.hh"
+#include "system/checkpoint.hh"
 
 
 
@@ -81,6 +83,25 @@ double EquationBase::solved_time()
     return time_->t();
 }
 
+std::string EquationBase::checkpoint_prefix() const
+{
+    return input_record_.address_string();
+}
+
+void EquationBase::save_state(Checkpoint &checkpoint)
+{
+    if (equation_empty_) return;
+    if (time_ != nullptr) time_->save_state(checkpoint, checkpoint_prefix() + "/time");
+    if (balance_) balance_->save_state(checkpoint, checkpoint_prefix() + "/balance");
+}
+
+void EquationBase::load_state(const Checkpoint &checkpoint)
+{
+    if (equation_empty_) return;
+    if (time_ != nullptr) time_->load_state(checkpoint, checkpoint_prefix() + "/time");
+    if (balance_) balance_->load_state(checkpoint, checkpoint_prefix() + "/balance");
+}
+
 void EquationBase::init_user_fields(Input::Array user_fields, FieldSet &output_fields) {
 	for (Input::Iterator<Input::Record> it = user_fields.begin<Input::Record>();
                     it != user_fields.end();
@@ -31,6 +31,7 @@
 #include "tools/time_governor.hh"                      // for TimeGovernor
 #include "tools/time_marks.hh"                         // for TimeMark, Time...
 class Balance;
+class Checkpoint;
 class FieldSet;
 class Mesh;
 
@@ -235,7 +236,24 @@ public:
      */
     void init_user_fields(Input::Array user_fields, FieldSet &output_fields);
 
+    /**
+     * Store state of the equation necessary for restart to the checkpoint. Default implementation
+     * stores the time governor and the balance, equations with a solution have to override this method
+     * and add their solution vectors (with keys prefixed by @p checkpoint_prefix).
+     */
+    virtual void save_state(Checkpoint &checkpoint);
+
+    /**
+     * Restore state stored by @p save_state. Called on restart after @p zero_time_step,
+     * the equation must be in the same state as after the last time step before the checkpoint was saved.
+     */
+    virtual void load_state(const Checkpoint &checkpoint);
+
 protected:
+    /// Prefix of checkpoint keys of the equation, given by address of its input record.
+    std::string checkpoint_prefix() const;
+
+
     bool equation_empty_;       ///< flag is true if only default constructor was called
     Mesh * mesh_;
     TimeGovernor *time_;
@@ -18,12 +18,19 @@
 #ifndef GENERIC_ASSEMBLY_HH_
 #define GENERIC_ASSEMBLY_HH_
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include "quadrature/quadrature_lib.hh"
 #include "fields/eval_subset.hh"
 #include "fields/eval_points.hh"
 #include "fields/field_value_cache.hh"
 #include "tools/revertable_list.hh"
+#include "tools/thread_pool.hh"
 #include "system/sys_profiler.hh"
+#include "system/logger.hh"
 
 
 
@@ -46,6 +53,73 @@ struct AssemblyIntegrals {
 };
 
 
+/**
+ * @brief Auxiliary data class holds number of threads used in evaluation of integrals on patch
+ * and pool of these threads. Number of threads can be set explicitly (e.g. as command line parameter).
+ *
+ * Implementation is done as singletone with access through static methods, same as CacheMapElementNumber.
+ * Pool is shared by all GenericAssembly objects, it is created during first call of thread_pool.
+ */
+class AssemblyThreadNumber {
+public:
+	/// Return number of threads, value 1 means serial assembly
+	static unsigned int get() {
+	    return get_instance().n_threads_;
+	}
+
+	/// Set number of threads, must be called before first threaded assembly
+	static void set(unsigned int n_threads) {
+	    ASSERT_PERMANENT_GT(n_threads, 0).error("Number of assembly threads must be positive.\n");
+	    get_instance().n_threads_ = n_threads;
+	    get_instance().thread_pool_.reset();
+	}
+
+	/// Return thread pool, calling thread is used as one of assembly threads
+	static ThreadPool &thread_pool() {
+	    AssemblyThreadNumber &instance = get_instance();
+	    if (!instance.thread_pool_)
+	        instance.thread_pool_ = std::make_unique<ThreadPool>(instance.n_threads_ - 1);
+	    return *instance.thread_pool_;
+	}
+
+	AssemblyThreadNumber(AssemblyThreadNumber const&) = delete;  ///< We don't need copy constructor.
+	void operator=(AssemblyThreadNumber const&)        = delete;  ///< We don't need assignment operator.
+
+private:
+	/// Forbiden default constructor
+	AssemblyThreadNumber() : n_threads_(1) {}
+
+    static AssemblyThreadNumber& get_instance()
+    {
+        static AssemblyThreadNumber instance;
+        return instance;
+    }
+
+    /// Number of threads evaluating integrals.
+    unsigned int n_threads_;
+
+    /// Pool of n_threads_-1 workers.
+    std::unique_ptr<ThreadPool> thread_pool_;
+};
+
+
+/**
+ * @brief Trait allows threaded evaluation of integrals of DimAssembly class.
+ *
+ * Evaluation is allowed if DimAssembly declares 'static constexpr bool thread_safe_integrals = true'.
+ * Such class must:
+ *  - use only own data members as temporary data of integral methods (FEValues, local matrices, ...)
+ *  - guard all writes to data shared by threads (linear systems, balance, ...) by AssemblyBase::lock_shared_data
+ *  - not call profiler or logger in integral methods
+ */
+template <class DimAsm, class = void>
+struct ThreadSafeIntegrals : std::false_type {};
+
+template <class DimAsm>
+struct ThreadSafeIntegrals<DimAsm, std::void_t<decltype(DimAsm::thread_safe_integrals)>>
+: std::integral_constant<bool, DimAsm::thread_safe_integrals> {};
+
+
 /**
  * Common interface class for all Assembly classes.
  */
@@ -174,6 +248,8 @@ public:
     GenericAssembly( typename DimAssembly<1>::EqFields *eq_fields, typename DimAssembly<1>::EqData *eq_data)
     : multidim_assembly_(eq_fields, eq_data),
 	  min_edge_sides_(2),
+	  patch_target_size_(0),
+	  n_patches_(0), n_reverted_patches_(0),
 	  bulk_integral_data_(20, 10),
 	  edge_integral_data_(12, 6),
 	  coupling_integral_data_(12, 6),
@@ -189,6 +265,7 @@ public:
         multidim_assembly_[2_d]->initialize(&element_cache_map_);
         multidim_assembly_[3_d]->initialize(&element_cache_map_);
         active_integrals_ = multidim_assembly_[1_d]->n_active_integrals();
+        this->init_fill_estimate();
     }
 
     /// Getter to set of assembly objects
@@ -206,15 +283,19 @@ public:
 	 * Loops through local cells and calls assemble methods of assembly
 	 * object of each cells over space dimension.
 	 *
-	 * TODO:
-	 * - make estimate of the cache fill for combination of (integral_type x element dimension)
-	 * - add next cell to patch if current_patch_size + next_element_size <= fixed_cache_size
-	 * - avoid reverting the integral data lists.
+	 * Patch is closed before adding of the cell if estimated cache fill of its integrals
+	 * (see estimate_computing_step_fill) would exceed patch_target_size_. Integral data
+	 * lists are reverted only if estimate fails and patch overflows CacheMapElementNumber.
+	 *
+	 * Number of patches and number of reverted patches are passed to profiler as call counts
+	 * of timers 'patch_refills' and 'patch_reverts', target patch size as call count of timer 'patch_target_size'.
 	 */
     void assemble(std::shared_ptr<DOFHandlerMultiDim> dh) override {
         START_TIMER( DimAssembly<1>::name() );
         this->reallocate_cache();
         multidim_assembly_[1_d]->begin();
+        n_patches_ = 0;
+        n_reverted_patches_ = 0;
 
         bool add_into_patch = false; // control variable
         for(auto cell_it = dh->local_range().begin(); cell_it != dh->local_range().end(); )
@@ -223,6 +304,11 @@ public:
             if (!add_into_patch) {
         	    element_cache_map_.start_elements_update();
         	    add_into_patch = true;
+            } else if (element_cache_map_.get_simd_rounded_size() + this->estimate_computing_step_fill(*cell_it) > patch_target_size_) {
+                // next cell doesn't fit into patch
+                this->assemble_integrals();
+                add_into_patch = false;
+                continue;
             }
 
             START_TIMER("add_integrals_to_patch");
@@ -230,11 +316,14 @@ public:
             END_TIMER("add_integrals_to_patch");
 
             if (element_cache_map_.get_simd_rounded_size() > CacheMapElementNumber::get()) {
+                ASSERT_PERMANENT_GT(element_cache_map_.eval_point_data_.permanent_size(), 0)
+                        .error("Eval points of single cell exceed size of FieldValueCache, increase CacheMapElementNumber.\n");
                 bulk_integral_data_.revert_temporary();
                 edge_integral_data_.revert_temporary();
                 coupling_integral_data_.revert_temporary();
                 boundary_integral_data_.revert_temporary();
                 element_cache_map_.eval_point_data_.revert_temporary();
+                ++n_reverted_patches_;
                 this->assemble_integrals();
                 add_into_patch = false;
             } else {
@@ -243,10 +332,6 @@ public:
                 coupling_integral_data_.make_permanent();
                 boundary_integral_data_.make_permanent();
                 element_cache_map_.eval_point_data_.make_permanent();
-                if (element_cache_map_.get_simd_rounded_size() == CacheMapElementNumber::get()) {
-                    this->assemble_integrals();
-                    add_into_patch = false;
-                }
                 ++cell_it;
             }
         }
@@ -255,6 +340,7 @@ public:
         }
 
         multidim_assembly_[1_d]->end();
+        this->profile_patch_statistics();
         END_TIMER( DimAssembly<1>::name() );
     }
 
@@ -264,8 +350,17 @@ public:
     }
 
 private:
+    /// Types of integrals distinguished in integral_fill_estimate_.
+    enum IntegralFill {
+        bulk_fill = 0,
+        edge_fill = 1,
+        coupling_fill = 2,
+        boundary_fill = 3
+    };
+
     /// Call assemblations when patch is filled
     void assemble_integrals() {
+        ++n_patches_;
         START_TIMER("create_patch");
         element_cache_map_.create_patch();
         END_TIMER("create_patch");
@@ -274,6 +369,14 @@ private:
         END_TIMER("cache_update");
         element_cache_map_.finish_elements_update();
 
+        if constexpr ( ThreadSafeIntegrals< DimAssembly<1> >::value ) {
+            if (AssemblyThreadNumber::get() > 1) {
+                this->assemble_integrals_threaded();
+                this->reset_integral_data();
+                return;
+            }
+        }
+
         {
             START_TIMER("assemble_volume_integrals");
             multidim_assembly_[1_d]->assemble_cell_integrals(bulk_integral_data_);
@@ -304,7 +407,11 @@ private:
             multidim_assembly_[3_d]->assemble_neighbour_integrals(coupling_integral_data_);
             END_TIMER("assemble_fluxes_elem_side");
         }
-        // clean integral data
+        this->reset_integral_data();
+    }
+
+    /// Clean integral data of finished patch
+    inline void reset_integral_data() {
         bulk_integral_data_.reset();
         edge_integral_data_.reset();
         coupling_integral_data_.reset();
@@ -312,6 +419,120 @@ private:
         element_cache_map_.clear_element_eval_points_map();
     }
 
+    /**
+     * Create copies of assembly object, one for each thread.
+     *
+     * Copies share integrals, ElementCacheMap and fields with multidim_assembly_, other data
+     * (FEValues, local matrices, ...) are private for each thread. Writes to shared data are
+     * guarded by shared_data_mutex_.
+     */
+    void create_thread_assemblies() {
+        unsigned int n_threads = AssemblyThreadNumber::get();
+        if (thread_assembly_.size() == n_threads) return;
+
+        thread_assembly_.clear();
+        thread_assembly_.reserve(n_threads);
+        for (unsigned int i=0; i<n_threads; ++i) {
+            thread_assembly_.emplace_back(multidim_assembly_[1_d]->eq_fields_, multidim_assembly_[1_d]->eq_data_);
+            MixedPtr<DimAssembly, 1> &dim_assembly = thread_assembly_.back();
+            dim_assembly[1_d]->share_integrals(*multidim_assembly_[1_d]);
+            dim_assembly[2_d]->share_integrals(*multidim_assembly_[2_d]);
+            dim_assembly[3_d]->share_integrals(*multidim_assembly_[3_d]);
+            dim_assembly[1_d]->initialize(&element_cache_map_);
+            dim_assembly[2_d]->initialize(&element_cache_map_);
+            dim_assembly[3_d]->initialize(&element_cache_map_);
+            dim_assembly[1_d]->set_shared_data_mutex(&shared_data_mutex_);
+            dim_assembly[2_d]->set_shared_data_mutex(&shared_data_mutex_);
+            dim_assembly[3_d]->set_shared_data_mutex(&shared_data_mutex_);
+        }
+    }
+
+    /// Return range of items of integral data list processed by given thread.
+    static inline std::pair<unsigned int, unsigned int> thread_range(unsigned int list_size, unsigned int i_thread, unsigned int n_threads) {
+        return std::make_pair(list_size * i_thread / n_threads, list_size * (i_thread+1) / n_threads);
+    }
+
+    /**
+     * Threaded version of integral evaluation of assemble_integrals.
+     *
+     * Each type of integrals is divided to continuous blocks processed by separate threads,
+     * types are processed in same order as in serial assembly. Fields are evaluated before
+     * on whole patch, threads only read FieldValueCache.
+     */
+    void assemble_integrals_threaded() {
+        this->create_thread_assemblies();
+        ThreadPool &pool = AssemblyThreadNumber::thread_pool();
+        unsigned int n_threads = thread_assembly_.size();
+
+        {
+            START_TIMER("assemble_volume_integrals");
+            pool.parallel_for(n_threads, [this, n_threads](unsigned int i_thread) {
+                MixedPtr<DimAssembly, 1> &dim_assembly = thread_assembly_[i_thread];
+                auto range = thread_range(bulk_integral_data_.permanent_size(), i_thread, n_threads);
+                for (unsigned int i=range.first; i<range.second; ++i) {
+                    const BulkIntegralData &data = bulk_integral_data_[i];
+                    unsigned int element_patch_idx = element_cache_map_.position_in_cache(data.cell.elm_idx());
+                    switch (data.cell.dim()) {
+                    case 1: dim_assembly[1_d]->cell_integral(data.cell, element_patch_idx); break;
+                    case 2: dim_assembly[2_d]->cell_integral(data.cell, element_patch_idx); break;
+                    case 3: dim_assembly[3_d]->cell_integral(data.cell, element_patch_idx); break;
+                    }
+                }
+            });
+            END_TIMER("assemble_volume_integrals");
+        }
+
+        {
+            START_TIMER("assemble_fluxes_boundary");
+            pool.parallel_for(n_threads, [this, n_threads](unsigned int i_thread) {
+                MixedPtr<DimAssembly, 1> &dim_assembly = thread_assembly_[i_thread];
+                auto range = thread_range(boundary_integral_data_.permanent_size(), i_thread, n_threads);
+                for (unsigned int i=range.first; i<range.second; ++i) {
+                    const BoundaryIntegralData &data = boundary_integral_data_[i];
+                    switch (data.side.dim()) {
+                    case 1: dim_assembly[1_d]->boundary_side_integral(data.side); break;
+                    case 2: dim_assembly[2_d]->boundary_side_integral(data.side); break;
+                    case 3: dim_assembly[3_d]->boundary_side_integral(data.side); break;
+                    }
+                }
+            });
+            END_TIMER("assemble_fluxes_boundary");
+        }
+
+        {
+            START_TIMER("assemble_fluxes_elem_elem");
+            pool.parallel_for(n_threads, [this, n_threads](unsigned int i_thread) {
+                MixedPtr<DimAssembly, 1> &dim_assembly = thread_assembly_[i_thread];
+                auto range = thread_range(edge_integral_data_.permanent_size(), i_thread, n_threads);
+                for (unsigned int i=range.first; i<range.second; ++i) {
+                    const EdgeIntegralData &data = edge_integral_data_[i];
+                    switch (data.edge_side_range.begin()->dim()) {
+                    case 1: dim_assembly[1_d]->edge_integral(data.edge_side_range); break;
+                    case 2: dim_assembly[2_d]->edge_integral(data.edge_side_range); break;
+                    case 3: dim_assembly[3_d]->edge_integral(data.edge_side_range); break;
+                    }
+                }
+            });
+            END_TIMER("assemble_fluxes_elem_elem");
+        }
+
+        {
+            START_TIMER("assemble_fluxes_elem_side");
+            pool.parallel_for(n_threads, [this, n_threads](unsigned int i_thread) {
+                MixedPtr<DimAssembly, 1> &dim_assembly = thread_assembly_[i_thread];
+                auto range = thread_range(coupling_integral_data_.permanent_size(), i_thread, n_threads);
+                for (unsigned int i=range.first; i<range.second; ++i) {
+                    const CouplingIntegralData &data = coupling_integral_data_[i];
+                    switch (data.side.dim()) {
+                    case 2: dim_assembly[2_d]->dimjoin_intergral(data.cell, data.side); break;
+                    case 3: dim_assembly[3_d]->dimjoin_intergral(data.cell, data.side); break;
+                    }
+                }
+            });
+            END_TIMER("assemble_fluxes_elem_side");
+        }
+    }
+
     /**
      * Add data of integrals to appropriate structure and register elements to ElementCacheMap.
      *
@@ -348,6 +569,7 @@ private:
 
     /// Add data of volume integral to appropriate data structure.
     inline void add_volume_integral(const DHCellAccessor &cell) {
+        unsigned int n_points = element_cache_map_.eval_point_data_.temporary_size();
         uint subset_idx = integrals_.bulk_[cell.dim()-1]->get_subset_idx();
         bulk_integral_data_.emplace_back(cell, subset_idx);
 
@@ -358,10 +580,12 @@ private:
                   i<uint( eval_points_->subset_end(cell.dim(), subset_idx) ); ++i) {
             element_cache_map_.add_eval_point(reg_idx, cell.elm_idx(), i, cell.local_idx());
         }
+        this->update_fill_estimate(IntegralFill::bulk_fill, cell.dim(), n_points);
     }
 
     /// Add data of edge integral to appropriate data structure.
     inline void add_edge_integral(const DHCellSide &cell_side) {
+        unsigned int n_points = element_cache_map_.eval_point_data_.temporary_size();
         auto range = cell_side.edge_sides();
         edge_integral_data_.emplace_back(range, integrals_.edge_[range.begin()->dim()-1]->get_subset_idx());
 
@@ -371,10 +595,13 @@ private:
                 element_cache_map_.add_eval_point(reg_idx, edge_side.elem_idx(), p.eval_point_idx(), edge_side.cell().local_idx());
             }
         }
+        // estimate is stored per one side of edge
+        this->update_fill_estimate(IntegralFill::edge_fill, cell_side.dim(), n_points, cell_side.n_edge_sides());
     }
 
     /// Add data of coupling integral to appropriate data structure.
     inline void add_coupling_integral(const DHCellAccessor &cell, const DHCellSide &ngh_side, bool add_low) {
+        unsigned int n_points = element_cache_map_.eval_point_data_.temporary_size();
         coupling_integral_data_.emplace_back(cell, integrals_.coupling_[cell.dim()-1]->get_subset_low_idx(), ngh_side,
                 integrals_.coupling_[cell.dim()-1]->get_subset_high_idx());
 
@@ -388,10 +615,12 @@ private:
                 element_cache_map_.add_eval_point(reg_idx_low, cell.elm_idx(), p_low.eval_point_idx(), cell.local_idx());
         	}
         }
+        this->update_fill_estimate(IntegralFill::coupling_fill, cell.dim(), n_points);
     }
 
     /// Add data of boundary integral to appropriate data structure.
     inline void add_boundary_integral(const DHCellSide &bdr_side) {
+        unsigned int n_points = element_cache_map_.eval_point_data_.temporary_size();
         boundary_integral_data_.emplace_back(integrals_.boundary_[bdr_side.dim()-1]->get_subset_low_idx(), bdr_side,
                 integrals_.boundary_[bdr_side.dim()-1]->get_subset_high_idx());
 
@@ -404,11 +633,125 @@ private:
         	// invalid local_idx value, DHCellAccessor of boundary element doesn't exist
         	element_cache_map_.add_eval_point(bdr_reg, bdr_side.cond().bc_ele_idx(), p_bdr.eval_point_idx(), -1);
         }
+        this->update_fill_estimate(IntegralFill::boundary_fill, bdr_side.dim(), n_points);
+    }
+
+    /**
+     * Set initial estimates of number of eval points added to patch by one integral.
+     *
+     * Estimates are given by numbers of points of integrals on one element (side). Coupling and boundary
+     * integrals add points on both elements.
+     */
+    void init_fill_estimate() {
+        for (auto &estimate : integral_fill_estimate_) estimate.fill(0);
+        for (unsigned int i=0; i<3; ++i) {
+            if (integrals_.bulk_[i])
+                integral_fill_estimate_[IntegralFill::bulk_fill][i] = integrals_.bulk_[i]->n_points();
+            if (integrals_.edge_[i])
+                integral_fill_estimate_[IntegralFill::edge_fill][i] = integrals_.edge_[i]->n_points_per_side();
+            if (integrals_.boundary_[i])
+                integral_fill_estimate_[IntegralFill::boundary_fill][i] = 2 * integrals_.boundary_[i]->n_points_per_side();
+            if (i<2 && integrals_.coupling_[i])
+                integral_fill_estimate_[IntegralFill::coupling_fill][i] = 2 * integrals_.coupling_[i]->n_points_per_side();
+        }
+    }
+
+    /**
+     * Update estimate of number of eval points added to patch by one integral of given type and dimension.
+     *
+     * @param fill_type   Type of integral
+     * @param dim         Dimension of cell (lower dim cell of coupling integral)
+     * @param n_points    Size of eval_point_data_ before addition of integral
+     * @param n_items     Number of items of integral (sides of edge integral) covered by estimate
+     */
+    inline void update_fill_estimate(IntegralFill fill_type, unsigned int dim, unsigned int n_points, unsigned int n_items = 1) {
+        unsigned int n_added = element_cache_map_.eval_point_data_.temporary_size() - n_points;
+        unsigned int item_fill = (n_added + n_items - 1) / n_items;
+        unsigned int &estimate = integral_fill_estimate_[fill_type][dim-1];
+        if (item_fill > estimate) estimate = item_fill;
+    }
+
+    /**
+     * Return estimate of number of eval points added to patch by add_integrals_of_computing_step.
+     *
+     * Method follows logic of add_integrals_of_computing_step, number of points of each integral
+     * is given by integral_fill_estimate_. Padding of new region of cell (see ElementCacheMap::get_simd_rounded_size)
+     * is added too.
+     */
+    unsigned int estimate_computing_step_fill(DHCellAccessor cell) const {
+        unsigned int fill = 0;
+        if (active_integrals_ & ActiveIntegrals::bulk)
+    	    if (cell.is_own()) { // Not ghost
+    	        fill += integral_fill_estimate_[IntegralFill::bulk_fill][cell.dim()-1];
+    	    }
+
+        for( DHCellSide cell_side : cell.side_range() ) {
+            if (active_integrals_ & ActiveIntegrals::boundary)
+                if (cell.is_own()) // Not ghost
+                    if ( (cell_side.side().edge().n_sides() == 1) && (cell_side.side().is_boundary()) ) {
+                        fill += integral_fill_estimate_[IntegralFill::boundary_fill][cell.dim()-1];
+                        continue;
+                    }
+            if (active_integrals_ & ActiveIntegrals::edge)
+                if ( (cell_side.n_edge_sides() >= min_edge_sides_) && (cell_side.edge_sides().begin()->element().idx() == cell.elm_idx())) {
+                    fill += cell_side.n_edge_sides() * integral_fill_estimate_[IntegralFill::edge_fill][cell.dim()-1];
+                }
+        }
+
+        if (active_integrals_ & ActiveIntegrals::coupling) {
+        	for( DHCellSide neighb_side : cell.neighb_sides() ) {
+                if (cell.dim() != neighb_side.dim()-1) continue;
+                fill += integral_fill_estimate_[IntegralFill::coupling_fill][cell.dim()-1];
+            }
+        }
+
+        if ( !element_cache_map_.contains_region(cell.elm().region_idx().idx()) )
+            fill += element_cache_map_.simd_size_double - 1;
+        return fill;
+    }
+
+    /**
+     * Set target size of patch (patch_target_size_).
+     *
+     * Size is given by CacheMapByteBudget and by size of FieldValueCache arrays of all evaluated fields
+     * per one eval point, it is limited by CacheMapElementNumber and rounded down to SIMD size.
+     * Method must be called after cache_reallocate.
+     */
+    void set_patch_target_size() {
+        std::size_t point_bytes = multidim_assembly_[1_d]->eq_fields_->cache_bytes_per_point();
+        std::size_t n_points = CacheMapElementNumber::get();
+        if (point_bytes > 0) n_points = std::min(n_points, CacheMapByteBudget::get() / point_bytes);
+        unsigned int simd_size = element_cache_map_.simd_size_double;
+        unsigned int target_size = std::max( simd_size, (unsigned int)(n_points / simd_size * simd_size) );
+        if (target_size != patch_target_size_) {
+            patch_target_size_ = target_size;
+            DebugOut().fmt("Patch target size of {}: {} eval points.\n", DimAssembly<1>::name(), patch_target_size_);
+        }
+        // profiler reports actual target size as number of calls of the timer
+        START_TIMER("patch_target_size");
+        SET_CALLS(patch_target_size_);
+        END_TIMER("patch_target_size");
+    }
+
+    /// Pass statistics of patches of last assemble call to profiler.
+    void profile_patch_statistics() {
+        // ADD_CALLS adds n-1 calls to the timer opened once
+        if (n_patches_ > 0) {
+            START_TIMER("patch_refills");
+            ADD_CALLS(n_patches_);
+            END_TIMER("patch_refills");
+        }
+        if (n_reverted_patches_ > 0) {
+            START_TIMER("patch_reverts");
+            ADD_CALLS(n_reverted_patches_);
+            END_TIMER("patch_reverts");
+        }
     }
 
     /// Calls cache_reallocate method on
     inline void reallocate_cache() {
         multidim_assembly_[1_d]->eq_fields_->cache_reallocate(this->element_cache_map_, multidim_assembly_[1_d]->used_fields_);
+        this->set_patch_target_size();
         // DebugOut() << "Order of evaluated fields (" << DimAssembly<1>::name() << "):" << multidim_assembly_[1_d]->eq_fields_->print_dependency();
     }
 
@@ -416,6 +759,12 @@ private:
     /// Assembly object
     MixedPtr<DimAssembly, 1> multidim_assembly_;
 
+    /// Copies of assembly object used in threaded evaluation of integrals, one for each thread.
+    std::vector< MixedPtr<DimAssembly, 1> > thread_assembly_;
+
+    /// Guards data shared by threads of assembly (linear systems, balance, ...).
+    std::mutex shared_data_mutex_;
+
     /// Holds mask of active integrals.
     int active_integrals_;
 
@@ -427,6 +776,22 @@ private:
      */
     unsigned int min_edge_sides_;
 
+    /**
+     * Estimates of number of eval points added to patch by one integral, updated during assembly.
+     *
+     * Indexed by [integral type][dimension-1], estimate of edge integral holds number of points of one side.
+     */
+    std::array<std::array<unsigned int, 3>, 4> integral_fill_estimate_;
+
+    /// Target number of eval points in patch, set by set_patch_target_size.
+    unsigned int patch_target_size_;
+
+    /// Number of patches evaluated in last assemble call.
+    unsigned int n_patches_;
+
+    /// Number of patches closed by revert of temporary integral data in last assemble call.
+    unsigned int n_reverted_patches_;
+
     // Following variables hold data of all integrals depending of actual computed element.
     // TODO sizes of arrays should be set dynamically, depend on number of elements in ElementCacheMap,
     RevertableList<BulkIntegralData>       bulk_integral_data_;      ///< Holds data for computing bulk integrals.
@@ -32,9 +32,17 @@
 #include "mesh/mesh.h"
 #include "io/msh_gmshreader.h"
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
+#include "tools/time_governor.hh"
+#include "system/file_path.hh"
+#include "io/output_time.hh"
 #include "input/input_type.hh"
 #include "input/accessors.hh"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 
 FLOW123D_FORCE_LINK_IN_PARENT(transportOperatorSplitting)
 FLOW123D_FORCE_LINK_IN_PARENT(concentrationTransportModel)
@@ -71,10 +79,28 @@ const it::Record & HC_ExplicitSequential::get_input_type() {
 				"Transport of soluted substances, depends on the velocity field from a Flow equation.")
 		.declare_key("heat_equation", AdvectionProcessBase::get_input_type(),
 		        "Heat transfer, depends on the velocity field from a Flow equation.")
+		.declare_key("checkpoint", HC_ExplicitSequential::get_checkpoint_input_type(), it::Default::optional(),
+		        "Checkpoints of the state of all equations and restart of the simulation from a checkpoint.")
 		.close();
 }
 
 
+const it::Record & HC_ExplicitSequential::get_checkpoint_input_type() {
+    return it::Record("Coupling_Checkpoint",
+            "Checkpoints of the simulation state. Every process writes its own binary file,\n"
+            "so the restarted simulation must run on the same number of processes.")
+        .declare_key("times", it::Array(TimeGovernor::get_input_time_type(0.0)), it::Default("[]"),
+                "Times of checkpoints. They are fixed times of all equations, the checkpoint is written when all equations reach the time.")
+        .declare_key("file", it::String(), it::Default("\"checkpoint\""),
+                "Base name of checkpoint files in the output directory. The i-th checkpoint time is written to files\n"
+                "<file>-<i>.<rank>.chk, where <i> has six digits.")
+        .declare_key("restart_from", it::String(), it::Default::optional(),
+                "Base name of checkpoint files (e.g. 'checkpoint-000001') in the output directory to restart the simulation from.\n"
+                "Time series of VTK output, observe and balance files in the output directory are continued after the checkpoint time.")
+        .close();
+}
+
+
 const int HC_ExplicitSequential::registrar = HC_ExplicitSequential::get_input_type().size();
 
 
@@ -121,6 +147,9 @@ HC_ExplicitSequential::HC_ExplicitSequential(Input::Record in_record)
 	START_TIMER("HC constructor");
     using namespace Input;
 
+    // restart time must be known before output streams of equations are created
+    init_checkpoints();
+
     // Read mesh
     {
         START_TIMER("HC read mesh");
@@ -158,13 +187,127 @@ HC_ExplicitSequential::HC_ExplicitSequential(Input::Record in_record)
 
     processes_.push_back(AdvectionData(make_advection_process("solute_equation")));
     processes_.push_back(AdvectionData(make_advection_process("heat_equation")));
+
+    add_checkpoint_marks();
+}
+
+
+void HC_ExplicitSequential::init_checkpoints()
+{
+    Input::Record chk_rec;
+    if (! in_record_.opt_val("checkpoint", chk_rec)) return;
+    checkpoint_file_ = chk_rec.val<std::string>("file");
+
+    std::string restart_from;
+    if (chk_rec.opt_val("restart_from", restart_from)) {
+        int rank, n_proc;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &n_proc);
+
+        std::string file_name = FilePath(Checkpoint::rank_file_name(restart_from, rank), FilePath::output_file);
+        restart_checkpoint_ = std::make_shared<Checkpoint>();
+        restart_checkpoint_->read(file_name);
+        if (restart_checkpoint_->load_value("n_proc") != n_proc)
+            THROW( Checkpoint::ExcCheckpointProcesses() << Checkpoint::EI_File(file_name)
+                    << Checkpoint::EI_Size(restart_checkpoint_->load_value("n_proc")) << Checkpoint::EI_ExpectedSize(n_proc) );
+
+        Checkpoint::set_restart_time(restart_checkpoint_->time());
+        MessageOut().fmt("Restart from checkpoint '{}' at time: {}\n", restart_from, restart_checkpoint_->time());
+    }
+}
+
+
+void HC_ExplicitSequential::add_checkpoint_marks()
+{
+    Input::Record chk_rec;
+    if (! in_record_.opt_val("checkpoint", chk_rec)) return;
+
+    Input::Array times = chk_rec.val<Input::Array>("times");
+    std::vector<double> checkpoint_times;
+    for (auto it = times.begin<Input::Tuple>(); it != times.end(); ++it)
+        checkpoint_times.push_back( water->time().read_time(it) );
+    checkpoints_.init(checkpoint_times, water->time().init_time());
+
+    for (double t : checkpoints_.times()) {
+        TimeGovernor::marks().add( TimeMark(t, water->time().equation_fixed_mark_type()) );
+        for(auto &pdata : processes_)
+            if (has_state(pdata))
+                TimeGovernor::marks().add( TimeMark(t, pdata.process->time().equation_fixed_mark_type()) );
+    }
+}
+
+
+bool HC_ExplicitSequential::has_state(const AdvectionData &pdata) const
+{
+    return ! std::dynamic_pointer_cast<TransportNothing>(pdata.process);
+}
+
+
+void HC_ExplicitSequential::restart()
+{
+    START_TIMER("HC restart");
+    // equations are initialized by zero time steps and then their state is replaced by the checkpoint,
+    // output of the initial time is skipped since it is before the restart time
+    for(auto &pdata : processes_) {
+        if (! has_state(pdata)) continue;
+        auto& flux = pdata.process->eq_fieldset()["flow_flux"];
+        flux.copy_from(water->eq_fieldset()["flux"]);
+        flux.set_time_result_changed();
+        pdata.process->zero_time_step();
+    }
+
+    water->load_state(*restart_checkpoint_);
+    for(auto &pdata : processes_) {
+        if (has_state(pdata)) pdata.process->load_state(*restart_checkpoint_);
+        pdata.velocity_changed = true;
+    }
+    restart_checkpoint_.reset();
 }
 
+
+void HC_ExplicitSequential::write_checkpoint()
+{
+    // all running equations must be at the checkpoint time
+    std::vector<const TimeGovernor *> times = { &water->time() };
+    for(auto &pdata : processes_)
+        if (has_state(pdata)) times.push_back( &pdata.process->time() );
+    if (! checkpoints_.reached(times)) return;
+    double t_chk = checkpoints_.times()[checkpoints_.next_index()];
+
+    START_TIMER("HC write checkpoint");
+    int rank, n_proc;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &n_proc);
+
+    // finish writing of the previous checkpoint, possible error is reported here
+    if (checkpoint_) checkpoint_->wait();
+    checkpoint_ = std::make_shared<Checkpoint>();
+    checkpoint_->set_time(t_chk);
+    checkpoint_->save("n_proc", n_proc);
+    water->save_state(*checkpoint_);
+    for(auto &pdata : processes_)
+        if (has_state(pdata)) pdata.process->save_state(*checkpoint_);
+
+    // output files must contain all data up to the checkpoint time
+    OutputTime::flush_all();
+
+    std::stringstream base_name;
+    base_name << checkpoint_file_ << "-" << std::setw(6) << std::setfill('0') << checkpoints_.next_index();
+    std::string file_name = FilePath(Checkpoint::rank_file_name(base_name.str(), rank), FilePath::output_file);
+    checkpoint_->write(file_name, true);
+    MessageOut().fmt("Checkpoint '{}' at time: {}\n", base_name.str(), t_chk);
+
+    checkpoints_.advance();
+}
+
+
 void HC_ExplicitSequential::advection_process_step(AdvectionData &pdata)
 {
     if (pdata.process->time().is_end()) return;
 
     is_end_all_=false;
+    // wait at the checkpoint time for other equations
+    if ( has_state(pdata) && checkpoints_.hold(pdata.process->time()) ) return;
     if ( pdata.process->time().step().le(pdata.velocity_time) ) {
         // having information about velocity field we can perform transport step
 
@@ -228,6 +371,7 @@ void HC_ExplicitSequential::run_simulation()
         for(auto &process : processes_)
             process.velocity_changed = true;
     }
+    if (restart_checkpoint_) restart();
 
 
     // following cycle is designed to support independent time stepping of
@@ -254,6 +398,10 @@ void HC_ExplicitSequential::run_simulation()
             if(! pdata.process->time().is_end())
                 flow_step(pdata.process->solved_time());
         }
+
+        // flow is not ahead of advection processes here and processes wait at the checkpoint time,
+        // so all equations meet there
+        write_checkpoint();
         
         double water_dt=water->time().estimate_dt();
         if (water->time().is_end()) water_dt = TimeGovernor::inf_time;
@@ -286,10 +434,50 @@ void HC_ExplicitSequential::run_simulation()
         advection_process_step(processes_[0]); // solute
         advection_process_step(processes_[1]); // heat
     }
+    if (checkpoint_) checkpoint_->wait();
     //MessageOut().fmt("End of simulation at time: {}\n", max(solute->solved_time(), heat->solved_time()));
 }
 
 
+void CheckpointTimes::init(std::vector<double> times, double start_time)
+{
+    times_ = times;
+    std::sort(times_.begin(), times_.end());
+
+    // checkpoints up to the initial (or restart) time are not written
+    start_time = std::max(start_time, Checkpoint::restart_time());
+    next_ = 0;
+    while (next_ < times_.size() && (times_[next_] <= start_time || Checkpoint::before_restart(times_[next_])))
+        next_++;
+}
+
+
+bool CheckpointTimes::hold(const TimeGovernor &time) const
+{
+    return next_ < times_.size() && time.step().eq(times_[next_]);
+}
+
+
+bool CheckpointTimes::reached(const std::vector<const TimeGovernor *> &times)
+{
+    if (next_ >= times_.size()) return false;
+    double t_chk = times_[next_];
+
+    bool all_at_checkpoint = true;
+    for (const TimeGovernor *time : times) {
+        if (time->t() == TimeGovernor::inf_time) continue; // steady equation
+        if (time->step().gt(t_chk)) {
+            WarningOut().fmt("Checkpoint at time {} is skipped, an equation has already passed it (time {}).\n",
+                    t_chk, time->t());
+            next_++;
+            return false;
+        }
+        if (! time->is_end() && ! time->step().eq(t_chk)) all_at_checkpoint = false;
+    }
+    return all_at_checkpoint;
+}
+
+
 HC_ExplicitSequential::~HC_ExplicitSequential() {
 	water.reset();
 	for(auto &pdata : processes_) pdata.process.reset();
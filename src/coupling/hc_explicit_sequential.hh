@@ -26,10 +26,12 @@
 #include "input/accessors_forward.hh"
 #include "coupling/equation.hh"
 
+class Checkpoint;
 class DarcyFlowInterface;
 class Mesh;
 class AdvectionProcessBase;
 class FieldCommon;
+class TimeGovernor;
 
 
 /**
@@ -42,6 +44,53 @@ public:
 };
 
 
+/**
+ * @brief Times of checkpoints of a coupled simulation and the index of the next one.
+ *
+ * Coupled equations use different time steps, so they reach the next checkpoint time
+ * (a fixed time mark of every equation) in different passes of the coupling loop.
+ * An equation at the checkpoint time is held there until all running equations arrive.
+ */
+class CheckpointTimes {
+public:
+    CheckpointTimes()
+    : next_(0)
+    {}
+
+    /// Set checkpoint times, times up to @p start_time and before the restart time are not written.
+    void init(std::vector<double> times, double start_time);
+
+    /// Sorted checkpoint times.
+    inline const std::vector<double> &times() const
+    { return times_; }
+
+    /// Index of the next checkpoint time, equal to the number of times after the last one.
+    inline unsigned int next_index() const
+    { return next_; }
+
+    /// Return true if the equation is at the next checkpoint time and has to wait for other equations.
+    bool hold(const TimeGovernor &time) const;
+
+    /**
+     * Return true if all equations are at the next checkpoint time (or at their end).
+     * Steady equations are ignored. If an equation has passed the checkpoint time,
+     * a warning is printed and the checkpoint is skipped.
+     */
+    bool reached(const std::vector<const TimeGovernor *> &times);
+
+    /// Move to the next checkpoint time, called after the checkpoint is written.
+    inline void advance()
+    { next_++; }
+
+private:
+    /// Sorted times of checkpoints.
+    std::vector<double> times_;
+
+    /// Index of the next checkpoint time.
+    unsigned int next_;
+};
+
+
 /**
  * @brief Class for solution of steady or unsteady flow with sequentially coupled explicit transport.
  *
@@ -50,6 +99,9 @@ class HC_ExplicitSequential : public CouplingBase {
 public:
     static const Input::Type::Record & get_input_type();
 
+    /// Input record of checkpoint and restart settings.
+    static const Input::Type::Record & get_checkpoint_input_type();
+
     HC_ExplicitSequential(Input::Record in_record);
     void run_simulation();
     ~HC_ExplicitSequential();
@@ -83,6 +135,27 @@ private:
      */
     void flow_step(double requested_time);
 
+    /**
+     * Read checkpoint settings, set restart time if the simulation is restarted
+     * and read the restart checkpoint. Must be called before equations are created.
+     */
+    void init_checkpoints();
+
+    /// Add fixed time marks of checkpoint times to all equations.
+    void add_checkpoint_marks();
+
+    /// Perform zero time steps of all equations and restore their state from the restart checkpoint.
+    void restart();
+
+    /**
+     * Write checkpoint if all running equations reached the next checkpoint time.
+     * The file is written asynchronously, writing is finished before the next checkpoint.
+     */
+    void write_checkpoint();
+
+    /// Return true if the process is a real equation (not TransportNothing).
+    bool has_state(const AdvectionData &pdata) const;
+
     static const int registrar;
 
     ///
@@ -104,6 +177,18 @@ private:
 
     FieldCommon *water_content_saturated_;
     FieldCommon *water_content_p0_;
+
+    /// Checkpoint times, equations are held at the next one until all of them arrive.
+    CheckpointTimes checkpoints_;
+
+    /// Base name of checkpoint files.
+    std::string checkpoint_file_;
+
+    /// Checkpoint used for restart, NULL if the simulation is not restarted.
+    std::shared_ptr<Checkpoint> restart_checkpoint_;
+
+    /// The last written checkpoint, its asynchronous writing may be in progress.
+    std::shared_ptr<Checkpoint> checkpoint_;
 };
 
 #endif /* HC_EXPLICIT_SEQUENTIAL_HH_ */
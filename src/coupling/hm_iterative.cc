@@ -18,10 +18,13 @@
 
 #include "hm_iterative.hh"
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
 #include "input/input_type.hh"
 #include "flow/darcy_flow_lmh.hh"
 #include "fields/field_fe.hh"         // for create_field_fe()
 #include "fields/field_model.hh"      // for Model
+#include "la/anderson_acceleration.hh"
+#include "fem/dh_cell_accessor.hh"
 #include "assembly_hm.hh"
 
 
@@ -101,6 +104,11 @@ const it::Record & HM_Iterative::get_input_type() {
                 "Absolute tolerance for difference in HM iteration." )
         .declare_key( "r_tol", it::Double(0), it::Default("1e-7"),
                 "Relative tolerance for difference in HM iteration." )
+        .declare_key( "acceleration_depth", it::Integer(0), it::Default("0"),
+                "Number of previous iterates used by Anderson acceleration of HM iteration. "
+                "Value 0 switches the acceleration off, value 1 corresponds to the Aitken (secant) step." )
+        .declare_key( "acceleration_damping", it::Double(0, 1), it::Default("1"),
+                "Damping factor of accelerated HM iteration, value 1 means no damping." )
 		.close();
 }
 
@@ -271,6 +279,20 @@ void HM_Iterative::initialize()
     flow_potential_assembly_ = new GenericAssembly<FlowPotentialAssemblyHM>(eq_fields_.get(), eq_data_.get());
     residual_assembly_ = new GenericAssembly<ResidualAssemblyHM>(eq_fields_.get(), eq_data_.get());
 
+    if (acceleration_depth_ > 0) {
+        // iterate consists of element pressures (checked by the convergence criterion) and displacement
+        // divergence passed to flow; fluxes and edge pressures of the mixed flow solution have other
+        // units and are recomputed from the accelerated divergence by the next flow solve,
+        // so the mechanics load (built from edge pressures) follows without being extrapolated itself
+        auto &flow_data = eq_data_->flow_->eq_data();
+        std::vector<unsigned int> ele_pressure_dofs;
+        for (DHCellAccessor cell : flow_data.dh_->own_range())
+            ele_pressure_dofs.push_back( cell.get_loc_dof_indices()[ cell.n_dofs()/2 ] );
+        acceleration_ = std::make_shared<AndersonAcceleration>(acceleration_depth_, acceleration_damping_);
+        acceleration_->add_block(flow_data.full_solution, ele_pressure_dofs);
+        acceleration_->add_block(eq_data_->mechanics_->eq_fields().output_div_ptr->vec());
+    }
+
     Input::Array user_fields_arr;
     if (input_record_.opt_val("user_fields", user_fields_arr)) {
         FieldSet sham_eq_output; // only for correct call of init_user_fields method
@@ -312,9 +334,34 @@ void HM_Iterative::update_solution()
     time_->view("HM");
     eq_fields_->set_time(time_->step(), LimitSide::right);
 
+    if (acceleration_) acceleration_->restart();
     solve_step();
 }
 
+void HM_Iterative::save_state(Checkpoint &checkpoint)
+{
+    EquationBase::save_state(checkpoint);
+    eq_data_->flow_->save_state(checkpoint);
+    eq_data_->mechanics_->save_state(checkpoint);
+    checkpoint.save_vector(checkpoint_prefix() + "/old_iter_pressure", eq_fields_->old_iter_pressure_ptr_->vec());
+    checkpoint.save_vector(checkpoint_prefix() + "/old_div_u", eq_fields_->old_div_u_ptr_->vec());
+}
+
+
+void HM_Iterative::load_state(const Checkpoint &checkpoint)
+{
+    EquationBase::load_state(checkpoint);
+    eq_data_->flow_->load_state(checkpoint);
+    eq_data_->mechanics_->load_state(checkpoint);
+    checkpoint.load_vector(checkpoint_prefix() + "/old_iter_pressure", eq_fields_->old_iter_pressure_ptr_->vec());
+    checkpoint.load_vector(checkpoint_prefix() + "/old_div_u", eq_fields_->old_div_u_ptr_->vec());
+    eq_fields_->old_iter_pressure.set_time_result_changed();
+    eq_fields_->old_div_u.set_time_result_changed();
+    // potential load of mechanics is given by restored pressure
+    update_potential();
+}
+
+
 void HM_Iterative::solve_iteration()
 {
     // pass displacement (divergence) to flow
@@ -325,12 +372,12 @@ void HM_Iterative::solve_iteration()
     // pass pressure to mechanics and solve mechanics
     update_potential();
     eq_data_->mechanics_->solve_linear_system();
+    eq_data_->mechanics_->update_output_fields();
 }
 
 
 void HM_Iterative::update_after_iteration()
 {
-    eq_data_->mechanics_->update_output_fields();
     copy_field(*eq_data_->flow_->eq_fields().field_ele_pressure.get_field_fe(), *eq_fields_->old_iter_pressure_ptr_);
     eq_fields_->old_iter_pressure.set_time_result_changed();
 }
@@ -394,6 +441,15 @@ void HM_Iterative::compute_iteration_error(double& abs_error, double& rel_error)
 }
 
 
+void HM_Iterative::accelerate_iteration()
+{
+    if (!acceleration_) return;
+
+    acceleration_->apply();
+    eq_data_->flow_->eq_fields().field_ele_pressure.set_time_result_changed();
+    eq_data_->mechanics_->eq_fields().output_divergence.set_time_result_changed();
+}
+
 
 HM_Iterative::~HM_Iterative() {
 	eq_data_->flow_.reset();
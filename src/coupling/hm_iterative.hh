@@ -28,10 +28,13 @@
 #include "flow/darcy_flow_interface.hh"
 #include "mechanics/elasticity.hh"
 #include "system/exceptions.hh"
+#include "system/logger.hh"
+#include "system/sys_profiler.hh"
 
 class Mesh;
 class FieldCommon;
 class DarcyLMH;
+class AndersonAcceleration;
 
 template<unsigned int dim> class FlowPotentialAssemblyHM;
 template<unsigned int dim> class ResidualAssemblyHM;
@@ -57,6 +60,11 @@ public:
                     "Absolute tolerance for difference in HM iteration." )
             .declare_key( "r_tol", it::Double(0), it::Default("1e-7"),
                     "Relative tolerance for difference in HM iteration." )
+            .declare_key( "acceleration_depth", it::Integer(0), it::Default("0"),
+                    "Number of previous iterates used by Anderson acceleration of HM iteration. "
+                    "Value 0 switches the acceleration off, value 1 corresponds to the Aitken (secant) step." )
+            .declare_key( "acceleration_damping", it::Double(0, 1), it::Default("1"),
+                    "Damping factor of accelerated HM iteration, value 1 means no damping." )
             .close();
     }
 
@@ -67,6 +75,8 @@ public:
         max_it_ = in_record.val<unsigned int>("max_it");
         a_tol_ = in_record.val<double>("a_tol");
         r_tol_ = in_record.val<double>("r_tol");
+        acceleration_depth_ = in_record.val<unsigned int>("acceleration_depth");
+        acceleration_damping_ = in_record.val<double>("acceleration_damping");
     }
 
     void solve_step()
@@ -75,13 +85,21 @@ public:
         double abs_error = std::numeric_limits<double>::max();
         double rel_error = std::numeric_limits<double>::max();
 
-        while ( it < min_it_ || (abs_error > a_tol_ && rel_error > r_tol_ && it < max_it_) )
         {
-            it++;
-            solve_iteration();
-            compute_iteration_error(abs_error, rel_error);
-            update_after_iteration();
+            START_TIMER("HM iteration");
+            while ( continue_iteration(abs_error, rel_error) )
+            {
+                it++;
+                solve_iteration();
+                compute_iteration_error(abs_error, rel_error);
+                // the last iterate is kept unmodified
+                if ( continue_iteration(abs_error, rel_error) )
+                    accelerate_iteration();
+                update_after_iteration();
+            }
+            ADD_CALLS(it);
         }
+        MessageOut().fmt("HM iterations: {}\n", it);
         update_after_converged();
     }
 
@@ -96,6 +114,9 @@ protected:
     /// Compute absolute and relative error in the solution.
     virtual void compute_iteration_error(double &abs_error, double &rel_error) = 0;
 
+    /// Modify the iterate before the next iteration (acceleration of convergence), does nothing by default.
+    virtual void accelerate_iteration() {}
+
     /// Save data (e.g. solution fields) for the next iteration.
     virtual void update_after_iteration() = 0;
 
@@ -115,8 +136,18 @@ protected:
     /// Relative tolerance for difference between two succeeding iterations.
     double r_tol_;
 
+    /// Number of previous iterates used by Anderson acceleration (0 = no acceleration).
+    unsigned int acceleration_depth_;
+
+    /// Damping factor of accelerated iteration.
+    double acceleration_damping_;
+
 private:
 
+    /// Return true if next iteration has to be performed.
+    inline bool continue_iteration(double abs_error, double rel_error) const
+    { return it < min_it_ || (abs_error > a_tol_ && rel_error > r_tol_ && it < max_it_); }
+
     /// Iteration index.
     unsigned int it;
 
@@ -180,6 +211,8 @@ public:
     void initialize() override;
     void zero_time_step() override;
     void update_solution() override;
+    void save_state(Checkpoint &checkpoint) override;
+    void load_state(const Checkpoint &checkpoint) override;
     ~HM_Iterative();
 
 private:
@@ -195,6 +228,8 @@ private:
     void update_after_converged() override;
     
     void compute_iteration_error(double &abs_error, double &rel_error) override;
+
+    void accelerate_iteration() override;
     
     static const int registrar;
 
@@ -205,6 +240,9 @@ private:
 
     std::shared_ptr<EqData> eq_data_;
 
+    /// Anderson acceleration of iterates of flow solution and displacement divergence, NULL if switched off.
+    std::shared_ptr<AndersonAcceleration> acceleration_;
+
 };
 
 #endif /* HC_EXPLICIT_SEQUENTIAL_HH_ */
@@ -181,8 +181,11 @@ void DOFHandlerMultiDim::receive_ghost_dofs(unsigned int proc, vector<LongIdx> &
     unsigned int n_elems = ghost_proc_el[proc].size();
     MPI_Send(&n_elems, 1, MPI_UNSIGNED, proc, 0, MPI_COMM_WORLD);
     
-    // send indices of elements required
-    MPI_Send(&(ghost_proc_el[proc][0]), n_elems, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD);
+    // send global rows of elements required (element indices differ between processes of distributed mesh)
+    vector<LongIdx> rows(n_elems);
+    for (unsigned int i=0; i<n_elems; i++)
+        rows[i] = mesh_->get_row_4_el()[ ghost_proc_el[proc][i] ];
+    MPI_Send(&(rows[0]), n_elems, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD);
     
     // receive numbers of dofs on required elements
     vector<unsigned int> n_dofs(n_elems);
@@ -202,9 +205,11 @@ void DOFHandlerMultiDim::send_ghost_dofs(unsigned int proc)
     unsigned int n_elems;
     MPI_Recv(&n_elems, 1, MPI_UNSIGNED, proc, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
     
-    // receive indices of elements required
+    // receive global rows of elements required and convert them to element indices
     vector<LongIdx> elems(n_elems);
     MPI_Recv(&(elems[0]), n_elems, MPI_LONG_IDX, proc, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    for (LongIdx &el : elems)
+        el = mesh_->get_el_4_loc()[ el - el_ds_->begin() ];
     
     // send numbers of dofs on required elements
     vector<unsigned int> n_dofs;
@@ -471,6 +476,10 @@ void DOFHandlerMultiDim::create_sequential()
       return;
   }
   
+  // sequential handler is indexed by all mesh elements, distributed mesh holds only own and ghost elements
+  ASSERT_PERMANENT( mesh_->get_el_ds()->size() == mesh_->n_elements() )
+          .error("Sequential DOF handler is not supported on distributed mesh.");
+  
   dh_seq_ = std::make_shared<DOFHandlerMultiDim>(*mesh_);
   
   dh_seq_->n_global_dofs_ = n_global_dofs_;
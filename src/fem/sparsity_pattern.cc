@@ -0,0 +1,140 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    sparsity_pattern.cc
+ * @brief   Symbolic sparsity pattern of matrix given by connectivity of DOF handler.
+ */
+
+#include <algorithm>
+#include <mpi.h>
+
+#include "fem/sparsity_pattern.hh"
+#include "fem/dofhandler.hh"
+#include "fem/dh_cell_accessor.hh"
+#include "la/distribution.hh"
+#include "system/sys_profiler.hh"
+
+
+SparsityPattern::SparsityPattern(std::shared_ptr<DOFHandlerMultiDim> dh)
+: dh_(dh),
+  distr_(dh->distr()),
+  local_rows_(distr_->lsize()),
+  remote_entries_(distr_->np())
+{}
+
+
+
+void SparsityPattern::add(const std::vector<LongIdx> &rows, const std::vector<LongIdx> &cols)
+{
+    for (LongIdx row : rows) {
+        if (distr_->is_local(row)) {
+            auto &row_cols = local_rows_[row - distr_->begin()];
+            row_cols.insert(row_cols.end(), cols.begin(), cols.end());
+        } else {
+            auto &entries = remote_entries_[distr_->get_proc(row)];
+            for (LongIdx col : cols) {
+                entries.push_back(row);
+                entries.push_back(col);
+            }
+        }
+    }
+}
+
+
+
+void SparsityPattern::add_couplings(unsigned int couplings)
+{
+    START_TIMER("SparsityPattern::add_couplings");
+    std::vector<LongIdx> dofs, side_dofs, coupled_dofs;
+    dofs.reserve(dh_->max_elem_dofs());
+    side_dofs.reserve(dh_->max_elem_dofs());
+
+    for (auto cell : dh_->local_range()) {
+        dofs.resize(cell.n_dofs());
+        cell.get_dof_indices(dofs);
+
+        if ( (couplings & Coupling::cell) && cell.is_own() )
+            this->add(dofs, dofs);
+
+        if (couplings & Coupling::edge) {
+            for (DHCellSide cell_side : cell.side_range()) {
+                // edge is processed by its first cell
+                if ( (cell_side.n_edge_sides() < 2) || (cell_side.edge_sides().begin()->element().idx() != cell.elm_idx()) )
+                    continue;
+                coupled_dofs.clear();
+                for (DHCellSide edge_side : cell_side.edge_sides()) {
+                    side_dofs.resize(edge_side.cell().n_dofs());
+                    edge_side.cell().get_dof_indices(side_dofs);
+                    coupled_dofs.insert(coupled_dofs.end(), side_dofs.begin(), side_dofs.end());
+                }
+                this->add(coupled_dofs, coupled_dofs);
+            }
+        }
+
+        if (couplings & Coupling::dimjoin) {
+            for (DHCellSide neighb_side : cell.neighb_sides()) { // cell -> elm lower dim, neighb_side -> elm higher dim
+                if (cell.dim() != neighb_side.dim()-1) continue;
+                DHCellAccessor cell_higher_dim = dh_->cell_accessor_from_element( neighb_side.element().idx() );
+                side_dofs.resize(cell_higher_dim.n_dofs());
+                cell_higher_dim.get_dof_indices(side_dofs);
+                coupled_dofs = dofs;
+                coupled_dofs.insert(coupled_dofs.end(), side_dofs.begin(), side_dofs.end());
+                this->add(coupled_dofs, coupled_dofs);
+            }
+        }
+    }
+}
+
+
+
+void SparsityPattern::finalize()
+{
+    START_TIMER("SparsityPattern::finalize");
+    MPI_Comm comm = distr_->get_comm();
+    unsigned int n_proc = distr_->np();
+
+    // send entries of remote rows to their owners
+    std::vector<int> send_counts(n_proc), recv_counts(n_proc), send_displs(n_proc+1, 0), recv_displs(n_proc+1, 0);
+    for (unsigned int proc=0; proc<n_proc; ++proc) {
+        send_counts[proc] = remote_entries_[proc].size();
+        send_displs[proc+1] = send_displs[proc] + send_counts[proc];
+    }
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+    for (unsigned int proc=0; proc<n_proc; ++proc)
+        recv_displs[proc+1] = recv_displs[proc] + recv_counts[proc];
+
+    std::vector<LongIdx> send_entries, recv_entries(recv_displs[n_proc]);
+    send_entries.reserve(send_displs[n_proc]);
+    for (auto &entries : remote_entries_) {
+        send_entries.insert(send_entries.end(), entries.begin(), entries.end());
+        std::vector<LongIdx>().swap(entries);
+    }
+    MPI_Alltoallv(send_entries.data(), send_counts.data(), send_displs.data(), MPI_LONG_IDX,
+                  recv_entries.data(), recv_counts.data(), recv_displs.data(), MPI_LONG_IDX, comm);
+    for (unsigned int i=0; i<recv_entries.size(); i+=2)
+        local_rows_[recv_entries[i] - distr_->begin()].push_back(recv_entries[i+1]);
+
+    // count unique columns in diagonal and off-diagonal block
+    on_nz_.assign(local_rows_.size(), 0);
+    off_nz_.assign(local_rows_.size(), 0);
+    for (unsigned int i_row=0; i_row<local_rows_.size(); ++i_row) {
+        auto &row_cols = local_rows_[i_row];
+        std::sort(row_cols.begin(), row_cols.end());
+        row_cols.erase( std::unique(row_cols.begin(), row_cols.end()), row_cols.end() );
+        for (LongIdx col : row_cols) {
+            if (distr_->is_local(col)) on_nz_[i_row]++;
+            else off_nz_[i_row]++;
+        }
+        std::vector<LongIdx>().swap(row_cols);
+    }
+}
@@ -0,0 +1,105 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    sparsity_pattern.hh
+ * @brief   Symbolic sparsity pattern of matrix given by connectivity of DOF handler.
+ */
+
+#ifndef SPARSITY_PATTERN_HH_
+#define SPARSITY_PATTERN_HH_
+
+#include <memory>                   // for shared_ptr
+#include <vector>                   // for vector
+#include "system/index_types.hh"    // for LongIdx
+
+class DOFHandlerMultiDim;
+class Distribution;
+
+
+/**
+ * @brief Symbolic sparsity pattern of matrix assembled over DOF handler.
+ *
+ * Collects couplings of DOFs without evaluation of fields and computes exact number of nonzero
+ * entries in diagonal and off-diagonal block of every local row, as needed by preallocation of
+ * PETSc matrix (see LinSys_PETSC::preallocate_matrix). Couplings are added either in the same way as
+ * GenericAssembly visits integrals (add_couplings) or explicitly by blocks of DOF indices (add).
+ *
+ * Usage:
+ * @code
+ *   SparsityPattern sparsity(dh);
+ *   sparsity.add_couplings(SparsityPattern::cell | SparsityPattern::edge);
+ *   sparsity.finalize();
+ *   ls->preallocate_matrix(sparsity.on_nz(), sparsity.off_nz());
+ * @endcode
+ */
+class SparsityPattern {
+public:
+    /// Types of couplings, correspond to integrals of GenericAssembly.
+    enum Coupling {
+        cell    = 0x1,  ///< DOFs of one cell (bulk and boundary integrals)
+        edge    = 0x2,  ///< DOFs of all cells sharing an edge (edge integrals)
+        dimjoin = 0x4   ///< DOFs of lower dim cell and its higher dim neighbour (coupling integrals)
+    };
+
+    /// Constructor, creates empty pattern of rows distributed by given DOF handler.
+    SparsityPattern(std::shared_ptr<DOFHandlerMultiDim> dh);
+
+    /**
+     * Add couplings of DOFs of local cells given by bitmask of @p Coupling.
+     *
+     * Cells are visited in the same way as in GenericAssembly, so rows owned by other processes
+     * are also added (see finalize).
+     */
+    void add_couplings(unsigned int couplings);
+
+    /// Add coupling of all given rows with all given columns (global DOF indices).
+    void add(const std::vector<LongIdx> &rows, const std::vector<LongIdx> &cols);
+
+    /**
+     * Send couplings of rows owned by other processes to their owners and count nonzero entries
+     * of local rows. Collective.
+     */
+    void finalize();
+
+    /// Return numbers of nonzero entries of local rows in diagonal block, valid after finalize.
+    inline const std::vector<LongIdx> &on_nz() const {
+        return on_nz_;
+    }
+
+    /// Return numbers of nonzero entries of local rows in off-diagonal block, valid after finalize.
+    inline const std::vector<LongIdx> &off_nz() const {
+        return off_nz_;
+    }
+
+private:
+    /// DOF handler.
+    std::shared_ptr<DOFHandlerMultiDim> dh_;
+
+    /// Distribution of rows.
+    std::shared_ptr<Distribution> distr_;
+
+    /// Columns of local rows (possibly repeated until finalize).
+    std::vector< std::vector<LongIdx> > local_rows_;
+
+    /// Pairs (row, column) of rows owned by other processes, one vector per process.
+    std::vector< std::vector<LongIdx> > remote_entries_;
+
+    /// Numbers of nonzero entries of local rows in diagonal block.
+    std::vector<LongIdx> on_nz_;
+
+    /// Numbers of nonzero entries of local rows in off-diagonal block.
+    std::vector<LongIdx> off_nz_;
+};
+
+
+#endif /* SPARSITY_PATTERN_HH_ */
@@ -285,6 +285,11 @@ public:
         return subset_index_;
     }
 
+    /// Return number of points of the integral on one element
+    inline uint n_points() const {
+        return end_idx_ - begin_idx_;
+    }
+
 
     /// Returns range of bulk local points for appropriate cell accessor
     inline Range< BulkPoint > points(unsigned int element_patch_idx, const ElementCacheMap *elm_cache_map) const {
@@ -332,6 +337,11 @@ public:
         return begin_idx_ + cell_side.side_idx() * n_points_per_side_;
     }
 
+    /// Return number of points of the integral on one side
+    inline uint n_points_per_side() const {
+        return n_points_per_side_;
+    }
+
     /// Returns range of side local points for appropriate cell side accessor
     inline Range< EdgePoint > points(const DHCellSide &cell_side, const ElementCacheMap *elm_cache_map) const {
         ASSERT_EQ(cell_side.dim(), dim_);
@@ -391,6 +401,11 @@ public:
         return eval_points_->subset_begin(dim_-1, bulk_integral_->get_subset_idx());
     }
 
+    /// Return number of points of the integral on one side of higher dim element
+    inline uint n_points_per_side() const {
+        return edge_integral_->n_points_per_side_;
+    }
+
     /// Returns range of side local points for appropriate cell side accessor
     inline Range< CouplingPoint > points(const DHCellSide &cell_side, const ElementCacheMap *elm_cache_map) const {
         ASSERT_EQ(cell_side.dim(), dim_);
@@ -443,6 +458,11 @@ public:
         return eval_points_->subset_begin(dim_-1, bulk_integral_->get_subset_idx());
     }
 
+    /// Return number of points of the integral on one side of bulk element
+    inline uint n_points_per_side() const {
+        return edge_integral_->n_points_per_side_;
+    }
+
     /// Returns range of bulk local points for appropriate cell accessor
     inline Range< BoundaryPoint > points(const DHCellSide &cell_side, const ElementCacheMap *elm_cache_map) const {
         ASSERT_EQ(cell_side.dim(), dim_);
@@ -325,6 +325,24 @@ public:
      */
     virtual bool is_constant(Region reg) =0;
 
+    /**
+     * Return true if all components of the field are given by the same input, i.e. input of MultiField
+     * never prescribes an array of values for individual components. Field has one component, so it
+     * returns true.
+     *
+     * Components set by MultiField::set are supposed to be computed from input fields (FieldModel).
+     */
+    virtual bool has_equal_components() const
+    { return true; }
+
+    /**
+     * Return true if components @p i and @p j of the field are given by the same input. Unlike
+     * @p has_equal_components, it allows to find groups of equal components of MultiField given
+     * by an array of values. Field returns true.
+     */
+    virtual bool equal_components(FMT_UNUSED unsigned int i, FMT_UNUSED unsigned int j) const
+    { return true; }
+
 
     /**
      * @brief Indicates special field states.
@@ -15,6 +15,7 @@
  * @brief   
  */
 
+#include <algorithm>
 #include "fields/field_constant.hh"
 #include "fields/field_algo_base.impl.hh"
 #include "fields/field_instances.hh"	// for instantiation macros
@@ -129,9 +130,13 @@ void FieldConstant<spacedim, Value>::cache_update(FieldValueCache<typename Value
 {
     unsigned int reg_chunk_begin = cache_map.region_chunk_begin(region_patch_idx);
     unsigned int reg_chunk_end = cache_map.region_chunk_end(region_patch_idx);
-    Armor::ArmaMat<typename Value::element_type, Value::NRows_, Value::NCols_> mat_value( const_cast<typename Value::element_type*>(this->value_.mem_ptr()) );
-    for (unsigned int i_cache = reg_chunk_begin; i_cache < reg_chunk_end; ++i_cache)
-        data_cache.set(i_cache) = mat_value;
+    // Fill contiguous block of each component (column-major order, same as value_), see Armor::Array
+    const typename Value::element_type *value_ptr = this->value_.mem_ptr();
+    unsigned int n_rows = data_cache.n_rows();
+    for (unsigned int i_comp = 0; i_comp < n_rows * data_cache.n_cols(); ++i_comp) {
+        typename Value::element_type *comp_data = data_cache(i_comp % n_rows, i_comp / n_rows);
+        std::fill(comp_data + reg_chunk_begin, comp_data + reg_chunk_end, value_ptr[i_comp]);
+    }
 }
 
 
@@ -221,39 +221,48 @@ void FieldFE<spacedim, Value>::cache_update(FieldValueCache<typename Value::elem
         return;
     }
 
-    Armor::ArmaMat<typename Value::element_type, Value::NRows_, Value::NCols_> mat_value;
-
     unsigned int reg_chunk_begin = cache_map.region_chunk_begin(region_patch_idx);
     unsigned int reg_chunk_end = cache_map.region_chunk_end(region_patch_idx);
-    unsigned int last_element_idx = -1;
-    DHCellAccessor cell = *( dh_->local_range().begin() ); //needs set variable for correct compiling
-    LocDofVec loc_dofs;
-    unsigned int range_bgn=0, range_end=0;
 
     // Throws exception if any element value of processed region is NaN
     unsigned int r_idx = cache_map.eval_point_data(reg_chunk_begin).i_reg_;
     if (region_value_err_[r_idx].is_invalid_)
         THROW( ExcUndefElementValue() << EI_Field(field_name_) << EI_File(reader_file_.filename()) );
 
-    for (unsigned int i_data = reg_chunk_begin; i_data < reg_chunk_end; ++i_data) { // i_eval_point_data
-        unsigned int elm_idx = cache_map.eval_point_data(i_data).i_element_;
-        if (elm_idx != last_element_idx) {
-            ElementAccessor<spacedim> elm(dh_->mesh(), elm_idx);
-            fe_values_[elm.dim()].reinit( elm );
-            cell = dh_->cell_accessor_from_element( elm_idx );
-            loc_dofs = cell.get_loc_dof_indices();
-            last_element_idx = elm_idx;
-            range_bgn = this->fe_item_[elm.dim()].range_begin_;
-            range_end = this->fe_item_[elm.dim()].range_end_;
-        }
-
-        unsigned int i_ep=cache_map.eval_point_data(i_data).i_eval_point_;
-        //DHCellAccessor cache_cell = cache_map(cell);
-        mat_value.fill(0.0);
-        for (unsigned int i_dof=range_bgn, i_cdof=0; i_dof<range_end; i_dof++, i_cdof++) {
-            mat_value += data_vec_.get(loc_dofs[i_dof]) * this->handle_fe_shape(cell.dim(), i_cdof, i_ep);
+    // Points of one element form continuous block of region chunk. Values of each block are computed
+    // component by component and stored directly to contiguous storage of the component in data_cache.
+    constexpr unsigned int n_comp = Value::NRows_ * Value::NCols_;
+    std::vector<double> dof_values;
+    unsigned int elm_begin = reg_chunk_begin;
+    while (elm_begin < reg_chunk_end) {
+        unsigned int elm_idx = cache_map.eval_point_data(elm_begin).i_element_;
+        unsigned int elm_end = elm_begin+1;
+        while ( (elm_end < reg_chunk_end) && (cache_map.eval_point_data(elm_end).i_element_ == elm_idx) ) ++elm_end;
+
+        ElementAccessor<spacedim> elm(dh_->mesh(), elm_idx);
+        unsigned int dim = elm.dim();
+        fe_values_[dim].reinit( elm );
+        DHCellAccessor cell = dh_->cell_accessor_from_element( elm_idx );
+        LocDofVec loc_dofs = cell.get_loc_dof_indices();
+        unsigned int range_bgn = this->fe_item_[dim].range_begin_;
+        unsigned int n_dofs = this->fe_item_[dim].range_end_ - range_bgn;
+        dof_values.resize(n_dofs);
+        for (unsigned int i_cdof=0; i_cdof<n_dofs; i_cdof++)
+            dof_values[i_cdof] = data_vec_.get(loc_dofs[range_bgn+i_cdof]);
+
+        for (unsigned int c=0; c<n_comp; ++c) {
+            // same ordering of components as in handle_fe_shape
+            typename Value::element_type *comp_data = (Value::NRows_ == Value::NCols_) ?
+                    data_cache(c/spacedim, c%spacedim) : data_cache(c, 0);
+            for (unsigned int i_data = elm_begin; i_data < elm_end; ++i_data) {
+                unsigned int i_ep = cache_map.eval_point_data(i_data).i_eval_point_;
+                double value = 0.0;
+                for (unsigned int i_cdof=0; i_cdof<n_dofs; i_cdof++)
+                    value += dof_values[i_cdof] * fe_values_[dim].shape_value_component(i_cdof, i_ep, c);
+                comp_data[i_data] = value;
+            }
         }
-        data_cache.set(i_data) = mat_value;
+        elm_begin = elm_end;
     }
 }
 
@@ -310,6 +319,11 @@ void FieldFE<spacedim, Value>::set_mesh(const Mesh *mesh) {
     // Mesh can be set only for field initialized from input.
     if ( flags_.match(FieldFlag::equation_input) && flags_.match(FieldFlag::declare_input) ) {
         ASSERT(field_name_ != "").error("Uninitialized FieldFE, did you call init_from_input()?\n");
+        if (mesh->is_distributed() && this->interpolation_ == DataInterpolation::equivalent_msh) {
+            // distributed mesh holds only own and ghost elements, data are mapped to them by element ids,
+            // whole source mesh is not created
+            this->interpolation_ = DataInterpolation::identic_msh;
+        }
         if (this->interpolation_ == DataInterpolation::identic_msh) {
         	//DebugOut() << "Identic mesh branch\n";
             source_target_mesh_elm_map_ = ReaderCache::identic_mesh_map(reader_file_, const_cast<Mesh *>(mesh));
@@ -420,10 +434,17 @@ bool FieldFE<spacedim, Value>::set_time(const TimeStep &time) {
 			this->calculate_element_values();
 		} else if (this->interpolation_==DataInterpolation::equivalent_msh) {
 			this->calculate_element_values();
-		} else if (this->interpolation_==DataInterpolation::gauss_p0) {
-			this->interpolate_gauss();
-		} else { // DataInterpolation::interp_p0
-			this->interpolate_intersection();
+		} else { // DataInterpolation::gauss_p0 or DataInterpolation::interp_p0
+		    if (interpolation_map_ == nullptr) {
+		        interpolation_map_ = ReaderCache::interpolation_map(reader_file_, dh_->mesh(), this->interpolation_,
+		                [this](InterpolationMap &map) {
+		                    if (this->interpolation_==DataInterpolation::gauss_p0)
+		                        this->create_gauss_interpolation_map(map);
+		                    else
+		                        this->create_intersection_interpolation_map(map);
+		                });
+		    }
+			this->interpolate_data();
 		}
 
 		return true;
@@ -433,17 +454,17 @@ bool FieldFE<spacedim, Value>::set_time(const TimeStep &time) {
 
 
 template <int spacedim, class Value>
-void FieldFE<spacedim, Value>::interpolate_gauss()
+void FieldFE<spacedim, Value>::create_gauss_interpolation_map(InterpolationMap &map)
 {
+	START_TIMER("create_gauss_interpolation_map");
 	static const unsigned int quadrature_order = 4; // parameter of quadrature
 	std::shared_ptr<Mesh> source_mesh = ReaderCache::get_mesh(reader_file_);
 	std::vector<unsigned int> searched_elements; // stored suspect elements in calculating the intersection
+	std::vector<unsigned int> contained_elements; // source elements containing one quadrature point
+	std::vector<double> elem_weights; // weights of suspect elements in computed (target) element
 	std::vector<arma::vec::fixed<3>> q_points; // real coordinates of quadrature points
 	std::vector<double> q_weights; // weights of quadrature points
 	unsigned int quadrature_size=0; // size of quadrature point and weight vector
-	std::vector<double> sum_val(dh_->max_elem_dofs()); // sum of value of one quadrature point
-	unsigned int elem_count; // count of intersect (source) elements of one quadrature point
-	std::vector<double> elem_value(dh_->max_elem_dofs()); // computed value of one (target) element
 	bool contains; // sign if source element contains quadrature point
 
 	{
@@ -455,7 +476,6 @@ void FieldFE<spacedim, Value>::interpolate_gauss()
 
 	for (auto cell : dh_->own_range()) {
 		auto ele = cell.elm();
-		std::fill(elem_value.begin(), elem_value.end(), 0.0);
 		switch (cell.dim()) {
 		case 0:
 			quadrature_size = 1;
@@ -474,14 +494,12 @@ void FieldFE<spacedim, Value>::interpolate_gauss()
 		}
 		searched_elements.clear();
 		source_mesh->get_bih_tree().find_bounding_box(ele.bounding_box(), searched_elements);
+		elem_weights.assign(searched_elements.size(), 0.0);
 
-		auto r_idx = cell.elm().region_idx().idx();
-		std::string reg_name = cell.elm().region().label();
 		for (unsigned int i=0; i<quadrature_size; ++i) {
-			std::fill(sum_val.begin(), sum_val.end(), 0.0);
-			elem_count = 0;
-			for (std::vector<unsigned int>::iterator it = searched_elements.begin(); it!=searched_elements.end(); it++) {
-				ElementAccessor<3> elm = source_mesh->element_accessor(*it);
+			contained_elements.clear();
+			for (unsigned int i_elm=0; i_elm<searched_elements.size(); i_elm++) {
+				ElementAccessor<3> elm = source_mesh->element_accessor(searched_elements[i_elm]);
 				contains=false;
 				switch (elm->dim()) {
 				case 0:
@@ -499,41 +517,28 @@ void FieldFE<spacedim, Value>::interpolate_gauss()
 				default:
 					ASSERT_PERMANENT(false).error("Invalid element dimension!");
 				}
-				if ( contains ) {
-					// projection point in element
-					unsigned int index = sum_val.size() * (*it);
-					for (unsigned int j=0; j < sum_val.size(); j++) {
-						sum_val[j] += get_scaled_value(index+j, dh_->mesh()->elem_index( cell.elm_idx() ), reg_name, region_value_err_[r_idx]);
-					}
-					++elem_count;
-				}
+				// projection point in element
+				if ( contains ) contained_elements.push_back(i_elm);
 			}
 
-			if (elem_count > 0) {
-				for (unsigned int j=0; j < sum_val.size(); j++) {
-					elem_value[j] += (sum_val[j] / elem_count) * q_weights[i];
-				}
-			}
+			// value in quadrature point is average of values of all source elements containing the point
+			for (unsigned int i_elm : contained_elements)
+				elem_weights[i_elm] += q_weights[i] / contained_elements.size();
 		}
 
-		LocDofVec loc_dofs;
-		loc_dofs = cell.get_loc_dof_indices();
-
-		ASSERT_LE(loc_dofs.n_elem, elem_value.size());
-		for (unsigned int i=0; i < elem_value.size(); i++) {
-			ASSERT_LT( loc_dofs[i], (int)data_vec_.size());
-			data_vec_.set( loc_dofs[i], elem_value[i] );
-		}
+		for (unsigned int i_elm=0; i_elm<searched_elements.size(); i_elm++)
+			if (elem_weights[i_elm] != 0.0) map.add(searched_elements[i_elm], elem_weights[i_elm]);
+		map.close_row(cell.elm_idx());
 	}
 }
 
 
 template <int spacedim, class Value>
-void FieldFE<spacedim, Value>::interpolate_intersection()
+void FieldFE<spacedim, Value>::create_intersection_interpolation_map(InterpolationMap &map)
 {
+	START_TIMER("create_intersection_interpolation_map");
 	std::shared_ptr<Mesh> source_mesh = ReaderCache::get_mesh(reader_file_);
 	std::vector<unsigned int> searched_elements; // stored suspect elements in calculating the intersection
-	std::vector<double> value(dh_->max_elem_dofs());
 	double total_measure;
 	double measure = 0;
 
@@ -543,8 +548,6 @@ void FieldFE<spacedim, Value>::interpolate_intersection()
 		}
 
 		double epsilon = 4* numeric_limits<double>::epsilon() * elm.measure();
-		auto r_idx = elm.region_idx().idx();
-		std::string reg_name = elm.region().label();
 
 		// gets suspect elements
 		if (elm.dim() == 0) {
@@ -556,9 +559,8 @@ void FieldFE<spacedim, Value>::interpolate_intersection()
 			source_mesh->get_bih_tree().find_bounding_box(bb, searched_elements);
 		}
 
-		// set zero values of value object
-		std::fill(value.begin(), value.end(), 0.0);
 		total_measure=0.0;
+		unsigned int row_begin = map.source_elm.size();
 
 		START_TIMER("compute_pressure");
 		ADD_CALLS(searched_elements.size());
@@ -602,31 +604,60 @@ void FieldFE<spacedim, Value>::interpolate_intersection()
                     }
                 }
 
-				//adds values to value_ object if intersection exists
+				//adds weight of source element if intersection exists
 				if (measure > epsilon) {
-					unsigned int index = value.size() * (*it);
-			        for (unsigned int i=0; i < value.size(); i++) {
-			        	value[i] += get_scaled_value(index+i, dh_->mesh()->elem_index( elm.idx() ), reg_name, region_value_err_[r_idx]) * measure;
-			        }
+					map.add(*it, measure);
 					total_measure += measure;
 				}
 			}
 		}
 
-		// computes weighted average, store it to data vector
+		// weighted average, empty row marks element out of source mesh
 		if (total_measure > epsilon) {
-			DHCellAccessor cell = dh_->cell_accessor_from_element(elm.idx());
-			LocDofVec loc_dofs = cell.get_loc_dof_indices();
+			for (unsigned int k=row_begin; k<map.source_elm.size(); k++)
+				map.weight[k] /= total_measure;
+		} else {
+			map.source_elm.resize(row_begin);
+			map.weight.resize(row_begin);
+		}
+		map.close_row(elm.idx());
+		END_TIMER("compute_pressure");
 
-			ASSERT_LE(loc_dofs.n_elem, value.size());
+	}
+}
+
+
+template <int spacedim, class Value>
+void FieldFE<spacedim, Value>::interpolate_data()
+{
+	const InterpolationMap &map = *interpolation_map_;
+	std::vector<double> value(dh_->max_elem_dofs());
+
+	for (unsigned int i_row=0; i_row<map.n_rows(); ++i_row) {
+		ElementAccessor<3> elm = dh_->mesh()->element_accessor(map.target_elm[i_row]);
+		if ( (map.row_offset[i_row] == map.row_offset[i_row+1]) && (this->interpolation_==DataInterpolation::interp_p0) ) {
+			WarningOut().fmt("Processed element with idx {} is out of source mesh!\n", elm.idx());
+			continue;
+		}
+
+		auto r_idx = elm.region_idx().idx();
+		std::string reg_name = elm.region().label();
+		std::fill(value.begin(), value.end(), 0.0);
+		for (unsigned int k=map.row_offset[i_row]; k<map.row_offset[i_row+1]; ++k) {
+			unsigned int index = value.size() * map.source_elm[k];
 			for (unsigned int i=0; i < value.size(); i++) {
-				data_vec_.set(loc_dofs[i], value[i] / total_measure);
+				value[i] += get_scaled_value(index+i, dh_->mesh()->elem_index( elm.idx() ), reg_name, region_value_err_[r_idx]) * map.weight[k];
 			}
-		} else {
-			WarningOut().fmt("Processed element with idx {} is out of source mesh!\n", elm.idx());
 		}
-		END_TIMER("compute_pressure");
 
+		DHCellAccessor cell = dh_->cell_accessor_from_element(elm.idx());
+		LocDofVec loc_dofs = cell.get_loc_dof_indices();
+
+		ASSERT_LE(loc_dofs.n_elem, value.size());
+		for (unsigned int i=0; i < value.size(); i++) {
+			ASSERT_LT( loc_dofs[i], (int)data_vec_.size());
+			data_vec_.set( loc_dofs[i], value[i] );
+		}
 	}
 }
 
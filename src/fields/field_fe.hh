@@ -237,11 +237,14 @@ private:
 	/// Create DofHandler object
 	void make_dof_handler(const MeshBase *mesh);
 
-	/// Interpolate data (use Gaussian distribution) over all elements of target mesh.
-	void interpolate_gauss();
+	/// Compute operator of interpolation (use Gaussian distribution) over all own elements of target mesh.
+	void create_gauss_interpolation_map(InterpolationMap &map);
 
-	/// Interpolate data (use intersection library) over all elements of target mesh.
-	void interpolate_intersection();
+	/// Compute operator of interpolation (use intersection library) over all elements of target mesh.
+	void create_intersection_interpolation_map(InterpolationMap &map);
+
+	/// Interpolate data of actual time frame by operator @p interpolation_map_ (single sparse mat-vec).
+	void interpolate_data();
 
 //	/// Calculate native data over all elements of target mesh.
 //	void calculate_native_values(ElementDataCache<double>::CacheData data_cache);
@@ -355,6 +358,9 @@ private:
     /// Maps element indices from computational mesh to the  source (data).
     std::shared_ptr<EquivalentMeshMap> source_target_mesh_elm_map_;
 
+    /// Operator of interpolation from source (data) mesh, shared through ReaderCache, used by gauss_p0 and interp_p0.
+    std::shared_ptr<InterpolationMap> interpolation_map_;
+
     /// Holds specific data of field evaluation over all dimensions.
     std::array<FEItem, 4> fe_item_;
     MixedPtr<FiniteElement> fe_;
@@ -74,7 +74,8 @@ template <int spacedim, class Value>
 FieldFormula<spacedim, Value>::FieldFormula( unsigned int n_comp)
 : FieldAlgorithmBase<spacedim, Value>(n_comp),
   b_parser_( CacheMapElementNumber::get() ),
-  arena_alloc_(nullptr)
+  arena_alloc_(nullptr),
+  jit_function_(nullptr)
 {
 	this->is_constant_in_space_ = false;
 }
@@ -118,6 +119,21 @@ void FieldFormula<spacedim, Value>::cache_update(FieldValueCache<typename Value:
     unsigned int reg_chunk_begin = cache_map.region_chunk_begin(region_patch_idx);
     unsigned int reg_chunk_end = cache_map.region_chunk_end(region_patch_idx);
 
+    if constexpr (std::is_same<typename Value::element_type, double>::value) {
+        if (jit_function_ != nullptr) {
+            // compiled formula reads data of dependent fields directly from their caches
+            jit_data_.resize(jit_variables_.size());
+            for (unsigned int i_var=0; i_var<jit_variables_.size(); ++i_var)
+                jit_data_[i_var] = (*jit_variables_[i_var].first->value_cache())(jit_variables_[i_var].second, 0);
+            double *result = data_cache(0, 0);
+            jit_function_(jit_data_.data(), this->time_.end(), result, reg_chunk_begin, reg_chunk_end);
+            if (this->unit_conversion_coefficient_ != 1.0)
+                for (unsigned int i=reg_chunk_begin; i<reg_chunk_end; ++i)
+                    result[i] *= this->unit_conversion_coefficient_;
+            return;
+        }
+    }
+
     for (unsigned int i=reg_chunk_begin; i<reg_chunk_end; ++i) {
         res_[i] = 0.0;
     }
@@ -214,15 +230,48 @@ std::vector<const FieldCommon * > FieldFormula<spacedim, Value>::set_dependency(
             }
         }
     }
+    this->init_jit(field_set);
 
     return required_fields_;
 }
 
 
+template <int spacedim, class Value>
+void FieldFormula<spacedim, Value>::init_jit(FieldSet &field_set) {
+    jit_function_ = nullptr;
+    jit_variables_.clear();
+    // only scalar formulas are compiled
+    if ( !FormulaJit::is_enabled() || (Value::NRows_*Value::NCols_ != 1)
+            || !std::is_same<typename Value::element_type, double>::value ) return;
+
+    FormulaJit::Translation translation;
+    try {
+        translation = FormulaJit::translate(formula_);
+    } catch (FormulaJit::ExcUnsupportedFormula &e) {
+        return;
+    }
+    for (const std::string &var : translation.variables) {
+        if (var == "x" || var == "y" || var == "z") {
+            jit_variables_.emplace_back( field_set.field("X"), var[0] - 'x' );
+        } else {
+            const FieldCommon *field_ptr = field_set.field(var);
+            if ( (field_ptr == nullptr) || (field_ptr->n_shape() != 1) ) {
+                // vector and tensor variables are not supported
+                jit_variables_.clear();
+                return;
+            }
+            jit_variables_.emplace_back(field_ptr, 0);
+        }
+    }
+    jit_function_ = FormulaJit::get_function(formula_, translation);
+}
+
+
 template <int spacedim, class Value>
 void FieldFormula<spacedim, Value>::cache_reinit(FMT_UNUSED const ElementCacheMap &cache_map)
 {
 	// Can not compile expression in set_time as the necessary cache size is not known there yet.
+    if (jit_function_ != nullptr) return; // BParser is not used
 
     if (arena_alloc_!=nullptr) {
         delete arena_alloc_;
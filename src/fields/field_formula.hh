@@ -31,6 +31,7 @@
 #include "fields/field_algo_base.hh"    // for FieldAlgorithmBase
 #include "fields/field_values.hh"       // for FieldValue<>::Enum, FieldValu...
 #include "fields/field_set.hh"
+#include "fields/formula_jit.hh"
 #include "input/accessors.hh"           // for ExcAccessorForNullStorage
 #include "input/accessors_impl.hh"      // for Record::val
 #include "input/storage.hh"             // for ExcStorageTypeMismatch
@@ -125,6 +126,14 @@ private:
      */
     inline arma::vec eval_depth_var(const Point &p);
 
+    /**
+     * Try to compile formula by FormulaJit.
+     *
+     * Sets jit_function_ and jit_variables_, jit_function_ stays nullptr if formula
+     * is not supported by FormulaJit and BParser is used.
+     */
+    void init_jit(FieldSet &field_set);
+
     // formula expression, string is set to BParser
     std::string formula_;
 
@@ -166,6 +175,15 @@ private:
 	 */
 	std::unordered_map<const FieldCommon *, double *> eval_field_data_;
 
+	/// Function compiled by FormulaJit, nullptr if formula is evaluated by BParser.
+	FormulaJit::EvalFunction jit_function_;
+
+	/// Variables of jit_function_, holds field and row of component in its FieldValueCache.
+	std::vector< std::pair<const FieldCommon *, unsigned int> > jit_variables_;
+
+	/// Pointers to data of jit_variables_ passed to jit_function_.
+	std::vector<const double *> jit_data_;
+
     /// Registrar of class to factory
     static const int registrar;
 
@@ -19,6 +19,7 @@
 #define FIELD_MODEL_HH_
 
 #include <armadillo>
+#include <array>
 #include <iostream>
 #include <tuple>
 #include <string>
@@ -200,6 +201,53 @@ namespace detail
     auto call(Function f, Tuple t)
     {
     }
+
+    /**
+     * Check that field holds values of fixed size and of type double in FieldValueCache.
+     * Types without ValueType (e.g. FieldCoords) and vectors of variable size are not packed.
+     */
+    template<typename FIELD, class = void>
+    struct is_packed_field : std::false_type {};
+
+    template<typename FIELD>
+    struct is_packed_field<FIELD, std::void_t<typename std::decay_t<FIELD>::ValueType>>
+    : std::bool_constant< std::is_same<typename std::decay_t<FIELD>::ValueType::element_type, double>::value
+                          && (std::decay_t<FIELD>::ValueType::NRows_ > 0) > {};
+
+    /**
+     * Check that result and all input fields of model hold fixed size values of type double.
+     * Such model can be evaluated by loops over component blocks of cache data.
+     */
+    template<class Value, class ... InputFields>
+    struct is_packed_model
+    : std::conjunction< std::bool_constant< std::is_same<typename Value::element_type, double>::value && (Value::NRows_ > 0) >,
+                        is_packed_field<InputFields>... > {};
+
+    /**
+     * Read / write value of given type from / to component blocks of FieldValueCache,
+     * @p ptr points to the first component of the value, @p reserved is distance of component blocks.
+     */
+    template<class T>
+    struct packed_value {
+        static inline T get(const double *ptr, unsigned int reserved) {
+            T val;
+            for (unsigned int i=0; i<val.n_elem; ++i) val(i) = ptr[i*reserved];
+            return val;
+        }
+        static inline void set(const T &val, double *ptr, unsigned int reserved) {
+            for (unsigned int i=0; i<val.n_elem; ++i) ptr[i*reserved] = val(i);
+        }
+    };
+
+    template<>
+    struct packed_value<double> {
+        static inline double get(const double *ptr, FMT_UNUSED unsigned int reserved) {
+            return *ptr;
+        }
+        static inline void set(double val, double *ptr, FMT_UNUSED unsigned int reserved) {
+            *ptr = val;
+        }
+    };
 }
 
 
@@ -266,19 +314,54 @@ public:
     	                >::eval(input_fields);
     }
 
-    /// Implements FieldAlgoBase::cache_update
+    /**
+     * Implements FieldAlgoBase::cache_update
+     *
+     * Models with values of fixed size and of type double are evaluated directly on component
+     * blocks of cache data (see cache_update_packed), other models point by point.
+     */
     void cache_update(FieldValueCache<typename Value::element_type> &data_cache,
                 ElementCacheMap &cache_map, unsigned int region_patch_idx) override {
         unsigned int reg_chunk_begin = cache_map.region_chunk_begin(region_patch_idx);
         unsigned int reg_chunk_end = cache_map.region_chunk_end(region_patch_idx);
-        for(unsigned int i_cache=reg_chunk_begin; i_cache<reg_chunk_end; ++i_cache) {
-            data_cache.set(i_cache) =
-                detail::model_cache_item<
-                    Fn,
-                    decltype(input_fields),
-                    std::tuple_size<FieldsTuple>::value
-                >::eval(i_cache, fn, input_fields);
-    	}
+        if constexpr (detail::is_packed_model<Value, InputFields...>::value) {
+            this->cache_update_packed(data_cache, reg_chunk_begin, reg_chunk_end,
+                    std::make_index_sequence< std::tuple_size<FieldsTuple>::value >());
+        } else {
+            for(unsigned int i_cache=reg_chunk_begin; i_cache<reg_chunk_end; ++i_cache) {
+                data_cache.set(i_cache) =
+                    detail::model_cache_item<
+                        Fn,
+                        decltype(input_fields),
+                        std::tuple_size<FieldsTuple>::value
+                    >::eval(i_cache, fn, input_fields);
+            }
+        }
+    }
+
+private:
+    /// Type of values of I-th input field.
+    template<size_t I>
+    using InputType = typename std::decay_t< std::tuple_element_t<I, FieldsTuple> >::ValueType::return_type;
+
+    /**
+     * Evaluates model in one loop over raw cache data of the region chunk.
+     *
+     * Values of inputs are read from component blocks of their caches and result is written to
+     * component blocks of @p data_cache, so no Armor temporaries are created. For scalar result
+     * and scalar inputs the loop reduces to operations on contiguous arrays.
+     */
+    template<size_t ... I>
+    void cache_update_packed(FieldValueCache<double> &data_cache, unsigned int reg_chunk_begin, unsigned int reg_chunk_end,
+            std::index_sequence<I ...>) {
+        double *result = data_cache(0, 0);
+        const unsigned int result_reserved = data_cache.reserved();
+        const std::array<const double *, sizeof...(I)> input_data{{ (*std::get<I>(input_fields).value_cache())(0, 0)... }};
+        const std::array<unsigned int, sizeof...(I)> input_reserved{{ std::get<I>(input_fields).value_cache()->reserved()... }};
+        for(unsigned int i_cache=reg_chunk_begin; i_cache<reg_chunk_end; ++i_cache)
+            detail::packed_value<typename Value::return_type>::set(
+                    fn( detail::packed_value< InputType<I> >::get(input_data[I] + i_cache, input_reserved[I])... ),
+                    result + i_cache, result_reserved);
     }
 
 };
@@ -24,11 +24,19 @@
 #include "system/system.hh"
 #include "system/python_loader.hh"
 #include "fields/field_algo_base.hh"
+#include "fields/field_value_cache.hh"
 #include "mesh/point.hh"
 #include "input/factory.hh"
 
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 using namespace std;
 namespace py = pybind11;
@@ -36,6 +44,66 @@ namespace py = pybind11;
 // Pybind11 needs set visibility to hidden (see https://pybind11.readthedocs.io/en/stable/faq.html).
 #pragma GCC visibility push(hidden)
 
+/**
+ * @brief Collects evaluations of Python fields that share one instance of user class.
+ *
+ * FieldPython registers its region chunks during FieldSet::cache_update instead of immediate call
+ * of Python. All registered chunks of one dependency level are evaluated by single call
+ * of PythonFieldBase._cache_update_batch. Chunks are grouped by field name (fields sharing
+ * the instance are registered alternately region by region), consecutive chunks of a field
+ * are merged. Python evaluates user method of every field once on all its chunks.
+ */
+class PythonFieldBatch : public DeferredCacheUpdate {
+public:
+    /// Return batch of given instance of user class, batch is shared by all FieldPython objects using the instance.
+    static std::shared_ptr<PythonFieldBatch> get_batch(const py::object &user_class_instance) {
+        static std::unordered_map<PyObject *, std::weak_ptr<PythonFieldBatch>> batches;
+        std::shared_ptr<PythonFieldBatch> batch = batches[user_class_instance.ptr()].lock();
+        if (!batch) {
+            batch = std::make_shared<PythonFieldBatch>(user_class_instance);
+            batches[user_class_instance.ptr()] = batch;
+        }
+        return batch;
+    }
+
+    /// Constructor
+    PythonFieldBatch(const py::object &user_class_instance)
+    : user_class_instance_(user_class_instance) {}
+
+    /// Register evaluation of field on points [begin, end)
+    void add(const std::string &field_name, unsigned int begin, unsigned int end) {
+        std::vector< std::pair<unsigned int, unsigned int> > &chunks = requests_[field_name];
+        if ( !chunks.empty() && (chunks.back().second == begin) )
+            chunks.back().second = end;
+        else
+            chunks.emplace_back(begin, end);
+    }
+
+    /// Evaluate all registered fields by one call of Python.
+    void evaluate() override {
+        if (requests_.empty()) return;
+        RequestMap requests;
+        requests.swap(requests_);
+        py::gil_scoped_acquire acquire;
+        try {
+            user_class_instance_.attr("_cache_update_batch")(requests);
+        } catch (const py::error_already_set &ex) {
+            PythonLoader::throw_error(ex);
+        }
+    }
+
+private:
+    /// Chunks [begin, end) of FieldValueCache registered for evaluation, grouped by field name.
+    typedef std::map< std::string, std::vector< std::pair<unsigned int, unsigned int> > > RequestMap;
+
+    /// Python instance of user class.
+    py::object user_class_instance_;
+
+    /// Registered evaluations.
+    RequestMap requests_;
+};
+
+
 /**
  *
  * This class assumes field python field with @p spacedim arguments containing coordinates of the given point.
@@ -92,6 +160,17 @@ public:
     virtual ~FieldPython();
 
 private:
+    /// Call Python evaluation of field on points [begin, end) immediately.
+    void call_cache_update(unsigned int begin, unsigned int end);
+
+    /// Fill data_cache on points [begin, end) from stored_values_, return false if some point is not stored.
+    bool read_stored_values(FieldValueCache<typename Value::element_type> &data_cache, const ElementCacheMap &cache_map,
+            unsigned int begin, unsigned int end);
+
+    /// Store values of data_cache on points [begin, end) to stored_values_.
+    void store_values(const FieldValueCache<typename Value::element_type> &data_cache, const ElementCacheMap &cache_map,
+            unsigned int begin, unsigned int end);
+
     /// Registrar of class to factory
     static const int registrar;
 
@@ -104,6 +183,29 @@ private:
     /// Holds python instance of user class.
     py::object user_class_instance_;
 
+    /// Evaluations of fields of user_class_instance_ deferred by FieldSet::cache_update.
+    std::shared_ptr<PythonFieldBatch> batch_;
+
+    /// Flag is set if values are constant in time, Python is called only for points without stored values.
+    bool constant_in_time_;
+
+    /**
+     * Values of constant_in_time_ field stored for each ElementCacheMap.
+     *
+     * Key of point_values_ is composed from element idx and index of eval point,
+     * value is position of point in values_. Store is cleared in cache_reinit and holds
+     * at most max_stored_points points, other points are evaluated by Python in every call.
+     */
+    struct StoredValues {
+        std::unordered_map<std::uint64_t, unsigned int> point_values_;
+        std::vector<typename Value::element_type> values_;
+        bool is_full_ = false;   ///< Set if max_stored_points is reached.
+    };
+    std::unordered_map<const ElementCacheMap *, StoredValues> stored_values_;
+
+    /// Maximal number of points in stored_values_ of one ElementCacheMap.
+    static constexpr unsigned int max_stored_points = 1 << 20;
+
     /// List of fields on which this field depends
 	std::vector<const FieldCommon * > required_fields_;
 
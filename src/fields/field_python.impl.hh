@@ -50,6 +50,9 @@ const Input::Type::Record & FieldPython<spacedim, Value>::get_input_type()
                 "For NxM tensor values: tensor(row,col) = tuple( M*row + col ).")
         .declare_key("used_fields", it::Array(it::String()), it::Default("[]"),
 				"Defines list of fields necessary in evaluation of actual field.")
+        .declare_key("constant_in_time", it::Bool(), it::Default("false"),
+                "Field is constant in time on the time interval of this input item. Values are evaluated only once "
+                "for each element and evaluation point and then reused, Python is not called in next time steps.")
 		//.declare_key("units", FieldAlgorithmBase<spacedim, Value>::get_field_algo_common_keys(), it::Default::optional(),
 		//		"Definition of unit.")
 		.close();
@@ -65,7 +68,8 @@ const int FieldPython<spacedim, Value>::registrar =
 
 template <int spacedim, class Value>
 FieldPython<spacedim, Value>::FieldPython(unsigned int n_comp)
-: FieldAlgorithmBase<spacedim, Value>( n_comp)
+: FieldAlgorithmBase<spacedim, Value>( n_comp),
+  constant_in_time_(false)
 {
 	this->is_constant_in_space_ = false;
 }
@@ -80,6 +84,7 @@ void FieldPython<spacedim, Value>::init_from_input(const Input::Record &rec, con
 
     std::string source_file = rec.val<string>("source_file");
     std::string source_class = rec.val<string>("class");
+    constant_in_time_ = rec.val<bool>("constant_in_time");
     try {
         set_python_field_from_class( source_file, source_class );
     } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, rec)
@@ -99,6 +104,7 @@ void FieldPython<spacedim, Value>::set_python_field_from_class(const string &fil
     } catch (const py::error_already_set &ex) {
         PythonLoader::throw_error(ex);
     }
+    batch_ = PythonFieldBatch::get_batch(user_class_instance_);
 }
 
 
@@ -129,13 +135,13 @@ void FieldPython<spacedim, Value>::cache_reinit(FMT_UNUSED const ElementCacheMap
 {
     std::vector<FieldCacheProxy> field_data;
     for (auto field_ptr : required_fields_) {
-        std::string field_name = field_ptr->name();
-        double * cache_data = field_ptr->value_cache()->data_;
-        field_data.emplace_back(field_name, field_ptr->shape_, cache_data, CacheMapElementNumber::get()*field_ptr->n_shape());
+        field_data.emplace_back(field_ptr->name(), field_ptr->shape_, *field_ptr->value_cache());
     }
 
-    double * cache_data = self_field_ptr_->value_cache()->data_;
-    FieldCacheProxy result_data(this->field_name_, self_field_ptr_->shape_, cache_data, (CacheMapElementNumber::get()*self_field_ptr_->n_shape()));
+    FieldCacheProxy result_data(this->field_name_, self_field_ptr_->shape_, *self_field_ptr_->value_cache());
+
+    // eval points of cache_map may be changed, stored values are not valid
+    stored_values_.clear();
 
     try {
         py::object p_func = user_class_instance_.attr("_cache_reinit");
@@ -148,14 +154,34 @@ void FieldPython<spacedim, Value>::cache_reinit(FMT_UNUSED const ElementCacheMap
 
 
 template <int spacedim, class Value>
-void FieldPython<spacedim, Value>::cache_update(FMT_UNUSED FieldValueCache<typename Value::element_type> &data_cache,
+void FieldPython<spacedim, Value>::cache_update(FieldValueCache<typename Value::element_type> &data_cache,
         ElementCacheMap &cache_map, unsigned int region_patch_idx)
 {
     unsigned int reg_chunk_begin = cache_map.region_chunk_begin(region_patch_idx);
     unsigned int reg_chunk_end = cache_map.region_chunk_end(region_patch_idx);
+
+    if (constant_in_time_) {
+        // stored values are used, new values must be evaluated immediately to be stored
+        if ( this->read_stored_values(data_cache, cache_map, reg_chunk_begin, reg_chunk_end) ) return;
+        this->call_cache_update(reg_chunk_begin, reg_chunk_end);
+        this->store_values(data_cache, cache_map, reg_chunk_begin, reg_chunk_end);
+    } else if (cache_map.deferred_updates_enabled()) {
+        batch_->add(this->field_name_, reg_chunk_begin, reg_chunk_end);
+        cache_map.add_deferred_update(batch_.get());
+    } else {
+        this->call_cache_update(reg_chunk_begin, reg_chunk_end);
+    }
+}
+
+
+
+template <int spacedim, class Value>
+void FieldPython<spacedim, Value>::call_cache_update(unsigned int begin, unsigned int end)
+{
+    py::gil_scoped_acquire acquire;
     try {
         py::object p_func = user_class_instance_.attr("_cache_update");
-        p_func(this->field_name_, reg_chunk_begin, reg_chunk_end);
+        p_func(this->field_name_, begin, end);
     } catch (const py::error_already_set &ex) {
         PythonLoader::throw_error(ex);
     }
@@ -163,6 +189,49 @@ void FieldPython<spacedim, Value>::cache_update(FMT_UNUSED FieldValueCache<typen
 
 
 
+template <int spacedim, class Value>
+bool FieldPython<spacedim, Value>::read_stored_values(FieldValueCache<typename Value::element_type> &data_cache,
+        const ElementCacheMap &cache_map, unsigned int begin, unsigned int end)
+{
+    constexpr unsigned int n_comp = Value::NRows_ * Value::NCols_;
+    StoredValues &stored = stored_values_[&cache_map];
+    if (stored.values_.empty()) return false;
+    for (unsigned int i=begin; i<end; ++i) {
+        const EvalPointData &point = cache_map.eval_point_data(i);
+        auto it = stored.point_values_.find( (std::uint64_t(point.i_element_) << 32) + point.i_eval_point_ );
+        if (it == stored.point_values_.end()) return false;
+        for (unsigned int i_comp=0; i_comp<n_comp; ++i_comp)
+            data_cache(i_comp % Value::NRows_, i_comp / Value::NRows_)[i] = stored.values_[it->second + i_comp];
+    }
+    return true;
+}
+
+
+
+template <int spacedim, class Value>
+void FieldPython<spacedim, Value>::store_values(const FieldValueCache<typename Value::element_type> &data_cache,
+        const ElementCacheMap &cache_map, unsigned int begin, unsigned int end)
+{
+    constexpr unsigned int n_comp = Value::NRows_ * Value::NCols_;
+    StoredValues &stored = stored_values_[&cache_map];
+    for (unsigned int i=begin; i<end; ++i) {
+        if (stored.point_values_.size() >= max_stored_points) {
+            if (stored.is_full_) return;
+            stored.is_full_ = true;
+            WarningOut().fmt("Number of stored values of constant in time FieldPython '{}' exceeds limit {}, "
+                    "values of other points are evaluated in every cache update.\n", this->field_name_, max_stored_points);
+            return;
+        }
+        const EvalPointData &point = cache_map.eval_point_data(i);
+        auto ret = stored.point_values_.emplace( (std::uint64_t(point.i_element_) << 32) + point.i_eval_point_, stored.values_.size() );
+        if (!ret.second) continue; // point is stored
+        for (unsigned int i_comp=0; i_comp<n_comp; ++i_comp)
+            stored.values_.push_back( data_cache(i_comp % Value::NRows_, i_comp / Value::NRows_)[i] );
+    }
+}
+
+
+
 template <int spacedim, class Value>
 FieldPython<spacedim, Value>::~FieldPython() {}
 
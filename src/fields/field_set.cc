@@ -23,11 +23,12 @@
 #include "tools/bidirectional_map.hh"
 #include "tools/unit_converter.hh"
 #include <boost/algorithm/string/replace.hpp>
+#include <algorithm>
 #include <queue>
 
 
 FieldSet::FieldSet()
-: mesh_(nullptr) {}
+: mesh_(nullptr), n_update_levels_(0) {}
 
 
 const Input::Type::Selection & FieldSet::get_user_field_shape_selection() {
@@ -210,6 +211,20 @@ bool FieldSet::is_constant(Region reg) const {
 }
 
 
+bool FieldSet::has_equal_components() const {
+    bool equal_all=true;
+    for(auto field : field_list) equal_all = equal_all && field->has_equal_components();
+    return equal_all;
+}
+
+
+bool FieldSet::equal_components(unsigned int i, unsigned int j) const {
+    for(auto field : field_list)
+        if (!field->equal_components(i, j)) return false;
+    return true;
+}
+
+
 bool FieldSet::is_jump_time() const {
     bool is_jump = false;
     for(auto field : field_list) is_jump = is_jump || field->is_jump_time();
@@ -219,34 +234,74 @@ bool FieldSet::is_jump_time() const {
 
 void FieldSet::cache_update(ElementCacheMap &cache_map) {
     ASSERT_GT(region_field_update_order_.size(), 0).error("Variable 'region_dependency_list' is empty. Did you call 'set_dependency' method?\n");
-    for (unsigned int i_reg_patch=0; i_reg_patch<cache_map.n_regions(); ++i_reg_patch) {
-        for (const FieldCommon *field : region_field_update_order_[cache_map.region_idx_from_chunk_position(i_reg_patch)])
-            field->cache_update(cache_map, i_reg_patch);
+    // Fields are updated by levels of dependency, evaluations deferred by fields are executed at the end of each level.
+    bool outer_deferred = cache_map.enable_deferred_updates(true);
+    for (unsigned int i_level=0; i_level<n_update_levels_; ++i_level) {
+        for (unsigned int i_reg_patch=0; i_reg_patch<cache_map.n_regions(); ++i_reg_patch) {
+            unsigned int region_idx = cache_map.region_idx_from_chunk_position(i_reg_patch);
+            const std::vector<unsigned int> &level_starts = region_level_starts_[region_idx];
+            if (i_level+1 >= level_starts.size()) continue;
+            const std::vector<const FieldCommon *> &update_order = region_field_update_order_[region_idx];
+            for (unsigned int i=level_starts[i_level]; i<level_starts[i_level+1]; ++i)
+                update_order[i]->cache_update(cache_map, i_reg_patch);
+        }
+        cache_map.eval_deferred_updates();
     }
+    cache_map.enable_deferred_updates(outer_deferred);
 }
 
 
 void FieldSet::set_dependency(FieldSet &used_fieldset) {
     region_field_update_order_.clear();
-    std::unordered_set<const FieldCommon *> used_fields;
+    region_level_starts_.clear();
+    n_update_levels_ = 0;
+    std::unordered_map<const FieldCommon *, unsigned int> field_levels;
 
     for (unsigned int i_reg=0; i_reg<mesh_->region_db().size(); ++i_reg) {
         for (FieldListAccessor f_acc : used_fieldset.fields_range()) {
-            topological_sort( f_acc.field(), i_reg, used_fields );
+            topological_sort( f_acc.field(), i_reg, field_levels );
         }
-        used_fields.clear();
+
+        // sort fields by levels, stable sort keeps dependency order
+        std::vector<const FieldCommon *> &update_order = region_field_update_order_[i_reg];
+        std::stable_sort(update_order.begin(), update_order.end(),
+                [&field_levels](const FieldCommon *a, const FieldCommon *b) { return field_levels[a] < field_levels[b]; });
+        std::vector<unsigned int> &level_starts = region_level_starts_[i_reg];
+        for (unsigned int i=0; i<update_order.size(); ++i)
+            while (level_starts.size() <= field_levels[ update_order[i] ]) level_starts.push_back(i);
+        level_starts.push_back(update_order.size());
+        n_update_levels_ = std::max( n_update_levels_, (unsigned int)(level_starts.size()-1) );
+
+        field_levels.clear();
     }
 }
 
 
-void FieldSet::topological_sort(const FieldCommon *f, unsigned int i_reg, std::unordered_set<const FieldCommon *> &used_fields) {
-    if (used_fields.find(f) != used_fields.end() ) return; // field processed
-    used_fields.insert(f);
+std::size_t FieldSet::cache_bytes_per_point() const {
+    std::unordered_set<const FieldCommon *> cached_fields;
+    for (auto &reg_it : region_field_update_order_)
+        for (const FieldCommon *field : reg_it.second)
+            if (field->value_cache() != nullptr) cached_fields.insert(field);
+
+    std::size_t n_bytes = 0;
+    for (const FieldCommon *field : cached_fields)
+        n_bytes += field->value_cache()->n_rows() * field->value_cache()->n_cols() * sizeof(double);
+    return n_bytes;
+}
+
+
+unsigned int FieldSet::topological_sort(const FieldCommon *f, unsigned int i_reg, std::unordered_map<const FieldCommon *, unsigned int> &field_levels) {
+    auto it = field_levels.find(f);
+    if (it != field_levels.end() ) return it->second; // field processed
+    field_levels[f] = 0;
+    unsigned int level = 0;
     auto dep_vec = f->set_dependency(i_reg); // vector of dependent fields
     for (auto f_dep : dep_vec) {
-        topological_sort(f_dep, i_reg, used_fields);
+        level = std::max( level, topological_sort(f_dep, i_reg, field_levels)+1 );
     }
+    field_levels[f] = level;
     region_field_update_order_[i_reg].push_back(f);
+    return level;
 }
 
 
@@ -344,6 +344,16 @@ public:
      */
     bool is_constant(Region reg) const;
 
+    /**
+     * Collective interface to @p FieldCommon::has_equal_components().
+     */
+    bool has_equal_components() const;
+
+    /**
+     * Collective interface to @p FieldCommon::equal_components().
+     */
+    bool equal_components(unsigned int i, unsigned int j) const;
+
     /**
      * Collective interface to @p FieldCommonBase::is_jump_time().
      */
@@ -373,6 +383,13 @@ public:
      */
     void set_dependency(FieldSet &used_fieldset);
 
+    /**
+     * Return number of bytes of FieldValueCache arrays of all evaluated fields per one eval point.
+     *
+     * Counts fields updated in cache_update, so method must be called after set_dependency.
+     */
+    std::size_t cache_bytes_per_point() const;
+
     /**
      * Add coords field (X_) and depth field to field_list.
      *
@@ -412,8 +429,14 @@ public:
 
 protected:
 
-    /// Helper method sort used fields by dependency
-    void topological_sort(const FieldCommon *f, unsigned int i_reg, std::unordered_set<const FieldCommon *> &used_fields);
+    /**
+     * Helper method sort used fields by dependency.
+     *
+     * Returns level of dependency of field @p f, fields without dependency have level 0,
+     * other fields have level greater than all their dependencies. Processed fields and
+     * their levels are stored in @p field_levels.
+     */
+    unsigned int topological_sort(const FieldCommon *f, unsigned int i_reg, std::unordered_map<const FieldCommon *, unsigned int> &field_levels);
 
     /// List of all fields.
     std::vector<FieldCommon *> field_list;
@@ -429,6 +452,16 @@ protected:
      */
     std::map<unsigned int, std::vector<const FieldCommon *>> region_field_update_order_;
 
+    /**
+     * Holds start positions of dependency levels in region_field_update_order_ for every region.
+     *
+     * Fields of level i are stored at positions [ starts[i], starts[i+1] ).
+     */
+    std::map<unsigned int, std::vector<unsigned int>> region_level_starts_;
+
+    /// Maximal number of dependency levels over all regions.
+    unsigned int n_update_levels_;
+
     // Default fields.
     // TODO derive from Field<>, make public, rename
 
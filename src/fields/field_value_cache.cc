@@ -38,7 +38,8 @@ ElementCacheMap::ElementCacheMap()
 : simd_size_double(bparser::get_simd_size()), elm_idx_(CacheMapElementNumber::get(), ElementCacheMap::undef_elem_idx),
   ready_to_reading_(false), element_eval_points_map_(nullptr), eval_point_data_(0),
   regions_starts_(2*ElementCacheMap::regions_in_chunk,ElementCacheMap::regions_in_chunk),
-  element_starts_(2*ElementCacheMap::elements_in_chunk,ElementCacheMap::elements_in_chunk) {}
+  element_starts_(2*ElementCacheMap::elements_in_chunk,ElementCacheMap::elements_in_chunk),
+  deferred_updates_enabled_(false) {}
 
 
 ElementCacheMap::~ElementCacheMap() {
@@ -124,3 +125,12 @@ void ElementCacheMap::finish_elements_update() {
 	ready_to_reading_ = true;
 }
 
+
+void ElementCacheMap::eval_deferred_updates() {
+    // list is cleared before evaluation, evaluation can throw an exception
+    std::vector<DeferredCacheUpdate *> updates;
+    updates.swap(deferred_updates_);
+    for (DeferredCacheUpdate *update : updates)
+        update->evaluate();
+}
+
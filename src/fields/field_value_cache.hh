@@ -19,6 +19,7 @@
 #ifndef FIELD_VALUE_CACHE_HH_
 #define FIELD_VALUE_CACHE_HH_
 
+#include <algorithm>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -119,6 +120,66 @@ private:
 };
 
 
+/**
+ * @brief Auxiliary data class holds size of memory (in bytes) targeted by all FieldValueCache arrays
+ * of one assembly during evaluation of patch.
+ *
+ * Value should correspond to size of L2 (or L3) cache of processor, it can be set explicitly
+ * (e.g. as command line parameter). Patch size of GenericAssembly is limited by this value
+ * and by CacheMapElementNumber.
+ *
+ * Implementation is done as singletone with access through static methods 'get' and 'set'.
+ */
+class CacheMapByteBudget {
+public:
+	/// Return size of memory in bytes
+	static std::size_t get() {
+	    return get_instance().n_bytes_;
+	}
+
+	/// Set size of memory in bytes
+	static void set(std::size_t n_bytes) {
+	    ASSERT_PERMANENT_GT(n_bytes, 0).error("Byte budget of field value cache must be positive.\n");
+	    get_instance().n_bytes_ = n_bytes;
+	}
+
+	CacheMapByteBudget(CacheMapByteBudget const&) = delete;  ///< We don't need copy constructor.
+	void operator=(CacheMapByteBudget const&)     = delete;  ///< We don't need assignment operator.
+
+private:
+	/// Forbiden default constructor, default budget is 1 MB (typical size of L2 cache)
+	CacheMapByteBudget() : n_bytes_(1024*1024) {}
+
+
+    static CacheMapByteBudget& get_instance()
+    {
+        static CacheMapByteBudget instance;
+        return instance;
+    }
+
+    /// Targeted size of memory of all FieldValueCache arrays.
+    std::size_t n_bytes_;
+};
+
+
+/**
+ * @brief Interface of evaluation of FieldValueCache data deferred by FieldSet::cache_update.
+ *
+ * Field algorithm can register its evaluation to ElementCacheMap instead of immediate update
+ * of cache (see ElementCacheMap::add_deferred_update). FieldSet::cache_update updates fields
+ * by levels of dependency and executes all registered evaluations at the end of each level.
+ * This allows evaluate more fields and regions of patch by one call (used by FieldPython).
+ */
+class DeferredCacheUpdate {
+public:
+    /// Destructor
+    virtual ~DeferredCacheUpdate() {}
+
+    /// Execute all registered evaluations.
+    virtual void evaluate() = 0;
+};
+
+
 /**
  * @brief Directing class of FieldValueCache.
  *
@@ -206,6 +267,12 @@ public:
         return eval_point_data_.temporary_size() + (simd_size_double - 1)*set_of_regions_.size();
     }
 
+    /// Return true if some eval point of given region is added to patch.
+    inline bool contains_region(unsigned int i_reg) const
+    {
+        return (set_of_regions_.find(i_reg) != set_of_regions_.end());
+    }
+
     /*
      * Access to item of \p element_eval_points_map_ like to two-dimensional array.
      *
@@ -298,6 +365,28 @@ public:
         return Value::get_from_array(field_cache, value_cache_idx);
     }
 
+    /// Return true if fields can defer their evaluation (inside FieldSet::cache_update).
+    inline bool deferred_updates_enabled() const {
+        return deferred_updates_enabled_;
+    }
+
+    /// Enable or disable deferring of evaluations, return previous state.
+    inline bool enable_deferred_updates(bool enable) {
+        bool previous = deferred_updates_enabled_;
+        deferred_updates_enabled_ = enable;
+        return previous;
+    }
+
+    /// Register deferred evaluation, each object is registered only once.
+    inline void add_deferred_update(DeferredCacheUpdate *update) {
+        ASSERT(deferred_updates_enabled_).error("Deferred update of cache is not enabled.\n");
+        if (std::find(deferred_updates_.begin(), deferred_updates_.end(), update) == deferred_updates_.end())
+            deferred_updates_.push_back(update);
+    }
+
+    /// Execute and clear all registered deferred evaluations.
+    void eval_deferred_updates();
+
     /// Size of block (evaluation of FieldFormula) must be multiple of this value.
     /// TODO We should take this value from BParser and it should be dependent on processor configuration.
     unsigned int simd_size_double;
@@ -366,6 +455,12 @@ protected:
     /// Keeps set of unique region indices of added eval. points.
     std::unordered_set<unsigned int> set_of_regions_;
 
+    /// Flag allows deferring of evaluations, set in FieldSet::cache_update.
+    bool deferred_updates_enabled_;
+
+    /// Evaluations registered during actual level of FieldSet::cache_update.
+    std::vector<DeferredCacheUpdate *> deferred_updates_;
+
     // TODO: remove friend class
     template < template<IntDim...> class DimAssembly>
     friend class GenericAssembly;
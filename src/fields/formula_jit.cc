@@ -0,0 +1,419 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    formula_jit.cc
+ * @brief
+ */
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <boost/filesystem.hpp>
+
+#include "fields/formula_jit.hh"
+#include "system/global_defs.h"
+#include "system/logger.hh"
+
+
+namespace {
+
+/// Functions allowed in formulas and their C++ equivalents.
+const std::map<std::string, std::string> &jit_functions() {
+    static const std::map<std::string, std::string> functions = {
+        {"sin", "std::sin"}, {"cos", "std::cos"}, {"tan", "std::tan"},
+        {"asin", "std::asin"}, {"acos", "std::acos"}, {"atan", "std::atan"}, {"atan2", "std::atan2"},
+        {"sinh", "std::sinh"}, {"cosh", "std::cosh"}, {"tanh", "std::tanh"},
+        {"exp", "std::exp"}, {"log", "std::log"}, {"log10", "std::log10"}, {"log2", "std::log2"},
+        {"sqrt", "std::sqrt"}, {"abs", "std::fabs"}, {"floor", "std::floor"}, {"ceil", "std::ceil"},
+        {"pow", "std::pow"}, {"min", "std::fmin"}, {"max", "std::fmax"}
+    };
+    return functions;
+}
+
+
+/**
+ * Recursive descent translator of formula to C++ expression.
+ *
+ * Grammar (same precedence as in BParser):
+ *   ternary    := or_expr [ 'if' or_expr 'else' ternary ]
+ *   or_expr    := and_expr { 'or' and_expr }
+ *   and_expr   := not_expr { 'and' not_expr }
+ *   not_expr   := 'not' not_expr | comparison
+ *   comparison := sum [ ('<' | '<=' | '>' | '>=' | '==' | '!=') sum ]
+ *   sum        := product { ('+' | '-') product }
+ *   product    := unary { ('*' | '/' | '%') unary }
+ *   unary      := ('-' | '+') unary | power
+ *   power      := atom [ '**' unary ]
+ *   atom       := number | name | name '(' ternary { ',' ternary } ')' | '(' ternary ')'
+ */
+class FormulaTranslator {
+public:
+    FormulaTranslator(const std::string &formula)
+    : formula_(formula), pos_(0)
+    {
+        translation_.has_time = false;
+    }
+
+    FormulaJit::Translation translate() {
+        this->next_token();
+        translation_.expression = this->ternary();
+        if (token_ != "") this->error("unexpected token '" + token_ + "'");
+        return translation_;
+    }
+
+private:
+    /// Read next token to token_, empty string marks end of formula.
+    void next_token() {
+        while (pos_ < formula_.size() && std::isspace(formula_[pos_])) ++pos_;
+        token_is_number_ = false;
+        if (pos_ >= formula_.size()) {
+            token_ = "";
+            return;
+        }
+        std::size_t begin = pos_;
+        char c = formula_[pos_];
+        if (std::isdigit(c) || (c == '.' && pos_+1 < formula_.size() && std::isdigit(formula_[pos_+1]))) {
+            while (pos_ < formula_.size() && (std::isdigit(formula_[pos_]) || formula_[pos_] == '.')) ++pos_;
+            if (pos_ < formula_.size() && (formula_[pos_] == 'e' || formula_[pos_] == 'E')) {
+                ++pos_;
+                if (pos_ < formula_.size() && (formula_[pos_] == '+' || formula_[pos_] == '-')) ++pos_;
+                while (pos_ < formula_.size() && std::isdigit(formula_[pos_])) ++pos_;
+            }
+            token_is_number_ = true;
+        } else if (std::isalpha(c) || c == '_') {
+            while (pos_ < formula_.size() && (std::isalnum(formula_[pos_]) || formula_[pos_] == '_')) ++pos_;
+        } else {
+            static const std::vector<std::string> operators = {"**", "<=", ">=", "==", "!=",
+                    "+", "-", "*", "/", "%", "<", ">", "(", ")", ","};
+            for (const std::string &op : operators)
+                if (formula_.compare(pos_, op.size(), op) == 0) {
+                    pos_ += op.size();
+                    token_ = op;
+                    return;
+                }
+            this->error(std::string("unsupported character '") + c + "'");
+        }
+        token_ = formula_.substr(begin, pos_ - begin);
+    }
+
+    void expect(const std::string &token) {
+        if (token_ != token) this->error("expected '" + token + "'");
+        this->next_token();
+    }
+
+    void error(const std::string &msg) {
+        THROW( FormulaJit::ExcUnsupportedFormula() << FormulaJit::EI_Formula(formula_) << FormulaJit::EI_Message(msg) );
+    }
+
+    std::string ternary() {
+        std::string value = this->or_expr();
+        if (token_ == "if") {
+            this->next_token();
+            std::string cond = this->or_expr();
+            this->expect("else");
+            std::string other = this->ternary();
+            return "((" + cond + ") != 0.0 ? (" + value + ") : (" + other + "))";
+        }
+        return value;
+    }
+
+    std::string or_expr() {
+        std::string expr = this->and_expr();
+        while (token_ == "or") {
+            this->next_token();
+            expr = "double((" + expr + ") != 0.0 || (" + this->and_expr() + ") != 0.0)";
+        }
+        return expr;
+    }
+
+    std::string and_expr() {
+        std::string expr = this->not_expr();
+        while (token_ == "and") {
+            this->next_token();
+            expr = "double((" + expr + ") != 0.0 && (" + this->not_expr() + ") != 0.0)";
+        }
+        return expr;
+    }
+
+    std::string not_expr() {
+        if (token_ == "not") {
+            this->next_token();
+            return "double((" + this->not_expr() + ") == 0.0)";
+        }
+        return this->comparison();
+    }
+
+    std::string comparison() {
+        std::string expr = this->sum();
+        if (token_ == "<" || token_ == "<=" || token_ == ">" || token_ == ">=" || token_ == "==" || token_ == "!=") {
+            std::string op = token_;
+            this->next_token();
+            expr = "double((" + expr + ") " + op + " (" + this->sum() + "))";
+        }
+        return expr;
+    }
+
+    std::string sum() {
+        std::string expr = this->product();
+        while (token_ == "+" || token_ == "-") {
+            std::string op = token_;
+            this->next_token();
+            expr = "(" + expr + " " + op + " " + this->product() + ")";
+        }
+        return expr;
+    }
+
+    std::string product() {
+        std::string expr = this->unary();
+        while (token_ == "*" || token_ == "/" || token_ == "%") {
+            std::string op = token_;
+            this->next_token();
+            if (op == "%") expr = "std::fmod(" + expr + ", " + this->unary() + ")";
+            else expr = "(" + expr + " " + op + " " + this->unary() + ")";
+        }
+        return expr;
+    }
+
+    std::string unary() {
+        if (token_ == "-" || token_ == "+") {
+            std::string op = token_;
+            this->next_token();
+            return "(" + op + this->unary() + ")";
+        }
+        return this->power();
+    }
+
+    std::string power() {
+        std::string expr = this->atom();
+        if (token_ == "**") {
+            this->next_token();
+            expr = "std::pow(" + expr + ", " + this->unary() + ")";
+        }
+        return expr;
+    }
+
+    std::string atom() {
+        if (token_ == "") this->error("unexpected end of formula");
+        if (token_ == "(") {
+            this->next_token();
+            std::string expr = this->ternary();
+            this->expect(")");
+            return "(" + expr + ")";
+        }
+        if (token_is_number_) {
+            std::string number = token_;
+            // avoid integer arithmetic in generated code
+            if (number.find_first_of(".eE") == std::string::npos) number += ".0";
+            this->next_token();
+            return number;
+        }
+        if ( !(std::isalpha(token_[0]) || token_[0] == '_') ) this->error("unexpected token '" + token_ + "'");
+
+        std::string name = token_;
+        this->next_token();
+        if (token_ == "(") {
+            auto it = jit_functions().find(name);
+            if (it == jit_functions().end()) this->error("unsupported function '" + name + "'");
+            this->next_token();
+            std::string expr = it->second + "(" + this->ternary();
+            while (token_ == ",") {
+                this->next_token();
+                expr += ", " + this->ternary();
+            }
+            this->expect(")");
+            return expr + ")";
+        }
+        if (name == "e") return "2.7182818284590452354";
+        if (name == "pi") return "3.14159265358979323846";
+        if (name == "t") {
+            translation_.has_time = true;
+            return "t";
+        }
+        if (name == "if" || name == "else" || name == "and" || name == "or" || name == "not")
+            this->error("unexpected keyword '" + name + "'");
+
+        unsigned int i_var = 0;
+        while (i_var < translation_.variables.size() && translation_.variables[i_var] != name) ++i_var;
+        if (i_var == translation_.variables.size()) translation_.variables.push_back(name);
+        return "v" + std::to_string(i_var) + "[i]";
+    }
+
+    const std::string &formula_;            ///< Translated formula
+    std::size_t pos_;                       ///< Position of next token in formula_
+    std::string token_;                     ///< Actual token
+    bool token_is_number_;                  ///< Flag marks numeric actual token
+    FormulaJit::Translation translation_;   ///< Result of translation
+};
+
+
+/// Split command line to words separated by whitespaces (no shell expansion).
+std::vector<std::string> split_words(const std::string &str) {
+    std::vector<std::string> words;
+    std::istringstream ss(str);
+    std::string word;
+    while (ss >> word) words.push_back(word);
+    return words;
+}
+
+
+/**
+ * Run command given by @p args (without shell, executable is searched in PATH), standard
+ * and error output is redirected to file @p log_path. Return true if command succeeds.
+ */
+bool run_command(const std::vector<std::string> &args, const std::string &log_path) {
+    std::vector<char *> argv;
+    for (const std::string &arg : args) argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+    pid_t pid;
+    extern char **environ;
+    int err = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (err != 0) return false;
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0)
+        if (errno != EINTR) return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+
+/// Stable (independent on compiler and run) 64-bit FNV-1a hash.
+std::uint64_t fnv1a_hash(const std::string &str) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+
+
+FormulaJit::FormulaJit()
+: cache_dir_(""),
+#ifdef FLOW123D_CXX_COMPILER
+  compiler_(FLOW123D_CXX_COMPILER),
+#else
+  compiler_("c++"),
+#endif
+  flags_("-O3")
+{}
+
+
+void FormulaJit::set_cache_dir(const std::string &cache_dir) {
+    get_instance().cache_dir_ = cache_dir;
+    get_instance().functions_.clear();
+}
+
+
+void FormulaJit::set_compiler(const std::string &compiler, const std::string &flags) {
+    get_instance().compiler_ = compiler;
+    get_instance().flags_ = flags;
+    get_instance().functions_.clear();
+}
+
+
+FormulaJit::Translation FormulaJit::translate(const std::string &formula) {
+    FormulaTranslator translator(formula);
+    return translator.translate();
+}
+
+
+std::string FormulaJit::generate_source(const std::string &formula, const Translation &translation) {
+    std::stringstream ss;
+    ss << "// Formula: " << formula.substr(0, formula.find_first_of("\r\n")) << "\n";
+    ss << "#include <cmath>\n\n";
+    ss << "extern \"C\" void flow123d_formula_eval(const double * const *vars, double t, double *result, unsigned int begin, unsigned int end) {\n";
+    for (unsigned int i_var=0; i_var<translation.variables.size(); ++i_var)
+        ss << "    const double * __restrict__ v" << i_var << " = vars[" << i_var << "]; // " << translation.variables[i_var] << "\n";
+    ss << "    (void)vars;\n";
+    ss << "    (void)t;\n";
+    ss << "    for (unsigned int i=begin; i<end; ++i)\n";
+    ss << "        result[i] = " << translation.expression << ";\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+
+bool FormulaJit::compile(const std::string &source, const std::string &so_path) {
+    // unique names of temporary files and log, more processes can compile same formula
+    std::string tmp_base = so_path + "." + std::to_string(getpid());
+    std::string src_path = tmp_base + ".cc";
+    std::string log_path = tmp_base + ".log";
+    {
+        std::ofstream src_file(src_path);
+        src_file << source;
+        if (!src_file.good()) return false;
+    }
+
+    std::vector<std::string> args = split_words(compiler_);
+    if (args.empty()) return false;
+    for (const std::string &flag : split_words(flags_)) args.push_back(flag);
+    for (const std::string &arg : {std::string("-fPIC"), std::string("-shared"), std::string("-o"), tmp_base + ".so", src_path})
+        args.push_back(arg);
+    bool success = run_command(args, log_path);
+    boost::system::error_code ec;
+    boost::filesystem::remove(src_path, ec);
+    if (!success) {
+        WarningOut().fmt("Compilation of formula failed (see '{}'), formula is evaluated by BParser.\n", log_path);
+        boost::filesystem::remove(tmp_base + ".so", ec);
+        return false;
+    }
+    boost::filesystem::rename(tmp_base + ".so", so_path, ec);
+    boost::filesystem::remove(log_path, ec);
+    return !ec;
+}
+
+
+FormulaJit::EvalFunction FormulaJit::get_function(const std::string &formula, const Translation &translation) {
+    FormulaJit &jit = get_instance();
+    if (!jit.is_enabled()) return nullptr;
+
+    std::string source = generate_source(formula, translation);
+    std::uint64_t hash = fnv1a_hash(jit.compiler_ + " " + jit.flags_ + "\n" + source);
+    auto it = jit.functions_.find(hash);
+    if (it != jit.functions_.end()) return it->second;
+
+    std::stringstream so_name;
+    so_name << "formula_" << std::hex << hash << ".so";
+    std::string so_path = (boost::filesystem::path(jit.cache_dir_) / so_name.str()).string();
+
+    EvalFunction function = nullptr;
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(jit.cache_dir_, ec);
+    if ( boost::filesystem::exists(so_path) || jit.compile(source, so_path) ) {
+        void *handle = dlopen(so_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle != nullptr)
+            function = reinterpret_cast<EvalFunction>( dlsym(handle, "flow123d_formula_eval") );
+        if (function == nullptr)
+            WarningOut().fmt("Loading of compiled formula '{}' failed, formula is evaluated by BParser.\n", so_path);
+    }
+    jit.functions_[hash] = function;
+    return function;
+}
@@ -0,0 +1,130 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    formula_jit.hh
+ * @brief
+ */
+
+#ifndef FORMULA_JIT_HH_
+#define FORMULA_JIT_HH_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "system/exceptions.hh"
+
+
+/**
+ * @brief Compiles scalar formulas of FieldFormula to native code.
+ *
+ * Formula is translated to C++ expression (method translate), the expression is placed
+ * into loop over points of patch and compiled by system C++ compiler to shared object.
+ * Shared objects are stored in cache directory and named by hash of generated source,
+ * so each distinct formula is compiled only once (also between runs of program).
+ *
+ * Supported formulas are scalar expressions with operators + - * / % **, comparisons,
+ * logical operators 'and', 'or', 'not', ternary operator 'a if cond else b', functions
+ * of <cmath> (sin, exp, log, sqrt, pow, min, max, ...), constants e, pi, time variable t
+ * and scalar variables (coordinates x, y, z, depth d, scalar fields). Other formulas
+ * (arrays, vector fields, ...) are not supported and FieldFormula evaluates them by BParser.
+ *
+ * Backend is disabled by default, it is enabled by setting of cache directory
+ * (command line option --formula_jit).
+ *
+ * Implementation is done as singletone with access through static methods.
+ */
+class FormulaJit {
+public:
+    /**
+     * Signature of compiled function.
+     *
+     * Evaluates formula on points [begin, end), @p vars holds pointers to data of variables
+     * in order given by Translation::variables.
+     */
+    typedef void (*EvalFunction)(const double * const *vars, double t, double *result, unsigned int begin, unsigned int end);
+
+    /// Formula translated to C++ expression.
+    struct Translation {
+        std::string expression;                ///< C++ expression, variable i is accessed as 'v<i>[i_point]'
+        std::vector<std::string> variables;    ///< Names of variables in order of first appearance
+        bool has_time;                         ///< Flag indicates that time variable 't' is used
+    };
+
+    TYPEDEF_ERR_INFO(EI_Formula, std::string);
+    TYPEDEF_ERR_INFO(EI_Message, std::string);
+    DECLARE_EXCEPTION(ExcUnsupportedFormula,
+            << "Formula " << EI_Formula::qval << " can not be compiled: " << EI_Message::val << "\n");
+
+    /// Enable backend and set directory of compiled formulas.
+    static void set_cache_dir(const std::string &cache_dir);
+
+    /**
+     * Set compiler and compilation flags, default compiler is given by build configuration.
+     *
+     * Both strings are split to words and passed to the compiler without shell. Default flags
+     * are portable, host specific flags (e.g. -march=native) are not part of the cache key,
+     * so they need a cache directory used by a single type of nodes.
+     */
+    static void set_compiler(const std::string &compiler, const std::string &flags);
+
+    /// Return true if backend is enabled.
+    static bool is_enabled() {
+        return !get_instance().cache_dir_.empty();
+    }
+
+    /// Translate formula to C++ expression, throws ExcUnsupportedFormula.
+    static Translation translate(const std::string &formula);
+
+    /// Return source code of shared object evaluating given translation.
+    static std::string generate_source(const std::string &formula, const Translation &translation);
+
+    /**
+     * Return compiled function of formula.
+     *
+     * Function is compiled if it is not found in cache directory. Returns nullptr
+     * if backend is disabled, formula is not supported or compilation fails.
+     */
+    static EvalFunction get_function(const std::string &formula, const Translation &translation);
+
+    FormulaJit(FormulaJit const&) = delete;  ///< We don't need copy constructor.
+    void operator=(FormulaJit const&) = delete;  ///< We don't need assignment operator.
+
+private:
+    /// Forbiden default constructor
+    FormulaJit();
+
+    static FormulaJit& get_instance()
+    {
+        static FormulaJit instance;
+        return instance;
+    }
+
+    /// Compile source to shared object of given path, return false if compilation fails.
+    bool compile(const std::string &source, const std::string &so_path);
+
+    /// Directory of compiled formulas, empty string means disabled backend.
+    std::string cache_dir_;
+
+    /// Command of C++ compiler.
+    std::string compiler_;
+
+    /// Compilation flags.
+    std::string flags_;
+
+    /// Loaded functions, key is hash of source, nullptr marks failed compilation.
+    std::unordered_map<std::uint64_t, EvalFunction> functions_;
+};
+
+
+#endif /* FORMULA_JIT_HH_ */
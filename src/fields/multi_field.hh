@@ -177,6 +177,16 @@ public:
      */
     bool is_constant(Region reg) override;
 
+    /**
+     * Implementation of @p FieldCommon::has_equal_components().
+     */
+    bool has_equal_components() const override;
+
+    /**
+     * Implementation of @p FieldCommon::equal_components().
+     */
+    bool equal_components(unsigned int i, unsigned int j) const override;
+
     /**
      * @brief Indicates special field states.
      *
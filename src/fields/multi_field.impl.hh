@@ -236,6 +236,38 @@ FieldResult MultiField<spacedim, Value>::field_result( RegionSet region_set) con
 }
 
 
+template<int spacedim, class Value>
+bool MultiField<spacedim, Value>::has_equal_components() const
+{
+    if (! flags().match(FieldFlag::declare_input) || full_input_list_.is_empty()) return true;
+
+    // array of size one and default value are used for all components
+    for (Input::Iterator<Input::Record> it = full_input_list_.begin<Input::Record>();
+					it != full_input_list_.end();
+					++it) {
+    	Input::Array mf_array;
+    	if ( it->opt_val(this->input_name(), mf_array) && mf_array.size() > 1 ) return false;
+    }
+    return true;
+}
+
+
+template<int spacedim, class Value>
+bool MultiField<spacedim, Value>::equal_components(unsigned int i, unsigned int j) const
+{
+    if (! flags().match(FieldFlag::declare_input) || full_input_list_.is_empty()) return true;
+
+    // array of size one and default value are used for all components
+    for (Input::Iterator<Input::Record> it = full_input_list_.begin<Input::Record>();
+					it != full_input_list_.end();
+					++it) {
+    	Input::Array mf_array;
+    	if ( it->opt_val(this->input_name(), mf_array) && mf_array.size() > 1 && !mf_array.equal_items(i, j) ) return false;
+    }
+    return true;
+}
+
+
 template<int spacedim, class Value>
 std::string MultiField<spacedim, Value>::get_value_attribute() const
 {
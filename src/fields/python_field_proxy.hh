@@ -34,26 +34,28 @@ public:
 	/**
 	 * Method encapsulates FieldValueCache data array for usage in Python.
 	 * Allows to create C++ and Python objects above shared block of memory.
+	 *
+	 * Strides follow layout of FieldValueCache: each component (row, col) is stored
+	 * in contiguous block of size reserved_, blocks are ordered by columns.
 	 */
 	static py::buffer_info field_proxy_get_buffer(FieldCacheProxy &proxy)
 	{
-	    ssize_t              n_comp  = ( (proxy.shape_.size()==1) ? proxy.shape_[0] : proxy.shape_[0]*proxy.shape_[1]);
-	    ssize_t              size    = proxy.data_size_ / n_comp;
 	    std::vector<ssize_t> shape;
 	    std::vector<ssize_t> strides;
 
+	    ssize_t comp_stride = proxy.reserved_ * sizeof(double);
 	    if (proxy.shape_[0] > 1) { // add dimensions only for vector and tensor
 	        shape.push_back(proxy.shape_[0]);
-	        if (proxy.shape_.size() == 2) shape.push_back(proxy.shape_[1]);
+	        strides.push_back(comp_stride);
+	        if (proxy.shape_.size() == 2) {
+	            shape.push_back(proxy.shape_[1]);
+	            strides.push_back(comp_stride * proxy.shape_[0]);
+	        }
 	    }
-	    shape.push_back(size);
+	    shape.push_back(proxy.n_points_);
+	    strides.push_back(sizeof(double));
 
 	    ssize_t n_dim = shape.size();
-	    strides.resize(n_dim);
-	    strides[n_dim-1] = sizeof(double);
-	    for(uint i=n_dim-1; i>0; i--) {
-	        strides[i-1] = strides[i] * shape[i];
-	    }
 
 	    // create n_dim NumPy array
 	    return  py::buffer_info(
@@ -67,13 +69,15 @@ public:
 	}
 
     /// Constructor
-    FieldCacheProxy(std::string field_name, std::vector<uint> shape, double * field_cache_data, uint data_size)
-    : field_name_(field_name), shape_(shape), field_cache_data_(field_cache_data), data_size_(data_size)
+    FieldCacheProxy(std::string field_name, std::vector<uint> shape, const FieldValueCache<double> &field_cache)
+    : field_name_(field_name), shape_(shape), field_cache_data_(field_cache.data_),
+      n_points_(field_cache.size()), reserved_(field_cache.reserved())
     {}
 
     /// Copy constructor
     FieldCacheProxy(const FieldCacheProxy &other)
-    : field_name_(other.field_name_), shape_(other.shape_), field_cache_data_(other.field_cache_data_), data_size_(other.data_size_)
+    : field_name_(other.field_name_), shape_(other.shape_), field_cache_data_(other.field_cache_data_),
+      n_points_(other.n_points_), reserved_(other.reserved_)
     {}
 
     /// Getter returns field name
@@ -84,7 +88,8 @@ private:
     std::string field_name_;
     std::vector<uint> shape_;
     double *field_cache_data_;
-    uint data_size_;
+    uint n_points_;        ///< Number of points of each component
+    uint reserved_;        ///< Distance between components in field_cache_data_
 };
 
 #pragma GCC visibility pop
@@ -37,6 +37,7 @@
 #include "la/linsys_PETSC.hh"
 #include "la/schur.hh"
 #include "la/local_system.hh"
+#include "la/local_schur_batch.hh"
 #include "la/local_constraint.hh"
 
 #include "coupling/balance.hh"
@@ -293,6 +294,10 @@ protected:
     {
 	    std::sort(eq_data_->loc_constraint_.begin(), eq_data_->loc_constraint_.end());
         eq_data_->loc_constraint_.emplace_back(uint(-1), 0, 0.0); // add constraint of invalid element to end of vector
+
+        // Schur complements of own cells are computed in batches of local systems of the same size
+        for (auto &batch : schur_batches_) batch.second.compute_schur_complement(true);
+
         unsigned int i_constr = 0;
         for ( DHCellAccessor dh_cell : eq_data_->dh_cr_->own_range() ) {
             this->set_loc_schur(dh_cell);
@@ -300,8 +305,7 @@ protected:
                 this->loc_schur_.set_solution(eq_data_->loc_constraint_[i_constr]);
             	i_constr++;
             }
-            eq_data_->loc_system_[dh_cell.local_idx()].compute_schur_complement(
-                    eq_data_->schur_offset_[dh_cell.dim()-1], this->loc_schur_, true);
+            schur_batch(dh_cell).get_schur_complement(schur_batch_idx_[dh_cell.local_idx()], this->loc_schur_);
 
             // for seepage BC, save local system
             if (eq_data_->save_local_system_[dh_cell.local_idx()])
@@ -340,8 +344,8 @@ protected:
             this->set_loc_schur(dh_cell);
             arma::vec schur_solution = this->eq_data_->p_edge_solution.get_subvec(this->loc_schur_.row_dofs);
             // reconstruct the velocity and pressure
-            this->eq_data_->loc_system_[this->bulk_local_idx_].reconstruct_solution_schur(this->eq_data_->schur_offset_[dh_cell.dim()-1],
-                                                                                  schur_solution, this->reconstructed_solution_);
+            LocalSchurBatch::reconstruct_solution_schur(this->eq_data_->loc_system_[this->bulk_local_idx_],
+                    this->eq_data_->schur_offset_[dh_cell.dim()-1], schur_solution, this->reconstructed_solution_);
 
             this->reconstructed_solution_ += this->eq_data_->postprocess_solution_[this->bulk_local_idx_];
 
@@ -595,6 +599,8 @@ protected:
 
     /// Precompute loc_system and loc_schur data members.
     void set_dofs() {
+        if (schur_batches_.empty()) this->create_schur_batches();
+
         unsigned int size, loc_size, elm_dim;;
         for ( DHCellAccessor dh_cell : eq_data_->dh_->local_range() ) {
             const ElementAccessor<3> ele = dh_cell.elm();
@@ -630,7 +636,10 @@ protected:
                     i++;
                 }
             }
-            eq_data_->loc_system_[dh_cell.local_idx()].reset(dofs, dofs);
+            if (dh_cell.is_own())
+                schur_batch(dh_cell).reset_system(schur_batch_idx_[dh_cell.local_idx()], eq_data_->loc_system_[dh_cell.local_idx()], dofs);
+            else
+                eq_data_->loc_system_[dh_cell.local_idx()].reset(dofs, dofs);
 
             // Set side-edge (flux-lambda) terms
             for (DHCellSide dh_side : dh_cell.side_range()) {
@@ -643,6 +652,39 @@ protected:
     }
 
 
+    /**
+     * Create batches of local systems of the same size (given by dimension, number of sides and neighbours)
+     * of own cells and set index of every local system in its batch. Local systems of batches are stored
+     * contiguously, see LocalSchurBatch.
+     */
+    void create_schur_batches() {
+        schur_batch_idx_.resize(eq_data_->loc_system_.size());
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> batch_sizes;
+        for ( DHCellAccessor dh_cell : eq_data_->dh_->own_range() ) {
+            auto key = schur_batch_key(dh_cell);
+            schur_batch_idx_[dh_cell.local_idx()] = batch_sizes[key]++;
+        }
+        for (auto &batch_size : batch_sizes) {
+            auto it = schur_batches_.emplace( batch_size.first,
+                    LocalSchurBatch(batch_size.first.first, batch_size.first.second) ).first;
+            it->second.resize(batch_size.second);
+        }
+    }
+
+
+    /// Return key of batch of local system of given cell: pair (offset of Schur complement, size of Schur complement).
+    inline std::pair<unsigned int, unsigned int> schur_batch_key(const DHCellAccessor &dh_cell) const {
+        const ElementAccessor<3> ele = dh_cell.elm();
+        return std::make_pair(eq_data_->schur_offset_[ele.dim()-1], ele->n_sides() + ele->n_neighs_vb());
+    }
+
+
+    /// Return batch of local system of given own cell.
+    inline LocalSchurBatch &schur_batch(const DHCellAccessor &dh_cell) {
+        return schur_batches_.at( schur_batch_key(dh_cell) );
+    }
+
+
     /// Precompute loc_schur data member of given cell.
     void set_loc_schur(const DHCellAccessor dh_cr_cell) {
         const ElementAccessor<3> ele = dh_cr_cell.elm();
@@ -785,6 +827,10 @@ protected:
 
     LocalSystem loc_schur_;
 
+    /// Batches of local systems of the same size, key is pair (offset of Schur complement, size of Schur complement).
+    std::map<std::pair<unsigned int, unsigned int>, LocalSchurBatch> schur_batches_;
+    std::vector<unsigned int> schur_batch_idx_;            ///< Index of local system of own cell in its batch, indexed by local idx of cell
+
     template < template<IntDim...> class DimAssembly>
     friend class GenericAssembly;
 
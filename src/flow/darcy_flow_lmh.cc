@@ -32,6 +32,7 @@
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
 #include "system/index_types.hh"
+#include "system/checkpoint.hh"
 #include "input/factory.hh"
 
 #include "mesh/mesh.h"
@@ -69,6 +70,7 @@
 #include "intersection/intersection_local.hh"
 
 #include "fem/fe_p.hh"
+#include "fem/sparsity_pattern.hh"
 
 
 FLOW123D_FORCE_LINK_IN_CHILD(darcy_flow_lmh)
@@ -892,6 +894,31 @@ void DarcyLMH::output_data() {
 }
 
 
+void DarcyLMH::save_state(Checkpoint &checkpoint)
+{
+    EquationBase::save_state(checkpoint);
+    std::string prefix = checkpoint_prefix();
+    checkpoint.save_vector(prefix + "/full_solution", eq_data_->full_solution);
+    checkpoint.save_vector(prefix + "/p_edge_solution", eq_data_->p_edge_solution);
+    checkpoint.save_vector(prefix + "/p_edge_solution_previous", eq_data_->p_edge_solution_previous);
+    checkpoint.save_vector(prefix + "/p_edge_solution_previous_time", eq_data_->p_edge_solution_previous_time);
+    checkpoint.save(prefix + "/use_steady_assembly", (double)eq_data_->use_steady_assembly_);
+}
+
+
+void DarcyLMH::load_state(const Checkpoint &checkpoint)
+{
+    EquationBase::load_state(checkpoint);
+    std::string prefix = checkpoint_prefix();
+    checkpoint.load_vector(prefix + "/full_solution", eq_data_->full_solution);
+    checkpoint.load_vector(prefix + "/p_edge_solution", eq_data_->p_edge_solution);
+    checkpoint.load_vector(prefix + "/p_edge_solution_previous", eq_data_->p_edge_solution_previous);
+    checkpoint.load_vector(prefix + "/p_edge_solution_previous_time", eq_data_->p_edge_solution_previous_time);
+    eq_data_->use_steady_assembly_ = (checkpoint.load_value(prefix + "/use_steady_assembly") != 0.0);
+    data_changed_ = true;
+}
+
+
 //double DarcyLMH::solution_precision() const
 //{
 //    return eq_data_->lin_sys_schur->get_solution_precision();
@@ -936,9 +963,8 @@ void DarcyLMH::allocate_mh_matrix()
 {
     START_TIMER("DarcyLMH::allocate_mh_matrix");
 
-    // to make space for second schur complement, max. 10 neighbour edges of one el.
-    double zeros[100000];
-    for(int i=0; i<100000; i++) zeros[i] = 0.0;
+    // symbolic sparsity of schur complement, no values are assembled
+    SparsityPattern sparsity(eq_data_->dh_cr_);
 
     std::vector<LongIdx> tmp_rows;
     tmp_rows.reserve(200);
@@ -949,19 +975,14 @@ void DarcyLMH::allocate_mh_matrix()
 
     // DebugOut() << "Allocate new schur\n";
     for ( DHCellAccessor dh_cell : eq_data_->dh_cr_->own_range() ) {
-        ElementAccessor<3> ele = dh_cell.elm(); 
-
-        const uint ndofs = dh_cell.n_dofs();
         dofs.resize(dh_cell.n_dofs());
         dh_cell.get_dof_indices(dofs);
 
-        int* dofs_ptr = dofs.data();
-        lin_sys_schur().mat_set_values(ndofs, dofs_ptr, ndofs, dofs_ptr, zeros);
+        sparsity.add(dofs, dofs);
         
         tmp_rows.clear();
         
         // compatible neighborings rows
-        unsigned int n_neighs = ele->n_neighs_vb();
         for ( DHCellSide neighb_side : dh_cell.neighb_sides() ) {
             // every compatible connection adds a 2x2 matrix involving
             // current element pressure  and a connected edge pressure
@@ -978,9 +999,9 @@ void DarcyLMH::allocate_mh_matrix()
             tmp_rows.push_back(dofs_ngh[neighb_side.side().side_idx()]);
         }
         
-        lin_sys_schur().mat_set_values(ndofs, dofs_ptr, n_neighs, tmp_rows.data(), zeros); // (edges)  x (neigh edges)
-        lin_sys_schur().mat_set_values(n_neighs, tmp_rows.data(), ndofs, dofs_ptr, zeros); // (neigh edges) x (edges)
-        lin_sys_schur().mat_set_values(n_neighs, tmp_rows.data(), n_neighs, tmp_rows.data(), zeros);  // (neigh edges) x (neigh edges)
+        sparsity.add(dofs, tmp_rows);     // (edges)  x (neigh edges)
+        sparsity.add(tmp_rows, dofs);     // (neigh edges) x (edges)
+        sparsity.add(tmp_rows, tmp_rows); // (neigh edges) x (neigh edges)
 
         tmp_rows.clear();
 //        if (eq_data_->mortar_method_ != NoMortar) {
@@ -1001,9 +1022,9 @@ void DarcyLMH::allocate_mh_matrix()
 //            }
 //        }
 
-        lin_sys_schur().mat_set_values(ndofs, dofs_ptr, tmp_rows.size(), tmp_rows.data(), zeros);   // master edges x slave edges
-        lin_sys_schur().mat_set_values(tmp_rows.size(), tmp_rows.data(), ndofs, dofs_ptr, zeros);   // slave edges  x master edges
-        lin_sys_schur().mat_set_values(tmp_rows.size(), tmp_rows.data(), tmp_rows.size(), tmp_rows.data(), zeros);  // slave edges  x slave edges
+        sparsity.add(dofs, tmp_rows);     // master edges x slave edges
+        sparsity.add(tmp_rows, dofs);     // slave edges  x master edges
+        sparsity.add(tmp_rows, tmp_rows); // slave edges  x slave edges
     }
     // DebugOut() << "end Allocate new schur\n";
     
@@ -1099,6 +1120,9 @@ void DarcyLMH::allocate_mh_matrix()
     } else if (mortar_method_ == MortarP1) {
         P1_CouplingAssembler(*this).assembly(*ls);
     }*/
+
+    sparsity.finalize();
+    ((LinSys_PETSC *)&lin_sys_schur())->preallocate_matrix(sparsity.on_nz(), sparsity.off_nz());
 }
 
 
@@ -1205,8 +1229,6 @@ void DarcyLMH::create_linear_system(Input::AbstractRecord in_rec) {
             // }
 
             START_TIMER("PETSC PREALLOCATION");
-            lin_sys_schur().start_allocation();
-            
             allocate_mh_matrix();
             
             eq_data_->full_solution.zero_entries();
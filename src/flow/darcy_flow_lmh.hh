@@ -309,6 +309,9 @@ public:
 
     virtual double solved_time() override;
 
+    void save_state(Checkpoint &checkpoint) override;
+    void load_state(const Checkpoint &checkpoint) override;
+
     inline EqFields &eq_fields() { return *eq_fields_; }
     inline EqData &eq_data() { return *eq_data_; }
 
@@ -9,6 +9,7 @@
 #include "system/global_defs.h"
 #include "system/sys_profiler.hh"
 #include "system/asserts.hh"
+#include "system/checkpoint.hh"
 
 #include "coupling/balance.hh"
 
@@ -191,6 +192,24 @@ void RichardsLMH::accept_time_step()
     eq_data_->p_edge_solution_previous_time.local_to_ghost_end();
 }
 
+void RichardsLMH::save_state(Checkpoint &checkpoint)
+{
+    DarcyLMH::save_state(checkpoint);
+    std::string prefix = checkpoint_prefix();
+    checkpoint.save_vector(prefix + "/water_content_previous_time", eq_data_->water_content_previous_time);
+    checkpoint.save_vector(prefix + "/capacity", eq_data_->capacity);
+    checkpoint.save_vector(prefix + "/water_content", eq_fields_->water_content_ptr->vec());
+}
+
+void RichardsLMH::load_state(const Checkpoint &checkpoint)
+{
+    DarcyLMH::load_state(checkpoint);
+    std::string prefix = checkpoint_prefix();
+    checkpoint.load_vector(prefix + "/water_content_previous_time", eq_data_->water_content_previous_time);
+    checkpoint.load_vector(prefix + "/capacity", eq_data_->capacity);
+    checkpoint.load_vector(prefix + "/water_content", eq_fields_->water_content_ptr->vec());
+}
+
 bool RichardsLMH::zero_time_term(bool time_global) {
     if (time_global) {
         return (eq_fields_->storativity.input_list_size() == 0)
@@ -103,6 +103,9 @@ public:
     static const Input::Type::Record & get_input_type();
     
     void accept_time_step() override;
+
+    void save_state(Checkpoint &checkpoint) override;
+    void load_state(const Checkpoint &checkpoint) override;
     
     virtual ~RichardsLMH() override;
 
@@ -16,6 +16,7 @@
  */
 
 #include <memory>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 #include "input/accessors.hh"
 
@@ -324,6 +325,18 @@ string Array::address_string() const
 }
 
 
+bool Array::equal_items(unsigned int i, unsigned int j) const
+{
+    ASSERT_LT(i, size()).error("Index out of array size.\n");
+    ASSERT_LT(j, size()).error("Index out of array size.\n");
+    if (i == j) return true;
+    std::ostringstream item_i, item_j;
+    address_.storage_head()->get_item(i)->print(item_i);
+    address_.storage_head()->get_item(j)->print(item_j);
+    return item_i.str() == item_j.str();
+}
+
+
 StorageArray Array::empty_storage_ = StorageArray(0);
 
 
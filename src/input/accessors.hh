@@ -611,6 +611,11 @@ public:
    template <class Container>
    void copy_to(Container &out) const;
 
+   /**
+    * Returns true if items with indices @p i and @p j hold equal input data (compared by whole subtrees).
+    */
+   bool equal_items(unsigned int i, unsigned int j) const;
+
    /**
     * Returns true if the accessor is empty (after default constructor).
     * TODO: have something similar for other accessors.
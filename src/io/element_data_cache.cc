@@ -156,6 +156,16 @@ void ElementDataCache<T>::print_binary_all(ostream &out_stream, bool print_data_
 }
 
 
+template <typename T>
+std::pair<const char *, std::size_t> ElementDataCache<T>::binary_data(unsigned int start)
+{
+	std::vector<T> &vec = *( this->data_.get() );
+	ASSERT_LE(start, this->n_values_);
+	return std::make_pair( reinterpret_cast<const char*>(vec.data() + n_comp_*start),
+			(this->n_values_ - start) * n_comp_ * sizeof(T) );
+}
+
+
 template <typename T>
 void ElementDataCache<T>::print_yaml_subarray(ostream &out_stream, unsigned int precision, unsigned int begin, unsigned int end)
 {
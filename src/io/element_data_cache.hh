@@ -119,6 +119,9 @@ public:
      */
     void print_binary_all(ostream &out_stream, bool print_data_size = true, unsigned int start = 0) override;
 
+    /// Implements @p ElementDataCacheBase::binary_data.
+    std::pair<const char *, std::size_t> binary_data(unsigned int start = 0) override;
+
     void print_yaml_subarray(ostream &out_stream, unsigned int precision, unsigned int begin, unsigned int end) override;
 
     /**
@@ -23,6 +23,7 @@
 #include <ostream>
 #include <string>
 #include <istream>
+#include <utility>
 #include "system/system.hh"
 #include "system/index_types.hh"
 
@@ -93,6 +94,13 @@ public:
      */
     virtual void print_binary_all(ostream &out_stream, bool print_data_size = true, unsigned int start = 0) = 0;
 
+    /**
+     * Return pointer to raw data of values starting from index @p start and size of these data in bytes.
+     *
+     * Allows to process binary data without copy (e.g. compression of appended VTK data).
+     */
+    virtual std::pair<const char *, std::size_t> binary_data(unsigned int start = 0) = 0;
+
     /**
      * Print stored values in the YAML format (using JSON like arrays).
      * Used for output of observe values.
@@ -324,6 +332,12 @@ public:
         ASSERT_PERMANENT(false).error("Not implemented.");
     }
 
+    std::pair<const char *, std::size_t> binary_data(unsigned int) override
+    {
+        ASSERT_PERMANENT(false).error("Not implemented.");
+        return std::make_pair(nullptr, 0);
+    }
+
     void print_yaml_subarray(ostream &, unsigned int, unsigned int , unsigned int) override
     {}
 
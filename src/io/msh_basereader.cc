@@ -19,10 +19,27 @@
 
 #include "io/msh_basereader.hh"
 #include "io/msh_gmshreader.h"
+#include "io/msh_snapshotreader.hh"
+#include "io/msh_distributedreader.hh"
 #include "io/msh_vtkreader.hh"
 #include "io/msh_pvdreader.hh"
 #include "mesh/mesh.h"
 #include "system/sys_profiler.hh"
+#include "tools/thread_pool.hh"
+
+
+namespace {
+
+/// Memory limit of prefetched data sections of all readers, zero turns prefetch off.
+std::size_t prefetch_memory_limit = 0;
+
+/// Memory used by prefetched data sections of all readers.
+std::size_t prefetch_memory_used = 0;
+
+/// Background thread reading data sections, created at first prefetch.
+std::unique_ptr<ThreadPool> prefetch_pool;
+
+}
 
 
 BaseMeshReader::BaseMeshReader(const FilePath &file_name)
@@ -54,10 +71,25 @@ Mesh * BaseMeshReader::mesh_factory(const Input::Record &input_mesh_rec) {
 
 	Input::Array region_list;
 	Mesh * mesh = new Mesh( input_mesh_rec );
+	bool write_snapshot = false;
 
 	try {
 	    auto file = input_mesh_rec.val<FilePath>("mesh_file");
-		std::shared_ptr< BaseMeshReader > reader = BaseMeshReader::reader_factory(file);
+	    // snapshot is used only on request, it must match content of GMSH file and optimization flag;
+	    // distributed mesh holds only part of elements on every process, so it is never used with distributed reading
+	    bool distributed_reading = (file.extension() == ".msh") && input_mesh_rec.val<bool>("distributed_reading");
+	    bool use_snapshot = (file.extension() == ".msh") && input_mesh_rec.val<bool>("snapshot") && !distributed_reading;
+	    bool optimize_mesh = input_mesh_rec.val<bool>("optimize_mesh");
+	    bool read_snapshot = use_snapshot && SnapshotMeshReader::is_valid(file, optimize_mesh);
+	    write_snapshot = use_snapshot && !read_snapshot;
+		std::shared_ptr< BaseMeshReader > reader;
+		if (read_snapshot) {
+			reader = std::make_shared<SnapshotMeshReader>(file);
+		} else if (distributed_reading) {
+			reader = std::make_shared<DistributedGmshMeshReader>(file);
+		} else {
+			reader = BaseMeshReader::reader_factory(file);
+		}
 		reader->read_physical_names(mesh);
 		if (input_mesh_rec.opt_val("regions", region_list)) {
 			mesh->read_regions_from_input(region_list);
@@ -66,6 +98,12 @@ Mesh * BaseMeshReader::mesh_factory(const Input::Record &input_mesh_rec) {
     } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, input_mesh_rec)
 
     mesh->setup_topology();
+    if (write_snapshot) {
+        // snapshot holds optimized mesh with topology, regions set by input are applied by check_and_finish
+        int rank;
+        MPI_Comm_rank(mesh->get_comm(), &rank);
+        if (rank == 0) SnapshotMeshReader::write(input_mesh_rec.val<FilePath>("mesh_file"), *mesh, input_mesh_rec.val<bool>("optimize_mesh"));
+    }
     mesh->check_and_finish();
     return mesh;
 
@@ -80,6 +118,7 @@ void BaseMeshReader::read_raw_mesh(Mesh * mesh) {
 
 void BaseMeshReader::set_element_ids(const Mesh &mesh)
 {
+	std::lock_guard<std::mutex> lock(read_mutex_);
 	has_compatible_mesh_ = true;
 	mesh.elements_id_maps(bulk_elements_id_, boundary_elements_id_);
 }
@@ -119,10 +158,17 @@ typename ElementDataCache<T>::CacheData BaseMeshReader::get_element_data(
             THROW(ExcWrongComponentsCount() << EI_FieldName(field_name) << EI_Time(header.time) << EI_MeshFile(tok_.f_name()) );
         }
 
-    	(*element_data_values_)[field_name] = std::make_shared< ElementDataCache<T> >(
-                field_name, header.time,
-                expected_n_components*expected_n_entities, boundary_begin);
-    	this->read_element_data(*(it->second), header );
+        unsigned int row_vec_size = expected_n_components*expected_n_entities;
+        ElementDataPtr prefetched = this->take_prefetched_data(header, row_vec_size, boundary_begin);
+        if (prefetched != nullptr) {
+            it->second = prefetched;
+        } else {
+            (*element_data_values_)[field_name] = std::make_shared< ElementDataCache<T> >(
+                    field_name, header.time, row_vec_size, boundary_begin);
+            std::lock_guard<std::mutex> lock(read_mutex_);
+            this->read_element_data(*(it->second), header );
+        }
+        this->template prefetch_next_data<T>(header, row_vec_size, boundary_begin);
 	}
 
     ElementDataCache<T> &current_cache = dynamic_cast<ElementDataCache<T> &>(*(it->second));
@@ -131,6 +177,71 @@ typename ElementDataCache<T>::CacheData BaseMeshReader::get_element_data(
 
 
 
+void BaseMeshReader::set_prefetch_memory_limit(std::size_t limit) {
+    prefetch_memory_limit = limit;
+}
+
+
+BaseMeshReader::ElementDataPtr BaseMeshReader::take_prefetched_data(const MeshDataHeader &header,
+        unsigned int row_vec_size, unsigned int boundary_begin) {
+    ElementDataPtr data = nullptr;
+    for (auto it = prefetched_data_.begin(); it != prefetched_data_.end(); ) {
+        if ( (it->field_name == header.field_name) && (it->time <= header.time) ) {
+            // exception of background reading is rethrown here
+            ElementDataPtr item_data = it->data.get();
+            if ( (it->time == header.time) && (it->row_vec_size == row_vec_size) && (it->boundary_begin == boundary_begin) )
+                data = item_data;
+            prefetch_memory_used -= it->mem_size;
+            it = prefetched_data_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return data;
+}
+
+
+template<typename T>
+void BaseMeshReader::prefetch_next_data(const MeshDataHeader &header, unsigned int row_vec_size, unsigned int boundary_begin) {
+    if (prefetch_memory_limit == 0) return;
+
+    MeshDataHeader next_header;
+    if ( !this->find_next_header(header, next_header) ) return;
+    if (next_header.n_components != header.n_components) return; // error is reported at regular reading
+    for (auto &item : prefetched_data_)
+        if ( (item.field_name == next_header.field_name) && (item.time == next_header.time) ) return;
+
+    std::size_t mem_size = row_vec_size * sizeof(T);
+    if (prefetch_memory_used + mem_size > prefetch_memory_limit) return;
+
+    if (!prefetch_pool) prefetch_pool = std::make_unique<ThreadPool>(1);
+    auto data_cache = std::make_shared< ElementDataCache<T> >(next_header.field_name, next_header.time, row_vec_size, boundary_begin);
+    PrefetchedData item;
+    item.field_name = next_header.field_name;
+    item.time = next_header.time;
+    item.row_vec_size = row_vec_size;
+    item.boundary_begin = boundary_begin;
+    item.mem_size = mem_size;
+    item.data = prefetch_pool->submit( [this, data_cache, next_header]() -> ElementDataPtr {
+        std::lock_guard<std::mutex> lock(read_mutex_);
+        this->read_element_data(*data_cache, next_header);
+        return data_cache;
+    } );
+    prefetch_memory_used += mem_size;
+    prefetched_data_.push_back( std::move(item) );
+}
+
+
+void BaseMeshReader::finish_prefetch() {
+    for (auto &item : prefetched_data_) {
+        item.data.wait();
+        prefetch_memory_used -= item.mem_size;
+    }
+    prefetched_data_.clear();
+}
+
+
+
 // explicit instantiation of template methods
 #define MESH_READER_GET_ELEMENT_DATA(TYPE) \
 template typename ElementDataCache<TYPE>::CacheData BaseMeshReader::get_element_data<TYPE>( \
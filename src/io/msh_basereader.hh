@@ -21,8 +21,11 @@
 
 
 
+#include <deque>                     // for deque
+#include <future>                    // for future
 #include <map>                       // for map, map<>::value_compare
 #include <memory>                    // for shared_ptr
+#include <mutex>                     // for mutex
 #include <string>                    // for string
 #include <vector>                    // for vector
 #include "input/accessors.hh"        // for Record
@@ -211,6 +214,15 @@ public:
 	 */
     virtual MeshDataHeader & find_header(HeaderQuery &header_query)=0;
 
+    /**
+     * Set memory limit (in bytes) of data sections prefetched by all readers (command line option --input_prefetch).
+     *
+     * If limit is positive, data section following in time the last read section of the field is read
+     * in background thread and it is used by next call of get_element_data. Zero limit (default)
+     * turns prefetch off.
+     */
+    static void set_prefetch_memory_limit(std::size_t limit);
+
 
 protected:
     typedef std::shared_ptr<ElementDataCacheBase> ElementDataPtr;
@@ -240,6 +252,41 @@ protected:
      */
     virtual void read_element_data(ElementDataCacheBase &data_cache, MeshDataHeader header)=0;
 
+    /**
+     * Find header of data section of the same field following given @p header in time.
+     *
+     * Used by prefetch of data, returns false if such section doesn't exist or reader doesn't
+     * support prefetch.
+     */
+    virtual bool find_next_header(FMT_UNUSED const MeshDataHeader &header, FMT_UNUSED MeshDataHeader &next_header)
+    { return false; }
+
+    /**
+     * Wait for all pending prefetch tasks and release their data.
+     *
+     * Must be called in destructor of descendants that implement find_next_header.
+     */
+    void finish_prefetch();
+
+    /**
+     * Data section read in background thread.
+     */
+    struct PrefetchedData {
+        std::string field_name;                     ///< Name of field
+        double time;                                ///< Time of data section
+        unsigned int row_vec_size;                  ///< Size of data (n_entities * n_components)
+        unsigned int boundary_begin;                ///< Begin of boundary elements in data
+        std::size_t mem_size;                       ///< Size of data in bytes
+        std::future<ElementDataPtr> data;           ///< Data cache filled by background thread
+    };
+
+    /// Return prefetched data of given header if exists, drops prefetched data older than header.
+    ElementDataPtr take_prefetched_data(const MeshDataHeader &header, unsigned int row_vec_size, unsigned int boundary_begin);
+
+    /// Start reading of data section following given header in background thread (see set_prefetch_memory_limit).
+    template<typename T>
+    void prefetch_next_data(const MeshDataHeader &header, unsigned int row_vec_size, unsigned int boundary_begin);
+
     /**
      * Flag stores that check of compatible mesh was performed.
      *
@@ -261,6 +308,12 @@ protected:
     /// If set through set_element_ids, the GMSH reader only reads given IDs and check that all IDs are read.
     vector<LongIdx> bulk_elements_id_, boundary_elements_id_;
 
+    /// Data sections read in background, ordered by time of start of reading.
+    std::deque<PrefetchedData> prefetched_data_;
+
+    /// Serializes reading of data sections (usage of tok_) by main and background thread.
+    std::mutex read_mutex_;
+
     friend class ReaderCache;
 };
 
@@ -0,0 +1,565 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    msh_distributedreader.cc
+ * @brief
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "io/msh_distributedreader.hh"
+#include "mesh/mesh.h"
+#include "mesh/bc_mesh.hh"
+#include "mesh/region.hh"
+#include "system/mpi_exchange.hh"
+#include "system/file_path.hh"
+#include "system/sys_profiler.hh"
+#include "system/logger.hh"
+
+
+namespace {
+
+/// Marks undefined offset (section not found, no error).
+const std::uint64_t undef_offset = std::numeric_limits<std::uint64_t>::max();
+
+/// Names of section headers in order given by DistributedGmshMeshReader::Section.
+const char * const section_names[] = { "$Nodes", "$EndNodes", "$Elements", "$EndElements" };
+
+/**
+ * Call @p func(line, offset) for each line of the stream starting in byte range [begin, end).
+ *
+ * Line that starts before @p begin is skipped (it belongs to previous range), last line can exceed @p end.
+ * Empty lines are skipped.
+ */
+template <class Func>
+void for_each_line(std::ifstream &in, std::uint64_t begin, std::uint64_t end, Func func) {
+    std::string line;
+    std::uint64_t pos = begin;
+    in.clear();
+    if (begin > 0) {
+        in.seekg(begin - 1);
+        std::getline(in, line);
+        pos = begin + line.size();
+    } else {
+        in.seekg(0);
+    }
+    while ( (pos < end) && std::getline(in, line) ) {
+        if (line.find_first_not_of(" \t\r") != std::string::npos) func(line, pos);
+        pos += line.size() + 1;
+    }
+}
+
+/// Return begin of range of given rank if [begin, end) is split to n_procs parts.
+inline std::uint64_t range_begin(std::uint64_t begin, std::uint64_t end, int rank, int n_procs) {
+    return begin + (end - begin) * rank / n_procs;
+}
+
+/// Read unsigned integer from string, move @p ptr behind it, return false if string doesn't start by number.
+inline bool read_uint(const char *&ptr, unsigned int &val) {
+    char *end;
+    unsigned long l = std::strtoul(ptr, &end, 10);
+    if (end == ptr) return false;
+    ptr = end;
+    val = (unsigned int)l;
+    return true;
+}
+
+/// Read double from string, move @p ptr behind it, return false if string doesn't start by number.
+inline bool read_double(const char *&ptr, double &val) {
+    char *end;
+    val = std::strtod(ptr, &end);
+    if (end == ptr) return false;
+    ptr = end;
+    return true;
+}
+
+/// Number of bits of Morton key per coordinate.
+const unsigned int morton_bits = 21;
+
+/// Return Morton key of @p point, coordinates are quantized in bounding box [box_min, box_max].
+std::uint64_t morton_key(const double *point, const double *box_min, const double *box_max) {
+    const std::uint64_t n_cells = (std::uint64_t(1) << morton_bits) - 1;
+    std::uint64_t q[3];
+    for (unsigned int d=0; d<3; ++d) {
+        double size = box_max[d] - box_min[d];
+        q[d] = (size > 0) ? (std::uint64_t)( (point[d] - box_min[d]) / size * n_cells ) : 0;
+    }
+    std::uint64_t key = 0;
+    for (unsigned int bit=0; bit<morton_bits; ++bit)
+        for (unsigned int d=0; d<3; ++d)
+            key |= ( (q[d] >> bit) & 1 ) << (3*bit + d);
+    return key;
+}
+
+/// Return true if element of given dimension and region id is bulk element (see Mesh::add_element).
+bool is_bulk(const Mesh *mesh, unsigned int dim, unsigned int region_id) {
+    Region reg = mesh->region_db().find_id(region_id, dim);
+    if ( !reg.is_valid() ) reg = mesh->region_db().find_id(region_id, RegionDB::undefined_dim);
+    return (dim > 0) && !(reg.is_valid() && reg.is_boundary());
+}
+
+} // namespace
+
+
+
+DistributedGmshMeshReader::DistributedGmshMeshReader(const FilePath &file_name)
+: GmshMeshReader(file_name), max_node_id_(0)
+{
+    file_name.open_stream(in_);
+    in_.seekg(0, std::ios::end);
+    file_size_ = in_.tellg();
+    section_offsets_.fill(undef_offset);
+}
+
+
+
+DistributedGmshMeshReader::~DistributedGmshMeshReader()
+{}
+
+
+
+void DistributedGmshMeshReader::find_sections(MPI_Comm comm) {
+    START_TIMER("DistributedGmshMeshReader - find sections");
+    int rank, n_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &n_procs);
+
+    std::array<std::uint64_t, 4> local_offsets;
+    local_offsets.fill(undef_offset);
+    for_each_line(in_, range_begin(0, file_size_, rank, n_procs), range_begin(0, file_size_, rank+1, n_procs),
+            [&local_offsets](const std::string &line, std::uint64_t offset) {
+                if (line.empty() || line[0] != '$') return;
+                std::size_t name_len = line.find_first_of(" \t\r");
+                if (name_len == std::string::npos) name_len = line.size();
+                for (unsigned int i=0; i<local_offsets.size(); ++i)
+                    if ( (local_offsets[i] == undef_offset) && (line.compare(0, name_len, section_names[i]) == 0) )
+                        local_offsets[i] = offset;
+            });
+    MPI_Allreduce(local_offsets.data(), section_offsets_.data(), local_offsets.size(), MPI_UINT64_T, MPI_MIN, comm);
+
+    for (unsigned int i=0; i<section_offsets_.size(); ++i)
+        if (section_offsets_[i] == undef_offset)
+            THROW(ExcMissingSection() << EI_Section(section_names[i]) << EI_GMSHFile(tok_.f_name()) );
+}
+
+
+
+void DistributedGmshMeshReader::section_range(Section section, std::uint64_t &begin, std::uint64_t &end,
+        unsigned int &n_entities) {
+    std::string header, count;
+    in_.clear();
+    in_.seekg(section_offsets_[section]);
+    std::getline(in_, header);
+    std::getline(in_, count);
+    const char *ptr = count.c_str();
+    if ( !read_uint(ptr, n_entities) )
+        THROW(ExcWrongFormat() << EI_Type("number") << EI_TokenizerMsg("count line of section " + header)
+                << EI_MeshFile(tok_.f_name()) );
+    begin = section_offsets_[section] + header.size() + count.size() + 2;
+    end = section_offsets_[section + 1];
+}
+
+
+
+template <class Parse>
+void DistributedGmshMeshReader::check_parse_error(MPI_Comm comm, std::uint64_t error_offset, Parse parse) {
+    std::uint64_t global_error_offset;
+    MPI_Allreduce(&error_offset, &global_error_offset, 1, MPI_UINT64_T, MPI_MIN, comm);
+    if (global_error_offset == undef_offset) return;
+
+    // all processes parse the first wrong line and throw the same exception
+    std::string line;
+    in_.clear();
+    in_.seekg(global_error_offset);
+    std::getline(in_, line);
+    parse(line, global_error_offset);
+    THROW(ExcWrongFormat() << EI_Type("line") << EI_TokenizerMsg(fmt::format("byte offset {}", global_error_offset))
+            << EI_MeshFile(tok_.f_name()) );
+}
+
+
+
+void DistributedGmshMeshReader::parse_node(const std::string &line, std::uint64_t offset, unsigned int &id, double *coords) {
+    const char *ptr = line.c_str();
+    if ( !read_uint(ptr, id) || !read_double(ptr, coords[0]) || !read_double(ptr, coords[1]) || !read_double(ptr, coords[2]) )
+        THROW(ExcWrongFormat() << EI_Type("number") << EI_TokenizerMsg(fmt::format("node at byte offset {}", offset))
+                << EI_MeshFile(tok_.f_name()) );
+}
+
+
+
+void DistributedGmshMeshReader::parse_element(const std::string &line, std::uint64_t offset, ElementRecord &elm) {
+    const char *ptr = line.c_str();
+    unsigned int type, n_tags, tag;
+    if ( !read_uint(ptr, elm.id) || !read_uint(ptr, type) || !read_uint(ptr, n_tags) )
+        THROW(ExcWrongFormat() << EI_Type("number") << EI_TokenizerMsg(fmt::format("element at byte offset {}", offset))
+                << EI_MeshFile(tok_.f_name()) );
+
+    // supported types are the same as in GmshMeshReader
+    switch (type) {
+        case 1:  elm.dim = 1; break;
+        case 2:  elm.dim = 2; break;
+        case 4:  elm.dim = 3; break;
+        case 15: elm.dim = 0; break;
+        default:
+            THROW(ExcUnsupportedType() << EI_ElementId(elm.id) << EI_ElementType(type) << EI_GMSHFile(tok_.f_name()) );
+    }
+    if (n_tags < 2)
+        THROW( ExcTooManyElementTags() << EI_ElementId(elm.id) << EI_Position(fmt::format("byte offset {}", offset)) );
+
+    bool ok = read_uint(ptr, elm.region_id) && read_uint(ptr, tag); // GMSH region number is not stored
+    elm.partition_id = 0;
+    if (ok && n_tags > 2) ok = read_uint(ptr, elm.partition_id);
+    for (unsigned int ti = 3; ok && ti < n_tags; ti++) ok = read_uint(ptr, tag);
+    for (unsigned int ni=0; ok && ni<elm.dim+1; ++ni) ok = read_uint(ptr, elm.node_ids[ni]);
+    if (!ok)
+        THROW(ExcWrongFormat() << EI_Type("number") << EI_TokenizerMsg(fmt::format("element at byte offset {}", offset))
+                << EI_MeshFile(tok_.f_name()) );
+}
+
+
+
+void DistributedGmshMeshReader::request_node_coords(MPI_Comm comm, const std::vector<unsigned int> &node_ids,
+        std::vector<double> &coords) {
+    int n_procs;
+    MPI_Comm_size(comm, &n_procs);
+    std::vector< std::vector<unsigned int> > requests(n_procs);
+    for (unsigned int id : node_ids) requests[ node_home(id, n_procs) ].push_back(id);
+    std::vector<unsigned int> received;
+    std::vector<int> n_received;
+    mpi_exchange(comm, MPI_UNSIGNED, requests, received, n_received);
+
+    // answer coordinates of home nodes, the least unknown node id is reported by all processes
+    const unsigned int undef_id = std::numeric_limits<unsigned int>::max();
+    unsigned int unknown_id = undef_id, global_unknown_id;
+    std::vector< std::vector<double> > answers(n_procs);
+    unsigned int i_rcv = 0;
+    for (int proc=0; proc<n_procs; ++proc)
+        for (int i=0; i<n_received[proc]; ++i, ++i_rcv) {
+            auto it = std::lower_bound(home_node_ids_.begin(), home_node_ids_.end(), received[i_rcv]);
+            if ( (it == home_node_ids_.end()) || (*it != received[i_rcv]) ) {
+                unknown_id = std::min(unknown_id, received[i_rcv]);
+                answers[proc].insert(answers[proc].end(), 3, 0.0);
+                continue;
+            }
+            const double *node_coords = home_node_coords_.data() + 3 * (it - home_node_ids_.begin());
+            answers[proc].insert(answers[proc].end(), node_coords, node_coords+3);
+        }
+    MPI_Allreduce(&unknown_id, &global_unknown_id, 1, MPI_UNSIGNED, MPI_MIN, comm);
+    if (global_unknown_id != undef_id)
+        THROW(ExcWrongFormat() << EI_Type("section $Elements")
+                << EI_TokenizerMsg(fmt::format("unknown node id {}", global_unknown_id)) << EI_MeshFile(tok_.f_name()) );
+
+    // node_ids are sorted, so answers of home processes (in order of processes) follow order of node_ids
+    mpi_exchange(comm, MPI_DOUBLE, answers, coords);
+}
+
+
+
+void DistributedGmshMeshReader::read_nodes(Mesh * mesh) {
+    START_TIMER("DistributedGmshMeshReader - read nodes");
+    MessageOut() << "- Reading nodes (distributed)...";
+    MPI_Comm comm = mesh->get_comm();
+    int rank, n_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &n_procs);
+    find_sections(comm);
+
+    std::uint64_t begin, end;
+    unsigned int n_nodes;
+    section_range(nodes_begin, begin, end, n_nodes);
+    if (n_nodes == 0) THROW( ExcZeroNodes() << EI_Position(tok_.f_name()) );
+
+    std::vector<unsigned int> local_ids;
+    std::vector<double> local_coords;
+    local_ids.reserve(n_nodes / n_procs + 1);
+    local_coords.reserve(3 * (n_nodes / n_procs + 1));
+    std::uint64_t error_offset = undef_offset;
+    for_each_line(in_, range_begin(begin, end, rank, n_procs), range_begin(begin, end, rank+1, n_procs),
+            [&](const std::string &line, std::uint64_t offset) {
+                if (error_offset != undef_offset) return;
+                unsigned int id;
+                double coords[3];
+                try {
+                    parse_node(line, offset, id, coords);
+                } catch (ExcWrongFormat &) {
+                    error_offset = offset;
+                    return;
+                }
+                local_ids.push_back(id);
+                local_coords.insert(local_coords.end(), coords, coords+3);
+            });
+    check_parse_error(comm, error_offset, [this](const std::string &line, std::uint64_t offset) {
+        unsigned int id;
+        double coords[3];
+        this->parse_node(line, offset, id, coords);
+    });
+
+    unsigned int n_local = local_ids.size(), n_found, local_max_id = 0;
+    MPI_Allreduce(&n_local, &n_found, 1, MPI_UNSIGNED, MPI_SUM, comm);
+    if (n_found != n_nodes)
+        THROW(ExcWrongFormat() << EI_Type("section $Nodes")
+                << EI_TokenizerMsg(fmt::format("{} nodes found, {} expected", n_found, n_nodes)) << EI_MeshFile(tok_.f_name()) );
+    for (unsigned int id : local_ids) local_max_id = std::max(local_max_id, id);
+    MPI_Allreduce(&local_max_id, &max_node_id_, 1, MPI_UNSIGNED, MPI_MAX, comm);
+
+    // nodes are kept by their home processes until elements are read, mesh is filled only by nodes of its elements
+    std::vector< std::vector<unsigned int> > send_ids(n_procs);
+    std::vector< std::vector<double> > send_coords(n_procs);
+    for (unsigned int i=0; i<local_ids.size(); ++i) {
+        unsigned int home = node_home(local_ids[i], n_procs);
+        send_ids[home].push_back(local_ids[i]);
+        send_coords[home].insert(send_coords[home].end(), &local_coords[3*i], &local_coords[3*i] + 3);
+    }
+    std::vector<unsigned int> ids;
+    std::vector<double> coords;
+    mpi_exchange(comm, MPI_UNSIGNED, send_ids, ids);
+    mpi_exchange(comm, MPI_DOUBLE, send_coords, coords);
+
+    std::vector<unsigned int> sorted(ids.size());
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::sort(sorted.begin(), sorted.end(), [&ids](unsigned int a, unsigned int b) { return ids[a] < ids[b]; });
+    home_node_ids_.resize(ids.size());
+    home_node_coords_.resize(coords.size());
+    for (unsigned int i=0; i<sorted.size(); ++i) {
+        home_node_ids_[i] = ids[ sorted[i] ];
+        std::copy(&coords[3*sorted[i]], &coords[3*sorted[i]] + 3, &home_node_coords_[3*i]);
+    }
+    MessageOut().fmt("... {} nodes read. \n", n_nodes);
+}
+
+
+
+void DistributedGmshMeshReader::partition_elements(Mesh * mesh, MPI_Comm comm, std::vector<ElementRecord> &elms) {
+    START_TIMER("DistributedGmshMeshReader - partition elements");
+    int n_procs;
+    MPI_Comm_size(comm, &n_procs);
+
+    std::vector<unsigned int> node_ids;
+    for (const ElementRecord &elm : elms) node_ids.insert(node_ids.end(), elm.node_ids, elm.node_ids + elm.dim + 1);
+    std::sort(node_ids.begin(), node_ids.end());
+    node_ids.erase( std::unique(node_ids.begin(), node_ids.end()), node_ids.end() );
+    std::vector<double> coords;
+    request_node_coords(comm, node_ids, coords);
+
+    // centroids of elements and bounding box of centroids of all processes
+    std::vector<double> centroids(3 * elms.size(), 0.0);
+    double box_min[3], box_max[3];
+    std::fill(box_min, box_min+3, std::numeric_limits<double>::max());
+    std::fill(box_max, box_max+3, std::numeric_limits<double>::lowest());
+    for (unsigned int i=0; i<elms.size(); ++i) {
+        for (unsigned int ni=0; ni<elms[i].dim+1; ++ni) {
+            unsigned int pos = std::lower_bound(node_ids.begin(), node_ids.end(), elms[i].node_ids[ni]) - node_ids.begin();
+            for (unsigned int d=0; d<3; ++d) centroids[3*i+d] += coords[3*pos+d] / (elms[i].dim+1);
+        }
+        for (unsigned int d=0; d<3; ++d) {
+            box_min[d] = std::min(box_min[d], centroids[3*i+d]);
+            box_max[d] = std::max(box_max[d], centroids[3*i+d]);
+        }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, box_min, 3, MPI_DOUBLE, MPI_MIN, comm);
+    MPI_Allreduce(MPI_IN_PLACE, box_max, 3, MPI_DOUBLE, MPI_MAX, comm);
+
+    // splitters of Morton curve are chosen from regular samples of sorted keys of bulk elements of all processes,
+    // small number of processes is oversampled to get balanced partitions
+    std::vector<std::uint64_t> keys(elms.size()), bulk_keys;
+    for (unsigned int i=0; i<elms.size(); ++i) {
+        keys[i] = morton_key(&centroids[3*i], box_min, box_max);
+        if (is_bulk(mesh, elms[i].dim, elms[i].region_id)) bulk_keys.push_back(keys[i]);
+    }
+    std::sort(bulk_keys.begin(), bulk_keys.end());
+    std::vector<std::uint64_t> samples;
+    const unsigned int n_proc_samples = std::max(n_procs, 64);
+    for (unsigned int i=0; i<n_proc_samples && !bulk_keys.empty(); ++i)
+        samples.push_back( bulk_keys[ (std::uint64_t)i * bulk_keys.size() / n_proc_samples ] );
+
+    int n_samples = samples.size();
+    std::vector<int> sample_counts(n_procs), sample_displs(n_procs, 0);
+    MPI_Allgather(&n_samples, 1, MPI_INT, sample_counts.data(), 1, MPI_INT, comm);
+    for (int proc=1; proc<n_procs; ++proc) sample_displs[proc] = sample_displs[proc-1] + sample_counts[proc-1];
+    std::vector<std::uint64_t> all_samples(sample_displs[n_procs-1] + sample_counts[n_procs-1]);
+    MPI_Allgatherv(samples.data(), n_samples, MPI_UINT64_T, all_samples.data(), sample_counts.data(), sample_displs.data(),
+            MPI_UINT64_T, comm);
+    std::sort(all_samples.begin(), all_samples.end());
+    std::vector<std::uint64_t> splitters;
+    for (int proc=1; proc<n_procs && !all_samples.empty(); ++proc)
+        splitters.push_back( all_samples[ (std::uint64_t)proc * all_samples.size() / n_procs ] );
+
+    for (unsigned int i=0; i<elms.size(); ++i)
+        elms[i].owner = std::upper_bound(splitters.begin(), splitters.end(), keys[i]) - splitters.begin();
+}
+
+
+
+void DistributedGmshMeshReader::distribute_elements(Mesh * mesh, MPI_Comm comm, const std::vector<ElementRecord> &local_elms,
+        std::vector<ElementRecord> &elms) {
+    START_TIMER("DistributedGmshMeshReader - distribute elements");
+    int rank, n_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &n_procs);
+
+    // home processes of nodes collect owners of bulk elements of the node, as pairs (node id, owner)
+    std::vector< std::vector<unsigned int> > node_owners(n_procs);
+    std::vector<unsigned int> node_ids;
+    for (const ElementRecord &elm : local_elms) {
+        bool bulk = is_bulk(mesh, elm.dim, elm.region_id);
+        for (unsigned int ni=0; ni<elm.dim+1; ++ni) {
+            node_ids.push_back(elm.node_ids[ni]);
+            if (bulk) {
+                auto &home_owners = node_owners[ node_home(elm.node_ids[ni], n_procs) ];
+                home_owners.push_back(elm.node_ids[ni]);
+                home_owners.push_back(elm.owner);
+            }
+        }
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+    node_ids.erase( std::unique(node_ids.begin(), node_ids.end()), node_ids.end() );
+    std::vector<unsigned int> received;
+    std::vector<int> n_received;
+    mpi_exchange(comm, MPI_UNSIGNED, node_owners, received);
+    std::vector< std::pair<unsigned int, unsigned int> > home_owners(received.size() / 2);
+    for (unsigned int i=0; i<home_owners.size(); ++i) home_owners[i] = std::make_pair(received[2*i], received[2*i+1]);
+    std::sort(home_owners.begin(), home_owners.end());
+    home_owners.erase( std::unique(home_owners.begin(), home_owners.end()), home_owners.end() );
+
+    // ask home processes for owners of nodes of parsed elements, answer is number of owners followed by owners
+    std::vector< std::vector<unsigned int> > requests(n_procs);
+    for (unsigned int id : node_ids) requests[ node_home(id, n_procs) ].push_back(id);
+    mpi_exchange(comm, MPI_UNSIGNED, requests, received, n_received);
+    std::vector< std::vector<unsigned int> > answers(n_procs);
+    unsigned int i_rcv = 0;
+    for (int proc=0; proc<n_procs; ++proc)
+        for (int i=0; i<n_received[proc]; ++i, ++i_rcv) {
+            auto first = std::lower_bound(home_owners.begin(), home_owners.end(), std::make_pair(received[i_rcv], 0u));
+            auto last = first;
+            while ( (last != home_owners.end()) && (last->first == received[i_rcv]) ) ++last;
+            answers[proc].push_back(last - first);
+            for (auto it = first; it != last; ++it) answers[proc].push_back(it->second);
+        }
+    std::vector<unsigned int> owners_data;
+    mpi_exchange(comm, MPI_UNSIGNED, answers, owners_data);
+    std::vector<unsigned int> owners_offset(node_ids.size());
+    for (unsigned int i=0, pos=0; i<node_ids.size(); ++i) {
+        owners_offset[i] = pos;
+        pos += owners_data[pos] + 1;
+    }
+
+    // element is sent to its owner and to owners of all bulk elements that share some node with it
+    std::vector< std::vector<ElementRecord> > send_elms(n_procs);
+    std::vector<unsigned int> targets;
+    for (const ElementRecord &elm : local_elms) {
+        targets.clear();
+        if (is_bulk(mesh, elm.dim, elm.region_id)) targets.push_back(elm.owner);
+        for (unsigned int ni=0; ni<elm.dim+1; ++ni) {
+            unsigned int pos = owners_offset[ std::lower_bound(node_ids.begin(), node_ids.end(), elm.node_ids[ni]) - node_ids.begin() ];
+            targets.insert(targets.end(), owners_data.begin() + pos + 1, owners_data.begin() + pos + 1 + owners_data[pos]);
+        }
+        // lonely boundary element is kept by its owner, so it is reported as in serial reading
+        if (targets.empty()) targets.push_back(elm.owner);
+        std::sort(targets.begin(), targets.end());
+        targets.erase( std::unique(targets.begin(), targets.end()), targets.end() );
+        for (unsigned int proc : targets) send_elms[proc].push_back(elm);
+    }
+
+    MPI_Datatype record_type;
+    MPI_Type_contiguous(sizeof(ElementRecord) / sizeof(unsigned int), MPI_UNSIGNED, &record_type);
+    MPI_Type_commit(&record_type);
+    mpi_exchange(comm, record_type, send_elms, elms);
+    MPI_Type_free(&record_type);
+
+    std::sort(elms.begin(), elms.end(), [rank](const ElementRecord &a, const ElementRecord &b) {
+        return std::make_pair(a.owner != (unsigned int)rank, a.id) < std::make_pair(b.owner != (unsigned int)rank, b.id);
+    });
+}
+
+
+
+void DistributedGmshMeshReader::read_elements(Mesh * mesh) {
+    START_TIMER("DistributedGmshMeshReader - read elements");
+    MessageOut() << "- Reading elements (distributed)...";
+    MPI_Comm comm = mesh->get_comm();
+    int rank, n_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &n_procs);
+
+    std::uint64_t begin, end;
+    unsigned int n_elements;
+    section_range(elements_begin, begin, end, n_elements);
+    if (n_elements == 0) THROW( ExcZeroElements() << EI_Position(tok_.f_name()) );
+
+    std::vector<ElementRecord> local_elms;
+    local_elms.reserve(n_elements / n_procs + 1);
+    std::uint64_t error_offset = undef_offset;
+    for_each_line(in_, range_begin(begin, end, rank, n_procs), range_begin(begin, end, rank+1, n_procs),
+            [&](const std::string &line, std::uint64_t offset) {
+                if (error_offset != undef_offset) return;
+                ElementRecord elm = {};
+                try {
+                    parse_element(line, offset, elm);
+                } catch (ExceptionBase &) {
+                    error_offset = offset;
+                    return;
+                }
+                local_elms.push_back(elm);
+            });
+    check_parse_error(comm, error_offset, [this](const std::string &line, std::uint64_t offset) {
+        ElementRecord elm;
+        this->parse_element(line, offset, elm);
+    });
+
+    unsigned int n_local = local_elms.size(), n_found;
+    MPI_Allreduce(&n_local, &n_found, 1, MPI_UNSIGNED, MPI_SUM, comm);
+    if (n_found != n_elements)
+        THROW(ExcWrongFormat() << EI_Type("section $Elements")
+                << EI_TokenizerMsg(fmt::format("{} elements found, {} expected", n_found, n_elements))
+                << EI_MeshFile(tok_.f_name()) );
+
+    std::vector<ElementRecord> elms;
+    partition_elements(mesh, comm, local_elms);
+    distribute_elements(mesh, comm, local_elms, elms);
+    std::vector<ElementRecord>().swap(local_elms);
+
+    // mesh holds only nodes of own and ghost elements
+    std::vector<unsigned int> node_ids;
+    for (const ElementRecord &elm : elms) node_ids.insert(node_ids.end(), elm.node_ids, elm.node_ids + elm.dim + 1);
+    std::sort(node_ids.begin(), node_ids.end());
+    node_ids.erase( std::unique(node_ids.begin(), node_ids.end()), node_ids.end() );
+    std::vector<double> coords;
+    request_node_coords(comm, node_ids, coords);
+    std::vector<unsigned int>().swap(home_node_ids_);
+    std::vector<double>().swap(home_node_coords_);
+
+    mesh->init_node_vector( node_ids.size() );
+    for (unsigned int i = 0; i < node_ids.size(); ++i) {
+        mesh->add_node(node_ids[i], arma::vec3{ coords[3*i], coords[3*i+1], coords[3*i+2] });
+    }
+
+    std::vector<unsigned int> elm_node_ids(4);
+    std::unordered_map<unsigned int, unsigned int> owners(elms.size());
+    mesh->init_element_vector( elms.size() );
+    for (const ElementRecord &elm : elms) {
+        std::copy(elm.node_ids, elm.node_ids + elm.dim + 1, elm_node_ids.begin());
+        mesh->add_element(elm.id, elm.dim, elm.region_id, elm.partition_id, elm_node_ids);
+        owners[elm.id] = elm.owner;
+    }
+    mesh->set_element_owners( std::move(owners) );
+
+    MessageOut().fmt("... {} elements read, {} bulk elements, {} boundary elements (own and ghost) on process {}. \n",
+            n_elements, mesh->n_elements(), mesh->bc_mesh()->n_elements(), rank);
+}
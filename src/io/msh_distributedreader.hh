@@ -0,0 +1,145 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    msh_distributedreader.hh
+ * @brief
+ */
+
+#ifndef MSH_DISTRIBUTEDREADER_HH
+#define	MSH_DISTRIBUTEDREADER_HH
+
+
+#include <array>                     // for array
+#include <cstdint>                   // for uint64_t
+#include <fstream>                   // for ifstream
+#include <mpi.h>                     // for MPI_Comm
+#include <string>                    // for string
+#include <vector>                    // for vector
+#include "io/msh_gmshreader.h"       // for GmshMeshReader
+
+class FilePath;
+class Mesh;
+
+
+/**
+ * @brief Reader of GMSH file that divides parsing and storage of the mesh between processes.
+ *
+ * Sections '$Nodes' and '$Elements' are split to byte ranges of equal size, each process parses
+ * only lines starting in its range (positions of sections are found by the same parallel scan of
+ * the file). No process holds the whole mesh:
+ *  - parsed nodes are sent to their home process (given by node id), which answers coordinates of nodes
+ *  - bulk elements are partitioned by Morton curve of their centroids, splitters of the curve are given
+ *    by sample sort of keys of all processes
+ *  - every element is sent to owner processes of all bulk elements that share some node with it,
+ *    so every process fills the mesh only by its own elements and the layer of ghost elements
+ *    (see Mesh::set_element_owners)
+ *
+ * Errors in file are reported consistently: the first wrong line (over all processes) is parsed
+ * again by every process and the same exception as in GmshMeshReader is thrown.
+ *
+ * Reader is used by BaseMeshReader::mesh_factory if key 'distributed_reading' of mesh input is set.
+ */
+class DistributedGmshMeshReader : public GmshMeshReader {
+public:
+    /// Construct the reader of given GMSH file.
+    DistributedGmshMeshReader(const FilePath &file_name);
+
+    /// Destructor
+    ~DistributedGmshMeshReader() override;
+
+protected:
+    /// Element data parsed from one line of '$Elements' section.
+    struct ElementRecord {
+        unsigned int id;
+        unsigned int dim;
+        unsigned int region_id;
+        unsigned int partition_id;
+        unsigned int node_ids[4];
+        unsigned int owner;       ///< Process that owns the element, set by partition_elements.
+    };
+
+    /// Indices of sections in section_offsets_.
+    enum Section {
+        nodes_begin = 0,
+        nodes_end = 1,
+        elements_begin = 2,
+        elements_end = 3
+    };
+
+    /// Parse nodes in range of actual process and send them to their home processes.
+    void read_nodes(Mesh * mesh) override;
+
+    /// Parse elements in range of actual process, partition them and fill mesh by own and ghost elements.
+    void read_elements(Mesh * mesh) override;
+
+    /// Return home process of node with given id, it stores coordinates of node between reading of nodes and elements.
+    inline unsigned int node_home(unsigned int node_id, unsigned int n_procs) const {
+        if (node_id > max_node_id_) return n_procs - 1; // unknown node, reported by home process
+        return (unsigned int)( (std::uint64_t)node_id * n_procs / ((std::uint64_t)max_node_id_ + 1) );
+    }
+
+    /**
+     * Return coordinates (three values per node) of nodes of given sorted @p node_ids received from home processes.
+     * Collective, throws on all processes if some process asks for node that is not in the file.
+     */
+    void request_node_coords(MPI_Comm comm, const std::vector<unsigned int> &node_ids, std::vector<double> &coords);
+
+    /// Set owners of parsed elements by sample sort of Morton keys of centroids of bulk elements.
+    void partition_elements(Mesh * mesh, MPI_Comm comm, std::vector<ElementRecord> &elms);
+
+    /**
+     * Send parsed elements @p local_elms to processes that own element sharing a node with them, return
+     * received own and ghost elements in @p elms (own elements first, both parts sorted by id).
+     */
+    void distribute_elements(Mesh * mesh, MPI_Comm comm, const std::vector<ElementRecord> &local_elms,
+            std::vector<ElementRecord> &elms);
+
+    /// Find byte offsets of section headers by parallel scan of the file, fill section_offsets_.
+    void find_sections(MPI_Comm comm);
+
+    /**
+     * Return byte range [begin, end) of lines of given section (without header and count lines)
+     * and the number of entities given in the count line.
+     */
+    void section_range(Section section, std::uint64_t &begin, std::uint64_t &end, unsigned int &n_entities);
+
+    /// Parse one line of '$Nodes' section.
+    void parse_node(const std::string &line, std::uint64_t offset, unsigned int &id, double *coords);
+
+    /// Parse one line of '$Elements' section.
+    void parse_element(const std::string &line, std::uint64_t offset, ElementRecord &elm);
+
+    /// If some process finds wrong line (@p error_offset), all processes parse this line and throw exception.
+    template <class Parse>
+    void check_parse_error(MPI_Comm comm, std::uint64_t error_offset, Parse parse);
+
+    /// File stream independent on tokenizer of GmshMeshReader.
+    std::ifstream in_;
+
+    /// Size of the file.
+    std::uint64_t file_size_;
+
+    /// Byte offsets of section headers (see Section).
+    std::array<std::uint64_t, 4> section_offsets_;
+
+    /// Maximal node id in file, determines home processes of nodes.
+    unsigned int max_node_id_;
+
+    /// Sorted ids of nodes of which actual process is home process.
+    std::vector<unsigned int> home_node_ids_;
+
+    /// Coordinates of nodes in home_node_ids_ (three values per node).
+    std::vector<double> home_node_coords_;
+};
+
+#endif	/* MSH_DISTRIBUTEDREADER_HH */
@@ -42,13 +42,15 @@ GmshMeshReader::GmshMeshReader(const FilePath &file_name)
     tok_.set_comment_pattern( "#");
     data_section_name_ = "$ElementData";
     has_compatible_mesh_ = false;
-    make_header_table();
+    header_table_ready_ = false; // table is created at first call of find_header
 }
 
 
 
 GmshMeshReader::~GmshMeshReader()   // Tokenizer close the file automatically
-{}
+{
+    this->finish_prefetch();
+}
 
 
 
@@ -327,6 +329,24 @@ void GmshMeshReader::make_header_table()
 	}
 
 	tok_.set_position( Tokenizer::Position() );
+	header_table_ready_ = true;
+}
+
+
+
+bool GmshMeshReader::find_next_header(const MeshDataHeader &header, MeshDataHeader &next_header)
+{
+	if (!header_table_ready_) return false;
+	HeaderTable::iterator table_it = header_table_.find(header.field_name);
+	if (table_it == header_table_.end()) return false;
+
+	// headers are sorted by time
+	for (const MeshDataHeader &table_header : table_it->second)
+		if (table_header.time > header.time) {
+			next_header = table_header;
+			return true;
+		}
+	return false;
 }
 
 
@@ -343,6 +363,11 @@ BaseMeshReader::MeshDataHeader & GmshMeshReader::find_header(BaseMeshReader::Hea
 		header_query.discretization = OutputTime::DiscreteSpace::ELEM_DATA;
 	}
 
+	if (!header_table_ready_) {
+		// table is built by tokenizer shared with prefetch of data sections
+		std::lock_guard<std::mutex> lock(read_mutex_);
+		make_header_table();
+	}
 	HeaderTable::iterator table_it = header_table_.find(header_query.field_name);
 
 	if (table_it == header_table_.end()) {
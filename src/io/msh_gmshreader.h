@@ -103,16 +103,25 @@ protected:
     void read_data_header(MeshDataHeader &head);
     /**
      * Reads table of ElementData headers from the tokenizer file.
+     *
+     * Uses tokenizer, so caller must hold read_mutex_ (see find_header).
      */
     void make_header_table() override;
     /**
      * Implements @p BaseMeshReader::read_element_data.
      */
     void read_element_data(ElementDataCacheBase &data_cache, MeshDataHeader header) override;
+    /**
+     * Implements @p BaseMeshReader::find_next_header.
+     */
+    bool find_next_header(const MeshDataHeader &header, MeshDataHeader &next_header) override;
 
 
     /// Table with data of ElementData headers
     HeaderTable header_table_;
+
+    /// Flag is set if header_table_ is created (table is created lazily, whole file must be read)
+    bool header_table_ready_;
 };
 
 #endif	/* _GMSHMESHREADER_H */
@@ -0,0 +1,337 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    msh_snapshotreader.cc
+ * @brief
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+
+#include "io/msh_snapshotreader.hh"
+#include "mesh/mesh.h"
+#include "mesh/bc_mesh.hh"
+#include "mesh/accessors.hh"
+#include "mesh/bih_tree.hh"
+#include "mesh/node_accessor.hh"
+#include "system/file_path.hh"
+#include "system/logger.hh"
+
+
+namespace {
+
+/// Magic string at the beginning of snapshot.
+const char snapshot_magic[8] = {'F', '1', '2', '3', 'S', 'N', 'A', 'P'};
+
+/// Version of snapshot format, must be increased if format changes.
+const std::uint32_t snapshot_version = 3;
+
+/**
+ * Header of snapshot. Header is followed by arrays (every array is padded to 8 bytes):
+ *  - coordinates of nodes: double[3*n_nodes]
+ *  - node ids: int32[n_nodes]
+ *  - elements: Mesh::TopologyData::ElementData[n_elements], bulk elements are followed by boundary elements
+ *  - node permutation: uint32[n_permuted_nodes]
+ *  - element permutation: uint32[n_bulk_elements]
+ *  - edges: uint32[n_edges+1] offsets to sides, uint32[2*n_edge_sides] sides
+ *  - boundaries: uint32[2*n_boundaries]
+ *  - neighbours: uint32[2*n_neighbours]
+ *  - BIH tree: BIHNode[n_bih_nodes], uint32[n_bulk_elements] element indexes in leaves
+ */
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t optimize_mesh;      ///< Value of 'optimize_mesh' input key the snapshot was created with
+    std::uint64_t source_size;        ///< Size of GMSH file
+    std::int64_t source_mtime;        ///< Modification time of GMSH file in nanoseconds
+    std::uint64_t source_hash;        ///< Hash of content of GMSH file (see set_source_hash)
+    std::uint64_t n_nodes;
+    std::uint64_t n_permuted_nodes;   ///< Number of nodes before removal of unused nodes
+    std::uint64_t n_elements;         ///< Number of bulk and boundary elements
+    std::uint64_t n_bulk_elements;
+    std::uint64_t n_edges;
+    std::uint64_t n_edge_sides;
+    std::uint64_t n_boundaries;
+    std::uint64_t n_neighbours;
+    std::uint64_t n_bih_nodes;
+    std::uint32_t max_edge_sides[4];  ///< Last item is padding
+};
+
+/// Round size up to multiple of 8 bytes.
+inline std::size_t align8(std::size_t size) {
+    return (size + 7) / 8 * 8;
+}
+
+/// Offsets of arrays in snapshot.
+struct SnapshotLayout {
+    SnapshotLayout(const SnapshotHeader &h) {
+        coords = sizeof(SnapshotHeader);
+        node_ids = coords + 3 * h.n_nodes * sizeof(double);
+        elements = node_ids + align8(h.n_nodes * sizeof(std::int32_t));
+        node_permutation = elements + h.n_elements * sizeof(Mesh::TopologyData::ElementData);
+        elem_permutation = node_permutation + align8(h.n_permuted_nodes * sizeof(std::uint32_t));
+        edge_offsets = elem_permutation + align8(h.n_bulk_elements * sizeof(std::uint32_t));
+        edge_sides = edge_offsets + align8((h.n_edges + 1) * sizeof(std::uint32_t));
+        boundaries = edge_sides + 2 * h.n_edge_sides * sizeof(std::uint32_t);
+        neighbours = boundaries + 2 * h.n_boundaries * sizeof(std::uint32_t);
+        bih_nodes = neighbours + 2 * h.n_neighbours * sizeof(std::uint32_t);
+        bih_in_leaves = bih_nodes + align8(h.n_bih_nodes * sizeof(BIHNode));
+        size = bih_in_leaves + align8(h.n_bulk_elements * sizeof(std::uint32_t));
+    }
+
+    std::size_t coords, node_ids, elements, node_permutation, elem_permutation, edge_offsets, edge_sides,
+            boundaries, neighbours, bih_nodes, bih_in_leaves, size;
+};
+
+/// Fill size and modification time of GMSH file to header, return false if file doesn't exist.
+bool set_source_stat(const std::string &source_path, SnapshotHeader &header) {
+    struct stat st;
+    if (stat(source_path.c_str(), &st) != 0) return false;
+    header.source_size = st.st_size;
+    header.source_mtime = std::int64_t(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+/**
+ * Fill hash of content of GMSH file to header, return false if file can't be read.
+ *
+ * FNV-1a is applied to 8-byte blocks of the file (trailing bytes are zero padded), hash is computed only
+ * if modification time of the file doesn't match snapshot (e.g. file is copied).
+ */
+bool set_source_hash(const std::string &source_path, SnapshotHeader &header) {
+    std::ifstream in(source_path, std::ios::binary);
+    if (!in) return false;
+    std::uint64_t hash = 14695981039346656037ull;
+    std::vector<std::uint64_t> buffer(1 << 17);
+    while (in) {
+        in.read(reinterpret_cast<char *>(buffer.data()), buffer.size() * sizeof(std::uint64_t));
+        std::size_t n_read = in.gcount();
+        if (n_read % sizeof(std::uint64_t))
+            std::memset(reinterpret_cast<char *>(buffer.data()) + n_read, 0, sizeof(std::uint64_t) - n_read % sizeof(std::uint64_t));
+        for (std::size_t i = 0; i < align8(n_read) / sizeof(std::uint64_t); ++i) {
+            hash ^= buffer[i];
+            hash *= 1099511628211ull;
+        }
+    }
+    if (!in.eof()) return false;
+    header.source_hash = hash;
+    return true;
+}
+
+/// Write array to stream and pad it to 8 bytes.
+template <class T>
+void write_array(std::ofstream &out, const T *data, std::size_t size) {
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    std::size_t n_bytes = size * sizeof(T);
+    out.write(reinterpret_cast<const char *>(data), n_bytes);
+    out.write(zeros, align8(n_bytes) - n_bytes);
+}
+
+/// Return array of given size stored in snapshot at given offset as vector.
+template <class T>
+std::vector<T> read_array(const char *data, std::size_t offset, std::size_t size) {
+    const T *begin = reinterpret_cast<const T *>(data + offset);
+    return std::vector<T>(begin, begin + size);
+}
+
+} // namespace
+
+
+
+SnapshotMeshReader::SnapshotMeshReader(const FilePath &file_name)
+: GmshMeshReader(file_name),
+  data_(nullptr),
+  data_size_(0)
+{
+    std::string path = snapshot_path(file_name);
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if ( (fd < 0) || (fstat(fd, &st) != 0) || (std::size_t(st.st_size) < sizeof(SnapshotHeader)) ) {
+        if (fd >= 0) close(fd);
+        THROW( ExcMapSnapshot() << EI_MeshFile(path) );
+    }
+    data_size_ = st.st_size;
+    void *ptr = mmap(nullptr, data_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // mapping is kept after closing of file
+    if (ptr == MAP_FAILED) THROW( ExcMapSnapshot() << EI_MeshFile(path) );
+    data_ = static_cast<const char *>(ptr);
+    if ( data_size_ != SnapshotLayout( *reinterpret_cast<const SnapshotHeader *>(data_) ).size )
+        THROW( ExcMapSnapshot() << EI_MeshFile(path) );
+}
+
+
+
+SnapshotMeshReader::~SnapshotMeshReader()
+{
+    if (data_ != nullptr) munmap(const_cast<char *>(data_), data_size_);
+}
+
+
+
+std::string SnapshotMeshReader::snapshot_path(const FilePath &file_name) {
+	return string(file_name) + ".snapshot";
+}
+
+
+
+bool SnapshotMeshReader::is_valid(const FilePath &file_name, bool optimize_mesh) {
+    SnapshotHeader source_info;
+    if ( !set_source_stat(string(file_name), source_info) ) return false;
+
+    std::ifstream in(snapshot_path(file_name), std::ios::binary);
+    SnapshotHeader header;
+    if ( !in.read(reinterpret_cast<char *>(&header), sizeof(SnapshotHeader)) ) return false;
+    in.seekg(0, std::ios::end);
+
+    bool header_match = (std::memcmp(header.magic, snapshot_magic, sizeof(snapshot_magic)) == 0)
+            && (header.version == snapshot_version)
+            && (header.optimize_mesh == std::uint32_t(optimize_mesh))
+            && (header.source_size == source_info.source_size)
+            && (std::size_t(in.tellg()) == SnapshotLayout(header).size);
+    if (!header_match) return false;
+    if (header.source_mtime == source_info.source_mtime) return true;
+
+    // file was touched or copied, content must be compared by hash
+    START_TIMER("SnapshotMeshReader - hash");
+    return set_source_hash(string(file_name), source_info) && (header.source_hash == source_info.source_hash);
+}
+
+
+
+void SnapshotMeshReader::write(const FilePath &file_name, Mesh &mesh, bool optimize_mesh) {
+    START_TIMER("SnapshotMeshReader - write");
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(SnapshotHeader));
+    std::memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+    header.version = snapshot_version;
+    header.optimize_mesh = optimize_mesh;
+    if ( !set_source_stat(string(file_name), header) || !set_source_hash(string(file_name), header) ) return;
+
+    Mesh::TopologyData topology;
+    mesh.get_topology_data(topology);
+    const BIHTree &bih_tree = mesh.get_bih_tree();
+    header.n_nodes = mesh.n_nodes();
+    header.n_elements = topology.elements.size();
+    header.n_bulk_elements = topology.n_bulk_elements;
+    header.n_edges = topology.edge_offsets.size() - 1;
+    header.n_edge_sides = topology.edge_sides.size();
+    header.n_boundaries = topology.boundaries.size();
+    header.n_neighbours = topology.neighbours.size();
+    header.n_bih_nodes = bih_tree.nodes().size();
+    std::copy(topology.max_edge_sides.begin(), topology.max_edge_sides.end(), header.max_edge_sides);
+
+    const std::vector<unsigned int> &node_permutation = mesh.node_permutations();
+    const std::vector<unsigned int> &elem_permutation = mesh.element_permutations();
+    header.n_permuted_nodes = node_permutation.size();
+
+    std::vector<double> coords;
+    std::vector<std::int32_t> node_ids;
+    coords.reserve(3 * header.n_nodes);
+    node_ids.reserve(header.n_nodes);
+    for (auto node : mesh.node_range()) {
+        arma::vec3 point = *node;
+        coords.insert(coords.end(), point.begin(), point.end());
+        node_ids.push_back( mesh.find_node_id(node.idx()) );
+    }
+
+    // write to temporary file, rename is atomic
+    std::string path = snapshot_path(file_name);
+    std::string tmp_path = path + "." + std::to_string(getpid());
+    {
+        std::ofstream out(tmp_path, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(SnapshotHeader));
+        write_array(out, coords.data(), coords.size());
+        write_array(out, node_ids.data(), node_ids.size());
+        write_array(out, topology.elements.data(), topology.elements.size());
+        write_array(out, node_permutation.data(), node_permutation.size());
+        write_array(out, elem_permutation.data(), elem_permutation.size());
+        write_array(out, topology.edge_offsets.data(), topology.edge_offsets.size());
+        write_array(out, topology.edge_sides.data(), topology.edge_sides.size());
+        write_array(out, topology.boundaries.data(), topology.boundaries.size());
+        write_array(out, topology.neighbours.data(), topology.neighbours.size());
+        write_array(out, bih_tree.nodes().data(), bih_tree.nodes().size());
+        write_array(out, bih_tree.in_leaves().data(), bih_tree.in_leaves().size());
+        if (!out.good()) {
+            WarningOut().fmt("Can not write snapshot of mesh file '{}'.\n", string(file_name));
+            out.close();
+            std::remove(tmp_path.c_str());
+            return;
+        }
+    }
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        WarningOut().fmt("Can not write snapshot of mesh file '{}'.\n", string(file_name));
+        boost::filesystem::remove(tmp_path, ec);
+        return;
+    }
+    MessageOut().fmt("Snapshot of mesh written to '{}'.\n", path);
+}
+
+
+
+void SnapshotMeshReader::read_nodes(Mesh * mesh) {
+    MessageOut() << "- Reading nodes from snapshot...";
+    const SnapshotHeader &header = *reinterpret_cast<const SnapshotHeader *>(data_);
+    SnapshotLayout layout(header);
+    const double *coords = reinterpret_cast<const double *>(data_ + layout.coords);
+    const std::int32_t *node_ids = reinterpret_cast<const std::int32_t *>(data_ + layout.node_ids);
+
+    mesh->init_node_vector( header.n_nodes );
+    for (unsigned int i = 0; i < header.n_nodes; ++i) {
+        mesh->add_node(node_ids[i], arma::vec3{ coords[3*i], coords[3*i+1], coords[3*i+2] });
+    }
+    MessageOut().fmt("... {} nodes read. \n", header.n_nodes);
+}
+
+
+
+void SnapshotMeshReader::read_elements(Mesh * mesh) {
+    MessageOut() << "- Reading elements and topology from snapshot...";
+    const SnapshotHeader &header = *reinterpret_cast<const SnapshotHeader *>(data_);
+    SnapshotLayout layout(header);
+
+    Mesh::TopologyData topology;
+    topology.elements = read_array<Mesh::TopologyData::ElementData>(data_, layout.elements, header.n_elements);
+    topology.n_bulk_elements = header.n_bulk_elements;
+    topology.edge_offsets = read_array<std::uint32_t>(data_, layout.edge_offsets, header.n_edges + 1);
+    topology.edge_sides = read_array< std::array<std::uint32_t, 2> >(data_, layout.edge_sides, header.n_edge_sides);
+    topology.boundaries = read_array< std::array<std::uint32_t, 2> >(data_, layout.boundaries, header.n_boundaries);
+    topology.neighbours = read_array< std::array<std::uint32_t, 2> >(data_, layout.neighbours, header.n_neighbours);
+    std::copy(header.max_edge_sides, header.max_edge_sides + 3, topology.max_edge_sides.begin());
+    mesh->set_topology_data(topology);
+
+    // permutations are set always, mesh with topology must not be optimized again
+    mesh->set_optimized_permutations(
+            read_array<unsigned int>(data_, layout.node_permutation, header.n_permuted_nodes),
+            read_array<unsigned int>(data_, layout.elem_permutation, header.n_bulk_elements) );
+
+    // BIH tree of the same elements, only boxes of elements are computed
+    auto bih_tree = std::make_shared<BIHTree>();
+    bih_tree->add_boxes( mesh->get_element_boxes() );
+    bih_tree->set_tree( read_array<BIHNode>(data_, layout.bih_nodes, header.n_bih_nodes),
+            read_array<unsigned int>(data_, layout.bih_in_leaves, header.n_bulk_elements) );
+    mesh->set_bih_tree(bih_tree);
+
+    MessageOut().fmt("... {} bulk elements, {} boundary elements, {} edges. \n", mesh->n_elements(),
+            mesh->bc_mesh()->n_elements(), header.n_edges);
+}
@@ -0,0 +1,89 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    msh_snapshotreader.hh
+ * @brief
+ */
+
+#ifndef MSH_SNAPSHOTREADER_HH
+#define	MSH_SNAPSHOTREADER_HH
+
+
+#include <cstddef>                   // for size_t
+#include <string>                    // for string
+#include "io/msh_gmshreader.h"       // for GmshMeshReader
+#include "system/exceptions.hh"      // for ExcStream, operator<<, EI, TYPED...
+
+class FilePath;
+class Mesh;
+
+
+/**
+ * @brief Reader of binary snapshot of GMSH mesh.
+ *
+ * Snapshot is stored next to the GMSH file (file name with suffix '.snapshot') and holds nodes and elements
+ * of the mesh in order given by MeshOptimizer together with permutation vectors, topology of the mesh (edges,
+ * neighbours, boundaries) and BIH tree of elements, so neither parsing of GMSH file nor optimization and
+ * setup of topology is performed. Snapshot is mapped to memory by mmap and is valid while size and modification
+ * time of GMSH file and the 'optimize_mesh' flag match values stored in snapshot. If only the modification time
+ * differs (e.g. copied file), content of GMSH file is compared by hash.
+ *
+ * Physical names and ElementData sections are read from the GMSH file (see GmshMeshReader), table
+ * of ElementData headers is created only if some data are read.
+ *
+ * Snapshot is used only by BaseMeshReader::mesh_factory if key 'snapshot' of mesh input is set: valid
+ * snapshot is read instead of GMSH file, otherwise snapshot is created. Readers of input data created by
+ * BaseMeshReader::reader_factory always read the GMSH file.
+ */
+class SnapshotMeshReader : public GmshMeshReader {
+public:
+	DECLARE_EXCEPTION(ExcMapSnapshot,
+			<< "Can not map snapshot of the mesh file: " << EI_MeshFile::qval);
+
+    /// Construct reader of snapshot of given GMSH file, snapshot must be valid (see is_valid).
+    SnapshotMeshReader(const FilePath &file_name);
+
+    /// Destructor unmaps snapshot.
+    ~SnapshotMeshReader() override;
+
+    /// Return path to snapshot of given GMSH file.
+    static std::string snapshot_path(const FilePath &file_name);
+
+    /// Return true if snapshot of given GMSH file exists and corresponds to actual content of file and given optimization flag.
+    static bool is_valid(const FilePath &file_name, bool optimize_mesh);
+
+    /**
+     * Write snapshot of given GMSH file.
+     *
+     * Must be called after Mesh::setup_topology and before Mesh::check_and_finish that applies regions
+     * set by input. BIH tree of the mesh is created if it doesn't exist. Snapshot is written to temporary file
+     * and renamed, so concurrent readers see only complete snapshot. Flag @p optimize_mesh is the value
+     * of 'optimize_mesh' input key, snapshot is valid only for the same value.
+     */
+    static void write(const FilePath &file_name, Mesh &mesh, bool optimize_mesh);
+
+protected:
+    /// Read nodes from mapped snapshot.
+    void read_nodes(Mesh * mesh) override;
+
+    /// Read elements and topology from mapped snapshot, set permutations of optimized mesh and BIH tree.
+    void read_elements(Mesh * mesh) override;
+
+    /// Mapped snapshot.
+    const char *data_;
+
+    /// Size of mapped snapshot.
+    std::size_t data_size_;
+};
+
+#endif	/* MSH_SNAPSHOTREADER_HH */
@@ -113,6 +113,9 @@ void VtkMeshReader::read_base_vtk_attributes(pugi::xml_node vtk_node, unsigned i
 		std::string compressor = vtk_node.attribute("compressor").as_string();
 		if (compressor == "vtkZLibDataCompressor")
 			data_format_ = DataFormat::binary_zlib;
+		else if (compressor == "vtkLZ4DataCompressor")
+			THROW( ExcWrongType() << EI_ErrMessage("Unsupported") << EI_SectionTypeName("compressor vtkLZ4DataCompressor")
+					<< EI_VTKFile(tok_.f_name()));
 		else
 			data_format_ = DataFormat::binary_uncompressed;
 	}
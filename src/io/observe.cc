@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <unordered_set>
 #include <queue>
+#include <cstdlib>
 
 #include "system/global_defs.h"
 #include "input/accessors.hh"
@@ -25,6 +26,7 @@
 #include "io/element_data_cache.hh"
 #include "fem/mapping_p1.hh"
 #include "tools/time_governor.hh"
+#include "system/checkpoint.hh"
 
 
 namespace IT = Input::Type;
@@ -376,13 +378,27 @@ Observe::Observe(string observe_name, Mesh &mesh, Input::Array in_array,
     MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
     if (rank_==0) {
         FilePath observe_file_path(observe_name_ + "_observe.yaml", FilePath::output_file);
+        // on restart keep header and values of times before restart
+        std::string restart_content;
+        if (Checkpoint::is_restart()) {
+            double coef = time_unit_conversion_->get_coef();
+            restart_content = Checkpoint::restart_output_content(string(observe_file_path),
+                    [coef](const std::string &line) -> double {
+                        const std::string time_key = "  - time: ";
+                        if (line.compare(0, time_key.size(), time_key) != 0) return numeric_limits<double>::quiet_NaN();
+                        return std::strtod(line.c_str() + time_key.size(), nullptr) * coef;
+                    });
+        }
         try {
             observe_file_path.open_stream(observe_file_);
             //observe_file_.setf(std::ios::scientific);
             observe_file_.precision(this->precision_);
 
         } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, in_array)
-        output_header();
+        if (restart_content.empty())
+            output_header();
+        else
+            observe_file_ << restart_content;
     }
 
     // Create vector of observe data on patch
@@ -475,6 +491,12 @@ void Observe::output_time_frame(bool flush) {
         ASSERT(observe_field_values_.size() == 0);
         return;        
     }
+
+    if (Checkpoint::before_restart(observe_values_time_[observe_time_idx_] * time_unit_conversion_->get_coef())) {
+        // values were written before restart, the slot is reused by the next time frame
+        observe_values_time_[observe_time_idx_] = numeric_limits<double>::signaling_NaN();
+        return;
+    }
     
     observe_time_idx_++;
     if ( (observe_time_idx_==Observe::max_observe_value_time) || flush ) {
@@ -485,6 +507,12 @@ void Observe::output_time_frame(bool flush) {
 
 }
 
+void Observe::flush() {
+    if (points_.size() == 0) return;
+    flush_values();
+    if (rank_ == 0) observe_file_.flush();
+}
+
 Range<ObservePointAccessor> Observe::local_range() const {
 	auto bgn_it = make_iter<ObservePointAccessor>( ObservePointAccessor(this, 0) );
 	auto end_it = make_iter<ObservePointAccessor>( ObservePointAccessor(this, point_4_loc_.size()) );
@@ -264,6 +264,12 @@ public:
      */
     void output_time_frame(bool flush);
 
+    /**
+     * Write all stored values to the output file and flush the file. Collective operation,
+     * used before a checkpoint is written.
+     */
+    void flush();
+
     /**
      * Return \p points_ vector
      */
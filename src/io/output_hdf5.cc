@@ -0,0 +1,369 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    output_hdf5.cc
+ * @brief   Parallel output to HDF5 file with XDMF descriptor.
+ */
+
+#include "config.h"
+
+#ifdef FLOW123D_HAVE_HDF5
+
+#include <cmath>
+#include <fstream>
+#include <utility>
+#include <hdf5.h>
+
+#include "output_hdf5.hh"
+#include "element_data_cache.hh"
+#include "output_mesh.hh"
+#include "input/factory.hh"
+#include "system/file_path.hh"
+#include "system/logger.hh"
+#include "tools/time_governor.hh"
+
+
+FLOW123D_FORCE_LINK_IN_CHILD(hdf5)
+
+
+using namespace Input::Type;
+
+const Record & OutputHDF5::get_input_type() {
+	return Record("hdf5", "Parameters of HDF5 output format. All processes write to single HDF5 file, "
+	        "the file is described by XDMF file that can be opened by Paraview.")
+		// It is derived from abstract class
+		.derive_from(OutputTime::get_input_format_type())
+		.close();
+}
+
+
+const int OutputHDF5::registrar = Input::register_class< OutputHDF5 >("hdf5") +
+		OutputHDF5::get_input_type().size();
+
+
+namespace {
+
+/// Return offset of local block of given size and global size of all blocks, collective.
+void global_block(unsigned long n_local, unsigned long &offset, unsigned long &n_global) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    offset = 0;
+    MPI_Exscan(&n_local, &offset, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    if (rank == 0) offset = 0; // result of Exscan is undefined on the first process
+    MPI_Allreduce(&n_local, &n_global, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+}
+
+/// Return native HDF5 type corresponding to type of output data.
+hid_t h5_type(ElementDataCacheBase::VTKValueType type) {
+    switch (type) {
+        case ElementDataCacheBase::VTK_INT8:    return H5T_NATIVE_INT8;
+        case ElementDataCacheBase::VTK_UINT8:   return H5T_NATIVE_UINT8;
+        case ElementDataCacheBase::VTK_INT16:   return H5T_NATIVE_INT16;
+        case ElementDataCacheBase::VTK_UINT16:  return H5T_NATIVE_UINT16;
+        case ElementDataCacheBase::VTK_INT32:   return H5T_NATIVE_INT32;
+        case ElementDataCacheBase::VTK_UINT32:  return H5T_NATIVE_UINT32;
+        case ElementDataCacheBase::VTK_FLOAT32: return H5T_NATIVE_FLOAT;
+        case ElementDataCacheBase::VTK_FLOAT64: return H5T_NATIVE_DOUBLE;
+    }
+    ASSERT_PERMANENT(false).error("Should not happen.");
+    return H5T_NATIVE_DOUBLE;
+}
+
+/// Return attributes 'NumberType' and 'Precision' of XDMF DataItem corresponding to type of output data.
+std::string xdmf_number_type(ElementDataCacheBase::VTKValueType type) {
+    switch (type) {
+        case ElementDataCacheBase::VTK_INT8:    return "NumberType=\"Char\" Precision=\"1\"";
+        case ElementDataCacheBase::VTK_UINT8:   return "NumberType=\"UChar\" Precision=\"1\"";
+        case ElementDataCacheBase::VTK_INT16:   return "NumberType=\"Int\" Precision=\"2\"";
+        case ElementDataCacheBase::VTK_UINT16:  return "NumberType=\"UInt\" Precision=\"2\"";
+        case ElementDataCacheBase::VTK_INT32:   return "NumberType=\"Int\" Precision=\"4\"";
+        case ElementDataCacheBase::VTK_UINT32:  return "NumberType=\"UInt\" Precision=\"4\"";
+        case ElementDataCacheBase::VTK_FLOAT32: return "NumberType=\"Float\" Precision=\"4\"";
+        case ElementDataCacheBase::VTK_FLOAT64: return "NumberType=\"Float\" Precision=\"8\"";
+    }
+    ASSERT_PERMANENT(false).error("Should not happen.");
+    return "";
+}
+
+/// Return XDMF attribute type given by number of components.
+std::string xdmf_attribute_type(unsigned int n_comp) {
+    switch (n_comp) {
+        case ElementDataCacheBase::N_SCALAR: return "Scalar";
+        case ElementDataCacheBase::N_VECTOR: return "Vector";
+        case ElementDataCacheBase::N_TENSOR: return "Tensor";
+        default:                             return "Matrix";
+    }
+}
+
+/// XDMF mixed topology codes of elements given by number of nodes (0D and 1D elements need number of nodes).
+const std::vector< std::vector<unsigned int> > xdmf_element_types = { {}, {0x1, 1}, {0x2, 2}, {0x4}, {0x6} };
+
+} // namespace
+
+
+
+OutputHDF5::OutputHDF5()
+: mesh_written_(false),
+  node_offset_(0), n_global_nodes_(0),
+  elem_offset_(0), n_global_elements_(0),
+  n_global_topology_(0)
+{
+    this->enable_refinement_ = false;
+}
+
+
+
+OutputHDF5::~OutputHDF5()
+{
+	// Perform output of last time step
+	this->finish_in_destructor();
+}
+
+
+
+void OutputHDF5::init_from_input(const std::string &equation_name,
+                                 const Input::Record &in_rec,
+                                 const std::shared_ptr<TimeUnitConversion>& time_unit_conv)
+{
+	OutputTime::init_from_input(equation_name, in_rec, time_unit_conv);
+
+	// every process writes its own part of data
+	this->parallel_ = true;
+	if (this->async_write_) {
+		if (this->rank_ == 0)
+			WarningOut() << "Asynchronous writing is not supported by HDF5 output: " << this->_base_filename;
+		this->async_write_ = false;
+	}
+
+    this->fix_main_file_extension(".xdmf");
+    h5_filename_ = FilePath({this->_base_filename.parent_path(), this->_base_filename.stem() + ".h5"},
+                            FilePath::output_file);
+
+    if (this->rank_ == 0) {
+        hid_t file = H5Fcreate(string(h5_filename_).c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+        if (file < 0) THROW( ExcHDF5Error() << EI_HDF5File(string(h5_filename_)) << EI_HDF5Object("/") );
+        H5Fclose(file);
+        LogOut() << "Writing flow output file: " << h5_filename_ << " ... ";
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+
+
+int OutputHDF5::write_frame(void)
+{
+    ASSERT_PTR(this->nodes_).error();
+
+    if (!mesh_written_) this->write_mesh();
+
+    LogOut() << __func__ << ": Writing output (frame: " << this->frame_step_
+             << ", rank: " << this->rank_
+             << ") file: " << h5_filename_ << " ... ";
+
+    double corrected_time = (std::isfinite(this->frame_time_)?this->frame_time_:0);
+    corrected_time /= this->time_unit_converter->get_coef();
+    std::string group = fmt::format("/Step_{:06d}", this->frame_step_);
+    std::string h5_file = h5_filename_.filename();
+
+    std::vector<DatasetBlock> blocks;
+    std::stringstream grid;
+    grid.precision(this->precision_);
+    grid << "<Grid Name=\"" << group.substr(1) << "\" GridType=\"Uniform\">\n";
+    grid << "<Time Value=\"" << corrected_time << "\"/>\n";
+    grid << "<Topology TopologyType=\"Mixed\" NumberOfElements=\"" << n_global_elements_ << "\">\n"
+         << "<DataItem Dimensions=\"" << n_global_topology_ << "\" "
+         << xdmf_number_type(ElementDataCacheBase::VTK_UINT32) << " Format=\"HDF\">"
+         << h5_file << ":/Mesh/Topology</DataItem>\n</Topology>\n";
+    grid << "<Geometry GeometryType=\"XYZ\">\n"
+         << "<DataItem Dimensions=\"" << n_global_nodes_ << " " << (unsigned int)ElementDataCacheBase::N_VECTOR << "\" "
+         << xdmf_number_type(ElementDataCacheBase::VTK_FLOAT64) << " Format=\"HDF\">"
+         << h5_file << ":/Mesh/Nodes</DataItem>\n</Geometry>\n";
+
+    for (auto &output_data : this->frame_data_vec_[NODE_DATA])
+        this->add_field_data(output_data, group, "Node", blocks, grid);
+    for (auto &output_data : this->frame_data_vec_[CORNER_DATA])
+        this->add_field_data(output_data, group, "Node", blocks, grid);
+    for (auto &output_data : this->frame_data_vec_[ELEM_DATA])
+        this->add_field_data(output_data, group, "Cell", blocks, grid);
+    grid << "</Grid>\n";
+
+    this->write_blocks({group}, blocks);
+
+    if (this->rank_ == 0) {
+        xdmf_grids_.push_back(grid.str());
+        this->write_xdmf();
+    }
+
+    LogOut() << "O.K.";
+
+    return 1;
+}
+
+
+
+void OutputHDF5::add_field_data(OutputDataPtr output_data, const std::string &group, const std::string &center,
+        std::vector<DatasetBlock> &blocks, std::stringstream &grid)
+{
+    if (output_data->is_dummy()) return;
+
+    bool node_data = (center == "Node");
+    unsigned long n_local = node_data ? this->nodes_->n_values() : this->offsets_->n_values()-1;
+    ASSERT_EQ(output_data->n_values(), n_local)(output_data->field_input_name()).error("Unexpected size of output data.\n");
+
+    DatasetBlock block;
+    block.name = group + "/" + output_data->field_input_name();
+    block.type = output_data->vtk_type();
+    block.data = output_data->binary_data().first;
+    block.n_rows = n_local;
+    block.offset = node_data ? node_offset_ : elem_offset_;
+    block.n_global = node_data ? n_global_nodes_ : n_global_elements_;
+    block.n_cols = output_data->n_comp();
+    blocks.push_back(block);
+
+    grid << "<Attribute Name=\"" << output_data->field_input_name() << "\" AttributeType=\""
+         << xdmf_attribute_type(block.n_cols) << "\" Center=\"" << center << "\">\n"
+         << "<DataItem Dimensions=\"" << block.n_global << " " << block.n_cols << "\" "
+         << xdmf_number_type(block.type) << " Format=\"HDF\">"
+         << h5_filename_.filename() << ":" << block.name << "</DataItem>\n</Attribute>\n";
+}
+
+
+
+void OutputHDF5::write_mesh()
+{
+    auto &offset_vec = *( this->offsets_->get_data().get() );
+    auto &conn_vec = *( this->connectivity_->get_data().get() );
+    unsigned long n_local_nodes = this->nodes_->n_values();
+    unsigned long n_local_elements = this->offsets_->n_values()-1;
+    global_block(n_local_nodes, node_offset_, n_global_nodes_);
+    global_block(n_local_elements, elem_offset_, n_global_elements_);
+
+    // mixed topology: type code (and number of nodes for 0D, 1D elements) followed by global node indices
+    std::vector<unsigned int> topology;
+    topology.reserve(conn_vec.size() + 2*n_local_elements);
+    for (unsigned int i_elm=0; i_elm<n_local_elements; ++i_elm) {
+        unsigned int n_nodes = offset_vec[i_elm+1] - offset_vec[i_elm];
+        ASSERT_LT(n_nodes, xdmf_element_types.size()).error("Unsupported type of element.\n");
+        topology.insert(topology.end(), xdmf_element_types[n_nodes].begin(), xdmf_element_types[n_nodes].end());
+        for (unsigned int i=offset_vec[i_elm]; i<offset_vec[i_elm+1]; ++i)
+            topology.push_back(conn_vec[i] + node_offset_);
+    }
+    unsigned long topology_offset;
+    global_block(topology.size(), topology_offset, n_global_topology_);
+
+    std::vector<DatasetBlock> blocks(2);
+    blocks[0] = { "/Mesh/Nodes", ElementDataCacheBase::VTK_FLOAT64, this->nodes_->binary_data().first,
+                  n_local_nodes, node_offset_, n_global_nodes_, (unsigned int)ElementDataCacheBase::N_VECTOR };
+    blocks[1] = { "/Mesh/Topology", ElementDataCacheBase::VTK_UINT32, topology.data(),
+                  topology.size(), topology_offset, n_global_topology_, 1 };
+    this->write_blocks({"/Mesh"}, blocks);
+
+    mesh_written_ = true;
+}
+
+
+
+void OutputHDF5::write_blocks(const std::vector<std::string> &groups, const std::vector<DatasetBlock> &blocks)
+{
+    std::string file_name = string(h5_filename_);
+    auto check = [&file_name](hid_t ret, const std::string &object) {
+        if (ret < 0) THROW( ExcHDF5Error() << EI_HDF5File(file_name) << EI_HDF5Object(object) );
+        return ret;
+    };
+    auto open_file = [&check, &file_name](hid_t fapl) {
+        return check( H5Fopen(file_name.c_str(), H5F_ACC_RDWR, fapl), "/" );
+    };
+    auto create_objects = [&check, &groups, &blocks](hid_t file) {
+        for (auto &group : groups)
+            H5Gclose( check( H5Gcreate2(file, group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), group ) );
+        for (auto &block : blocks) {
+            hsize_t dims[2] = {block.n_global, block.n_cols};
+            hid_t space = H5Screate_simple(2, dims, NULL);
+            hid_t dset = check( H5Dcreate2(file, block.name.c_str(), h5_type(block.type), space,
+                    H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), block.name );
+            H5Dclose(dset);
+            H5Sclose(space);
+        }
+    };
+    auto write_block = [&check](hid_t file, const DatasetBlock &block, hid_t dxpl) {
+        hid_t dset = check( H5Dopen2(file, block.name.c_str(), H5P_DEFAULT), block.name );
+        hid_t file_space = H5Dget_space(dset);
+        hsize_t start[2] = {block.offset, 0};
+        hsize_t count[2] = {block.n_rows, block.n_cols};
+        hsize_t one_row[2] = {1, block.n_cols};
+        hid_t mem_space;
+        if (block.n_rows > 0) {
+            H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+            mem_space = H5Screate_simple(2, count, NULL);
+        } else {
+            // empty block, process must take part in collective write
+            H5Sselect_none(file_space);
+            mem_space = H5Screate_simple(2, one_row, NULL);
+            H5Sselect_none(mem_space);
+        }
+        herr_t ret = H5Dwrite(dset, h5_type(block.type), mem_space, file_space, dxpl, block.data);
+        H5Sclose(mem_space);
+        H5Sclose(file_space);
+        H5Dclose(dset);
+        check(ret, block.name);
+    };
+
+#ifdef H5_HAVE_PARALLEL
+    // collective creation of objects and collective write
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
+    hid_t file = open_file(fapl);
+    H5Pclose(fapl);
+    create_objects(file);
+    hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+    for (auto &block : blocks) write_block(file, block, dxpl);
+    H5Pclose(dxpl);
+    H5Fclose(file);
+#else
+    // serial HDF5 library: objects are created by the first process, processes write their blocks in turns
+    if (this->rank_ == 0) {
+        hid_t file = open_file(H5P_DEFAULT);
+        create_objects(file);
+        H5Fclose(file);
+    }
+    for (int i_rank=0; i_rank<this->n_proc_; ++i_rank) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (i_rank != this->rank_) continue;
+        hid_t file = open_file(H5P_DEFAULT);
+        for (auto &block : blocks)
+            if (block.n_rows > 0) write_block(file, block, H5P_DEFAULT);
+        H5Fclose(file);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif // H5_HAVE_PARALLEL
+}
+
+
+
+void OutputHDF5::write_xdmf()
+{
+    // file is rewritten, so it is valid after every time frame
+    try {
+        this->_base_filename.open_stream( this->_base_file );
+    } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, input_record_)
+
+    this->_base_file << "<?xml version=\"1.0\" ?>\n";
+    this->_base_file << "<Xdmf Version=\"3.0\">\n<Domain>\n";
+    this->_base_file << "<Grid Name=\"" << this->equation_name_ << "\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+    for (auto &grid : xdmf_grids_) this->_base_file << grid;
+    this->_base_file << "</Grid>\n</Domain>\n</Xdmf>\n";
+    this->_base_file.close();
+}
+
+#endif // FLOW123D_HAVE_HDF5
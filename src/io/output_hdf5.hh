@@ -0,0 +1,154 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    output_hdf5.hh
+ * @brief   Header: Parallel output to HDF5 file with XDMF descriptor.
+ */
+
+#ifndef OUTPUT_HDF5_HH_
+#define OUTPUT_HDF5_HH_
+
+#include <memory>                      // for shared_ptr
+#include <sstream>                     // for stringstream
+#include <string>                      // for string
+#include <vector>                      // for vector
+#include "output_time.hh"              // for OutputTime, OutputTime::OutputDataFieldVec
+#include "element_data_cache_base.hh"  // for ElementDataCacheBase::VTKValueType
+#include "system/exceptions.hh"
+
+class TimeUnitConversion;
+namespace Input {
+	class Record;
+	namespace Type {
+		class Record;
+	}
+}
+
+
+/**
+ * \brief This class is used for output data to single HDF5 file described by XDMF file.
+ *
+ * All processes write their local part of the output mesh and data (no gather to the first process)
+ * into one HDF5 file '<base name>.h5':
+ *  - group '/Mesh' with datasets 'Nodes' and 'Topology' (XDMF mixed topology with global node indices)
+ *    is written once with the first time frame,
+ *  - every time frame is written to group '/Step_<frame>' with one dataset per output field.
+ *
+ * Main file '<base name>.xdmf' describes the HDF5 file as a temporal collection of grids and can be
+ * opened by Paraview. It is written by the first process and rewritten after every time frame.
+ *
+ * If HDF5 library supports MPI-IO, datasets are written collectively, otherwise processes write
+ * their blocks in turns. Native data are not written.
+ */
+class OutputHDF5 : public OutputTime {
+
+public:
+	typedef OutputTime FactoryBaseType;
+
+	TYPEDEF_ERR_INFO(EI_HDF5File, std::string);
+	TYPEDEF_ERR_INFO(EI_HDF5Object, std::string);
+	DECLARE_EXCEPTION(ExcHDF5Error,
+			<< "Can not write object " << EI_HDF5Object::qval << " to HDF5 file " << EI_HDF5File::qval << ".\n");
+
+    /**
+     * \brief The constructor of this class.
+     */
+    OutputHDF5();
+
+    /**
+     * \brief The destructor of this class. It writes last time frame.
+     */
+    ~OutputHDF5();
+
+    /**
+     * \brief The definition of input record for hdf5 file format
+     */
+    static const Input::Type::Record & get_input_type();
+
+    /**
+     * \brief Override @p OutputTime::init_from_input.
+     *
+     * Creates HDF5 file. Asynchronous writing is disabled, because write of time frame
+     * is collective and MPI calls can't be performed in I/O thread.
+     */
+    void init_from_input(const std::string &equation_name,
+                         const Input::Record &in_rec,
+                         const std::shared_ptr<TimeUnitConversion>& time_unit_conv) override;
+
+    /**
+     * \brief Write data of time frame to HDF5 file and rewrite XDMF file
+     */
+    int write_frame(void) override;
+
+protected:
+
+    /// Block of one process in dataset with global number of rows.
+    struct DatasetBlock {
+        std::string name;       ///< Full path of dataset in HDF5 file
+        ElementDataCacheBase::VTKValueType type; ///< Type of data
+        const void *data;       ///< Local data
+        unsigned long n_rows;   ///< Local number of rows
+        unsigned long offset;   ///< First global row of local data
+        unsigned long n_global; ///< Global number of rows
+        unsigned int n_cols;    ///< Number of columns
+    };
+
+    /**
+     * \brief Write nodes and topology of output mesh to group '/Mesh', compute offsets of local blocks.
+     */
+    void write_mesh();
+
+    /**
+     * \brief Write all given blocks to HDF5 file, collective.
+     *
+     * Groups in @p groups are created before datasets.
+     */
+    void write_blocks(const std::vector<std::string> &groups, const std::vector<DatasetBlock> &blocks);
+
+    /**
+     * \brief Add dataset of given output data to @p blocks and its description to @p grid
+     *
+     * @param center  XDMF center of data: 'Node' or 'Cell'
+     */
+    void add_field_data(OutputDataPtr output_data, const std::string &group, const std::string &center,
+            std::vector<DatasetBlock> &blocks, std::stringstream &grid);
+
+    /**
+     * \brief Rewrite XDMF file (only the first process).
+     */
+    void write_xdmf();
+
+    /// Name of HDF5 file.
+    FilePath h5_filename_;
+
+    /// Flag set after mesh is written.
+    bool mesh_written_;
+
+    /// Offset of local nodes and global number of nodes.
+    unsigned long node_offset_, n_global_nodes_;
+
+    /// Offset of local elements and global number of elements.
+    unsigned long elem_offset_, n_global_elements_;
+
+    /// Global size of topology dataset.
+    unsigned long n_global_topology_;
+
+    /// XDMF descriptions of written time frames (used only on the first process).
+    std::vector<std::string> xdmf_grids_;
+
+    /// Registrar of class to factory
+    static const int registrar;
+
+};
+
+#endif /* OUTPUT_HDF5_HH_ */
@@ -313,6 +313,9 @@ std::shared_ptr<ElementDataCache<double>> OutputMesh::make_serial_nodes_cache(FM
 {
 	std::shared_ptr<ElementDataCache<double>> serial_nodes_cache;
 
+    // node_4_loc_ holds indices of nodes in local part of distributed mesh, not global indices
+    if (orig_mesh_->is_distributed()) THROW( ExcSerialDistributedMesh() );
+
     // collects nodes_ data (coordinates)
     auto serial_nodes = nodes_->gather(node_ds_, node_4_loc_);
 
@@ -252,6 +252,9 @@ protected:
 class OutputMesh : public OutputMeshBase
 {
 public:
+    DECLARE_EXCEPTION(ExcSerialDistributedMesh,
+            << "Serial output of continuous mesh is not supported for distributed mesh, use parallel VTK output.\n");
+
     OutputMesh(Mesh &mesh);
     OutputMesh(Mesh &mesh, const Input::Record &in_rec);
     ~OutputMesh();
@@ -54,7 +54,7 @@ OutputMSH::OutputMSH()
 OutputMSH::~OutputMSH()
 {
 	// Perform output of last time step
-	this->write_time_frame();
+	this->finish_in_destructor();
 
 	this->write_tail();
 }
@@ -165,7 +165,7 @@ void OutputMSH::write_msh_ascii_data(std::shared_ptr<ElementDataCache<unsigned i
 void OutputMSH::write_node_data(OutputDataPtr output_data)
 {
     ofstream &file = this->_base_file;
-    double time_fixed = isfinite(this->registered_time_)?this->registered_time_:0;
+    double time_fixed = isfinite(this->frame_time_)?this->frame_time_:0;
     time_fixed /= this->time_unit_converter->get_coef();
 
     file << "$NodeData" << endl;
@@ -177,7 +177,7 @@ void OutputMSH::write_node_data(OutputDataPtr output_data)
     file << time_fixed << endl;    // first real tag = time
 
     file << "3" << endl;     // 3 integer tags
-    file << this->current_step << endl;    // step number (start = 0)
+    file << this->frame_step_ << endl;    // step number (start = 0)
     file << output_data->n_comp() << endl;   // number of components
     file << output_data->n_values() << endl;  // number of values
 
@@ -191,7 +191,7 @@ void OutputMSH::write_node_data(OutputDataPtr output_data)
 void OutputMSH::write_corner_data(OutputDataPtr output_data)
 {
     ofstream &file = this->_base_file;
-    double time_fixed = isfinite(this->registered_time_)?this->registered_time_:0;
+    double time_fixed = isfinite(this->frame_time_)?this->frame_time_:0;
 
     file << "$ElementNodeData" << endl;
 
@@ -199,10 +199,10 @@ void OutputMSH::write_corner_data(OutputDataPtr output_data)
     file << "\"" << output_data->field_input_name() <<"\"" << endl;
 
     file << "1" << endl;     // one real tag
-    file << time_fixed << endl;    // first real tag = registered_time_
+    file << time_fixed << endl;    // first real tag = frame_time_
 
     file << "3" << endl;     // 3 integer tags
-    file << this->current_step << endl;    // step number (start = 0)
+    file << this->frame_step_ << endl;    // step number (start = 0)
     file << output_data->n_comp() << endl;   // number of components
     file << this->offsets_->n_values()-1 << endl; // number of values
 
@@ -227,7 +227,7 @@ void OutputMSH::write_corner_data(OutputDataPtr output_data)
 void OutputMSH::write_elem_data(OutputDataPtr output_data)
 {
     ofstream &file = this->_base_file;
-    double time_fixed = isfinite(this->registered_time_)?this->registered_time_:0;
+    double time_fixed = isfinite(this->frame_time_)?this->frame_time_:0;
 
     file << "$ElementData" << endl;
 
@@ -235,10 +235,10 @@ void OutputMSH::write_elem_data(OutputDataPtr output_data)
     file << "\"" << output_data->field_input_name() <<"\"" << endl;
 
     file << "1" << endl;     // one real tag
-    file << time_fixed << endl;    // first real tag = registered_time_
+    file << time_fixed << endl;    // first real tag = frame_time_
 
     file << "3" << endl;     // 3 integer tags
-    file << this->current_step << endl;    // step number (start = 0)
+    file << this->frame_step_ << endl;    // step number (start = 0)
     file << output_data->n_comp() << endl;   // number of components
     file << output_data->n_values() << endl;  // number of values
 
@@ -263,7 +263,7 @@ int OutputMSH::write_head(void)
     return 1;
 }
 
-int OutputMSH::write_data(void)
+int OutputMSH::write_frame(void)
 {
     /* Output of serial format is implemented only in the first process */
     if (this->rank_ != 0) {
@@ -285,15 +285,15 @@ int OutputMSH::write_data(void)
     LogOut() << __func__ << ": Writing output file " << this->_base_filename << " ... ";
 
 
-    auto &node_data_list = this->output_data_vec_[NODE_DATA];
+    auto &node_data_list = this->frame_data_vec_[NODE_DATA];
     for(auto data_it = node_data_list.begin(); data_it != node_data_list.end(); ++data_it) {
     	write_node_data(*data_it);
     }
-    auto &corner_data_list = this->output_data_vec_[CORNER_DATA];
+    auto &corner_data_list = this->frame_data_vec_[CORNER_DATA];
     for(auto data_it = corner_data_list.begin(); data_it != corner_data_list.end(); ++data_it) {
     	write_corner_data(*data_it);
     }
-    auto &elem_data_list = this->output_data_vec_[ELEM_DATA];
+    auto &elem_data_list = this->frame_data_vec_[ELEM_DATA];
     for(auto data_it = elem_data_list.begin(); data_it != elem_data_list.end(); ++data_it) {
     	write_elem_data(*data_it);
     }
@@ -33,7 +33,7 @@ public:
 
     /**
      * \brief The constructor of this class.
-     * We open the output file in first call of write_data
+     * We open the output file in first call of write_frame
      */
     OutputMSH();
 
@@ -55,11 +55,11 @@ public:
     int write_head(void);
 
     /**
-     * \brief This method writes data to GMSH (.msh) file format for current time
+     * \brief This method writes data of time frame to GMSH (.msh) file format
      *
      * \return      This function returns 1
      */
-    int write_data(void);
+    int write_frame(void) override;
 
     /**
      * \brief This method should write tail of GMSH (.msh) file format
@@ -26,11 +26,15 @@
 #include "output_mesh.hh"
 #include "io/output_time_set.hh"
 #include "io/observe.hh"
+#include "system/checkpoint.hh"
 #include "tools/time_governor.hh"
 
 
 FLOW123D_FORCE_LINK_IN_PARENT(vtk)
 FLOW123D_FORCE_LINK_IN_PARENT(gmsh)
+#ifdef FLOW123D_HAVE_HDF5
+FLOW123D_FORCE_LINK_IN_PARENT(hdf5)
+#endif // FLOW123D_HAVE_HDF5
 
 
 namespace IT = Input::Type;
@@ -56,6 +60,9 @@ const IT::Record & OutputTime::get_input_type() {
         .declare_key("precision", IT::Integer(0), IT::Default(default_prec.str()),
                 "The number of decimal digits used in output of floating point values.\n"
                 "Default is 17 decimal digits which are necessary to reproduce double values exactly after write-read cycle.")
+        .declare_key("async_write", IT::Bool(), IT::Default("false"),
+                "Write time frames asynchronously in separate I/O thread. Computation of next time frame overlaps "
+                "with formatting and writing of previous one, at most one time frame is written at a time.")
         .declare_key("observe_points", IT::Array(ObservePoint::get_input_type()), IT::Default("[]"),
                 "Array of observe points.")
 		.close();
@@ -73,7 +80,10 @@ OutputTime::OutputTime()
 : current_step(0),
   registered_time_(-1.0),
   write_time(-1.0),
-  parallel_(false)
+  parallel_(false),
+  frame_time_(-1.0),
+  frame_step_(0),
+  async_write_(false)
 {
     MPI_Comm_rank(MPI_COMM_WORLD, &this->rank_);
     MPI_Comm_size(MPI_COMM_WORLD, &this->n_proc_);
@@ -95,6 +105,7 @@ void OutputTime::init_from_input(const std::string &equation_name,
     FilePath output_file_path(equation_name+"_fields", FilePath::output_file);
     input_record_.opt_val("file", output_file_path);
     this->precision_ = input_record_.val<int>("precision");
+    this->async_write_ = input_record_.val<bool>("async_write");
     this->_base_filename = output_file_path;
 }
 
@@ -114,6 +125,11 @@ OutputTime::~OutputTime(void)
      //    return;
     // }
 
+    try {
+        this->wait_for_frame();
+    } catch (std::exception &e) {
+        WarningOut() << "Writing of time frame to output stream '" << this->_base_filename << "' failed:\n" << e.what();
+    }
     if (this->_base_file.is_open()) this->_base_file.close();
 
     LogOut() << "O.K.";
@@ -192,11 +208,31 @@ std::shared_ptr<OutputTime> OutputTime::create_output_stream(const std::string &
     Input::AbstractRecord format = Input::Record(in_rec).val<Input::AbstractRecord>("format");
     std::shared_ptr<OutputTime> output_time = format.factory< OutputTime >();
     output_time->init_from_input(equation_name, in_rec, time_unit_conv);
+    if (Checkpoint::is_restart() && !std::dynamic_pointer_cast<OutputVTK>(output_time))
+        WarningOut() << "Output stream " << output_time->_base_filename
+                     << " is not continued on restart, it contains only time frames after the restart time.\n";
 
+    output_streams_.push_back(output_time);
     return output_time;
 }
 
 
+std::vector< std::weak_ptr<OutputTime> > OutputTime::output_streams_;
+
+
+void OutputTime::flush_all()
+{
+    START_TIMER("OutputTime::flush_all");
+    for (auto &weak_stream : output_streams_) {
+        std::shared_ptr<OutputTime> stream = weak_stream.lock();
+        if (!stream) continue;
+        stream->wait_for_frame();
+        if (stream->observe_) stream->observe_->flush();
+        if (stream->_base_file.is_open()) stream->_base_file.flush();
+    }
+}
+
+
 
 
 
@@ -206,14 +242,29 @@ void OutputTime::write_time_frame()
     if (observe_)
         observe_->output_time_frame( write_time < registered_time_ );
 
+    if (write_time < registered_time_ && Checkpoint::before_restart(registered_time_)) {
+        // time frame was written by the simulation before restart
+        write_time = registered_time_;
+        clear_data();
+        return;
+    }
+
     // Write data to output stream, when data registered to this output
     // streams were changed
     if(write_time < registered_time_) {
+        // back-pressure, previous frame must be written before next one (also file name can be changed by writer)
+        this->wait_for_frame();
 
     	if (this->rank_ == 0 || this->parallel_) // for serial output write log only one (same output file on all processes)
     	    LogOut() << "Write output to output stream: " << this->_base_filename << " for time: " << registered_time_;
     	gather_output_data();
-        write_data();
+    	this->snapshot_frame();
+    	if (async_write_) {
+    	    if (!writer_) writer_ = std::make_unique<ThreadPool>(1);
+    	    pending_frame_ = writer_->submit( [this]() { this->write_frame(); } );
+    	} else {
+    	    this->write_frame();
+    	}
         // Remember the last time of writing to output stream
         write_time = registered_time_;
         current_step++;
@@ -231,6 +282,48 @@ void OutputTime::write_time_frame()
     clear_data();
 }
 
+int OutputTime::write_data(void)
+{
+    this->snapshot_frame();
+    return this->write_frame();
+}
+
+
+void OutputTime::wait_for_frame()
+{
+    if (pending_frame_.valid()) {
+        START_TIMER("OutputTime::wait_for_frame");
+        pending_frame_.get();
+    }
+}
+
+
+void OutputTime::finish()
+{
+    this->write_time_frame();
+    this->wait_for_frame();
+}
+
+
+void OutputTime::finish_in_destructor()
+{
+    try {
+        this->finish();
+    } catch (std::exception &e) {
+        WarningOut() << "Writing of time frame to output stream '" << this->_base_filename << "' failed:\n" << e.what();
+    }
+}
+
+
+void OutputTime::snapshot_frame()
+{
+    for (unsigned int i=0; i<N_DISCRETE_SPACES; ++i)
+        frame_data_vec_[i] = output_data_vec_[i];
+    frame_time_ = registered_time_;
+    frame_step_ = current_step;
+}
+
+
 std::shared_ptr<Observe> OutputTime::observe(Mesh *mesh)
 {
     // create observe object at first call
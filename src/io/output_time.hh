@@ -19,11 +19,13 @@
 #define OUTPUT_TIME_HH_
 
 #include <fstream>              // for ofstream
-#include <memory>               // for shared_ptr
+#include <future>               // for future
+#include <memory>               // for shared_ptr, unique_ptr
 #include <string>               // for string, allocator
 #include <vector>               // for vector
 #include "input/accessors.hh"   // for Iterator, Array (ptr only), Record
 #include "system/file_path.hh"  // for FilePath
+#include "tools/thread_pool.hh" // for ThreadPool
 
 class ElementDataCacheBase;
 class Mesh;
@@ -164,9 +166,19 @@ public:
     
     /**
      * Write all data registered as a new time frame.
+     *
+     * In the case of restart from a checkpoint, time frames not later than the restart time
+     * are skipped, since they were written before restart.
      */
     void write_time_frame();
 
+    /**
+     * Finish writing of all existing output streams (asynchronously written time frames,
+     * observe values and main files). Called before a checkpoint is written, so the output files
+     * are consistent with the checkpoint.
+     */
+    static void flush_all();
+
     /**
      * Getter of the observe object.
      */
@@ -251,6 +263,28 @@ public:
     	return registered_time_;
     }
 
+    /**
+     * \brief Write actual registered data to output file.
+     *
+     * Takes snapshot of registered data (see \p snapshot_frame) and writes it synchronously by \p write_frame.
+     */
+    int write_data(void);
+
+    /**
+     * \brief Wait until asynchronous writing of previous time frame is finished.
+     *
+     * Exception thrown during asynchronous writing is rethrown here.
+     */
+    void wait_for_frame();
+
+    /**
+     * \brief Write last registered time frame and wait until it is written.
+     *
+     * Exception thrown during asynchronous writing is rethrown here. Descendants call
+     * \p finish_in_destructor, which only logs the exception.
+     */
+    void finish();
+
 
 protected:
     
@@ -271,9 +305,28 @@ protected:
 
 
     /**
-     * \brief Virtual method for writing data to output file
+     * \brief Virtual method for writing data of time frame to output file
+     *
+     * Implementations must use only data of snapshot (\p frame_data_vec_, \p frame_time_, \p frame_step_),
+     * method can be called in I/O thread simultaneously with computation of next time frame.
+     */
+    virtual int write_frame(void) = 0;
+
+    /**
+     * \brief Call \p finish from destructor of descendant.
+     *
+     * Throwing from destructor terminates the program, so exception of asynchronous
+     * writing is logged as warning instead.
+     */
+    void finish_in_destructor();
+
+    /**
+     * \brief Copy shared pointers of registered output data, actual time and step to snapshot of time frame.
+     *
+     * Output data caches are not copied, new caches are created for next time frame by \p prepare_compute_data
+     * and \p clear_data.
      */
-    virtual int write_data(void) = 0;
+    void snapshot_frame();
 
     /**
      * \brief Collect data of individual processes to serial data on master (0th) process
@@ -358,6 +411,27 @@ protected:
     /// Vector of offsets of node indices of elements. Maps elements to their nodes in connectivity_.
     std::shared_ptr<ElementDataCache<unsigned int>> offsets_;
 
+    /// Output data of time frame passed to write_frame, see \p snapshot_frame.
+    OutputDataFieldVec  frame_data_vec_[N_DISCRETE_SPACES];
+
+    /// Time of time frame passed to write_frame.
+    double frame_time_;
+
+    /// Step of time frame passed to write_frame.
+    int frame_step_;
+
+    /// Flag for asynchronous writing of time frames (set by input key 'async_write').
+    bool async_write_;
+
+    /// I/O thread, created at first asynchronous write.
+    std::unique_ptr<ThreadPool> writer_;
+
+    /// Result of time frame written by I/O thread. At most one time frame is written asynchronously.
+    std::future<void> pending_frame_;
+
+    /// All output streams created by @p create_output_stream, used by @p flush_all.
+    static std::vector< std::weak_ptr<OutputTime> > output_streams_;
+
 };
 
 
@@ -22,13 +22,25 @@
 #include "mesh/mesh.h"
 
 #include <limits.h>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 #include "input/factory.hh"
 #include "input/accessors_forward.hh"
 #include "system/file_path.hh"
 #include "tools/time_governor.hh"
 #include "la/distribution.hh"
+#include "tools/thread_pool.hh"
+#include "system/checkpoint.hh"
 
 #include "config.h"
+#ifdef FLOW123D_HAVE_LZ4
+#include <lz4.h>
+#endif // FLOW123D_HAVE_LZ4
 
 FLOW123D_FORCE_LINK_IN_CHILD(vtk)
 
@@ -44,6 +56,8 @@ const Record & OutputVTK::get_input_type() {
 		// The parallel or serial variant
 		.declare_key("parallel", Bool(), Default("false"),
 			"Parallel or serial version of file format.")
+		.declare_key("compression_level", Integer(0, 9), Default("9"),
+			"Level of ZLib compression of 'binary_zlib' variant, from 0 (no compression) to 9 (best and slowest compression).")
 		.close();
 }
 
@@ -58,6 +72,11 @@ const Selection & OutputVTK::get_input_type_variant() {
 		.add_value(OutputVTK::VARIANT_BINARY_ZLIB, "binary_zlib",
 			"Appended binary XML VTK format without usage of base64 encoding of appended data. Compressed with ZLib.")
 #endif // FLOW123D_HAVE_ZLIB
+#ifdef FLOW123D_HAVE_LZ4
+		.add_value(OutputVTK::VARIANT_BINARY_LZ4, "binary_lz4",
+			"Appended binary XML VTK format without usage of base64 encoding of appended data. Compressed with LZ4, "
+			"faster but weaker than ZLib.")
+#endif // FLOW123D_HAVE_LZ4
 		.close();
 }
 
@@ -66,11 +85,48 @@ const int OutputVTK::registrar = Input::register_class< OutputVTK >("vtk") +
 		OutputVTK::get_input_type().size();
 
 
-const std::vector<std::string> OutputVTK::formats = { "ascii", "appended", "appended" };
+const std::vector<std::string> OutputVTK::formats = { "ascii", "appended", "appended", "appended" };
+
+
+namespace {
+
+/// Number of threads compressing blocks of appended data.
+unsigned int compression_threads = 1;
+
+/**
+ * Pool of compression_threads-1 workers, created at first compression.
+ *
+ * Frames can be written by background thread of OutputTime, so the pool is shared
+ * under compression_mutex; compression holds its own reference, therefore
+ * set_compression_threads never destroys pool that is in use.
+ */
+std::shared_ptr<ThreadPool> compression_pool;
+
+/// Guards compression_threads and compression_pool.
+std::mutex compression_mutex;
+
+/// Return number of compression threads and pool (null for single thread).
+std::pair<unsigned int, std::shared_ptr<ThreadPool>> get_compression_pool() {
+    std::lock_guard<std::mutex> lock(compression_mutex);
+    if (compression_threads > 1 && !compression_pool)
+        compression_pool = std::make_shared<ThreadPool>(compression_threads - 1);
+    return std::make_pair(compression_threads, compression_pool);
+}
+
+}
+
+
+void OutputVTK::set_compression_threads(unsigned int n_threads) {
+    ASSERT_PERMANENT_GT(n_threads, 0).error("Number of output threads must be positive.\n");
+    std::lock_guard<std::mutex> lock(compression_mutex);
+    compression_threads = n_threads;
+    compression_pool.reset();
+}
 
 
 
 OutputVTK::OutputVTK()
+: compression_level_(Z_BEST_COMPRESSION)
 {
     this->enable_refinement_ = true;
 }
@@ -80,7 +136,7 @@ OutputVTK::OutputVTK()
 OutputVTK::~OutputVTK()
 {
 	// Perform output of last time step
-	this->write_time_frame();
+	this->finish_in_destructor();
 
     this->write_tail();
 }
@@ -95,10 +151,29 @@ void OutputVTK::init_from_input(const std::string &equation_name,
 
     auto format_rec = (Input::Record)(input_record_.val<Input::AbstractRecord>("format"));
     variant_type_ = format_rec.val<VTKVariant>("variant");
+    compression_level_ = format_rec.val<int>("compression_level");
     this->parallel_ = format_rec.val<bool>("parallel");
     this->fix_main_file_extension(".pvd");
 
+    // on restart keep head and DataSets of time frames before restart
+    std::string restart_content;
+    int n_restart_frames = 0;
     if(this->rank_ == 0) {
+        if (Checkpoint::is_restart()) {
+            double coef = this->time_unit_converter->get_coef();
+            restart_content = Checkpoint::restart_output_content(string(this->_base_filename),
+                    [coef](const std::string &line) -> double {
+                        if (line.find("</Collection>") != std::string::npos) return std::numeric_limits<double>::infinity();
+                        std::size_t pos = line.find("timestep=\"");
+                        if (pos == std::string::npos) return std::numeric_limits<double>::quiet_NaN();
+                        return std::strtod(line.c_str() + pos + 10, nullptr) * coef;
+                    });
+            // every frame has one DataSet of the first part
+            for (std::size_t pos = restart_content.find("part=\"0\""); pos != std::string::npos;
+                    pos = restart_content.find("part=\"0\"", pos+1))
+                n_restart_frames++;
+        }
+
         try {
             this->_base_filename.open_stream( this->_base_file );
             this->set_stream_precision(this->_base_file);
@@ -108,7 +183,15 @@ void OutputVTK::init_from_input(const std::string &equation_name,
     }
 
     this->make_subdirectory();
-    this->write_head();
+    if (Checkpoint::is_restart()) {
+        // continue numbering of VTU files after the kept frames
+        MPI_Bcast(&n_restart_frames, 1, MPI_INT, 0, MPI_COMM_WORLD);
+        this->current_step = n_restart_frames;
+    }
+    if (restart_content.empty())
+        this->write_head();
+    else
+        this->_base_file << restart_content;
 
 }
 
@@ -136,7 +219,7 @@ string pvd_dataset_line(double step, int rank, string file) {
     return ss.str();
 }
 
-int OutputVTK::write_data(void)
+int OutputVTK::write_frame(void)
 {
     ASSERT_PTR(this->nodes_).error();
 
@@ -161,15 +244,15 @@ int OutputVTK::write_data(void)
     	//int current_step = this->get_parallel_current_step();
 
         /* Write dataset lines to the PVD file. */
-        double corrected_time = (isfinite(this->registered_time_)?this->registered_time_:0);
+        double corrected_time = (isfinite(this->frame_time_)?this->frame_time_:0);
         corrected_time /= this->time_unit_converter->get_coef();
         if (parallel_) {
         	for (int i_rank=0; i_rank<n_proc_; ++i_rank) {
-                string file = this->form_vtu_filename_(main_output_basename_, current_step, i_rank);
+                string file = this->form_vtu_filename_(main_output_basename_, frame_step_, i_rank);
                 this->_base_file << pvd_dataset_line(corrected_time, i_rank, file);
         	}
         } else {
-            string file = this->form_vtu_filename_(main_output_basename_, current_step, -1);
+            string file = this->form_vtu_filename_(main_output_basename_, frame_step_, -1);
             this->_base_file << pvd_dataset_line(corrected_time, 0, file);
         }
     }
@@ -177,14 +260,14 @@ int OutputVTK::write_data(void)
     /* write VTU file */
     {
         /* Open VTU file */
-        std::string frame_file_name = this->form_vtu_filename_(main_output_basename_, current_step, this->rank_);
+        std::string frame_file_name = this->form_vtu_filename_(main_output_basename_, frame_step_, this->rank_);
         FilePath frame_file_path({main_output_dir_, frame_file_name}, FilePath::output_file);
         try {
             frame_file_path.open_stream(_data_file);
             this->set_stream_precision(_data_file);
         } INPUT_CATCH(FilePath::ExcFileOpen, FilePath::EI_Address_String, input_record_)
 
-        LogOut() << __func__ << ": Writing output (frame: " << this->current_step
+        LogOut() << __func__ << ": Writing output (frame: " << this->frame_step_
                  << ", rank: " << this->rank_
                  << ") file: " << frame_file_name << " ... ";
 
@@ -234,6 +317,8 @@ void OutputVTK::write_vtk_vtu_head(void)
     }
     if ( this->variant_type_ == VTKVariant::VARIANT_BINARY_ZLIB ) {
     	file << " compressor=\"vtkZLibDataCompressor\"";
+    } else if ( this->variant_type_ == VTKVariant::VARIANT_BINARY_LZ4 ) {
+    	file << " compressor=\"vtkLZ4DataCompressor\"";
     }
     file << ">" << endl;
     file << "<UnstructuredGrid>" << endl;
@@ -303,82 +388,74 @@ void OutputVTK::write_vtk_data(OutputTime::OutputDataPtr output_data, unsigned i
     	output_data->get_min_max_range(range_min, range_max);
     	file    << " offset=\"" << appended_data_.tellp() << "\" ";
     	file    << "RangeMin=\"" << range_min << "\" RangeMax=\"" << range_max << "\"/>" << endl;
-    	if ( this->variant_type_ == VTKVariant::VARIANT_BINARY_UNCOMPRESSED ) {
-    		output_data->print_binary_all( appended_data_, true, start );
-    	} else { // ZLib compression
-    		stringstream uncompressed_data, compressed_data;
-    		output_data->print_binary_all( uncompressed_data, false, start );
-    		this->compress_data(uncompressed_data, compressed_data);
-    		appended_data_ << compressed_data.str();
-    	}
+    	this->write_appended_data(output_data, start);
     }
 
 }
 
 
-void OutputVTK::compress_data(stringstream &uncompressed_stream, stringstream &compressed_stream) {
+void OutputVTK::write_appended_data(OutputDataPtr output_data, unsigned int start) {
+	std::pair<const char *, std::size_t> data = output_data->binary_data(start);
+	if ( this->variant_type_ == VTKVariant::VARIANT_BINARY_UNCOMPRESSED ) {
+		unsigned long long int data_byte_size = data.second;
+		appended_data_.write(reinterpret_cast<const char*>(&data_byte_size), sizeof(unsigned long long int));
+		appended_data_.write(data.first, data.second);
+	} else {
+		this->compress_data(data.first, data.second, appended_data_);
+	}
+}
+
+
+void OutputVTK::compress_data(const char *data, std::size_t size, ostream &compressed_stream) {
     // size of block of compressed data.
 	static const size_t BUF_SIZE = 32 * 1024;
 
-	string uncompressed_string = uncompressed_stream.str();  // full uncompressed string
-	zlib_ulong uncompressed_size = uncompressed_string.size();    // size of uncompressed string
-	stringstream compressed_data;                            // helper stream stores blocks of compress data
-
-	zlib_ulong count_of_blocks = (uncompressed_size + BUF_SIZE - 1) / BUF_SIZE;
-	zlib_ulong last_block_size = (uncompressed_size % BUF_SIZE);
+	zlib_ulong count_of_blocks = (size + BUF_SIZE - 1) / BUF_SIZE;
+	zlib_ulong last_block_size = (size % BUF_SIZE);
 	compressed_stream.write(reinterpret_cast<const char*>(&count_of_blocks), sizeof(unsigned long long int));
 	compressed_stream.write(reinterpret_cast<const char*>(&BUF_SIZE), sizeof(unsigned long long int));
 	compressed_stream.write(reinterpret_cast<const char*>(&last_block_size), sizeof(unsigned long long int));
 
-	for (zlib_ulong i=0; i<count_of_blocks; ++i) {
-		// get block of data for compression
-		std::string data_block = uncompressed_string.substr(i*BUF_SIZE, BUF_SIZE);
-		zlib_ulong data_block_size = data_block.size();
-
-		std::vector<uint8_t> buffer;
-		uint8_t temp_buffer[BUF_SIZE];
-
-		// set zlib object
-		z_stream strm;
-		strm.zalloc = 0;
-		strm.zfree = 0;
-		strm.next_in = reinterpret_cast<uint8_t *>(&data_block[0]);
-		strm.avail_in = data_block_size;
-		strm.next_out = temp_buffer;
-		strm.avail_out = BUF_SIZE;
-
-		// compression of data
-		deflateInit(&strm, Z_BEST_COMPRESSION);
-		while (strm.avail_in != 0) {
-			int res = deflate(&strm, Z_NO_FLUSH);
-			ASSERT_EQ(res, Z_OK).error();
-			if (strm.avail_out == 0) {
-				buffer.insert(buffer.end(), temp_buffer, temp_buffer + BUF_SIZE);
-				strm.next_out = temp_buffer;
-				strm.avail_out = BUF_SIZE;
-			}
+	// blocks are compressed independently, each to own buffer
+	std::vector< std::vector<char> > blocks(count_of_blocks);
+	auto compress_block = [&](zlib_ulong i_block) {
+		const char *data_block = data + i_block * BUF_SIZE;
+		zlib_ulong data_block_size = std::min(BUF_SIZE, size - i_block * BUF_SIZE);
+		std::vector<char> &buffer = blocks[i_block];
+#ifdef FLOW123D_HAVE_LZ4
+		if (this->variant_type_ == VTKVariant::VARIANT_BINARY_LZ4) {
+			buffer.resize( LZ4_compressBound(data_block_size) );
+			int compressed_size = LZ4_compress_default(data_block, buffer.data(), data_block_size, buffer.size());
+			ASSERT_GT(compressed_size, 0).error("LZ4 compression failed.\n");
+			buffer.resize(compressed_size);
+			return;
 		}
-		int deflate_res = Z_OK;
-		while (deflate_res == Z_OK) {
-			if (strm.avail_out == 0) {
-				buffer.insert(buffer.end(), temp_buffer, temp_buffer + BUF_SIZE);
-				strm.next_out = temp_buffer;
-				strm.avail_out = BUF_SIZE;
-			}
-			deflate_res = deflate(&strm, Z_FINISH);
-		}
-		ASSERT_EQ(deflate_res, Z_STREAM_END).error();
-		buffer.insert(buffer.end(), temp_buffer, temp_buffer + BUF_SIZE - strm.avail_out);
-		deflateEnd(&strm);
+#endif // FLOW123D_HAVE_LZ4
+		zlib_ulong compressed_size = compressBound(data_block_size);
+		buffer.resize(compressed_size);
+		int res = compress2(reinterpret_cast<Bytef *>(buffer.data()), &compressed_size,
+				reinterpret_cast<const Bytef *>(data_block), data_block_size, compression_level_);
+		ASSERT_EQ(res, Z_OK).error("ZLib compression failed.\n");
+		buffer.resize(compressed_size);
+	};
+
+	auto [n_threads, pool] = get_compression_pool();
+	unsigned int n_tasks = std::min( (zlib_ulong)n_threads, count_of_blocks );
+	if (n_tasks > 1) {
+		pool->parallel_for(n_tasks, [&](unsigned int i_task) {
+			for (zlib_ulong i=i_task; i<count_of_blocks; i+=n_tasks) compress_block(i);
+		});
+	} else {
+		for (zlib_ulong i=0; i<count_of_blocks; ++i) compress_block(i);
+	}
 
-		// store compress data and its size to streams
-		std::string str(buffer.begin(), buffer.end());
-		zlib_ulong compressed_data_size = str.size();
+	// store sizes of compressed blocks and compressed data
+	for (auto &block : blocks) {
+		unsigned long long int compressed_data_size = block.size();
 		compressed_stream.write(reinterpret_cast<const char*>(&compressed_data_size), sizeof(unsigned long long int));
-		compressed_data << str;
 	}
-	// push compress data to returned stream
-	compressed_stream << compressed_data.str();
+	for (auto &block : blocks)
+		compressed_stream.write(block.data(), block.size());
 }
 
 
@@ -425,9 +502,9 @@ void OutputVTK::write_vtk_node_data(void)
     ofstream &file = this->_data_file;
 
     // merge node and corner data
-    OutputDataFieldVec node_corner_data(output_data_vec_[NODE_DATA]);
+    OutputDataFieldVec node_corner_data(frame_data_vec_[NODE_DATA]);
     node_corner_data.insert(node_corner_data.end(),
-            output_data_vec_[CORNER_DATA].begin(), output_data_vec_[CORNER_DATA].end());
+            frame_data_vec_[CORNER_DATA].begin(), frame_data_vec_[CORNER_DATA].end());
 
     if( ! node_corner_data.empty() ) {
         /* Write <PointData begin */
@@ -436,10 +513,10 @@ void OutputVTK::write_vtk_node_data(void)
         file << ">" << endl;
 
         /* Write data on nodes */
-        this->write_vtk_field_data(output_data_vec_[NODE_DATA]);
+        this->write_vtk_field_data(frame_data_vec_[NODE_DATA]);
 
         /* Write data in corners of elements */
-        this->write_vtk_field_data(output_data_vec_[CORNER_DATA]);
+        this->write_vtk_field_data(frame_data_vec_[CORNER_DATA]);
 
         /* Write PointData end */
         file << "</PointData>" << endl;
@@ -451,7 +528,7 @@ void OutputVTK::write_vtk_element_data(void)
 {
     ofstream &file = this->_data_file;
 
-    auto &data_map = this->output_data_vec_[ELEM_DATA];
+    auto &data_map = this->frame_data_vec_[ELEM_DATA];
     if (data_map.empty()) return;
 
     /* Write CellData begin */
@@ -471,7 +548,7 @@ void OutputVTK::write_vtk_native_data(void)
 {
     ofstream &file = this->_data_file;
 
-    auto &data_map = this->output_data_vec_[NATIVE_DATA];
+    auto &data_map = this->frame_data_vec_[NATIVE_DATA];
     if (data_map.empty()) return;
 
     /* Write Flow123dData begin */
@@ -500,14 +577,7 @@ void OutputVTK::write_vtk_native_data(void)
         	output_data->get_min_max_range(range_min, range_max);
         	file    << " offset=\"" << appended_data_.tellp() << "\" ";
         	file    << "RangeMin=\"" << range_min << "\" RangeMax=\"" << range_max << "\"/>" << endl;
-        	if ( this->variant_type_ == VTKVariant::VARIANT_BINARY_UNCOMPRESSED ) {
-        		output_data->print_binary_all( appended_data_ );
-        	} else { // ZLib compression
-        		stringstream uncompressed_data, compressed_data;
-        		output_data->print_binary_all( uncompressed_data, false );
-        		this->compress_data(uncompressed_data, compressed_data);
-        		appended_data_ << compressed_data.str();
-        	}
+        	this->write_appended_data(output_data, 0);
         }
     }
 
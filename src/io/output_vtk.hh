@@ -69,13 +69,15 @@ public:
 	 */
     static const Input::Type::Selection & get_input_type_variant();
 
+    /// Set number of threads compressing blocks of binary VTK output (command line option --output_threads).
+    static void set_compression_threads(unsigned int n_threads);
+
 
 
     /**
-     * \brief This function write data to VTK (.pvd) file format
-     * for curent time
+     * \brief This function write data of time frame to VTK (.pvd) file format
      */
-    int write_data(void);
+    int write_frame(void) override;
 
     /**
      * \brief This function writes header of VTK (.pvd) file format
@@ -100,7 +102,8 @@ protected:
     typedef enum {
     	VARIANT_ASCII  = 0,
     	VARIANT_BINARY_UNCOMPRESSED = 1,
-    	VARIANT_BINARY_ZLIB = 2
+    	VARIANT_BINARY_ZLIB = 2,
+    	VARIANT_BINARY_LZ4 = 3
     } VTKVariant;
 
     // VTK Element types
@@ -140,7 +143,7 @@ protected:
 	static const std::vector<std::string> formats;
 
 	/**
-	 * Used internally by write_data.
+	 * Used internally by write_frame.
 	 */
 	string form_vtu_filename_(string basename, int i_step, int rank);
 
@@ -206,11 +209,16 @@ protected:
    void make_subdirectory();
 
    /**
-    * Compress data stored in @p uncompressed_stream to @p compressed_stream.
+    * Compress @p size bytes of @p data and write them to @p compressed_stream.
     *
-    * Use ZLib compression.
+    * Data are split to blocks compressed independently (format of vtkZLibDataCompressor or
+    * vtkLZ4DataCompressor given by variant_type_), blocks are compressed by pool of threads
+    * (see set_compression_threads).
     */
-   void compress_data(stringstream &uncompressed_stream, stringstream &compressed_stream);
+   void compress_data(const char *data, std::size_t size, ostream &compressed_stream);
+
+   /// Write binary data of @p output_data starting at value @p start to appended_data_.
+   void write_appended_data(OutputDataPtr output_data, unsigned int start);
 
 
    /**
@@ -236,6 +244,9 @@ protected:
 
    /// Output format (ascii, binary or binary compressed)
    VTKVariant variant_type_;
+
+   /// Level of ZLib compression (0-9)
+   int compression_level_;
 };
 
 #endif /* OUTPUT_VTK_HH_ */
@@ -117,6 +117,8 @@ std::shared_ptr<EquivalentMeshMap> ReaderCache::identic_mesh_map(const FilePath
 
 std::shared_ptr<EquivalentMeshMap> ReaderCache::eqivalent_mesh_map(const FilePath &file_path,
                                                                             Mesh *computational_mesh) {
+    ASSERT_PERMANENT( !computational_mesh->is_distributed() )(string(file_path))
+            .error("Equivalent mesh map can't be created for distributed mesh, use identic_mesh_map.\n");
     auto it = ReaderCache::get_reader_data(file_path);
     auto source_mesh = ReaderCache::get_mesh(file_path);
     auto &reader_data = (*it).second;
@@ -128,3 +130,22 @@ std::shared_ptr<EquivalentMeshMap> ReaderCache::eqivalent_mesh_map(const FilePat
     return reader_data.target_mesh_element_map_;
 }
 
+std::shared_ptr<InterpolationMap> ReaderCache::interpolation_map(const FilePath &file_path,
+        const MeshBase *target_mesh, unsigned int interpolation,
+        const std::function<void(InterpolationMap &)> &create_map) {
+    auto &interpolation_maps = (*ReaderCache::get_reader_data(file_path)).second.interpolation_maps_;
+
+    // remove operators of released fields
+    for (auto it = interpolation_maps.begin(); it != interpolation_maps.end(); )
+        if (it->second.expired()) it = interpolation_maps.erase(it);
+        else ++it;
+
+    auto key = std::make_pair(target_mesh->serial_number(), interpolation);
+    auto found = interpolation_maps.find(key);
+    if (found != interpolation_maps.end()) return found->second.lock();
+
+    auto map_ptr = std::make_shared<InterpolationMap>();
+    create_map(*map_ptr);
+    interpolation_maps[key] = map_ptr;
+    return map_ptr;
+}
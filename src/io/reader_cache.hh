@@ -19,15 +19,18 @@
 #define READER_CACHE_HH_
 
 
+#include <functional>           // for function
 #include <map>                  // for map, map<>::value_compare
-#include <memory>               // for shared_ptr
+#include <memory>               // for shared_ptr, weak_ptr
 #include <string>               // for string
 #include "system/file_path.hh"  // for FilePath
 #include "system/index_types.hh" // for LongIdx
 
 class BaseMeshReader;
 class Mesh;
+class MeshBase;
 class EquivalentMeshMap;
+struct InterpolationMap;
 
 
 
@@ -43,6 +46,13 @@ public:
 		std::shared_ptr<BaseMeshReader> reader_;
 		std::shared_ptr<Mesh> mesh_;
 		std::shared_ptr<EquivalentMeshMap> target_mesh_element_map_;
+		/**
+		 * Interpolation operators to target meshes, key is pair (serial number of target mesh, type of interpolation).
+		 *
+		 * Operators are owned by fields that use them, so operator is released together with the last field
+		 * (and so with its target mesh), expired items are removed in interpolation_map.
+		 */
+		std::map< std::pair<unsigned int, unsigned int>, std::weak_ptr<InterpolationMap> > interpolation_maps_;
 	};
 
 	typedef std::map< string, ReaderData > ReaderTable;
@@ -54,6 +64,10 @@ public:
 
 	/**
 	 * Returns mesh of given FilePath.
+	 *
+	 * Mesh is always read whole on every process. On distributed computational mesh it is used only
+	 * by interpolations 'P0_gauss' and 'P0_intersection', data of equivalent mesh are mapped by
+	 * identic_mesh_map to own and ghost elements.
 	 */
 	static std::shared_ptr<Mesh> get_mesh(const FilePath &file_path);
 
@@ -71,9 +85,25 @@ public:
     static std::shared_ptr<EquivalentMeshMap> eqivalent_mesh_map(const FilePath &file_path,
                                                                           Mesh *computational_mesh);
 
+    /**
+     * Returns shared vector mapping elements to target mesh by element ids.
+     *
+     * On distributed \p computational_mesh the map holds only own and ghost elements.
+     */
     static std::shared_ptr<EquivalentMeshMap> identic_mesh_map(const FilePath &file_path,
                                                                           Mesh *computational_mesh);
 
+    /**
+     * Returns shared interpolation operator from mesh given by FilePath to \p target_mesh.
+     *
+     * Operator is identified by target mesh and type of interpolation \p interpolation. If it doesn't exist,
+     * it is filled by \p create_map and stored only after it is complete, so exception thrown by
+     * \p create_map leaves no incomplete operator in the cache.
+     */
+    static std::shared_ptr<InterpolationMap> interpolation_map(const FilePath &file_path,
+            const MeshBase *target_mesh, unsigned int interpolation,
+            const std::function<void(InterpolationMap &)> &create_map);
+
 private:
 	/// Returns singleton instance
 	static ReaderCache * instance();
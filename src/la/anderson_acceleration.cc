@@ -0,0 +1,171 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    anderson_acceleration.cc
+ * @brief   Anderson acceleration of fixed point iterations.
+ */
+
+#include "la/anderson_acceleration.hh"
+#include "la/vector_mpi.hh"
+#include "system/asserts.hh"
+#include "system/sys_profiler.hh"
+#include "system/system.hh"
+
+#include <petscvec.h>
+
+
+AndersonAcceleration::AndersonAcceleration(unsigned int depth, double damping)
+: depth_(depth), damping_(damping), block_offsets_(1, 0), n_applied_(0)
+{
+    ASSERT_GT(depth_, 0);
+    ASSERT(damping_ > 0.0 && damping_ <= 1.0)(damping_).error("Damping factor must be in (0,1].");
+}
+
+
+void AndersonAcceleration::add_block(VectorMPI &vec)
+{
+    PetscInt local_size;
+    chkerr(VecGetLocalSize(vec.petsc_vec(), &local_size));
+    blocks_.push_back(&vec);
+    block_indices_.emplace_back();
+    block_offsets_.push_back(block_offsets_.back() + local_size);
+}
+
+
+void AndersonAcceleration::add_block(VectorMPI &vec, const std::vector<unsigned int> &local_indices)
+{
+    PetscInt local_size;
+    chkerr(VecGetLocalSize(vec.petsc_vec(), &local_size));
+    for (unsigned int idx : local_indices)
+        ASSERT_LT(idx, (unsigned int)local_size).error("Accelerated entry is not locally owned.");
+    blocks_.push_back(&vec);
+    block_indices_.push_back(local_indices);
+    block_offsets_.push_back(block_offsets_.back() + local_indices.size());
+}
+
+
+inline unsigned int AndersonAcceleration::local_index(unsigned int i_block, unsigned int i) const
+{
+    return block_indices_[i_block].empty() ? i : block_indices_[i_block][i];
+}
+
+
+void AndersonAcceleration::restart()
+{
+    dg_.clear();
+    df_.clear();
+    n_applied_ = 0;
+    gather(x_);
+}
+
+
+void AndersonAcceleration::apply()
+{
+    START_TIMER("Anderson acceleration");
+    ASSERT_EQ(x_.n_elem, block_offsets_.back()).error("Missing call of restart().");
+
+    arma::vec g;
+    gather(g);
+    if (n_applied_ == 0) set_weights(g);
+    arma::vec f = g - x_;
+
+    if (n_applied_ > 0) {
+        dg_.push_back(g - g_prev_);
+        df_.push_back(f - f_prev_);
+        if (dg_.size() > depth_) {
+            dg_.pop_front();
+            df_.pop_front();
+        }
+    }
+    g_prev_ = g;
+    f_prev_ = f;
+    n_applied_++;
+
+    // plain (damped) fixed point step
+    arma::vec x_new = g - (1-damping_) * f;
+
+    unsigned int m = df_.size();
+    if (m > 0) {
+        // normal equations of least squares problem min |f - dF * gamma|, all dot products in one reduction
+        std::vector<double> local_data(m*m + m, 0.0), data(m*m + m);
+        arma::vec wf = weights_ % f;
+        for (unsigned int i=0; i<m; ++i) {
+            arma::vec wdf = weights_ % df_[i];
+            for (unsigned int j=0; j<=i; ++j)
+                local_data[i + m*j] = arma::dot(wdf, df_[j]);
+            local_data[m*m + i] = arma::dot(wf, df_[i]);
+        }
+        MPI_Allreduce(local_data.data(), data.data(), m*m + m, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+        arma::mat gram(m, m);
+        arma::vec rhs(m), gamma;
+        for (unsigned int i=0; i<m; ++i) {
+            for (unsigned int j=0; j<=i; ++j)
+                gram(i,j) = gram(j,i) = data[i + m*j];
+            rhs(i) = data[m*m + i];
+        }
+
+        if (arma::solve(gamma, gram, rhs, arma::solve_opts::no_approx) && gamma.is_finite()) {
+            for (unsigned int i=0; i<m; ++i)
+                x_new -= gamma(i) * ( dg_[i] - (1-damping_) * df_[i] );
+        } else {
+            // history is (nearly) linearly dependent, continue with plain step
+            dg_.clear();
+            df_.clear();
+        }
+    }
+
+    x_ = x_new;
+    scatter(x_);
+}
+
+
+void AndersonAcceleration::gather(arma::vec &x)
+{
+    x.set_size(block_offsets_.back());
+    for (unsigned int i_block=0; i_block<blocks_.size(); ++i_block)
+        for (unsigned int i=block_offsets_[i_block]; i<block_offsets_[i_block+1]; ++i)
+            x(i) = blocks_[i_block]->get( local_index(i_block, i - block_offsets_[i_block]) );
+}
+
+
+void AndersonAcceleration::scatter(const arma::vec &x)
+{
+    ASSERT_EQ(x.n_elem, block_offsets_.back());
+    for (unsigned int i_block=0; i_block<blocks_.size(); ++i_block) {
+        for (unsigned int i=block_offsets_[i_block]; i<block_offsets_[i_block+1]; ++i)
+            blocks_[i_block]->set( local_index(i_block, i - block_offsets_[i_block]), x(i) );
+        blocks_[i_block]->local_to_ghost_begin();
+        blocks_[i_block]->local_to_ghost_end();
+    }
+}
+
+
+void AndersonAcceleration::set_weights(const arma::vec &g)
+{
+    unsigned int n_blocks = blocks_.size();
+    std::vector<double> local_norm2(n_blocks), norm2(n_blocks);
+    for (unsigned int i_block=0; i_block<n_blocks; ++i_block) {
+        unsigned int begin = block_offsets_[i_block], end = block_offsets_[i_block+1];
+        local_norm2[i_block] = (end > begin) ? arma::dot(g.subvec(begin, end-1), g.subvec(begin, end-1)) : 0.0;
+    }
+    MPI_Allreduce(local_norm2.data(), norm2.data(), n_blocks, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+    weights_.set_size(block_offsets_.back());
+    for (unsigned int i_block=0; i_block<n_blocks; ++i_block) {
+        // zero block (e.g. initial displacement) is not scaled
+        double weight = (norm2[i_block] > 0.0) ? 1.0 / norm2[i_block] : 1.0;
+        for (unsigned int i=block_offsets_[i_block]; i<block_offsets_[i_block+1]; ++i)
+            weights_(i) = weight;
+    }
+}
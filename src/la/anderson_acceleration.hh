@@ -0,0 +1,117 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    anderson_acceleration.hh
+ * @brief   Anderson acceleration of fixed point iterations.
+ */
+
+#ifndef ANDERSON_ACCELERATION_HH_
+#define ANDERSON_ACCELERATION_HH_
+
+#include <deque>
+#include <vector>
+#include <armadillo>
+
+class VectorMPI;
+
+/**
+ * Anderson acceleration (mixing) of a fixed point iteration x = G(x).
+ *
+ * The iterate is composed of several blocks given by distributed vectors (e.g. solutions of coupled
+ * equations). Having the last iterate x_k and the value g_k = G(x_k) with residual f_k = g_k - x_k,
+ * the new iterate is
+ *
+ *     x_{k+1} = g_k - dG * gamma - (1-damping) * (f_k - dF * gamma),
+ *
+ * where columns of dF, dG are differences of last @p depth residuals and values of G and gamma
+ * minimizes |f_k - dF * gamma|. Depth 1 gives the secant (Aitken type) step. In the inner product
+ * every block is scaled by inverse of its norm, so blocks of different physical units contribute equally.
+ *
+ * Usage:
+ * 1) add all blocks
+ * 2) call @p restart when blocks contain the initial iterate x_0
+ * 3) after every evaluation of G (blocks contain g_k) call @p apply, which replaces the values in blocks
+ *    by the accelerated iterate x_{k+1} (including ghost values)
+ */
+class AndersonAcceleration
+{
+public:
+    /// Constructor, sets the history depth and damping factor.
+    AndersonAcceleration(unsigned int depth, double damping = 1.0);
+
+    /// Add block of the iterate, the vector must exist until the last call of @p apply.
+    void add_block(VectorMPI &vec);
+
+    /**
+     * Add block given by locally owned entries @p local_indices of the vector, other entries are not
+     * accelerated (e.g. only element pressures of mixed flow solution). The vector must exist until
+     * the last call of @p apply.
+     */
+    void add_block(VectorMPI &vec, const std::vector<unsigned int> &local_indices);
+
+    /// Forget the history and take the current values of blocks as the initial iterate.
+    void restart();
+
+    /// Replace values G(x_k) in blocks by the accelerated iterate.
+    void apply();
+
+    /// Return the history depth.
+    inline unsigned int depth() const
+    { return depth_; }
+
+private:
+    /// Return local index in vector of @p i_block of its i-th accelerated entry.
+    unsigned int local_index(unsigned int i_block, unsigned int i) const;
+
+    /// Copy locally owned values of all blocks to @p x.
+    void gather(arma::vec &x);
+
+    /// Set locally owned values of all blocks from @p x and update ghost values.
+    void scatter(const arma::vec &x);
+
+    /// Set weights of blocks to inverse of squared norms of blocks in @p g.
+    void set_weights(const arma::vec &g);
+
+    /// Maximal number of stored differences.
+    unsigned int depth_;
+
+    /// Damping (mixing) factor, 1 means no damping.
+    double damping_;
+
+    /// Blocks of the iterate.
+    std::vector<VectorMPI *> blocks_;
+
+    /// Local indices of accelerated entries of blocks (whole locally owned part if empty).
+    std::vector< std::vector<unsigned int> > block_indices_;
+
+    /// Offsets of blocks in gathered vectors, the last item is the local size of the iterate.
+    std::vector<unsigned int> block_offsets_;
+
+    /// Weights of entries in inner product.
+    arma::vec weights_;
+
+    /// Last iterate x_k.
+    arma::vec x_;
+
+    /// Value of G and residual from the previous call of @p apply.
+    arma::vec g_prev_, f_prev_;
+
+    /// Differences of values of G and of residuals, the newest at the back.
+    std::deque<arma::vec> dg_, df_;
+
+    /// Number of calls of @p apply after the last restart.
+    unsigned int n_applied_;
+};
+
+
+#endif /* ANDERSON_ACCELERATION_HH_ */
@@ -79,6 +79,15 @@ void LinSys_PERMON::set_inequality(Mat matrix_ineq, Vec ineq)
   ineq_ = ineq;
 }
 
+void LinSys_PERMON::set_from_input(const Input::Record in_rec)
+{
+	LinSys::set_from_input( in_rec );
+
+	// PERMON creates QP solver in every solve, so preconditioner reuse keys of LinSys_PETSC are not supported
+    std::string user_params = in_rec.val<string>("options");
+	if (user_params != "") params_ = user_params;
+}
+
 LinSys::SolveInfo LinSys_PERMON::solve()
 {
 
@@ -53,6 +53,9 @@ public:
 
     void set_inequality(Mat matrix_ineq, Vec ineq);
 
+    /// Set parameters of solver from input, keys of preconditioner reuse are not part of PERMON input.
+    void set_from_input(const Input::Record in_rec) override;
+
     LinSys_PETSC::SolveInfo solve() override;
 
     /**
@@ -23,6 +23,7 @@
 #include "petscmat.h"
 #include "system/sys_profiler.hh"
 #include "system/system.hh"
+#include "tools/thread_pool.hh"
 
 
 //#include <boost/bind.hpp>
@@ -54,6 +55,12 @@ const it::Record & LinSys_PETSC::get_input_type() {
                     "Maximum number of outer iterations of the linear solver.")
 		.declare_key("options", it::String(), it::Default("\"\""),  "This options is passed to PETSC to create a particular KSP (Krylov space method).\n"
                                                                     "If the string is left empty (by default), the internal default options is used.")
+		.declare_key("pc_reuse", it::Integer(0), it::Default("0"),
+		            "Maximal number of consecutive solves with changed matrix which reuse the preconditioner of an older matrix. "
+		            "The preconditioner is always reused while the matrix is unchanged, zero value means that it is rebuilt on every change of the matrix.")
+		.declare_key("pc_reuse_iter_growth", it::Double(0.0), it::Default("0.5"),
+		            "Reused preconditioner of an older matrix is rebuilt if the number of iterations exceeds "
+		            "the number of iterations of the first solve with this preconditioner by given fraction.")
 		.close();
 }
 
@@ -65,7 +72,16 @@ LinSys_PETSC::LinSys_PETSC( const Distribution * rows_ds, const std::string &par
         : LinSys( rows_ds ),
           params_(params),
           init_guess_nonzero(false),
-          matrix_(0)
+          matrix_(0),
+          coo_assembly_(false),
+          coo_pattern_changed_(true),
+          coo_block_(0),
+          system(NULL),
+          pc_reuse_max_(0),
+          pc_reuse_iter_growth_(0.5),
+          pc_reuse_count_(0),
+          pc_setup_its_(-1),
+          pc_rebuild_(false)
 {
     // create PETSC vectors:
     PetscErrorCode ierr;
@@ -82,7 +98,10 @@ LinSys_PETSC::LinSys_PETSC( const Distribution * rows_ds, const std::string &par
 }
 
 LinSys_PETSC::LinSys_PETSC( LinSys_PETSC &other )
-	: LinSys(other), params_(other.params_), v_rhs_(NULL), solution_precision_(other.solution_precision_)
+	: LinSys(other), params_(other.params_), v_rhs_(NULL), coo_assembly_(other.coo_assembly_),
+	  coo_pattern_changed_(true), coo_block_(0), solution_precision_(other.solution_precision_), system(NULL),
+	  pc_reuse_max_(other.pc_reuse_max_), pc_reuse_iter_growth_(other.pc_reuse_iter_growth_),
+	  pc_reuse_count_(0), pc_setup_its_(-1), pc_rebuild_(false)
 {
 	MatCopy(other.matrix_, matrix_, DIFFERENT_NONZERO_PATTERN);
 	VecCopy(other.rhs_, rhs_);
@@ -159,7 +178,10 @@ void LinSys_PETSC::mat_set_values( int nrow, int *rows, int ncol, int *cols, dou
     switch (status_) {
         case INSERT:
         case ADD:
-            chkerr(MatSetValues(matrix_,nrow,rows,ncol,cols,vals,(InsertMode)status_));
+            if (coo_assembly_ && status_ == ADD)
+                this->coo_set_values(nrow,rows,ncol,cols,vals);
+            else
+                chkerr(MatSetValues(matrix_,nrow,rows,ncol,cols,vals,(InsertMode)status_));
             break;
         case ALLOCATE:
             this->preallocate_values(nrow,rows,ncol,cols); 
@@ -170,6 +192,76 @@ void LinSys_PETSC::mat_set_values( int nrow, int *rows, int ncol, int *cols, dou
     matrix_changed_ = true;
 }
 
+void LinSys_PETSC::coo_set_values( int nrow, int *rows, int ncol, int *cols, double *vals )
+{
+    ThreadPool::TaskId task = ThreadPool::current_task();
+    if (task.block != coo_block_) {
+        // previous parallel_for block is finished
+        this->coo_merge_task_buffers();
+        coo_block_ = task.block;
+    }
+
+    if (task.block == 0) {
+        for (int i=0; i<nrow; i++)
+            for (int j=0; j<ncol; j++)
+                this->coo_add_entry(rows[i], cols[j], vals[i*ncol+j]);
+    } else {
+        // threaded assembly, values are buffered per task and merged in task order
+        if (task.task >= coo_task_buffers_.size()) coo_task_buffers_.resize(task.task+1);
+        CooTaskBuffer &buffer = coo_task_buffers_[task.task];
+        for (int i=0; i<nrow; i++)
+            for (int j=0; j<ncol; j++) {
+                buffer.rows.push_back(rows[i]);
+                buffer.cols.push_back(cols[j]);
+                buffer.vals.push_back(vals[i*ncol+j]);
+            }
+    }
+}
+
+void LinSys_PETSC::coo_add_entry( PetscInt row, PetscInt col, PetscScalar val )
+{
+    unsigned int pos = coo_vals_.size();
+    if ( coo_pattern_changed_ || pos >= coo_rows_.size() || coo_rows_[pos] != row || coo_cols_[pos] != col ) {
+        // pattern differs from previous assembly, rest of pattern is recorded again
+        if (pos < coo_rows_.size()) {
+            coo_rows_.resize(pos);
+            coo_cols_.resize(pos);
+        }
+        coo_rows_.push_back(row);
+        coo_cols_.push_back(col);
+        coo_pattern_changed_ = true;
+    }
+    coo_vals_.push_back(val);
+}
+
+void LinSys_PETSC::coo_merge_task_buffers()
+{
+    for (CooTaskBuffer &buffer : coo_task_buffers_) {
+        for (unsigned int i=0; i<buffer.vals.size(); i++)
+            this->coo_add_entry(buffer.rows[i], buffer.cols[i], buffer.vals[i]);
+        buffer.clear();
+    }
+}
+
+void LinSys_PETSC::coo_finish_assembly()
+{
+    this->coo_merge_task_buffers();
+    coo_block_ = 0;
+    if (coo_vals_.size() == 0) return;
+
+    START_TIMER("LinSys_PETSC::coo_finish_assembly");
+    if (coo_pattern_changed_ || coo_vals_.size() != coo_rows_.size()) {
+        coo_rows_.resize(coo_vals_.size());
+        coo_cols_.resize(coo_vals_.size());
+        // PETSc can modify given index arrays
+        std::vector<PetscInt> rows(coo_rows_), cols(coo_cols_);
+        chkerr(MatSetPreallocationCOO(matrix_, rows.size(), rows.data(), cols.data()));
+        coo_pattern_changed_ = false;
+    }
+    chkerr(MatSetValuesCOO(matrix_, coo_vals_.data(), ADD_VALUES));
+    coo_vals_.clear();
+}
+
 void LinSys_PETSC::rhs_set_values( int nrow, int *rows, double *vals )
 {
     PetscErrorCode ierr;
@@ -209,16 +301,14 @@ void LinSys_PETSC::preallocate_matrix()
 {
 	ASSERT_EQ(status_, ALLOCATE).error("Linear system has to be in ALLOCATE status.");
 
-    PetscErrorCode ierr;
-    PetscInt *on_nz, *off_nz;
     PetscScalar *on_array, *off_array;
 
     // assembly and get values from counting vectors, destroy them
     VecAssemblyBegin(on_vec_);
     VecAssemblyBegin(off_vec_);
 
-    on_nz  = new PetscInt[ rows_ds_->lsize() ];
-    off_nz = new PetscInt[ rows_ds_->lsize() ];
+    std::vector<PetscInt> on_nz( rows_ds_->lsize() );
+    std::vector<PetscInt> off_nz( rows_ds_->lsize() );
 
     VecAssemblyEnd(on_vec_);
     VecAssemblyEnd(off_vec_);
@@ -236,26 +326,43 @@ void LinSys_PETSC::preallocate_matrix()
     VecDestroy(&on_vec_);
     VecDestroy(&off_vec_);
 
+    this->create_matrix(on_nz, off_nz);
+}
+
+void LinSys_PETSC::preallocate_matrix(const std::vector<LongIdx> &on_nz, const std::vector<LongIdx> &off_nz)
+{
+    ASSERT_EQ(on_nz.size(), rows_ds_->lsize()).error("Size of preallocation data doesn't match local rows.");
+    ASSERT_EQ(off_nz.size(), rows_ds_->lsize()).error("Size of preallocation data doesn't match local rows.");
+
+    this->create_matrix( std::vector<PetscInt>(on_nz.begin(), on_nz.end()),
+                         std::vector<PetscInt>(off_nz.begin(), off_nz.end()) );
+    status_ = ADD;
+    matrix_changed_ = true;
+}
+
+void LinSys_PETSC::create_matrix(const std::vector<PetscInt> &on_nz, const std::vector<PetscInt> &off_nz)
+{
+    PetscErrorCode ierr;
+
+    // KSP holds operators of the destroyed matrix
+    this->destroy_ksp();
+
     // create PETSC matrix with preallocation
     if (matrix_ != NULL)
     {
     	chkerr(MatDestroy(&matrix_));
     }
     ierr = MatCreateAIJ(PETSC_COMM_WORLD, rows_ds_->lsize(), rows_ds_->lsize(), PETSC_DETERMINE, PETSC_DETERMINE,
-                           0, on_nz, 0, off_nz, &matrix_); CHKERRV( ierr );
+                           0, on_nz.data(), 0, off_nz.data(), &matrix_); CHKERRV( ierr );
 
     if (symmetric_) MatSetOption(matrix_, MAT_SYMMETRIC, PETSC_TRUE);
     MatSetOption(matrix_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE);
+    coo_pattern_changed_ = true;
 
     // This option is used in order to assembly larger local matrices with own non-zero structure.
     // Zero entries are ignored so we must prevent adding exact zeroes.
     // Add LocalSystem::almost_zero for entries that should not be eliminated.
     MatSetOption(matrix_, MAT_IGNORE_ZERO_ENTRIES, PETSC_TRUE);
-
-
-
-    delete[] on_nz;
-    delete[] off_nz;
 }
 
 void LinSys_PETSC::finish_assembly( )
@@ -272,6 +379,7 @@ void LinSys_PETSC::finish_assembly( MatAssemblyType assembly_type )
     	WarningOut() << "Finalizing linear system without setting values.\n";
         this->preallocate_matrix();
     }
+    if (coo_assembly_) this->coo_finish_assembly();
     ierr = MatAssemblyBegin(matrix_, assembly_type); CHKERRV( ierr ); 
     ierr = VecAssemblyBegin(rhs_); CHKERRV( ierr ); 
     ierr = MatAssemblyEnd(matrix_, assembly_type); CHKERRV( ierr ); 
@@ -284,7 +392,7 @@ void LinSys_PETSC::finish_assembly( MatAssemblyType assembly_type )
     //VecView(rhs_, PETSC_VIEWER_STDOUT_SELF);
     //this->view();
 
-    matrix_changed_ = true;
+    // matrix_changed_ is set by methods modifying the matrix, assembly of RHS keeps the preconditioner
     rhs_changed_ = true;
 }
 
@@ -339,12 +447,22 @@ void LinSys_PETSC::set_initial_guess_nonzero(bool set_nonzero)
 }
 
 
-LinSys::SolveInfo LinSys_PETSC::solve()
+void LinSys_PETSC::set_coo_assembly(bool use_coo)
 {
+#if PETSC_VERSION_LT(3,17,0)
+    // older PETSc has only generic COO implementation for MPIAIJ matrices, standard assembly is faster
+    use_coo = false;
+#endif
+    coo_assembly_ = use_coo;
+    this->coo_clear_values();
+    coo_pattern_changed_ = true;
+}
+
 
+void LinSys_PETSC::create_ksp()
+{
     const char *petsc_dflt_opt;
-    int nits;
-    
+
     // -mat_no_inode ... inodes are usefull only for
     //  vector problems e.g. MH without Schur complement reduction
     
@@ -389,16 +507,74 @@ LinSys::SolveInfo LinSys_PETSC::solve()
     chkerr(KSPSetTolerances(system, r_tol_, a_tol_, d_tol_,PETSC_DEFAULT));
     chkerr(KSPSetTolerances(system, r_tol_, a_tol_, d_tol_,  max_it_));
     KSPSetFromOptions(system);
+
+    pc_reuse_count_ = 0;
+    pc_setup_its_ = -1;
+    pc_rebuild_ = false;
+}
+
+
+void LinSys_PETSC::destroy_ksp()
+{
+    if (system != NULL) chkerr(KSPDestroy(&system));
+}
+
+
+void LinSys_PETSC::setup_ksp()
+{
+    if (system == NULL) {
+        this->create_ksp();
+    } else {
+        // PETSc rebuilds preconditioner of changed matrix unless reuse is set
+        bool rebuild = pc_rebuild_ || (matrix_changed_ && pc_reuse_count_ >= pc_reuse_max_);
+        if (rebuild) {
+            pc_reuse_count_ = 0;
+            pc_setup_its_ = -1;
+            pc_rebuild_ = false;
+        } else if (matrix_changed_) {
+            pc_reuse_count_++;
+        }
+        chkerr(KSPSetReusePreconditioner(system, rebuild ? PETSC_FALSE : PETSC_TRUE));
+        chkerr(KSPSetTolerances(system, r_tol_, a_tol_, d_tol_,  max_it_));
+    }
+
     // We set the KSP flag set_initial_guess_nonzero
     // unless KSP type is preonly.
     // In such case PETSc fails (version 3.4.1)
-    if (init_guess_nonzero)
+    KSPType type;
+    KSPGetType(system, &type);
+    if (strcmp(type, KSPPREONLY) != 0)
+        KSPSetInitialGuessNonzero(system, init_guess_nonzero ? PETSC_TRUE : PETSC_FALSE);
+
     {
-    	KSPType type;
-    	KSPGetType(system, &type);
-    	if (strcmp(type, KSPPREONLY) != 0)
-    		KSPSetInitialGuessNonzero(system, PETSC_TRUE);
+        START_TIMER("PETSC preconditioner setup");
+        chkerr(KSPSetUp(system));
     }
+    matrix_changed_ = false;
+}
+
+
+void LinSys_PETSC::update_pc_reuse(int nits)
+{
+    if (pc_setup_its_ < 0)
+        pc_setup_its_ = nits;
+    else if (pc_reuse_count_ > 0 && nits > (1.0 + pc_reuse_iter_growth_) * pc_setup_its_)
+        pc_rebuild_ = true;
+}
+
+
+void LinSys_PETSC::set_pc_reuse(unsigned int max_steps, double iter_growth)
+{
+    pc_reuse_max_ = max_steps;
+    pc_reuse_iter_growth_ = iter_growth;
+}
+
+
+LinSys::SolveInfo LinSys_PETSC::solve()
+{
+    int nits;
+
+    this->setup_ksp();
 
     {
 		START_TIMER("PETSC linear solver");
@@ -408,6 +584,7 @@ LinSys::SolveInfo LinSys_PETSC::solve()
 		KSPGetIterationNumber(system,&nits);
 		ADD_CALLS(nits);
     }
+    this->update_pc_reuse(nits);
     // substitute by PETSc call for residual
     VecNorm(rhs_, NORM_2, &residual_norm_);
     
@@ -419,12 +596,56 @@ LinSys::SolveInfo LinSys_PETSC::solve()
     // TODO: I do not understand this 
     //Profiler::instance()->set_timer_subframes("SOLVING MH SYSTEM", nits);
 
-    chkerr(KSPDestroy(&system));
-
     return LinSys::SolveInfo(static_cast<int>(reason), static_cast<int>(nits));
 
 }
 
+
+LinSys::SolveInfo LinSys_PETSC::solve_multi(const std::vector<Vec> &rhs_vecs, const std::vector<Vec> &solutions)
+{
+    ASSERT_EQ(rhs_vecs.size(), solutions.size()).error("Different number of right-hand sides and solutions.");
+    int nits;
+    PetscInt n_rhs = rhs_vecs.size();
+    Mat rhs_block, solution_block;
+    Vec col;
+
+    // copy right-hand sides and initial guesses to columns of dense matrices
+    chkerr(MatCreateDense(comm_, rows_ds_->lsize(), PETSC_DECIDE, PETSC_DETERMINE, n_rhs, NULL, &rhs_block));
+    chkerr(MatDuplicate(rhs_block, MAT_DO_NOT_COPY_VALUES, &solution_block));
+    for (PetscInt i=0; i<n_rhs; i++) {
+        chkerr(MatDenseGetColumnVecWrite(rhs_block, i, &col));
+        chkerr(VecCopy(rhs_vecs[i], col));
+        chkerr(MatDenseRestoreColumnVecWrite(rhs_block, i, &col));
+        chkerr(MatDenseGetColumnVecWrite(solution_block, i, &col));
+        chkerr(VecCopy(solutions[i], col));
+        chkerr(MatDenseRestoreColumnVecWrite(solution_block, i, &col));
+    }
+
+    this->setup_ksp();
+
+    {
+		START_TIMER("PETSC linear solver");
+		START_TIMER("PETSC linear iteration");
+		chkerr(KSPMatSolve(system, rhs_block, solution_block));
+		KSPGetConvergedReason(system,&reason);
+		KSPGetIterationNumber(system,&nits);
+		ADD_CALLS(nits);
+    }
+    this->update_pc_reuse(nits);
+    LogOut().fmt("convergence reason {}, number of iterations is {} ({} right-hand sides)\n", reason, nits, n_rhs);
+    KSPGetResidualNorm(system, &solution_precision_);
+
+    for (PetscInt i=0; i<n_rhs; i++) {
+        chkerr(MatDenseGetColumnVecRead(solution_block, i, &col));
+        chkerr(VecCopy(col, solutions[i]));
+        chkerr(MatDenseRestoreColumnVecRead(solution_block, i, &col));
+    }
+    chkerr(MatDestroy(&rhs_block));
+    chkerr(MatDestroy(&solution_block));
+
+    return LinSys::SolveInfo(static_cast<int>(reason), static_cast<int>(nits));
+}
+
 void LinSys_PETSC::view(string text )
 {
     FilePath matFileName(text + "_flow123d_matrix.m",FilePath::FileType::output_file);
@@ -463,6 +684,7 @@ void LinSys_PETSC::view(string text )
 
 LinSys_PETSC::~LinSys_PETSC( )
 {
+    this->destroy_ksp();
     if (matrix_ != NULL) { chkerr(MatDestroy(&matrix_)); }
     chkerr(VecDestroy(&rhs_));
 
@@ -481,6 +703,9 @@ void LinSys_PETSC::set_from_input(const Input::Record in_rec)
     // otherwise keep settings provided in constructor of LinSys_PETSC.
     std::string user_params = in_rec.val<string>("options");
 	if (user_params != "") params_ = user_params;
+	this->set_pc_reuse( in_rec.val<unsigned int>("pc_reuse"), in_rec.val<double>("pc_reuse_iter_growth") );
+	// options of existing solver are set only at its creation
+	this->destroy_ksp();
 }
 
 
@@ -23,6 +23,7 @@
 #include <string>        // for string
 #include <vector>        // for vector
 #include "la/linsys.hh"  // for LinSys
+#include "system/index_types.hh"  // for LongIdx
 #include "petscksp.h"    // for KSP, KSPConvergedReason, _p_KSP
 #include "petscmat.h"    // for Mat, MatCopy, MatZeroEntries, MatAssemblyType
 #include "petscmath.h"   // for PetscScalar
@@ -92,6 +93,7 @@ public:
     {
         matrix_changed_ = true;
         constraints_.clear();
+        this->coo_clear_values();
     	return MatZeroEntries(matrix_);
     }
 
@@ -115,6 +117,13 @@ public:
 
     void preallocate_matrix();
 
+    /**
+     * Create matrix preallocated by given numbers of nonzero entries of local rows in diagonal
+     * and off-diagonal block (e.g. computed by SparsityPattern), no allocating assembly is necessary.
+     * Linear system is switched to ADD status.
+     */
+    void preallocate_matrix(const std::vector<LongIdx> &on_nz, const std::vector<LongIdx> &off_nz);
+
     void finish_assembly() override;
 
     void finish_assembly( MatAssemblyType assembly_type );
@@ -123,8 +132,42 @@ public:
 
     void set_initial_guess_nonzero(bool set_nonzero = true);
 
+    /**
+     * Set reuse policy of preconditioner (see input keys 'pc_reuse' and 'pc_reuse_iter_growth').
+     *
+     * KSP solver and its preconditioner are kept between solves, the preconditioner is always reused
+     * while the matrix is unchanged (see LinSys::set_matrix_changed). After change of the matrix
+     * the preconditioner of an older matrix is reused for at most @p max_steps solves and until
+     * the number of iterations exceeds the number of iterations of the first solve with this
+     * preconditioner by fraction @p iter_growth.
+     */
+    void set_pc_reuse(unsigned int max_steps, double iter_growth);
+
+    /**
+     * Switch assembly of matrix to coordinate (COO) format.
+     *
+     * Values added by mat_set_values in ADD status are appended to the buffer and passed to PETSc
+     * at once by MatSetValuesCOO in finish_assembly. Pattern of the matrix is given by the sequence
+     * of added indices and it is passed to PETSc (MatSetPreallocationCOO) only if it differs from
+     * the previous assembly, so repeated assembly is a pure scatter of values. Matrix has to be
+     * assembled from zero entries (mat_zero_entries) in one pass.
+     *
+     * Values added by tasks of ThreadPool::parallel_for (threaded assembly, calls must be guarded
+     * by a mutex) are buffered per task and merged in task order, so the pattern doesn't depend
+     * on scheduling of threads. Mode is ignored for PETSc older than 3.17, which has no efficient
+     * COO assembly of MPIAIJ matrices.
+     */
+    void set_coo_assembly(bool use_coo = true);
+
     LinSys::SolveInfo solve() override;
 
+    /**
+     * Solve system with the matrix of this linear system for several right-hand sides at once
+     * (KSPMatSolve), preconditioner is set up only once. Given solutions are used as initial guess
+     * if it is set nonzero. Right-hand side and solution of this linear system are not used.
+     */
+    LinSys::SolveInfo solve_multi(const std::vector<Vec> &rhs_vecs, const std::vector<Vec> &solutions);
+
     /**
      * Returns information on absolute solver accuracy
      */
@@ -167,6 +210,53 @@ private:
     };
 
 protected:
+    /// Values added to COO buffer by one task of threaded assembly.
+    struct CooTaskBuffer {
+        std::vector<PetscInt> rows;
+        std::vector<PetscInt> cols;
+        std::vector<PetscScalar> vals;
+
+        /// Clear values, allocated memory is kept.
+        inline void clear() {
+            rows.clear();
+            cols.clear();
+            vals.clear();
+        }
+    };
+
+    /// Create KSP solver of the matrix, set options given by input or default options.
+    void create_ksp();
+
+    /// Create KSP solver at first solve or update it according to preconditioner reuse policy, set up preconditioner.
+    void setup_ksp();
+
+    /// Destroy KSP solver, it is created again in the next solve.
+    void destroy_ksp();
+
+    /// Check number of iterations of finished solve against reuse policy of preconditioner.
+    void update_pc_reuse(int nits);
+
+    /// Create PETSc matrix preallocated by given numbers of nonzero entries of local rows, destroy previous matrix.
+    void create_matrix(const std::vector<PetscInt> &on_nz, const std::vector<PetscInt> &off_nz);
+
+    /// Append values to COO buffer, indices are compared with pattern of previous assembly.
+    void coo_set_values(int nrow, int *rows, int ncol, int *cols, double *vals);
+
+    /// Append one value to COO buffer, index is compared with pattern of previous assembly.
+    void coo_add_entry(PetscInt row, PetscInt col, PetscScalar val);
+
+    /// Append values of task buffers to COO buffer in order of tasks.
+    void coo_merge_task_buffers();
+
+    /// Pass COO buffer to PETSc matrix, set new COO pattern if it was changed.
+    void coo_finish_assembly();
+
+    /// Clear values of COO buffer and task buffers, pattern and allocated memory are kept.
+    inline void coo_clear_values() {
+        coo_vals_.clear();
+        for (CooTaskBuffer &buffer : coo_task_buffers_) buffer.clear();
+        coo_block_ = 0;
+    }
 
     std::string params_;		 //!< command-line-like options for the PETSc solver
 
@@ -181,12 +271,26 @@ protected:
     Vec     on_vec_;             //!< Vectors for counting non-zero entries in diagonal block.
     Vec     off_vec_;            //!< Vectors for counting non-zero entries in off-diagonal block.
 
+    bool    coo_assembly_;       //!< Flag for assembly of matrix in COO format.
+    std::vector<PetscInt> coo_rows_;     //!< Row indices of COO pattern.
+    std::vector<PetscInt> coo_cols_;     //!< Column indices of COO pattern.
+    std::vector<PetscScalar> coo_vals_;  //!< Values of current assembly in order of COO pattern.
+    bool    coo_pattern_changed_; //!< COO pattern has to be passed to PETSc matrix.
+    std::vector<CooTaskBuffer> coo_task_buffers_;  //!< Values added by tasks of parallel_for block coo_block_.
+    unsigned long coo_block_;    //!< Serial number of parallel_for block of buffered values (see ThreadPool::TaskId).
+
 
     double  solution_precision_; // precision of KSP system solver
 
-    KSP                system;
+    KSP                system;       //!< KSP solver kept between solves, created in setup_ksp.
     KSPConvergedReason reason;
 
+    unsigned int pc_reuse_max_;        //!< Maximal number of solves with changed matrix reusing older preconditioner.
+    double  pc_reuse_iter_growth_;     //!< Allowed relative growth of iterations with reused preconditioner.
+    unsigned int pc_reuse_count_;      //!< Number of changes of matrix since the last setup of preconditioner.
+    int     pc_setup_its_;             //!< Iterations of the first solve after setup of preconditioner (-1 before the solve).
+    bool    pc_rebuild_;               //!< Preconditioner is rebuilt in the next solve.
+
 
 };
 
@@ -0,0 +1,251 @@
+#include "la/local_schur_batch.hh"
+#include "la/local_system.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <armadillo>
+#include "system/asserts.hh"
+
+
+namespace {
+
+/**
+ * LU factorization with partial pivoting of column-major matrix @p a of size N x N (in place).
+ * Returns false if matrix is singular.
+ */
+template <unsigned int N>
+inline bool lu_factorize(double *a, unsigned int *perm)
+{
+    for (unsigned int k=0; k<N; ++k) {
+        unsigned int p = k;
+        double max_val = std::fabs(a[k + N*k]);
+        for (unsigned int i=k+1; i<N; ++i)
+            if (std::fabs(a[i + N*k]) > max_val) {
+                max_val = std::fabs(a[i + N*k]);
+                p = i;
+            }
+        if (max_val == 0.0) return false;
+        perm[k] = p;
+        if (p != k)
+            for (unsigned int j=0; j<N; ++j) std::swap(a[k + N*j], a[p + N*j]);
+
+        double inv_pivot = 1.0 / a[k + N*k];
+        for (unsigned int i=k+1; i<N; ++i) {
+            a[i + N*k] *= inv_pivot;
+            for (unsigned int j=k+1; j<N; ++j)
+                a[i + N*j] -= a[i + N*k] * a[k + N*j];
+        }
+    }
+    return true;
+}
+
+/// Solve system with matrix factorized by lu_factorize, right hand side @p x is rewritten by solution.
+template <unsigned int N>
+inline void lu_solve(const double *lu, const unsigned int *perm, double *x)
+{
+    for (unsigned int k=0; k<N; ++k)
+        if (perm[k] != k) std::swap(x[k], x[perm[k]]);
+    for (unsigned int i=1; i<N; ++i)
+        for (unsigned int j=0; j<i; ++j)
+            x[i] -= lu[i + N*j] * x[j];
+    for (int i=N-1; i>=0; --i) {
+        for (unsigned int j=i+1; j<N; ++j)
+            x[i] -= lu[i + N*j] * x[j];
+        x[i] /= lu[i + N*i];
+    }
+}
+
+/// Copy block A of local system to @p a and factorize it.
+template <unsigned int N>
+inline bool factorize_block(const arma::mat &matrix, double *a, unsigned int *perm)
+{
+    for (unsigned int j=0; j<N; ++j)
+        for (unsigned int i=0; i<N; ++i)
+            a[i + N*j] = matrix(i, j);
+    return lu_factorize<N>(a, perm);
+}
+
+/// Fixed size version of LocalSystem::reconstruct_solution_schur, returns false if block A is singular.
+template <unsigned int N>
+bool reconstruct_fixed(const arma::mat &matrix, const arma::vec &rhs,
+        const arma::vec &schur_solution, arma::vec &reconstructed_solution)
+{
+    double a[N*N], x[N];
+    unsigned int perm[N];
+    if (! factorize_block<N>(matrix, a, perm)) return false;
+
+    // x = b - Bt * schur_solution
+    for (unsigned int i=0; i<N; ++i) {
+        x[i] = rhs(i);
+        for (unsigned int j=0; j<schur_solution.n_elem; ++j)
+            x[i] -= matrix(i, N+j) * schur_solution(j);
+    }
+    lu_solve<N>(a, perm, x);
+
+    reconstructed_solution.set_size(N);
+    for (unsigned int i=0; i<N; ++i) reconstructed_solution(i) = x[i];
+    return true;
+}
+
+} // namespace
+
+
+
+LocalSchurBatch::LocalSchurBatch(unsigned int n_a, unsigned int n_schur)
+: n_a_(n_a), n_schur_(n_schur)
+{
+    ASSERT_GT(n_a_, 0);
+    ASSERT_GT(n_schur_, 0);
+}
+
+
+void LocalSchurBatch::resize(unsigned int n_systems)
+{
+    const unsigned int n = n_a_ + n_schur_;
+    systems_.assign(n_systems, nullptr);
+    data_.assign(n_systems * n*(n+1), 0.0);
+    tile_.resize(n*(n+1) * simd_width);
+}
+
+
+void LocalSchurBatch::reset_system(unsigned int i, LocalSystem &loc, const LocDofVec &dofs)
+{
+    const unsigned int n = n_a_ + n_schur_;
+    ASSERT_LT(i, systems_.size());
+    ASSERT_EQ(dofs.n_elem, n)("Local system size mismatch.");
+    loc.reset(dofs, dofs, &data_[i * n*(n+1)]);
+    systems_[i] = &loc;
+}
+
+
+void LocalSchurBatch::compute_schur_complement(bool negative)
+{
+    for (unsigned int i_first=0; i_first<systems_.size(); i_first+=simd_width) {
+        std::array<bool, simd_width> singular = eliminate_tile(i_first, negative);
+        for (unsigned int l=0; l<simd_width && i_first+l<systems_.size(); ++l)
+            if (singular[l]) compute_schur_complement_generic(i_first+l, negative);
+    }
+}
+
+
+std::array<bool, LocalSchurBatch::simd_width> LocalSchurBatch::eliminate_tile(unsigned int i_first, bool negative)
+{
+    constexpr unsigned int w = simd_width;
+    const unsigned int n = n_a_ + n_schur_;
+    const unsigned int stride = n*(n+1);
+    const unsigned int n_lanes = std::min(w, (unsigned int)systems_.size() - i_first);
+
+    // gather systems of tile, free lanes of last tile repeat its last system
+    for (unsigned int l=0; l<w; ++l) {
+        unsigned int i_sys = i_first + std::min(l, n_lanes-1);
+        ASSERT_PTR(systems_[i_sys]).error("Local system is not reset.");
+        ASSERT(systems_[i_sys]->get_matrix().memptr() == &data_[i_sys * stride]).error("Local system does not use storage of batch.");
+        const double *sys = &data_[i_sys * stride];
+        for (unsigned int k=0; k<stride; ++k) tile_[k*w + l] = sys[k];
+    }
+    // pointers to values of matrix entry (i,j) and of RHS entry i of all systems of tile
+    auto mat = [this, n](unsigned int i, unsigned int j) { return &tile_[(i + n*j) * w]; };
+    double *rhs = &tile_[n*n * w];
+
+    std::array<bool, w> singular;
+    singular.fill(false);
+    double inv_pivot[w], factor[w];
+    for (unsigned int k=0; k<n_a_; ++k) {
+        // partial pivoting in rows of block A, separately for every system
+        for (unsigned int l=0; l<w; ++l) {
+            unsigned int p = k;
+            double max_val = std::fabs(mat(k,k)[l]);
+            for (unsigned int i=k+1; i<n_a_; ++i)
+                if (std::fabs(mat(i,k)[l]) > max_val) {
+                    max_val = std::fabs(mat(i,k)[l]);
+                    p = i;
+                }
+            if (max_val == 0.0) {
+                // elimination of this system is skipped
+                singular[l] = true;
+                inv_pivot[l] = 0.0;
+                continue;
+            }
+            if (p != k) {
+                for (unsigned int j=k; j<n; ++j) std::swap(mat(k,j)[l], mat(p,j)[l]);
+                std::swap(rhs[k*w + l], rhs[p*w + l]);
+            }
+            inv_pivot[l] = 1.0 / mat(k,k)[l];
+        }
+
+        // eliminate column k in rows of block A and block B, block C becomes C - B * invA * Bt
+        for (unsigned int i=k+1; i<n; ++i) {
+            const double *a_ik = mat(i,k);
+            for (unsigned int l=0; l<w; ++l) factor[l] = a_ik[l] * inv_pivot[l];
+            for (unsigned int j=k+1; j<n; ++j) {
+                double *a_ij = mat(i,j);
+                const double *a_kj = mat(k,j);
+                for (unsigned int l=0; l<w; ++l) a_ij[l] -= factor[l] * a_kj[l];
+            }
+            for (unsigned int l=0; l<w; ++l) rhs[i*w + l] -= factor[l] * rhs[k*w + l];
+        }
+    }
+
+    // scatter Schur complements to block C and tail of RHS
+    const double sign = negative ? -1.0 : 1.0;
+    for (unsigned int l=0; l<n_lanes; ++l) {
+        if (singular[l]) continue;
+        double *sys = &data_[(i_first+l) * stride];
+        for (unsigned int j=n_a_; j<n; ++j)
+            for (unsigned int i=n_a_; i<n; ++i)
+                sys[i + n*j] = sign * mat(i,j)[l];
+        for (unsigned int i=n_a_; i<n; ++i)
+            sys[n*n + i] = sign * rhs[i*w + l];
+    }
+    return singular;
+}
+
+
+void LocalSchurBatch::compute_schur_complement_generic(unsigned int i, bool negative)
+{
+    LocalSystem schur;
+    systems_[i]->compute_schur_complement(n_a_, schur, negative);
+
+    const unsigned int n = n_a_ + n_schur_;
+    double *sys = &data_[i * n*(n+1)];
+    for (unsigned int j=0; j<n_schur_; ++j)
+        for (unsigned int k=0; k<n_schur_; ++k)
+            sys[n_a_+k + n*(n_a_+j)] = schur.get_matrix()(k, j);
+    for (unsigned int k=0; k<n_schur_; ++k)
+        sys[n*n + n_a_+k] = schur.get_rhs()(k);
+}
+
+
+void LocalSchurBatch::get_schur_complement(unsigned int i, LocalSystem &schur) const
+{
+    ASSERT_LT(i, systems_.size());
+    const LocalSystem &loc = *systems_[i];
+    const unsigned int n = n_a_ + n_schur_;
+    schur.set_matrix( loc.get_matrix().submat(n_a_, n_a_, n-1, n-1) );
+    schur.set_rhs( loc.get_rhs().tail(n_schur_) );
+}
+
+
+void LocalSchurBatch::reconstruct_solution_schur(const LocalSystem &loc, unsigned int offset,
+        const arma::vec &schur_solution, arma::vec &reconstructed_solution)
+{
+    const arma::mat &matrix = loc.get_matrix();
+    ASSERT_EQ(matrix.n_rows, offset + schur_solution.n_elem)("Schur complement (offset) dimension mismatch.");
+
+    bool done = false;
+    switch (offset) {
+    case 3:
+        done = reconstruct_fixed<3>(matrix, loc.get_rhs(), schur_solution, reconstructed_solution);
+        break;
+    case 4:
+        done = reconstruct_fixed<4>(matrix, loc.get_rhs(), schur_solution, reconstructed_solution);
+        break;
+    case 5:
+        done = reconstruct_fixed<5>(matrix, loc.get_rhs(), schur_solution, reconstructed_solution);
+        break;
+    default:
+        break;
+    }
+    if (!done)
+        loc.reconstruct_solution_schur(offset, schur_solution, reconstructed_solution);
+}
@@ -0,0 +1,92 @@
+#ifndef LOCAL_SCHUR_BATCH_HH_
+#define LOCAL_SCHUR_BATCH_HH_
+
+#include <array>
+#include <vector>
+#include <armadillo>
+#include "system/index_types.hh"
+
+class LocalSystem;
+
+/**
+ * Batch of local systems of the same size, provides their storage and computes their Schur complements at once.
+ *
+ * Local system matrix is split to blocks
+ *
+ *     | A  Bt |
+ *     | B  C  |
+ *
+ * where A is the eliminated block of size @p n_a (velocity and pressure of MH element)
+ * and C is the Schur complement block of size @p n_schur.
+ *
+ * Matrices and RHS of all local systems of the batch are stored contiguously in the batch,
+ * local systems only refer to this memory. Schur complements S = C - B * invA * Bt are computed
+ * by block Gaussian elimination (partial pivoting in block A) on tiles of @p simd_width local systems,
+ * the loops over local systems of the tile are innermost, so they are vectorized by the compiler.
+ * Schur complement (and its RHS) overwrites block C (and the tail of RHS) of the local system,
+ * blocks A, Bt, B and head of RHS are kept for the reconstruction of the solution.
+ * Local systems with singular block A are processed by LocalSystem methods.
+ *
+ * Usage:
+ * 1) set number of local systems (once, storage is kept for all following assemblies)
+ * 2) reset all local systems by reset_system and assemble them
+ * 3) compute Schur complements
+ * 4) get Schur complement of every local system
+ */
+class LocalSchurBatch
+{
+public:
+    /// Number of local systems processed together by the Schur complement kernel.
+    static constexpr unsigned int simd_width = 4;
+
+    /// Constructor, sets sizes of eliminated block and of Schur complement.
+    LocalSchurBatch(unsigned int n_a, unsigned int n_schur);
+
+    /// Set number of local systems and allocate their storage. Local systems must be reset again.
+    void resize(unsigned int n_systems);
+
+    /// Reset @p i-th local system of batch, its matrix and RHS are stored in the batch.
+    void reset_system(unsigned int i, LocalSystem &loc, const LocDofVec &dofs);
+
+    /// Compute Schur complements of all local systems.
+    void compute_schur_complement(bool negative=false);
+
+    /// Set matrix and RHS of @p schur to Schur complement of @p i-th local system.
+    void get_schur_complement(unsigned int i, LocalSystem &schur) const;
+
+    /// Return number of local systems in batch.
+    inline unsigned int size() const
+    { return systems_.size(); }
+
+    /**
+     * Reconstruct solution x = invA * (b - Bt * schur_solution) of single local system,
+     * see LocalSystem::reconstruct_solution_schur.
+     */
+    static void reconstruct_solution_schur(const LocalSystem &loc, unsigned int offset,
+            const arma::vec &schur_solution, arma::vec &reconstructed_solution);
+
+private:
+    /// Eliminate block A of systems [i_first, i_first+simd_width), return flags of systems with singular block A.
+    std::array<bool, simd_width> eliminate_tile(unsigned int i_first, bool negative);
+
+    /// Compute Schur complement of @p i-th local system by LocalSystem (singular block A).
+    void compute_schur_complement_generic(unsigned int i, bool negative);
+
+    /// Size of eliminated block A.
+    unsigned int n_a_;
+
+    /// Size of Schur complement.
+    unsigned int n_schur_;
+
+    /// Local systems of batch.
+    std::vector<LocalSystem *> systems_;
+
+    /// Matrix (column-major) followed by RHS for every local system.
+    std::vector<double> data_;
+
+    /// Tile of local systems, value k of system l is stored at index k*simd_width + l.
+    std::vector<double> tile_;
+};
+
+
+#endif /* LOCAL_SCHUR_BATCH_HH_ */
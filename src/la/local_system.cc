@@ -78,6 +78,23 @@ void LocalSystem::reset(const LocDofVec &rdofs, const LocDofVec &cdofs)
 }
 
 
+void LocalSystem::reset(const LocDofVec &rdofs, const LocDofVec &cdofs, double *mem)
+{
+    if(matrix.memptr() != mem || matrix.n_rows != rdofs.n_rows || matrix.n_cols != cdofs.n_rows)
+    {
+        set_size(rdofs.n_rows, cdofs.n_rows);
+        // non-strict auxiliary memory, move assignment takes over the pointer without copy
+        matrix = arma::mat(mem, rdofs.n_rows, cdofs.n_rows, false, false);
+        rhs = arma::vec(mem + rdofs.n_rows*cdofs.n_rows, rdofs.n_rows, false, false);
+        ASSERT_PERMANENT(matrix.memptr() == mem && rhs.memptr() == mem + matrix.n_elem).error("Local system does not use provided memory.");
+    }
+
+    reset();
+    row_dofs = rdofs;
+    col_dofs = cdofs;
+}
+
+
 
 void LocalSystem::set_solution(uint loc_dof, double solution, double diag)
 {
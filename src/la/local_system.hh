@@ -79,8 +79,15 @@ public:
      */
     void reset(const LocDofVec &row_dofs, const LocDofVec &col_dofs);
 
-    const arma::mat& get_matrix() {return matrix;}
-    const arma::vec& get_rhs() {return rhs;}
+    /**
+     * Same as previous, matrix and RHS are stored in memory @p mem provided by caller:
+     * column-major matrix followed by RHS, i.e. nrows*(ncols+1) values (see LocalSchurBatch).
+     * Memory must be valid until the next call of any reset function with different size.
+     */
+    void reset(const LocDofVec &row_dofs, const LocDofVec &col_dofs, double *mem);
+
+    const arma::mat& get_matrix() const {return matrix;}
+    const arma::vec& get_rhs() const {return rhs;}
     
     /** @brief Set the position and value of known solution. E.g. Dirichlet boundary condition.
      * 
@@ -40,6 +40,9 @@ public:
 
     static constexpr const char * name() { return "StiffnessAssemblyElasticity"; }
 
+    /// Integrals can be evaluated in threads, see ThreadSafeIntegrals.
+    static constexpr bool thread_safe_integrals = true;
+
     /// Constructor.
     StiffnessAssemblyElasticity(EqFields *eq_fields, EqData *eq_data)
     : AssemblyBase<dim>(1), eq_fields_(eq_fields), eq_data_(eq_data) {
@@ -119,6 +122,7 @@ public:
             }
             k++;
         }
+        auto lock = this->lock_shared_data();
         eq_data_->ls->mat_set_values(n_dofs_, dof_indices_.data(), n_dofs_, dof_indices_.data(), &(local_matrix_[0]));
     }
 
@@ -165,6 +169,7 @@ public:
             }
         }
 
+        auto lock = this->lock_shared_data();
         eq_data_->ls->mat_set_values(n_dofs_, dof_indices_.data(), n_dofs_, dof_indices_.data(), &(local_matrix_[0]));
     }
 
@@ -234,8 +239,10 @@ public:
         }
 
         for (unsigned int n=0; n<2; ++n)
-            for (unsigned int m=0; m<2; ++m)
+            for (unsigned int m=0; m<2; ++m) {
+                auto lock = this->lock_shared_data();
                 eq_data_->ls->mat_set_values(n_dofs_ngh_[n], side_dof_indices_[n].data(), n_dofs_ngh_[m], side_dof_indices_[m].data(), &(local_matrix_ngh_[n][m][0]));
+            }
     }
 
 
@@ -289,6 +296,9 @@ public:
 
     static constexpr const char * name() { return "RhsAssemblyElasticity"; }
 
+    /// Integrals can be evaluated in threads, see ThreadSafeIntegrals.
+    static constexpr bool thread_safe_integrals = true;
+
     /// Constructor.
     RhsAssemblyElasticity(EqFields *eq_fields, EqData *eq_data)
     : AssemblyBase<dim>(1), eq_fields_(eq_fields), eq_data_(eq_data) {
@@ -371,6 +381,7 @@ public:
                                 )*eq_fields_->cross_section(p)*fe_values_.JxW(k);
             ++k;
         }
+        auto lock = this->lock_shared_data();
         eq_data_->ls->rhs_set_values(n_dofs_, dof_indices_.data(), &(local_rhs_[0]));
 
 //         for (unsigned int i=0; i<n_dofs_; i++)
@@ -470,6 +481,7 @@ public:
                 ++k;
             }
         }
+        auto lock = this->lock_shared_data();
         eq_data_->ls->rhs_set_values(n_dofs_, dof_indices_.data(), &(local_rhs_[0]));
 
 
@@ -524,8 +536,10 @@ public:
             ++k;
         }
 
-        for (unsigned int n=0; n<2; ++n)
+        for (unsigned int n=0; n<2; ++n) {
+            auto lock = this->lock_shared_data();
             eq_data_->ls->rhs_set_values(n_dofs_ngh_[n], side_dof_indices_[n].data(), &(local_rhs_ngh_[n][0]));
+        }
     }
 
 
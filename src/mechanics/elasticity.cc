@@ -17,6 +17,7 @@
  */
 
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
 #include "mechanics/elasticity.hh"
 #include "mechanics/assembly_elasticity.hh"
 
@@ -26,6 +27,7 @@
 #include "fem/fe_p.hh"
 #include "fem/fe_rt.hh"
 #include "fem/fe_system.hh"
+#include "fem/sparsity_pattern.hh"
 #include "fields/field_fe.hh"
 #include "la/linsys_PETSC.hh"
 #include "la/linsys_PERMON.hh"
@@ -533,10 +535,11 @@ void Elasticity::zero_time_step()
 
 void Elasticity::preallocate()
 {
-    // preallocate system matrix
-	eq_data_->ls->start_allocation();
-    stiffness_assembly_->assemble(eq_data_->dh_);
-    rhs_assembly_->assemble(eq_data_->dh_);
+    // preallocate system matrix, sparsity follows from bulk and coupling integrals
+    SparsityPattern sparsity(eq_data_->dh_);
+    sparsity.add_couplings(SparsityPattern::cell | SparsityPattern::dimjoin);
+    sparsity.finalize();
+    ((LinSys_PETSC *)eq_data_->ls)->preallocate_matrix(sparsity.on_nz(), sparsity.off_nz());
 
     if (has_contact_)
         assemble_constraint_matrix();
@@ -629,6 +632,24 @@ void Elasticity::output_data()
 
 
 
+void Elasticity::save_state(Checkpoint &checkpoint)
+{
+    EquationBase::save_state(checkpoint);
+    checkpoint.save_vector(checkpoint_prefix() + "/displacement", eq_fields_->output_field_ptr->vec());
+}
+
+
+void Elasticity::load_state(const Checkpoint &checkpoint)
+{
+    EquationBase::load_state(checkpoint);
+    checkpoint.load_vector(checkpoint_prefix() + "/displacement", eq_fields_->output_field_ptr->vec());
+    // derived fields (divergence) are used by coupled equations
+    update_output_fields();
+}
+
+
+
+
 void Elasticity::calculate_cumulative_balance()
 {
 //     if (balance_->cumulative())
@@ -191,6 +191,9 @@ public:
     
 	// Recompute fields for output (stress, divergence etc.)
 	void update_output_fields();
+
+	void save_state(Checkpoint &checkpoint) override;
+	void load_state(const Checkpoint &checkpoint) override;
     
     void set_potential_load(const Field<3, FieldValue<3>::Scalar> &potential,
                             const Field<3, FieldValue<3>::Scalar> &ref_potential)
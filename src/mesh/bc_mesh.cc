@@ -18,6 +18,7 @@
 
 
 #include "system/index_types.hh"
+#include "system/mpi_exchange.hh"
 #include "mesh/bc_mesh.hh"
 #include "mesh/accessors.hh"
 #include "mesh/partitioning.hh"
@@ -66,15 +67,61 @@ void BCMesh::init_distribution()
 	for (unsigned int i=0; i<loc_el_ids.size(); i++) this->el_4_loc[i] = loc_el_ids[i];
 
 	this->row_4_el = new LongIdx[n_elements()];
-	vector<LongIdx> row_4_loc_el(n_elements(), 0);
-	for (unsigned int i=0; i<loc_el_ids.size(); i++)
-		row_4_loc_el[loc_el_ids[i]] = i + this->el_ds->begin();
-	MPI_Allreduce(row_4_loc_el.data(), this->row_4_el, n_elements(), MPI_LONG_IDX, MPI_MAX, PETSC_COMM_WORLD);
+	if (parent_mesh_->is_distributed()) {
+		this->distribute_ghost_rows(loc_el_ids);
+	} else {
+		vector<LongIdx> row_4_loc_el(n_elements(), 0);
+		for (unsigned int i=0; i<loc_el_ids.size(); i++)
+			row_4_loc_el[loc_el_ids[i]] = i + this->el_ds->begin();
+		MPI_Allreduce(row_4_loc_el.data(), this->row_4_el, n_elements(), MPI_LONG_IDX, MPI_MAX, PETSC_COMM_WORLD);
+	}
 
 	make_neighbours_and_edges();
 }
 
 
+void BCMesh::distribute_ghost_rows(const vector<LongIdx> &loc_el_ids)
+{
+	// boundary elements of other elements than parent's own and ghost ones are not known
+	std::fill(this->row_4_el, this->row_4_el + n_elements(), -1);
+	for (unsigned int i=0; i<loc_el_ids.size(); i++)
+		this->row_4_el[loc_el_ids[i]] = i + this->el_ds->begin();
+
+	// request rows of boundary elements of ghost parent elements from their owners, by pair (parent id, side idx)
+	MPI_Comm comm = parent_mesh_->get_comm();
+	unsigned int n_procs = this->el_ds->np();
+	vector< vector<unsigned int> > requests(n_procs);
+	vector< vector<LongIdx> > requested_bc_idx(n_procs);
+	for (auto parent_el : parent_mesh_->elements_range()) {
+		if (parent_el.proc() == this->el_ds->myp()) continue;
+		for (unsigned int sid=0; sid<parent_el->n_sides(); sid++)
+			if (parent_el.side(sid)->is_boundary()) {
+				requests[parent_el.proc()].push_back( parent_mesh_->find_elem_id(parent_el.idx()) );
+				requests[parent_el.proc()].push_back(sid);
+				requested_bc_idx[parent_el.proc()].push_back( parent_el.side(sid)->cond().element_accessor().idx() );
+			}
+	}
+
+	// answer requests of other processes, side can be on boundary of ghost layer of requesting process only
+	vector<unsigned int> received;
+	vector<int> n_received;
+	mpi_exchange(comm, MPI_UNSIGNED, requests, received, n_received);
+	vector< vector<LongIdx> > answers(n_procs);
+	unsigned int i_rcv = 0;
+	for (unsigned int proc=0; proc<n_procs; ++proc)
+		for (int i=0; i<n_received[proc]; i+=2, i_rcv+=2) {
+			auto parent_el = parent_mesh_->element_accessor( parent_mesh_->elem_index(received[i_rcv]) );
+			auto side = parent_el.side(received[i_rcv+1]);
+			answers[proc].push_back( side->is_boundary() ? this->row_4_el[side->cond().element_accessor().idx()] : -1 );
+		}
+	vector<LongIdx> rows;
+	mpi_exchange(comm, MPI_LONG_IDX, answers, rows);
+	unsigned int i_row = 0;
+	for (auto &proc_bc_idx : requested_bc_idx)
+		for (LongIdx bc_idx : proc_bc_idx) this->row_4_el[bc_idx] = rows[i_row++];
+}
+
+
 Partitioning *BCMesh::get_part() {
     return parent_mesh_->get_part();
 }
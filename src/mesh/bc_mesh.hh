@@ -63,6 +63,12 @@ private:
     /// setup distribution of elements and related vectors
     void init_distribution();
 
+    /**
+     * Set row_4_el of boundary elements if parent mesh is distributed (see Mesh::set_element_owners).
+     * Rows of boundary elements of ghost parent elements are received from owners of parent elements.
+     */
+    void distribute_ghost_rows(const std::vector<LongIdx> &loc_el_ids);
+
     void make_neighbours_and_edges();
 
     // unused methods (should not be used)
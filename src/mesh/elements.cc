@@ -35,11 +35,12 @@
 Element::Element()
 : boundary_idx_(NULL),
   neigh_vb(NULL),
-  inverted(false),
   pid_(0),
   n_neighs_vb_(0),
-  dim_(0)
+  dim_(0),
+  inverted(false)
 {
+    edge_idx_.fill(undef_idx);
 }
 
 
@@ -58,12 +59,8 @@ void Element::init(unsigned int dim, RegionIdx reg) {
     dim_=dim;
     region_idx_=reg;
 
-    edge_idx_.resize( n_sides() );
     boundary_idx_ = NULL;
-
-    for (unsigned int si=0; si<this->n_sides(); si++) {
-        edge_idx_[ si ]=undef_idx;
-    }
+    edge_idx_.fill(undef_idx);
 }
 
 
@@ -24,6 +24,7 @@
 #include <ostream>                             // for operator<<
 #include <string>                              // for operator<<
 #include <vector>                              // for vector
+#include <array>                               // for array
 #include <armadillo>
 #include "system/index_types.hh"
 #include "mesh/region.hh"                      // for RegionIdx, Region
@@ -76,37 +77,41 @@ public:
 
     // TODO move data members to protected part, add access trough getters or use direct access of friend class Mesh
 
-    unsigned int *boundary_idx_; // Possible boundaries on sides (REMOVE) all bcd assembly should be done through iterating over boundaries
+    unsigned int *boundary_idx_; // Possible boundaries on sides, points to contiguous array MeshBase::boundary_idx_data_ (NULL if element has no boundary side)
                            // ?? deal.ii has this not only boundary iterators
                            // TODO remove direct access in balance, side and transport
 
-    Neighbour **neigh_vb; // List og neighbours, V-B type (comp.)
+    Neighbour **neigh_vb; // List og neighbours, V-B type (comp.), points to contiguous array MeshBase::neigh_vb_data_
         // TODO remove direct access in DarcyFlow, MhDofHandler, Mesh? Partitioning and Trabsport
 
 
-    /// Inverted permutation of element nodes, negative Jacobian.
-    bool inverted;
-
     /// Index of permutation of input nodes.
     // TODO: Output full mesh after optimizations and drop this and global node and element permutatitons
     uint permutation_;
 
 protected:
+    // Members are ordered by size to avoid padding, fixed size arrays avoid heap allocation per element.
+
+    /// indices to element's nodes
+    std::array<unsigned int, 4> nodes_;
+
+    /// Edges on sides, only first n_sides() items are used
+    std::array<unsigned int, 4> edge_idx_;
+
     int pid_;                            ///< Id # of mesh partition
-    std::vector<unsigned int> edge_idx_; ///< Edges on sides
     mutable unsigned int n_neighs_vb_;   ///< # of neighbours, V-B type (comp.)
                                          // only ngh from this element to higher dimension edge
                                          // TODO fix and remove mutable directive
 
-
-
     // Data readed from mesh file
     RegionIdx  region_idx_;
     unsigned int dim_;
 
-    /// indices to element's nodes
-    std::array<unsigned int, 4> nodes_;
+public:
+    /// Inverted permutation of element nodes, negative Jacobian.
+    bool inverted;
 
+protected:
     friend class MeshBase;
     friend class Mesh;
     friend class BCMesh;
@@ -133,7 +138,7 @@ inline unsigned int Element::n_sides() const {
 }
 
 inline unsigned int Element::edge_idx(unsigned int edg_idx) const {
-	ASSERT(edg_idx<edge_idx_.size())(edg_idx)(edge_idx_.size()).error("Index of Edge is out of bound!");
+	ASSERT(edg_idx<n_sides())(edg_idx)(n_sides()).error("Index of Edge is out of bound!");
 	return edge_idx_[edg_idx];
 }
 
@@ -19,6 +19,8 @@
 
 #include <unistd.h>
 #include <set>
+#include <atomic>
+#include <algorithm>
 #include <unordered_map>
 
 #include "system/system.hh"
@@ -28,6 +30,7 @@
 #include "input/input_type.hh"
 #include "input/accessors.hh"
 #include "system/sys_profiler.hh"
+#include "system/mpi_exchange.hh"
 #include "la/distribution.hh"
 
 #include "mesh/mesh.h"
@@ -73,6 +76,9 @@ MeshBase::MeshBase()
     duplicate_nodes_(nullptr),
     region_db_(make_shared<RegionDB>())
 {
+    static std::atomic<unsigned int> n_meshes(0);
+    serial_number_ = n_meshes++;
+
         // Initialize numbering of nodes on sides.
     // This is temporary solution, until class Element is templated
     // by dimension. Then we can replace Mesh::side_nodes by
@@ -110,12 +116,6 @@ MeshBase::~MeshBase()
     for(EdgeData &edg : this->edges)
         if (edg.side_) delete[] edg.side_;
 
-    for (unsigned int idx=0; idx < element_vec_.size(); idx++) {
-    	Element *ele=&(element_vec_[idx]);
-        if (ele->boundary_idx_) delete[] ele->boundary_idx_;
-        if (ele->neigh_vb) delete[] ele->neigh_vb;
-    }
-
     if (row_4_el != nullptr) delete[] row_4_el;
     if (el_4_loc != nullptr) delete[] el_4_loc;
     if (el_ds != nullptr) delete el_ds;
@@ -149,7 +149,33 @@ unsigned int MeshBase::n_vb_neighbours() const
 std::array<std::pair<uint,uint>, 6> _comparisons = { {{0,1},{0,2},{0,3},{1,2},{1,3},{2,3}} };
 
 
-void MeshBase::canonical_faces() {
+void MeshBase::init_boundary_idx(const std::vector<unsigned int> &side_boundary) {
+    ASSERT_EQ(side_boundary.size(), 4*element_vec_.size());
+    auto has_boundary = [&side_boundary](const Element &ele, unsigned int idx) {
+        return std::any_of(side_boundary.begin() + 4*idx, side_boundary.begin() + 4*idx + ele.n_sides(),
+                [](unsigned int bdr_idx) { return bdr_idx != undef_idx; });
+    };
+
+    unsigned int size = 0;
+    for (unsigned int idx=0; idx<element_vec_.size(); ++idx)
+        if (has_boundary(element_vec_[idx], idx)) size += element_vec_[idx].n_sides();
+
+    // Elements point to their parts of one contiguous array
+    boundary_idx_data_.assign(size, undef_idx);
+    unsigned int offset = 0;
+    for (unsigned int idx=0; idx<element_vec_.size(); ++idx) {
+        Element &ele = element_vec_[idx];
+        ele.boundary_idx_ = nullptr;
+        if (has_boundary(ele, idx)) {
+            ele.boundary_idx_ = &boundary_idx_data_[offset];
+            std::copy(side_boundary.begin() + 4*idx, side_boundary.begin() + 4*idx + ele.n_sides(), ele.boundary_idx_);
+            offset += ele.n_sides();
+        }
+    }
+}
+
+
+void MeshBase::init_element_nodes_original() {
 	// Fill mappings from canonical element nodes to original
 	// for individual permitations.
 	// Permutations are numbered by the bifield of all six _comparisons.
@@ -177,8 +203,12 @@ void MeshBase::canonical_faces() {
 	element_nodes_original_[59] = {3,1,2,0};
 	element_nodes_original_[31] = {3,2,0,1};
 	element_nodes_original_[63] = {3,2,1,0};
+}
 
 
+void MeshBase::canonical_faces() {
+    init_element_nodes_original();
+
     // element_vec_ still contains both bulk and boundary elements
     for (uint i_el=0; i_el < element_vec_.size(); i_el++) {
         Element &ele = element_vec_[i_el];
@@ -233,6 +263,15 @@ const IT::Record & Mesh::get_input_type() {
                      "Output file with neighboring data from mesh.")
         .declare_key("optimize_mesh", IT::Bool(), IT::Default("true"), "If true, permute nodes and elements in order to increase cache locality. "
         		     "This will speed up the calculations. GMSH output preserves original ordering but is slower. All variants of VTK output use the permuted.")
+        .declare_key("snapshot", IT::Bool(), IT::Default("false"), "If true, binary snapshot of the GMSH mesh file is stored next to the file "
+                     "(with suffix '.snapshot'). In next runs with this key set, snapshot matching content of the GMSH file and value of 'optimize_mesh' "
+                     "is mapped to memory instead of parsing, optimization and setup of topology of the mesh.")
+        .declare_key("distributed_reading", IT::Bool(), IT::Default("false"), "If true, parsing of nodes and elements of the GMSH mesh file "
+                     "is divided between processes. Elements are partitioned in parallel and every process holds only its own elements "
+                     "and the layer of ghost elements, so memory per process does not grow with size of the whole mesh. "
+                     "Key 'partitioning' and 'snapshot' are not used, serial output of continuous mesh is not supported (use parallel VTK output). "
+                     "FieldFE data with 'equivalent_mesh' interpolation are mapped by element ids (as 'identic_mesh') to own and ghost elements, "
+                     "interpolations 'P0_gauss' and 'P0_intersection' read whole source mesh on every process.")
         .close();
 }
 
@@ -291,6 +330,9 @@ void Mesh::init()
     }
 
     optimize_memory_locality = in_record_.val<bool>("optimize_mesh");
+    is_optimized_ = false;
+    has_topology_ = false;
+    is_distributed_ = false;
 
     n_insides = NDEF;
     n_exsides = NDEF;
@@ -441,37 +483,67 @@ void Mesh::check_mesh_on_read() {
 
 
 
-void Mesh::setup_topology() {
-    if (optimize_memory_locality) {
+void Mesh::apply_optimization() {
+    if (optimize_memory_locality && !is_optimized_) {
         START_TIMER("MESH - optimizer");
         this->optimize();
         END_TIMER("MESH - optimizer");
+        is_optimized_ = true;
     }
+}
 
-    START_TIMER("MESH - setup topology");
 
-    canonical_faces();
-    check_mesh_on_read();
+void Mesh::set_optimized_permutations(const std::vector<unsigned int> &node_permutation,
+        const std::vector<unsigned int> &elem_permutation) {
+    // unused nodes can be removed by check_mesh_on_read after optimization
+    ASSERT_GE(node_permutation.size(), this->n_nodes());
+    ASSERT_EQ(elem_permutation.size(), this->n_elements());
+    node_permutation_ = node_permutation;
+    elem_permutation_ = elem_permutation;
+    is_optimized_ = true;
+}
+
 
+void Mesh::setup_topology() {
+    this->apply_optimization();
 
-    make_neighbours_and_edges();
+    START_TIMER("MESH - setup topology");
+
+    if (has_topology_) {
+        // nodes of elements are in canonical order, edges and neighbours are read from snapshot
+        init_element_nodes_original();
+        bc_mesh_->init_element_nodes_original();
+    } else {
+        canonical_faces();
+        check_mesh_on_read();
+        make_neighbours_and_edges();
+    }
     element_to_neigh_vb();
     count_side_types();
+    std::size_t topology_mem = topology_memory_size(), per_element_mem = per_element_topology_memory_size();
+    MessageOut().fmt( "Mesh topology uses {:.1f} MB ({} B per element), per element heap arrays would use {:.1f} MB ({} B per element).\n",
+            topology_mem / 1048576.0, topology_mem / std::max(n_elements(), 1u),
+            per_element_mem / 1048576.0, per_element_mem / std::max(n_elements(), 1u) );
     
     this->duplicate_nodes_ = new DuplicateNodes(this);
 
-    part_ = std::make_shared<Partitioning>(this, in_record_.val<Input::Record>("partitioning") );
-
-    // create parallel distribution and numbering of elements
-    LongIdx *id_4_old = new LongIdx[n_elements()];
-    int i = 0;
-    for (auto ele : this->elements_range())
-        id_4_old[i++] = ele.idx();
-    part_->id_maps(n_elements(), id_4_old, el_ds, el_4_loc, row_4_el);
+    if (is_distributed_) {
+        // elements are distributed by reader
+        this->distribute_elements();
+        part_ = std::make_shared<Partitioning>(this, in_record_.val<Input::Record>("partitioning"), *el_ds);
+    } else {
+        part_ = std::make_shared<Partitioning>(this, in_record_.val<Input::Record>("partitioning") );
+
+        // create parallel distribution and numbering of elements
+        LongIdx *id_4_old = new LongIdx[n_elements()];
+        int i = 0;
+        for (auto ele : this->elements_range())
+            id_4_old[i++] = ele.idx();
+        part_->id_maps(n_elements(), id_4_old, el_ds, el_4_loc, row_4_el);
+        delete[] id_4_old;
+    }
     bc_mesh_->init_distribution();
     bc_mesh_->duplicate_nodes_ = new DuplicateNodes(bc_mesh_);
-
-    delete[] id_4_old;
     
     this->distribute_nodes();
 
@@ -479,6 +551,118 @@ void Mesh::setup_topology() {
 }
 
 
+void Mesh::get_topology_data(TopologyData &data) {
+    data.n_bulk_elements = this->n_elements();
+    data.elements.clear();
+    data.elements.reserve( this->n_elements() + bc_mesh_->n_elements() );
+    auto add_elements = [&data](const MeshBase &elm_mesh) {
+        for (auto elm_acc : elm_mesh.elements_range()) {
+            const Element &elm = *elm_acc.element();
+            TopologyData::ElementData elm_data;
+            elm_data.id = elm_mesh.find_elem_id(elm_acc.idx());
+            elm_data.dim = elm.dim();
+            elm_data.region_id = elm_acc.region().id();
+            elm_data.partition_id = elm.pid();
+            for (unsigned int i=0; i<4; ++i) {
+                elm_data.nodes[i] = elm.nodes_[i];
+                elm_data.edge_idx[i] = elm.edge_idx_[i];
+                elm_data.boundary_idx[i] = (elm.boundary_idx_ != nullptr && i < elm.n_sides()) ? elm.boundary_idx_[i] : undef_idx;
+            }
+            elm_data.permutation = elm.permutation_;
+            elm_data.inverted = elm.inverted;
+            data.elements.push_back(elm_data);
+        }
+    };
+    add_elements(*this);
+    add_elements(*bc_mesh_);
+
+    data.edge_offsets.assign(1, 0);
+    data.edge_sides.clear();
+    for (const EdgeData &edg : edges) {
+        for (unsigned int i=0; i<edg.n_sides; ++i)
+            data.edge_sides.push_back({ edg.side_[i]->elem_idx(), edg.side_[i]->side_idx() });
+        data.edge_offsets.push_back( data.edge_sides.size() );
+    }
+
+    data.boundaries.clear();
+    for (const BoundaryData &bdr : boundary_)
+        data.boundaries.push_back({ bdr.edge_idx_, bdr.bc_ele_idx_ });
+
+    data.neighbours.clear();
+    for (const Neighbour &ngh : vb_neighbours_)
+        data.neighbours.push_back({ ngh.elem_idx_, ngh.edge_idx_ });
+
+    std::copy(max_edge_sides_, max_edge_sides_ + 3, data.max_edge_sides.begin());
+}
+
+
+void Mesh::set_topology_data(const TopologyData &data) {
+    ASSERT_LE(data.n_bulk_elements, data.elements.size());
+    std::vector<unsigned int> side_boundary(4*data.n_bulk_elements, undef_idx);
+    this->init_element_vector( data.n_bulk_elements );
+    bc_mesh_->init_element_vector( data.elements.size() - data.n_bulk_elements );
+    for (unsigned int i=0; i<data.elements.size(); ++i) {
+        const TopologyData::ElementData &elm_data = data.elements[i];
+        bool is_boundary = (i >= data.n_bulk_elements);
+        RegionIdx region_idx;
+        if (is_boundary && elm_data.id < 0) {
+            // boundary element created by make_neighbours_and_edges
+            region_idx = region_db_->implicit_boundary_region();
+        } else {
+            region_idx = region_db_->get_region( elm_data.region_id, elm_data.dim );
+            if ( !region_idx.is_valid() )
+                region_idx = region_db_->add_region( elm_data.region_id, region_db_->create_label_from_id(elm_data.region_id),
+                        elm_data.dim, "$Element" );
+        }
+        region_db_->mark_used_region(region_idx.idx());
+
+        Element *ele = add_element_to_vector(elm_data.id, is_boundary);
+        ele->init(elm_data.dim, region_idx);
+        ele->pid_ = elm_data.partition_id;
+        for (unsigned int j=0; j<4; ++j) {
+            ele->nodes_[j] = elm_data.nodes[j];
+            ele->edge_idx_[j] = elm_data.edge_idx[j];
+        }
+        ele->permutation_ = elm_data.permutation;
+        ele->inverted = elm_data.inverted;
+        if (!is_boundary)
+            std::copy(elm_data.boundary_idx, elm_data.boundary_idx + 4, side_boundary.begin() + 4*i);
+    }
+    this->init_boundary_idx(side_boundary);
+
+    edges.resize( data.edge_offsets.size() - 1 );
+    for (unsigned int i=0; i<edges.size(); ++i) {
+        EdgeData &edg = edges[i];
+        edg.n_sides = data.edge_offsets[i+1] - data.edge_offsets[i];
+        edg.side_ = new struct SideIter[ edg.n_sides ];
+        for (unsigned int j=0; j<edg.n_sides; ++j) {
+            const std::array<std::uint32_t, 2> &side = data.edge_sides[ data.edge_offsets[i] + j ];
+            edg.side_[j] = SideIter( Side(this, side[0], side[1]) );
+        }
+    }
+
+    boundary_.resize( data.boundaries.size() );
+    for (unsigned int i=0; i<boundary_.size(); ++i) {
+        boundary_[i].edge_idx_ = data.boundaries[i][0];
+        boundary_[i].bc_ele_idx_ = data.boundaries[i][1];
+        if (boundary_[i].edge_idx_ != undef_idx) boundary_[i].mesh_ = this;
+    }
+
+    Neighbour neighbour;
+    neighbour.mesh_ = this;
+    vb_neighbours_.clear();
+    vb_neighbours_.reserve( data.neighbours.size() );
+    for (const std::array<std::uint32_t, 2> &ngh : data.neighbours) {
+        neighbour.elem_idx_ = ngh[0];
+        neighbour.edge_idx_ = ngh[1];
+        vb_neighbours_.push_back(neighbour);
+    }
+
+    std::copy(data.max_edge_sides.begin(), data.max_edge_sides.end(), max_edge_sides_);
+    has_topology_ = true;
+}
+
+
 void Mesh::optimize() {
     MeshOptimizer<3> mo(this);
     mo.calculate_sizes();
@@ -637,6 +821,8 @@ void Mesh::make_neighbours_and_edges()
 
 	vector<unsigned int> side_nodes;
 	vector<unsigned int> intersection_list; // list of elements in intersection of node element lists
+	// boundary indices of element sides, moved to contiguous boundary_idx_data_ at the end
+	vector<unsigned int> side_boundary(4*element_vec_.size(), undef_idx);
 
 	for( unsigned int i=0; i<bc_mesh()->n_elements(); ++i) {
 
@@ -678,8 +864,8 @@ void Mesh::make_neighbours_and_edges()
                     SideIter si = elem.side(ecs);
                     if ( same_sides( si, side_nodes) ) {
                         if (elem->edge_idx(ecs) != undef_idx) {
-                        	ASSERT_PTR(elem->boundary_idx_).error("Null boundary idx array.\n");
-                            int last_bc_ele_idx=this->boundary_[elem->boundary_idx_[ecs]].bc_ele_idx_;
+                        	ASSERT(side_boundary[4*elem.idx()+ecs] != undef_idx).error("Undefined boundary idx.\n");
+                            int last_bc_ele_idx=this->boundary_[side_boundary[4*elem.idx()+ecs]].bc_ele_idx_;
                             int new_bc_ele_idx=i;
                             THROW( ExcDuplicateBoundary()
                                     << EI_ElemLast(bc_mesh_->find_elem_id(last_bc_ele_idx))
@@ -690,13 +876,7 @@ void Mesh::make_neighbours_and_edges()
                         }
                         element_vec_[*isect].edge_idx_[ecs] = last_edge_idx;
                         edg->side_[ edg->n_sides++ ] = si;
-
-                        if (elem->boundary_idx_ == NULL) {
-                        	Element *el = &(element_vec_[*isect]);
-                        	el->boundary_idx_ = new unsigned int [ el->n_sides() ];
-                            std::fill( el->boundary_idx_, el->boundary_idx_ + el->n_sides(), undef_idx);
-                        }
-                        elem->boundary_idx_[ecs] = bdr_idx;
+                        side_boundary[4*elem.idx()+ecs] = bdr_idx;
                         break; // next element in intersection list
                     }
                 }
@@ -735,21 +915,15 @@ void Mesh::make_neighbours_and_edges()
 
                 if (intersection_list.size() == 1) {
                 	// outer edge, create boundary object as well
-                	Element &elm = element_vec_[e.idx()];
                     edg->n_sides=1;
                     edg->side_[0] = e.side(s);
                     element_vec_[e.idx()].edge_idx_[s] = last_edge_idx;
 
-                    if (e->boundary_idx_ == NULL) {
-                    	elm.boundary_idx_ = new unsigned int [ e->n_sides() ];
-                        std::fill( elm.boundary_idx_, elm.boundary_idx_ + e->n_sides(), undef_idx);
-                    }
-
                     unsigned int bdr_idx=boundary_.size()+1; // need for VTK mesh that has no boundary elements
                                                              // and bulk elements are indexed from 0
                     boundary_.resize(bdr_idx+1);
                     BoundaryData &bdr=boundary_.back();
-                    elm.boundary_idx_[s] = bdr_idx;
+                    side_boundary[4*e.idx()+s] = bdr_idx;
 
                     // fill boundary element
                     Element * bc_ele = add_element_to_vector(-bdr_idx, true);
@@ -804,6 +978,7 @@ void Mesh::make_neighbours_and_edges()
 				ASSERT_EQ( (unsigned int) edg->n_sides, intersection_list.size())(e.input_id())(s).error("Missing edge sides.");
 		} // for element sides
 	}   // for elements
+	this->init_boundary_idx(side_boundary);
 
 	MessageOut().fmt( "Created {} edges and {} neighbours.\n", edges.size(), vb_neighbours_.size() );
 }
@@ -824,12 +999,17 @@ void Mesh::element_to_neigh_vb()
     // count vb neighs per element
     for (auto & ngh : this->vb_neighbours_)  ngh.element()->n_neighs_vb_++;
 
-    // Allocation of the array per element
-    for (vector<Element>::iterator ele = element_vec_.begin(); ele!= element_vec_.end(); ++ele)
+    // Elements point to their parts of one contiguous array
+    neigh_vb_data_.assign(vb_neighbours_.size(), nullptr);
+    unsigned int offset = 0;
+    for (vector<Element>::iterator ele = element_vec_.begin(); ele!= element_vec_.end(); ++ele) {
+        ele->neigh_vb = nullptr;
         if( ele->n_neighs_vb() > 0 ) {
-            ele->neigh_vb = new struct Neighbour* [ele->n_neighs_vb()];
+            ele->neigh_vb = &neigh_vb_data_[offset];
+            offset += ele->n_neighs_vb();
             ele->n_neighs_vb_=0;
         }
+    }
 
     // fill
     ElementAccessor<3> ele;
@@ -1305,6 +1485,62 @@ void Mesh::output_internal_ngh_data()
 
 
 
+void Mesh::set_element_owners(std::unordered_map<unsigned int, unsigned int> &&owners) {
+    element_owners_ = std::move(owners);
+    is_distributed_ = true;
+}
+
+
+void Mesh::distribute_elements() {
+    int my_proc, n_procs;
+    MPI_Comm_rank(comm_, &my_proc);
+    MPI_Comm_size(comm_, &n_procs);
+
+    // own elements in order of mesh, ids of ghost elements are sorted by owners
+    std::vector<LongIdx> own_idx;
+    std::vector< std::vector<unsigned int> > ghost_ids(n_procs);
+    std::vector< std::vector<LongIdx> > ghost_idx(n_procs);
+    for (auto ele : this->elements_range()) {
+        unsigned int elm_id = this->find_elem_id(ele.idx());
+        auto it = element_owners_.find(elm_id);
+        ASSERT_PERMANENT(it != element_owners_.end())(elm_id).error("Missing owner of element of distributed mesh.");
+        if ((int)it->second == my_proc) {
+            own_idx.push_back(ele.idx());
+        } else {
+            ghost_ids[it->second].push_back(elm_id);
+            ghost_idx[it->second].push_back(ele.idx());
+        }
+    }
+
+    el_ds = new Distribution(own_idx.size(), comm_);
+    el_4_loc = new LongIdx[own_idx.size()];
+    row_4_el = new LongIdx[n_elements()];
+    for (unsigned int i=0; i<own_idx.size(); ++i) {
+        el_4_loc[i] = own_idx[i];
+        row_4_el[own_idx[i]] = el_ds->begin() + i;
+    }
+
+    // send rows of own elements requested as ghosts by other processes
+    std::vector<unsigned int> requested_ids;
+    std::vector<int> n_requested;
+    mpi_exchange(comm_, MPI_UNSIGNED, ghost_ids, requested_ids, n_requested);
+    std::vector< std::vector<LongIdx> > requested_rows(n_procs);
+    unsigned int i_req = 0;
+    for (int proc=0; proc<n_procs; ++proc)
+        for (int i=0; i<n_requested[proc]; ++i, ++i_req) {
+            int idx = this->elem_index(requested_ids[i_req]);
+            ASSERT_PERMANENT(idx >= 0 && (int)element_owners_[requested_ids[i_req]] == my_proc)(requested_ids[i_req])
+                    .error("Requested element is not own element of process.");
+            requested_rows[proc].push_back(row_4_el[idx]);
+        }
+    std::vector<LongIdx> ghost_rows;
+    mpi_exchange(comm_, MPI_LONG_IDX, requested_rows, ghost_rows);
+    unsigned int i_ghost = 0;
+    for (auto &proc_idx : ghost_idx)
+        for (LongIdx idx : proc_idx) row_4_el[idx] = ghost_rows[i_ghost++];
+}
+
+
 void Mesh::distribute_nodes() {
     ASSERT_PTR(el_4_loc).error("Array 'el_4_loc' is not initialized. Did you call Partitioning::id_maps?\n");
 
@@ -1365,5 +1601,37 @@ const Neighbour &MeshBase::vb_neighbour(unsigned int nb) const
     return vb_neighbours_[nb];
 }
 
+
+std::size_t MeshBase::topology_memory_size() const
+{
+    std::size_t mem = element_vec_.capacity() * sizeof(Element)
+                    + edges.capacity() * sizeof(EdgeData)
+                    + vb_neighbours_.capacity() * sizeof(Neighbour)
+                    + neigh_vb_data_.capacity() * sizeof(Neighbour *)
+                    + boundary_idx_data_.capacity() * sizeof(unsigned int);
+    for (const EdgeData &edg : edges)
+        mem += edg.n_sides * sizeof(SideIter);
+    return mem;
+}
+
+
+std::size_t MeshBase::per_element_topology_memory_size() const
+{
+    // size of heap block of glibc allocator: 8 B header, 16 B alignment, 32 B minimum
+    auto heap_block = [](std::size_t size) -> std::size_t {
+        return std::max<std::size_t>(32, (size + 8 + 15) & ~std::size_t(15));
+    };
+    std::size_t mem = topology_memory_size()
+                    - neigh_vb_data_.capacity() * sizeof(Neighbour *)
+                    - boundary_idx_data_.capacity() * sizeof(unsigned int);
+    for (const Element &ele : element_vec_) {
+        // std::vector of edges (header of vector in Element instead of fixed array) and arrays of neighbours and boundaries
+        mem += sizeof(std::vector<unsigned int>) - sizeof(ele.edge_idx_) + heap_block(ele.n_sides() * sizeof(unsigned int));
+        if (ele.n_neighs_vb() > 0) mem += heap_block(ele.n_neighs_vb() * sizeof(Neighbour *));
+        if (ele.boundary_idx_) mem += heap_block(ele.n_sides() * sizeof(unsigned int));
+    }
+    return mem;
+}
+
 //-----------------------------------------------------------------------------
 // vim: set cindent:
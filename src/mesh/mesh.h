@@ -19,10 +19,13 @@
 #define MAKE_MESH_H
 
 #include <mpi.h>                             // for MPI_Comm, MPI_COMM_WORLD
+#include <array>                             // for array
+#include <cstdint>                           // for uint32_t, int32_t
 
 //#include <boost/range.hpp>
 #include <memory>                            // for shared_ptr
 #include <string>                            // for string
+#include <unordered_map>                     // for unordered_map
 #include <vector>                            // for vector, vector<>::iterator
 #include "input/accessors.hh"                // for Record, Array (ptr only)
 #include "input/accessors_impl.hh"           // for Record::val
@@ -92,6 +95,44 @@ struct EquivalentMeshMap{
 };
 
 
+/**
+ * Sparse operator of interpolation of elementwise data between non-matching meshes.
+ *
+ * Stored in CSR format, one row per element of target (computational) mesh. Value on target element
+ * target_elm[i] is given as sum of weight[k] * (value on source element source_elm[k]) for
+ * k = row_offset[i], ..., row_offset[i+1]-1. Operator depends only on the geometry of both meshes,
+ * so it is computed once and applied to all time frames of data (see ReaderCache::interpolation_map).
+ */
+struct InterpolationMap{
+    std::vector<unsigned int> row_offset;
+    std::vector<unsigned int> target_elm;
+    std::vector<unsigned int> source_elm;
+    std::vector<double> weight;
+
+    InterpolationMap()
+    : row_offset(1, 0)
+    {}
+
+    /// Return number of rows (target elements).
+    inline unsigned int n_rows() const
+    { return target_elm.size(); }
+
+    /// Add entry to last row.
+    inline void add(unsigned int source_idx, double w)
+    {
+        source_elm.push_back(source_idx);
+        weight.push_back(w);
+    }
+
+    /// Close last row, start the new one with given target element.
+    inline void close_row(unsigned int target_idx)
+    {
+        target_elm.push_back(target_idx);
+        row_offset.push_back(source_elm.size());
+    }
+};
+
+
 /// Base class for Mesh and BCMesh.
 class MeshBase {
 public:
@@ -128,12 +169,29 @@ public:
     const Element &element(unsigned idx) const
     { return element_vec_[idx]; }
 
+    /// Serial number of the mesh, unique during the run (unlike address, it is never reused by other mesh).
+    inline unsigned int serial_number() const
+    { return serial_number_; }
+
     /// Return edge with given index.
     Edge edge(uint edge_idx) const;
 
     /// Return neighbour with given index.
     const Neighbour &vb_neighbour(unsigned int nb) const;
 
+    /**
+     * Return memory (in bytes) allocated by topology data of the mesh: elements, edges,
+     * VB neighbours and their per element arrays. Used for memory report in setup_topology.
+     */
+    std::size_t topology_memory_size() const;
+
+    /**
+     * Return estimate of memory (in bytes) of the same topology data, if per element arrays (edges,
+     * VB neighbours and boundaries) were allocated as separate heap blocks of every element.
+     * Used to report saving of contiguous arrays in setup_topology.
+     */
+    std::size_t per_element_topology_memory_size() const;
+
     /// Return element id (in GMSH file) of element of given position in element vector.
     int find_elem_id(unsigned int pos) const
     { return element_ids_[pos]; }
@@ -267,6 +325,15 @@ protected:
      */
     void canonical_faces();
 
+    /// Fill table element_nodes_original_ of mappings from canonical element nodes to original.
+    void init_element_nodes_original();
+
+    /**
+     * Fill boundary_idx_data_ and set Element::boundary_idx_ of elements with at least one boundary side.
+     * @param side_boundary Boundary index of every side (4 per element) or undef_idx.
+     */
+    void init_boundary_idx(const std::vector<unsigned int> &side_boundary);
+
     /**
      * Create element lists for nodes in Mesh::nodes_elements.
      */
@@ -303,6 +370,15 @@ protected:
     /// Vector of compatible neighbourings.
     vector<Neighbour> vb_neighbours_;
 
+    /// Pointers to VB neighbours of all elements stored contiguously, Element::neigh_vb points to this array (CSR like storage).
+    vector<Neighbour *> neigh_vb_data_;
+
+    /// Boundary indices of sides of elements with a boundary side stored contiguously, Element::boundary_idx_ points to this array.
+    vector<unsigned int> boundary_idx_data_;
+
+    /// Serial number of the mesh, see serial_number().
+    unsigned int serial_number_;
+
     /// Maximal number of sides per one edge in the actual mesh (set in make_neighbours_and_edges()).
     unsigned int max_edge_sides_[3];
 
@@ -452,6 +528,18 @@ public:
      */
     inline MPI_Comm get_comm() const { return comm_; }
 
+    /**
+     * Set owner processes of elements (element id -> process) of mesh that holds only own elements
+     * of the process and the layer of ghost elements (elements sharing a node with own element),
+     * see DistributedGmshMeshReader. Distribution of elements is then given by owners instead of
+     * partitioning in setup_topology.
+     */
+    void set_element_owners(std::unordered_map<unsigned int, unsigned int> &&owners);
+
+    /// Return true if mesh holds only own and ghost elements of the process, see set_element_owners.
+    inline bool is_distributed() const
+    { return is_distributed_; }
+
 
     MixedMeshIntersections &mixed_intersections();
 
@@ -543,6 +631,66 @@ public:
     void add_element(unsigned int elm_id, unsigned int dim, unsigned int region_id, unsigned int partition_id,
     		std::vector<unsigned int> node_ids);
 
+    /**
+     * Permute nodes and elements by MeshOptimizer if it is allowed by input ('optimize_mesh' key).
+     *
+     * Optimization is performed only once, it is called at the beginning of setup_topology.
+     */
+    void apply_optimization();
+
+    /**
+     * Set permutation vectors of mesh that was read in optimized order (see SnapshotMeshReader).
+     *
+     * Must be called after reading of nodes and elements, following apply_optimization doesn't change the mesh.
+     */
+    void set_optimized_permutations(const std::vector<unsigned int> &node_permutation,
+            const std::vector<unsigned int> &elem_permutation);
+
+    /**
+     * Topology of the mesh stored in plain arrays, used by snapshot of mesh (see SnapshotMeshReader).
+     *
+     * Elements are stored in order bulk elements - boundary elements (including boundary elements created
+     * by make_neighbours_and_edges, they have negative ids), nodes of elements are given by node indices
+     * in canonical order.
+     */
+    struct TopologyData {
+        struct ElementData {
+            std::int32_t id;
+            std::uint32_t dim;
+            std::uint32_t region_id;
+            std::int32_t partition_id;
+            std::uint32_t nodes[4];
+            std::uint32_t edge_idx[4];
+            std::uint32_t boundary_idx[4];        ///< undef_idx for sides without boundary
+            std::uint32_t permutation;
+            std::uint32_t inverted;
+        };
+
+        std::vector<ElementData> elements;
+        std::uint32_t n_bulk_elements;
+        std::vector<std::uint32_t> edge_offsets;                  ///< Sides of edge i are stored in [edge_offsets[i], edge_offsets[i+1])
+        std::vector< std::array<std::uint32_t, 2> > edge_sides;   ///< Element index and side index
+        std::vector< std::array<std::uint32_t, 2> > boundaries;   ///< Edge index and boundary element index
+        std::vector< std::array<std::uint32_t, 2> > neighbours;   ///< Element index and edge index
+        std::array<std::uint32_t, 3> max_edge_sides;
+    };
+
+    /// Fill topology of the mesh to @p data, must be called after setup_topology.
+    void get_topology_data(TopologyData &data);
+
+    /**
+     * Create elements and topology of the mesh from @p data, must be called after reading of nodes.
+     *
+     * Following setup_topology doesn't compute canonical faces, doesn't check elements and doesn't create
+     * edges, neighbours and boundaries.
+     */
+    void set_topology_data(const TopologyData &data);
+
+    /// Set BIH tree of elements read from snapshot of mesh.
+    void set_bih_tree(std::shared_ptr<BIHTree> bih_tree) {
+        bih_tree_ = bih_tree;
+    }
+
     /// Add new node of given id and coordinates to mesh
     void add_physical_name(unsigned int dim, unsigned int id, std::string name);
 
@@ -663,6 +811,12 @@ protected:
      */
     bool optimize_memory_locality;
 
+    /// Flag is set if nodes and elements are permuted by MeshOptimizer (or read in permuted order).
+    bool is_optimized_;
+
+    /// Flag is set if topology is read from snapshot of mesh (see set_topology_data).
+    bool has_topology_;
+
     /**
      * Mesh partitioning. Created in setup_topology.
      */
@@ -701,6 +855,17 @@ private:
     /// Fill array node_4_loc_ and create object node_ds_ according to element distribution.
     void distribute_nodes();
 
+    /**
+     * Create el_ds, el_4_loc and row_4_el of distributed mesh according to element_owners_.
+     * Rows of own elements follow their order in mesh, rows of ghost elements are received from owners.
+     */
+    void distribute_elements();
+
+    /// Owner processes of elements of distributed mesh (element id -> process).
+    std::unordered_map<unsigned int, unsigned int> element_owners_;
+    /// Flag is set if mesh holds only own and ghost elements of the process.
+    bool is_distributed_;
+
 	/// Index set assigning to local node index its global index.
     LongIdx *node_4_loc_;
     /// Parallel distribution of nodes. Depends on elements distribution.
@@ -66,6 +66,16 @@ Partitioning::Partitioning(Mesh *mesh, Input::Record in)
 
 
 
+Partitioning::Partitioning(Mesh *mesh, Input::Record in, const Distribution &el_ds)
+: mesh_(mesh), in_(in), graph_(NULL), loc_part_(NULL), init_el_ds_(NULL)
+{
+    init_el_ds_ = new Distribution(el_ds);
+    loc_part_ = new LongIdx[init_el_ds_->lsize()];
+    for (unsigned int i=0; i<init_el_ds_->lsize(); ++i) loc_part_[i] = init_el_ds_->myp();
+}
+
+
+
 Partitioning::~Partitioning() {
     if (loc_part_) delete [] loc_part_;
     loc_part_ = NULL;
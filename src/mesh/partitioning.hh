@@ -69,6 +69,13 @@ public:
      */
     Partitioning(Mesh *mesh, Input::Record in);
 
+    /**
+     * Constructor of partitioning of distributed mesh, elements are already distributed by @p el_ds
+     * (see Mesh::set_element_owners), so partitioning tool is not called and all own elements stay
+     * on the process.
+     */
+    Partitioning(Mesh *mesh, Input::Record in, const Distribution &el_ds);
+
     /**
      * Get initial distribution.
      */
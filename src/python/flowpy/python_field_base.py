@@ -68,14 +68,18 @@ class PythonFieldBase:
         """ 
         Constructor. Define all generic attributes.
         """
-        # Slice of the quadrature points to evaluate, set by _cache_update.
+        # Quadrature points to evaluate (slice or index array), set by _cache_update and _cache_update_batch.
+        self._points = slice(0, 0)
+        # Range of evaluated points in arrays of the input fields, 'end - begin' is number of points.
         self._region_chunk_begin = 0
         self._region_chunk_end = 0
         # Currently evaluated time.
         self.t = 0.0
-        # Dictionary of the input fields. Access through dot syntax:
+        # Dictionary of the input fields of currently evaluated field. Access through dot syntax:
         # self.<input_field>
         self._used_fields_dict = dict()
+        # Dictionaries of the input fields of all result fields, instance is shared by more result fields.
+        self._result_used_fields = dict()
         # Dictionary of the output fields. No direct access. Reuslts of the user methods are stored
         # in `_cache_update`.
         self._result_fields_dict = dict()
@@ -86,7 +90,7 @@ class PythonFieldBase:
         Example: use 'self.field_name' id equal to 'self.used_fields_dict["field_name"]'
         """
         cache_data = self._used_fields_dict.get(attr, None)
-        return cache_data[..., self._region_chunk_begin:self._region_chunk_end]
+        return cache_data[..., self._points]
         
     @staticmethod
     def repl(x):
@@ -107,13 +111,15 @@ class PythonFieldBase:
     def _cache_reinit(self, time: float, data: List[FieldCacheProxy], result: FieldCacheProxy) -> None:
         """
         Create arrays as wrappers to given C++ field value caches passed as FieldCacheProxy.
-        One reinit is called for every result field.
+        One reinit is called for every result field. Input fields are stored separately
+        for every result field and selected before evaluation of the result field.
         """
-        self._used_fields_dict.clear()
+        self._used_fields_dict = dict()
         for in_field in data:
             in_array = np.array(in_field, copy=False)
             in_array.flags.writeable = False
             self._used_fields_dict[in_field.field_name()] = in_array
+        self._result_used_fields[result.field_name()] = self._used_fields_dict
         self._result_fields_dict[result.field_name()] = np.array(result, copy=False)
         
         self.t = time
@@ -125,17 +131,43 @@ class PythonFieldBase:
         Needs to define the method with same name as name of evaluated field in descendant
         that executes evaluation.
         """
+        self._evaluate(field_name, slice(reg_chunk_begin, reg_chunk_end), reg_chunk_begin, reg_chunk_end)
+
+
+    def _cache_update_batch(self, requests: Dict[str, List[Tuple[int, int]]]) -> None:
+        """
+        Method called from C++ code (PythonFieldBatch), evaluates all fields of the patch
+        registered during one dependency level of FieldSet::cache_update.
+        Requests map field name to the list of chunks (reg_chunk_begin, reg_chunk_end), consecutive
+        chunks are already merged. User method of every field is called once on all its chunks.
+        """
+        for field_name, chunks in requests.items():
+            if len(chunks) == 1:
+                begin, end = chunks[0]
+                self._evaluate(field_name, slice(begin, end), begin, end)
+            else:
+                points = np.concatenate([np.arange(begin, end) for begin, end in chunks])
+                self._evaluate(field_name, points, 0, len(points))
+
+
+    def _evaluate(self, field_name: str, points, reg_chunk_begin: int, reg_chunk_end: int):
+        """
+        Call user method of field `field_name` on given points (slice or index array) and store result
+        to the result field.
+        """
+        self._used_fields_dict = self._result_used_fields[field_name]
+        self._points = points
         self._region_chunk_begin = reg_chunk_begin
         self._region_chunk_end = reg_chunk_end
         res_array = getattr(self, field_name)()
         
         # Check number of dimensions and shape of result array
         result_shape = res_array.shape
-        expect_shape = self._result_fields_dict[field_name][..., self._region_chunk_begin:self._region_chunk_end].shape
+        expect_shape = self._result_fields_dict[field_name].shape[:-1] + (reg_chunk_end - reg_chunk_begin,)
         if result_shape != expect_shape:
             raise ValueError(f"Invalid shape of '{field_name}' method result. Must be {expect_shape}.")
 
-        self._result_fields_dict[field_name][..., self._region_chunk_begin:self._region_chunk_end] = res_array
+        self._result_fields_dict[field_name][..., points] = res_array
 
 
     def _print_fields(self):
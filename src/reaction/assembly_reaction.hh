@@ -305,40 +305,93 @@ public:
             subst_id = eq_data_->substance_global_idx_[i_subst];
 
             Isotherm & isotherm = eq_data_->isotherms[reg_idx_][i_subst];
-
-            bool limited_solubility_on = eq_data_->solubility_vec_[i_subst] > 0.0;
-
-            // in case of no sorbing surface, set isotherm type None
-            if( no_sorbing_surface_cond <= std::numeric_limits<double>::epsilon())
-            {
-                isotherm.reinit(Isotherm::none, false, eq_data_->solvent_density_,
-                                scale_aqua, scale_sorbed,
-                                0,0,0);
-            } else {
-                if ( scale_sorbed <= 0.0)
-                    THROW( SorptionBase::ExcNotPositiveScaling() << SorptionBase::EI_Subst(i_subst) );
-
-                isotherm.reinit(Isotherm::SorptionType(eq_fields_->sorption_type[i_subst](p)),
-                                limited_solubility_on, eq_data_->solvent_density_,
-                                scale_aqua, scale_sorbed,
-                                eq_data_->solubility_vec_[i_subst],
-                                eq_fields_->distribution_coefficient[i_subst](p),
-                                eq_fields_->isotherm_other[i_subst](p));
+            double &table_request = eq_data_->table_request_[reg_idx_][i_subst];
+
+            // isotherm with interpolation table keeps parameters constant on the region
+            if (table_request > 0.0 || !isotherm.is_precomputed()) {
+                bool limited_solubility_on = eq_data_->solubility_vec_[i_subst] > 0.0;
+
+                // in case of no sorbing surface, set isotherm type None
+                if( no_sorbing_surface_cond <= std::numeric_limits<double>::epsilon())
+                {
+                    isotherm.reinit(Isotherm::none, false, eq_data_->solvent_density_,
+                                    scale_aqua, scale_sorbed,
+                                    0,0,0);
+                } else {
+                    if ( scale_sorbed <= 0.0)
+                        THROW( SorptionBase::ExcNotPositiveScaling() << SorptionBase::EI_Subst(i_subst) );
+
+                    isotherm.reinit(Isotherm::SorptionType(eq_fields_->sorption_type[i_subst](p)),
+                                    limited_solubility_on, eq_data_->solvent_density_,
+                                    scale_aqua, scale_sorbed,
+                                    eq_data_->solubility_vec_[i_subst],
+                                    eq_fields_->distribution_coefficient[i_subst](p),
+                                    eq_fields_->isotherm_other[i_subst](p));
+                }
+
+                if (table_request > 0.0) {
+                    isotherm.make_table(eq_data_->n_interpolation_steps_, table_request);
+                    table_request = 0.0;
+                }
             }
 
             double c_aqua = eq_fields_->conc_mobile_fe[subst_id]->vec().get(dof_p0_);
             double c_sorbed = eq_fields_->conc_solid_fe[subst_id]->vec().get(dof_p0_);
+
+            // elements with interpolation table are evaluated together in end()
+            if (isotherm.is_precomputed()) {
+                SorptionBase::EqData::TableBatch &batch = eq_data_->table_batches_[reg_idx_][i_subst];
+                batch.dofs.push_back(dof_p0_);
+                batch.c_aqua.push_back(c_aqua);
+                batch.c_sorbed.push_back(c_sorbed);
+                continue;
+            }
+
             isotherm.compute(c_aqua, c_sorbed);
             eq_fields_->conc_mobile_fe[subst_id]->vec().set(dof_p0_, c_aqua);
             eq_fields_->conc_solid_fe[subst_id]->vec().set(dof_p0_, c_sorbed);
 
             // update maximal concentration per region (optimization for interpolation)
             if(eq_data_->table_limit_[i_subst] < 0)
-                eq_data_->max_conc[reg_idx_][i_subst] = std::max(eq_data_->max_conc[reg_idx_][i_subst],
-                                                      eq_fields_->conc_mobile_fe[subst_id]->vec().get(dof_p0_));
+                eq_data_->max_conc[reg_idx_][i_subst] = std::max(eq_data_->max_conc[reg_idx_][i_subst], c_aqua);
         }
     }
 
+    /**
+     * Evaluate batches of elements gathered by cell_integral by interpolation tables.
+     *
+     * Method is called only on the assembly object of dimension 1, batches of all dimensions
+     * are stored in EqData.
+     */
+    void end() override
+    {
+        for (unsigned int i_reg = 0; i_reg < eq_data_->table_batches_.size(); i_reg++)
+            for (unsigned int i_subst = 0; i_subst < eq_data_->n_substances_; i_subst++)
+            {
+                SorptionBase::EqData::TableBatch &batch = eq_data_->table_batches_[i_reg][i_subst];
+                if (batch.dofs.size() == 0) continue;
+
+                unsigned int subst_id = eq_data_->substance_global_idx_[i_subst];
+                eq_data_->isotherms[i_reg][i_subst].interpolate(batch.c_aqua, batch.c_sorbed);
+
+                VectorMPI &conc_mobile = eq_fields_->conc_mobile_fe[subst_id]->vec();
+                VectorMPI &conc_solid = eq_fields_->conc_solid_fe[subst_id]->vec();
+                double max_conc = eq_data_->max_conc[i_reg][i_subst];
+                for (unsigned int i = 0; i < batch.dofs.size(); i++) {
+                    conc_mobile.set(batch.dofs[i], batch.c_aqua[i]);
+                    conc_solid.set(batch.dofs[i], batch.c_sorbed[i]);
+                    max_conc = std::max(max_conc, batch.c_aqua[i]);
+                }
+                // update maximal concentration per region (optimization for interpolation)
+                if(eq_data_->table_limit_[i_subst] < 0)
+                    eq_data_->max_conc[i_reg][i_subst] = max_conc;
+
+                batch.dofs.clear();
+                batch.c_aqua.clear();
+                batch.c_sorbed.clear();
+            }
+    }
+
 
 private:
     /// Data objects shared with Elasticity
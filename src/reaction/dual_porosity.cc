@@ -23,6 +23,7 @@
 #include "reaction/reaction_term.hh"
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
 
 #include "la/distribution.hh"
 #include "mesh/mesh.h"
@@ -281,6 +282,26 @@ void DualPorosity::compute_reaction(FMT_UNUSED const DHCellAccessor& dh_cell)
 }
 
 
+void DualPorosity::save_state(Checkpoint &checkpoint)
+{
+  EquationBase::save_state(checkpoint);
+  std::string prefix = checkpoint_prefix();
+  for (unsigned int sbi = 0; sbi < eq_fields_->conc_immobile_fe.size(); sbi++)
+    checkpoint.save_vector(prefix + "/conc_immobile/" + std::to_string(sbi), eq_fields_->conc_immobile_fe[sbi]->vec());
+  if (reaction_mobile) reaction_mobile->save_state(checkpoint);
+  if (reaction_immobile) reaction_immobile->save_state(checkpoint);
+}
+
+void DualPorosity::load_state(const Checkpoint &checkpoint)
+{
+  EquationBase::load_state(checkpoint);
+  std::string prefix = checkpoint_prefix();
+  for (unsigned int sbi = 0; sbi < eq_fields_->conc_immobile_fe.size(); sbi++)
+    checkpoint.load_vector(prefix + "/conc_immobile/" + std::to_string(sbi), eq_fields_->conc_immobile_fe[sbi]->vec());
+  if (reaction_mobile) reaction_mobile->load_state(checkpoint);
+  if (reaction_immobile) reaction_immobile->load_state(checkpoint);
+}
+
 void DualPorosity::output_data(void )
 {
     eq_fields_->output_fields.set_time(time_->step(), LimitSide::right);
@@ -127,6 +127,12 @@ public:
   
   /// Main output routine.
   void output_data(void) override;
+
+  /// Store immobile concentrations and state of the reactions in both zones.
+  void save_state(Checkpoint &checkpoint) override;
+
+  /// Restore state stored by @p save_state.
+  void load_state(const Checkpoint &checkpoint) override;
   
 protected:
   /**
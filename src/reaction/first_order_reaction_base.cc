@@ -15,6 +15,8 @@
  * @brief   
  */
 
+#include <algorithm>
+
 #include "reaction/first_order_reaction_base.hh"
 #include "reaction/reaction_term.hh"
 
@@ -105,18 +107,56 @@ void FirstOrderReactionBase::compute_reaction(const DHCellAccessor& dh_cell)
 void FirstOrderReactionBase::update_solution(void)
 {
     //DebugOut() << "FirstOrderReactionBases - update solution\n";
+    begin_block_reaction();
+
+    START_TIMER("linear reaction step");
+
+    if (own_dofs_.empty())
+        for ( DHCellAccessor dh_cell : eq_data_base_->dof_handler_->own_range() )
+            own_dofs_.push_back( dh_cell.get_loc_dof_indices()[0] );
+
+    // gather concentrations of all own elements, one row per element
+    conc_block_.set_size(own_dofs_.size(), n_substances_);
+    for (unsigned int sbi = 0; sbi < n_substances_; sbi++) {
+        VectorMPI &conc_vec = this->eq_fields_base_->conc_mobile_fe[sbi]->vec();
+        double *col = conc_block_.colptr(sbi);
+        for (unsigned int i = 0; i < own_dofs_.size(); i++) col[i] = conc_vec.get(own_dofs_[i]);
+    }
+
+    // compute new concentrations of all elements by single product with exponential of reaction matrix
+    linear_ode_solver_->update_solution(conc_block_);
+
+    // scatter new concentrations
+    for (unsigned int sbi = 0; sbi < n_substances_; sbi++) {
+        VectorMPI &conc_vec = this->eq_fields_base_->conc_mobile_fe[sbi]->vec();
+        const double *col = conc_block_.colptr(sbi);
+        for (unsigned int i = 0; i < own_dofs_.size(); i++) conc_vec.set(own_dofs_[i], col[i]);
+    }
+    END_TIMER("linear reaction step");
+}
+
+
+void FirstOrderReactionBase::begin_block_reaction()
+{
     if(time_->is_changed_dt())
     {
         linear_ode_solver_->set_step(time_->dt());
     }
+}
 
-    START_TIMER("linear reaction step");
+void FirstOrderReactionBase::compute_reaction_block(const std::vector<double *> &conc, unsigned int begin, unsigned int end)
+{
+    ASSERT_EQ(conc.size(), n_substances_);
+    ASSERT_LE(end, eq_data_base_->dof_handler_->lsize());
 
-    for ( DHCellAccessor dh_cell : eq_data_base_->dof_handler_->own_range() )
-    {
-        compute_reaction(dh_cell);
-    }
-    END_TIMER("linear reaction step");
+    conc_block_.set_size(end - begin, n_substances_);
+    for (unsigned int sbi = 0; sbi < n_substances_; sbi++)
+        std::copy(conc[sbi] + begin, conc[sbi] + end, conc_block_.colptr(sbi));
+
+    linear_ode_solver_->update_solution(conc_block_);
+
+    for (unsigned int sbi = 0; sbi < n_substances_; sbi++)
+        std::copy(conc_block_.colptr(sbi), conc_block_.colptr(sbi) + (end - begin), conc[sbi] + begin);
 }
 
 
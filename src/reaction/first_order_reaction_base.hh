@@ -60,9 +60,21 @@ public:
                 
     /// Updates the solution. 
     /**
-     * Goes through local distribution of elements and calls @p compute_reaction.
+     * Gathers concentrations on all local elements to block @p conc_block_, computes the reaction
+     * by single product with the reaction matrix and scatters the result back (same result as
+     * @p compute_reaction called on every element).
      */
     void update_solution(void) override;
+
+    /// Reaction acts on every element independently.
+    bool allows_block_reaction() const override
+    { return true; }
+
+    /// Update the solution matrix if the time step has changed.
+    void begin_block_reaction() override;
+
+    /// Computes the reaction on a block of elements by single product with the reaction matrix.
+    void compute_reaction_block(const std::vector<double *> &conc, unsigned int begin, unsigned int end) override;
     
 protected:
     /// Assembles the matrix of the ODEs.
@@ -106,6 +118,8 @@ protected:
     
     arma::mat reaction_matrix_;   ///< Reaction matrix.
     arma::vec prev_conc_;      ///< Column vector storing previous concetrations on an element.
+    arma::mat conc_block_;     ///< Concentrations on all local elements, one row per element (used in update_solution).
+    std::vector<IntIdx> own_dofs_; ///< Local indices of P0 dofs of own elements (rows of @p conc_block_).
     
     arma::mat molar_matrix_;      ///< Diagonal matrix with molar masses of substances.
     arma::mat molar_mat_inverse_; ///< Inverse of @p molar_matrix_.
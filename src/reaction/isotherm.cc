@@ -16,6 +16,7 @@
  */
 
 #include "reaction/isotherm.hh"
+#include "system/asserts.hh"
 #include "system/sys_profiler.hh"
 #include "system/logger.hh"
 
@@ -97,6 +98,40 @@ void Isotherm::interpolate( double &c_aqua, double &c_sorbed )
 }
 
 
+void Isotherm::interpolate( std::vector<double> &c_aqua, std::vector<double> &c_sorbed )
+{
+    ASSERT_EQ(c_aqua.size(), c_sorbed.size());
+    // if sorption is switched off, do not compute anything
+    if(adsorption_type_ == SorptionType::none)
+        return;
+
+    const unsigned int n_values = c_aqua.size();
+    const double *table = interpolation_table.data();
+    const double last_idx = interpolation_table.size() - 1;
+    double *aqua = c_aqua.data();
+    double *sorbed = c_sorbed.data();
+    std::vector<unsigned int> out_of_table;
+
+    for (unsigned int i=0; i<n_values; i++) {
+        double total_mass = scale_aqua_ * aqua[i] + scale_sorbed_ * sorbed[i];
+        double total_mass_steps = total_mass / total_mass_step_;
+        // negative total mass is left to compute_projection, which throws
+        if ( !(total_mass_steps >= 0.0 && total_mass_steps < last_idx) ) {
+            out_of_table.push_back(i);
+            continue;
+        }
+        unsigned int total_mass_idx = static_cast <unsigned int>(total_mass_steps);
+        double rot_sorbed = table[total_mass_idx]
+                            + (total_mass_steps - total_mass_idx)*(table[total_mass_idx+1] - table[total_mass_idx]);
+        aqua[i] = total_mass * inv_scale_aqua_ - rot_sorbed * inv_scale_sorbed_;
+        sorbed[i] = total_mass * inv_scale_sorbed_ + rot_sorbed * inv_scale_aqua_;
+    }
+
+    for (unsigned int i : out_of_table)
+        interpolate(c_aqua[i], c_sorbed[i]);
+}
+
+
 Isotherm::ConcPair Isotherm::compute_projection( Isotherm::ConcPair c_pair )
 {
     double total_mass = get_total_mass(c_pair);
@@ -233,6 +233,14 @@ public:
      */
     void interpolate(double &c_aqua, double &c_sorbed);
 
+    /**
+     * Vectorized version of @p interpolate applied to concentrations of many elements.
+     * Table lookup is done in a single loop over all values, values with total mass out of the table
+     * are computed afterwards by @p precipitate or by the nonlinear solver.
+     * Assumes previous call to @p make_table.
+     */
+    void interpolate(std::vector<double> &c_aqua, std::vector<double> &c_sorbed);
+
     /**
      * Returns true if interpolation table is created.
      */
@@ -17,6 +17,7 @@
 
 #include "reaction/linear_ode_solver.hh"
 
+#include <algorithm>
 #include "armadillo"
 #include "input/accessors.hh"
 
@@ -45,16 +46,35 @@ void LinearODESolver::set_step(double step)
     step_changed_ = true;
 }
 
-void LinearODESolver::update_solution(arma::vec& init_vector, arma::vec& output_vec)
+void LinearODESolver::update_solution_matrix()
 {
     if(step_changed_ || system_matrix_changed_)
     {
-        solution_matrix_ = arma::expmat(system_matrix_*step_);    //coefficients multiplied by time
+        auto it = std::find_if(solution_cache_.begin(), solution_cache_.end(),
+                [this](const SolutionMatrixItem &item) {
+                    return (item.step == step_) && arma::approx_equal(item.system_matrix, system_matrix_, "absdiff", 0.0);
+                });
+        if (it != solution_cache_.end())
+            solution_matrix_ = it->solution_matrix;
+        else {
+            solution_matrix_ = arma::expmat(system_matrix_*step_);    //coefficients multiplied by time
+            if (solution_cache_.size() == max_cache_size) solution_cache_.pop_front();
+            solution_cache_.push_back( {system_matrix_, step_, solution_matrix_} );
+        }
         step_changed_ = false;
         system_matrix_changed_ = false;
     }
-    
-    output_vec = solution_matrix_ * init_vector;
 }
 
+void LinearODESolver::update_solution(arma::vec& init_vector, arma::vec& output_vec)
+{
+    update_solution_matrix();
+    output_vec = solution_matrix_ * init_vector;
+}
 
+void LinearODESolver::update_solution(arma::mat& conc_block)
+{
+    update_solution_matrix();
+    // rows are initial vectors: (S * c)^T = c^T * S^T, single matrix-matrix product
+    conc_block = conc_block * solution_matrix_.t();
+}
@@ -20,6 +20,7 @@
 
 
 
+#include <deque>                                       // for deque
 #include <iosfwd>                                      // for stringstream
 #include <string>                                      // for string, basic_...
 #include <vector>                                      // for vector
@@ -50,10 +51,32 @@ public:
      * @param output_vec is the column output vector containing the result
      */
     void update_solution(arma::vec &init_vec, arma::vec &output_vec);
-                                 
+
+    /// Updates solution of the ODEs system for a block of initial vectors at once.
+    /**
+     * @param conc_block is the matrix with one initial vector per row (e.g. concentrations on one element),
+     *        it is rewritten by the result
+     */
+    void update_solution(arma::mat &conc_block);
+
 protected:
+    /// Item of cache of solution matrices.
+    struct SolutionMatrixItem {
+        arma::mat system_matrix;
+        double step;
+        arma::mat solution_matrix;
+    };
+
+    /// Maximal number of items in @p solution_cache_.
+    static const unsigned int max_cache_size = 8;
+
+    /// Updates solution_matrix_ if system matrix or step has been changed, uses @p solution_cache_.
+    void update_solution_matrix();
+
     arma::mat system_matrix_;     ///< the square matrix of ODE system
     arma::mat solution_matrix_;   ///< the square solution matrix (exponential of system matrix)
+    /// Solution matrices of recently used pairs (system matrix, step), expmat is evaluated only for new pairs.
+    std::deque<SolutionMatrixItem> solution_cache_;
     arma::vec rhs_;               ///< the column vector of RHS values (not used currently)
     double step_;           ///< the step of the numerical method
     bool step_changed_;     ///< flag is true if the step has been changed
@@ -67,3 +67,15 @@ void ReactionTerm::choose_next_time(void)
 {
   ASSERT(0).error("ReactionTerm does not change TimeGovernor.\n");
 }
+
+
+void ReactionTerm::begin_block_reaction()
+{
+  ASSERT_PERMANENT(false).error("Block reaction is not supported by this reaction term.\n");
+}
+
+
+void ReactionTerm::compute_reaction_block(const std::vector<double *> &, unsigned int, unsigned int)
+{
+  ASSERT_PERMANENT(false).error("Block reaction is not supported by this reaction term.\n");
+}
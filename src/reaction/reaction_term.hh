@@ -23,6 +23,7 @@
 
 #include <memory>                    // for shared_ptr
 #include <string>                    // for string
+#include <vector>                    // for vector
 #include "coupling/equation.hh"      // for EquationBase
 #include "system/index_types.hh"     // for LongInt
 #include "input/input_exception.hh"  // for DECLARE_INPUT_EXCEPTION, Exception
@@ -138,6 +139,22 @@ public:
     /// Disable changes in TimeGovernor by empty method.
     void choose_next_time(void) override;
 
+    /**
+     * Return true if the reaction acts on every element independently and it can be computed
+     * on blocks of elements by @p compute_reaction_block (fused with the transport step).
+     */
+    virtual bool allows_block_reaction() const
+    { return false; }
+
+    /// Prepare the block reaction of the current time step, called before the first block.
+    virtual void begin_block_reaction();
+
+    /**
+     * Compute reaction on elements with local DOF indices [begin, end).
+     * @p conc contains local arrays of mobile concentrations of all substances.
+     */
+    virtual void compute_reaction_block(const std::vector<double *> &conc, unsigned int begin, unsigned int end);
+
 protected:
     /// Compute reaction on a single element.
     virtual void compute_reaction(const DHCellAccessor& dh_cell) = 0;
@@ -100,6 +100,7 @@ SorptionDual::EqFields::EqFields(const string &output_field_name, const string &
             .flags_add(FieldFlag::input_copy)
             .name("porosity_immobile")
             .set_limits(0.0);
+    isotherm_field_set_ += immob_porosity_;
 }
 
 SorptionDual::SorptionDual(Mesh &init_mesh, Input::Record in_rec,
@@ -25,6 +25,7 @@
 
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
 
 #include "la/distribution.hh"
 #include "mesh/mesh.h"
@@ -106,6 +107,10 @@ SorptionBase::EqFields::EqFields(const string &output_field_name, const string &
             .units( UnitSI().dimensionless() );
 
     input_field_set_ += *this;
+    isotherm_field_set_ += rock_density;
+    isotherm_field_set_ += sorption_type;
+    isotherm_field_set_ += distribution_coefficient;
+    isotherm_field_set_ += isotherm_other;
 
     // porosity field is set from governing equation (transport) later
     // hence we do not add it to the input_field_set_
@@ -114,6 +119,7 @@ SorptionBase::EqFields::EqFields(const string &output_field_name, const string &
             .units( UnitSI::dimensionless() )
             .flags(FieldFlag::input_copy)
 			.set_limits(0.0);
+    isotherm_field_set_ += porosity;
     
     output_fields += *this;
     output_fields += conc_solid.name(output_field_name)
@@ -202,10 +208,14 @@ void SorptionBase::initialize()
   unsigned int nr_of_regions = mesh_->region_db().bulk_size();
   eq_data_->isotherms.resize(nr_of_regions);
   eq_data_->max_conc.resize(nr_of_regions);
+  eq_data_->table_request_.resize(nr_of_regions);
+  eq_data_->table_batches_.resize(nr_of_regions);
   for(unsigned int i_reg = 0; i_reg < nr_of_regions; i_reg++)
   {
     eq_data_->isotherms[i_reg].resize(eq_data_->n_substances_);
     eq_data_->max_conc[i_reg].resize(eq_data_->n_substances_, 0.0);
+    eq_data_->table_request_[i_reg].resize(eq_data_->n_substances_, 0.0);
+    eq_data_->table_batches_[i_reg].resize(eq_data_->n_substances_);
     for(unsigned int i_subst = 0; i_subst < eq_data_->n_substances_; i_subst++)
     {
       eq_data_->isotherms[i_reg][i_subst] = Isotherm();
@@ -284,7 +294,7 @@ void SorptionBase::initialize_substance_ids()
 void SorptionBase::initialize_from_input()
 {
     // read number of interpolation steps - value checked by the record definition
-    n_interpolation_steps_ = input_record_.val<int>("substeps");
+    eq_data_->n_interpolation_steps_ = input_record_.val<int>("substeps");
     
     // read the density of solvent - value checked by the record definition
     eq_data_->solvent_density_ = input_record_.val<double>("solvent_density");
@@ -500,21 +510,16 @@ void SorptionBase::make_tables(void)
         {
             int reg_idx = reg_iter.bulk_idx();
             // true if data has been changed and are constant on the region
-            bool call_reinit = eq_fields_->changed() && eq_fields_->is_constant(reg_iter);
+            bool is_constant = eq_fields_->isotherm_field_set_.is_constant(reg_iter);
+            bool call_reinit = eq_fields_->isotherm_field_set_.changed() && is_constant;
             
-//            if(call_reinit)
-//            {
-//                ElementAccessor<3> elm(this->mesh_, reg_iter);
-////                 DebugOut().fmt("isotherm reinit\n");
-//                isotherm_reinit_all(elm);
-//            }
-            
-            // find table limit and create interpolation table for every substance
+            // find table limit and request interpolation table for every substance
             for(unsigned int i_subst = 0; i_subst < eq_data_->n_substances_; i_subst++){
                 
                 // clear interpolation tables, if not spacially constant OR switched off
-                if(! eq_fields_->is_constant(reg_iter) || eq_data_->table_limit_[i_subst] == 0.0){
+                if(! is_constant || eq_data_->table_limit_[i_subst] == 0.0){
                     eq_data_->isotherms[reg_idx][i_subst].clear_table();
+                    eq_data_->table_request_[reg_idx][i_subst] = 0.0;
 //                     DebugOut().fmt("limit: 0.0 -> clear table\n");
                     continue;
                 }
@@ -538,11 +543,15 @@ void SorptionBase::make_tables(void)
                 else
                 {
                     subst_table_limit = eq_data_->table_limit_[i_subst];
+                    call_make_table = call_make_table || (subst_table_limit != eq_data_->isotherms[reg_idx][i_subst].table_limit());
                 }
                 
+                // isotherm parameters are known only in assembly, table is created there (see ReactionAssemblySorp)
                 if(call_make_table){
-                    eq_data_->isotherms[reg_idx][i_subst].make_table(n_interpolation_steps_, subst_table_limit);
-//                     DebugOut().fmt("reg: {} i_subst {}: table_limit = {}\n", reg_idx, i_subst, eq_data_->isotherms[reg_idx][i_subst].table_limit());
+                    if(subst_table_limit > 0.0)
+                        eq_data_->table_request_[reg_idx][i_subst] = subst_table_limit;
+                    else
+                        eq_data_->isotherms[reg_idx][i_subst].clear_table();
                 }
             }
         }
@@ -602,6 +611,26 @@ void SorptionBase::compute_reaction(FMT_UNUSED const DHCellAccessor& dh_cell)
 
 /**************************************** OUTPUT ***************************************************/
 
+void SorptionBase::save_state(Checkpoint &checkpoint)
+{
+  EquationBase::save_state(checkpoint);
+  std::string prefix = checkpoint_prefix();
+  for (unsigned int sbi = 0; sbi < eq_fields_->conc_solid_fe.size(); sbi++)
+    checkpoint.save_vector(prefix + "/conc_solid/" + std::to_string(sbi), eq_fields_->conc_solid_fe[sbi]->vec());
+  if (reaction_liquid) reaction_liquid->save_state(checkpoint);
+  if (reaction_solid) reaction_solid->save_state(checkpoint);
+}
+
+void SorptionBase::load_state(const Checkpoint &checkpoint)
+{
+  EquationBase::load_state(checkpoint);
+  std::string prefix = checkpoint_prefix();
+  for (unsigned int sbi = 0; sbi < eq_fields_->conc_solid_fe.size(); sbi++)
+    checkpoint.load_vector(prefix + "/conc_solid/" + std::to_string(sbi), eq_fields_->conc_solid_fe[sbi]->vec());
+  if (reaction_liquid) reaction_liquid->load_state(checkpoint);
+  if (reaction_solid) reaction_solid->load_state(checkpoint);
+}
+
 void SorptionBase::output_data(void )
 {
     eq_fields_->output_fields.set_time(time().step(), LimitSide::right);
@@ -39,6 +39,7 @@
 #include "input/type_base.hh"           // for Array
 #include "input/type_generic.hh"        // for Instance
 #include "petscvec.h"                   // for Vec, VecScatter, _p_VecScatter
+#include "system/index_types.hh"        // for IntIdx
 //
 #include "system/exceptions.hh"         // for operator<<, ExcStream, EI
 
@@ -109,6 +110,9 @@ public:
     /// Input data set - fields in this set are read from the input file.
     FieldSet input_field_set_;
 
+    /// Fields determining parameters of isotherms, interpolation tables are used on regions where all of them are constant.
+    FieldSet isotherm_field_set_;
+
     /// Fields indended for output, i.e. all input fields plus those representing solution.
     EquationOutput output_fields;
 
@@ -157,6 +161,24 @@ public:
      * lenght in cocidered system of coordinates, just function values are stored.
      */
     std::vector<std::vector<Isotherm> > isotherms;
+
+    /// Number of steps of interpolation tables.
+    unsigned int n_interpolation_steps_;
+    /**
+     * Table limits of isotherms requested by @p make_tables, |nr_of_region x nr_of_substances|.
+     * Positive value means that the interpolation table is (re)created from isotherm parameters
+     * evaluated on the first element of the region during the next assembly.
+     */
+    std::vector<std::vector<double>> table_request_;
+
+    /// Concentrations of elements gathered for evaluation by interpolation table of one isotherm.
+    struct TableBatch {
+        std::vector<IntIdx> dofs;      ///< Local DOF indices of elements.
+        std::vector<double> c_aqua;    ///< Aqueous concentrations.
+        std::vector<double> c_sorbed;  ///< Sorbed concentrations.
+    };
+    /// Batches of elements evaluated by interpolation tables, |nr_of_region x nr_of_substances|.
+    std::vector<std::vector<TableBatch>> table_batches_;
   };
 
 
@@ -188,6 +210,12 @@ public:
   void update_solution(void) override;
   
   void output_data(void) override;
+
+  /// Store sorbed concentrations and state of the chained reactions.
+  void save_state(Checkpoint &checkpoint) override;
+
+  /// Restore state stored by @p save_state.
+  void load_state(const Checkpoint &checkpoint) override;
   
     
 protected:
@@ -225,7 +253,8 @@ protected:
 //  void isotherm_reinit_all(const ElementAccessor<3> &elm);
   
     /**
-   * Creates interpolation table for isotherms.
+   * Decides which interpolation tables of isotherms have to be (re)created or cleared.
+   * Tables are created during the next assembly, see EqData::table_request_.
    */
   void make_tables(void);
   
@@ -241,11 +270,6 @@ protected:
   std::shared_ptr<EqFields> eq_fields_;  ///< Pointer to equation fields. The object is constructed in descendants.
   std::shared_ptr<EqData> eq_data_;      ///< Equation data
 
-  /**
-   * Temporary nr_of_points can be computed using step_length. Should be |nr_of_region x nr_of_substances| matrix later.
-   */
-  unsigned int n_interpolation_steps_;
-  
   /**
    * Reaction model that follows the sorption.
    */
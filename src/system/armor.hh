@@ -31,6 +31,8 @@
 //#define ARMA_NO_DEBUG
 #include <armadillo>
 #include <array>
+#include <new>
+#include <type_traits>
 #include "system/asserts.hh"
 #include "system/logger.hh"
 
@@ -592,10 +594,24 @@ using ArmaVec = typename arma::Col<Type>::template fixed<nr>;
  * Array of Armor::Mat with given shape. Provides contiguous storage for the data and access to the array elements.
  * The shape of the matrices is specified at run time, so the class Array is independent of additional template parameters.
  * However, to access the array elements, one must use the templated method get().
+ *
+ * Data are stored in structure-of-arrays layout: every component (i_row, i_col) of matrices is stored in separate
+ * contiguous block, see operator(). Blocks are aligned to simd_alignment and their size (reserved size of array)
+ * is rounded up to multiple of SIMD width, so loops over one component can be vectorized.
  */
 template<class Type>
 class Array {
+    static_assert(std::is_trivial<Type>::value, "Armor::Array allows only trivial types of items.");
 public:
+    /// Alignment (in bytes) of data blocks of components, corresponds to cache line and AVX-512 register size.
+    static constexpr uint simd_alignment = 64;
+
+    /// Return given size rounded up to multiple of number of items fitting into simd_alignment.
+    static inline uint aligned_size(uint size) {
+        constexpr uint block = (simd_alignment / sizeof(Type) > 0) ? simd_alignment / sizeof(Type) : 1;
+        return (size + block - 1) / block * block;
+    }
+
     class ArrayMatSet {
         Type * ptr_;
         uint n_rows_, n_cols_;
@@ -657,24 +673,22 @@ public:
      * @param nc    Number of columns in each matrix.
      */
     Array(uint nr, uint nc = 1, uint size = 0)
-    : data_(new Type[nr * nc * size]),
+    : data_(allocate(nr * nc * aligned_size(size))),
       n_rows_(nr),
       n_cols_(nc),
       size_(size),
-      reserved_(size)
+      reserved_(aligned_size(size))
     {
     }
     
     Array(const Array &other)
     : Array(other.n_rows_, other.n_cols_, other.size_)
     {
-        for(uint i = 0; i < n_rows_ * n_cols_ * size(); i++) {
-            data_[i] = other.data_[i];
-        }
+        this->copy_data(other);
     }
 
     ~Array() {
-        delete [] data_;
+        deallocate(data_);
         data_ = nullptr;
     }
 
@@ -684,9 +698,7 @@ public:
         reinit(other.size());
         resize(other.size());
 
-        for(uint i = 0; i < n_rows_ * n_cols_ * size(); i++) {
-            data_[i] = other.data_[i];
-        }
+        this->copy_data(other);
         return *this;
     }
 
@@ -744,11 +756,11 @@ public:
      * @param size  New size of array.
      */
     void reinit(uint size) {
-        delete [] data_;
+        deallocate(data_);
         data_ = nullptr;
-        reserved_ = size;
+        reserved_ = aligned_size(size);
         size_ = 0;
-        data_ = new Type[n_rows_ * n_cols_ * reserved_];
+        data_ = allocate(n_rows_ * n_cols_ * reserved_);
     }
 
 
@@ -777,6 +789,13 @@ public:
         return size_;
     }
 
+    /**
+     * Get size of allocated space of one component (distance between components in data_).
+     */
+    inline unsigned int reserved() const {
+        return reserved_;
+    }
+
     /**
      * Increase active space by 1 and store given Mat value to the end of the active space.
      */
@@ -922,6 +941,23 @@ public:
 
 private:
     inline uint space_() { return n_rows_ * n_cols_ * reserved_; }
+
+    /// Copy active part of data of other array of same shape, reserved sizes can differ.
+    inline void copy_data(const Array &other) {
+        for(uint i_comp = 0; i_comp < n_rows_ * n_cols_; i_comp++)
+            for(uint i = 0; i < size_; i++)
+                data_[i_comp * reserved_ + i] = other.data_[i_comp * other.reserved_ + i];
+    }
+
+    /// Allocate aligned (see simd_alignment) uninitialized storage of given number of items.
+    static inline Type * allocate(uint n_items) {
+        return static_cast<Type *>( ::operator new[](n_items * sizeof(Type), std::align_val_t(simd_alignment)) );
+    }
+
+    /// Release storage allocated by allocate.
+    static inline void deallocate(Type *ptr) {
+        if (ptr != nullptr) ::operator delete[](ptr, std::align_val_t(simd_alignment));
+    }
     uint n_rows_;
     uint n_cols_;
     uint size_;
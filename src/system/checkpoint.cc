@@ -0,0 +1,267 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    checkpoint.cc
+ * @brief   Binary snapshot of simulation state used for restart.
+ */
+
+#include "system/checkpoint.hh"
+#include "system/asserts.hh"
+#include "system/file_path.hh"
+#include "system/sys_profiler.hh"
+#include "system/system.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+
+namespace {
+
+/// Identification of checkpoint files, followed by format version.
+const char checkpoint_magic[] = "FLOW123D_CHECKPOINT";
+const unsigned int checkpoint_version = 1;
+
+/// Append raw bytes of @p value to @p buffer.
+template <class T>
+inline void append_raw(std::vector<char> &buffer, const T *value, std::size_t n = 1)
+{
+    const char *bytes = reinterpret_cast<const char *>(value);
+    buffer.insert(buffer.end(), bytes, bytes + n*sizeof(T));
+}
+
+/// Read raw bytes to @p value, return false at the end of stream.
+template <class T>
+inline bool read_raw(std::istream &in, T *value, std::size_t n = 1)
+{
+    in.read(reinterpret_cast<char *>(value), n*sizeof(T));
+    return (bool)in;
+}
+
+/// Write @p buffer to temporary file and rename it to @p file_name.
+void write_buffer(const std::string &file_name, const std::vector<char> &buffer)
+{
+    std::string tmp_name = file_name + ".tmp";
+    {
+        std::ofstream out(tmp_name, std::ios::binary | std::ios::trunc);
+        if (! out.is_open()) THROW( FilePath::ExcFileOpen() << FilePath::EI_Path(tmp_name) );
+        out.write(buffer.data(), buffer.size());
+        out.close();
+        if (out.fail()) THROW( Checkpoint::ExcCheckpointFile() << Checkpoint::EI_File(tmp_name) );
+    }
+    if (std::rename(tmp_name.c_str(), file_name.c_str()) != 0)
+        THROW( Checkpoint::ExcCheckpointFile() << Checkpoint::EI_File(file_name) );
+}
+
+} // namespace
+
+
+double Checkpoint::restart_time_ = -std::numeric_limits<double>::infinity();
+
+
+Checkpoint::Checkpoint()
+{}
+
+
+Checkpoint::~Checkpoint()
+{
+    if (pending_write_.valid()) pending_write_.wait();
+}
+
+
+std::string Checkpoint::rank_file_name(const std::string &base_name, int rank)
+{
+    std::stringstream ss;
+    ss << base_name << "." << rank << ".chk";
+    return ss.str();
+}
+
+
+void Checkpoint::save(const std::string &key, const std::vector<double> &values)
+{
+    items_[key] = values;
+}
+
+
+void Checkpoint::save(const std::string &key, double value)
+{
+    items_[key] = std::vector<double>(1, value);
+}
+
+
+void Checkpoint::save_petsc_vec(const std::string &key, Vec vec)
+{
+    PetscInt size;
+    const PetscScalar *array;
+    chkerr(VecGetLocalSize(vec, &size));
+    chkerr(VecGetArrayRead(vec, &array));
+    items_[key] = std::vector<double>(array, array + size);
+    chkerr(VecRestoreArrayRead(vec, &array));
+}
+
+
+bool Checkpoint::has(const std::string &key) const
+{
+    return items_.find(key) != items_.end();
+}
+
+
+const std::vector<double> &Checkpoint::load(const std::string &key) const
+{
+    auto it = items_.find(key);
+    if (it == items_.end())
+        THROW( ExcMissingItem() << EI_Key(key) << EI_File(file_name_) );
+    return it->second;
+}
+
+
+const std::vector<double> &Checkpoint::load(const std::string &key, unsigned int size) const
+{
+    const std::vector<double> &values = this->load(key);
+    if (values.size() != size)
+        THROW( ExcItemSize() << EI_Key(key) << EI_File(file_name_) << EI_Size(values.size()) << EI_ExpectedSize(size) );
+    return values;
+}
+
+
+double Checkpoint::load_value(const std::string &key) const
+{
+    return this->load(key, 1)[0];
+}
+
+
+void Checkpoint::load_petsc_vec(const std::string &key, Vec vec) const
+{
+    PetscInt size;
+    PetscScalar *array;
+    chkerr(VecGetLocalSize(vec, &size));
+    const std::vector<double> &values = this->load(key, size);
+    chkerr(VecGetArray(vec, &array));
+    std::copy(values.begin(), values.end(), array);
+    chkerr(VecRestoreArray(vec, &array));
+}
+
+
+void Checkpoint::write(const std::string &file_name, bool async)
+{
+    START_TIMER("Checkpoint::write");
+    this->wait();
+    file_name_ = file_name;
+
+    // serialization: magic, version, number of items, then (key length, key, size, values) for every item
+    std::vector<char> buffer;
+    append_raw(buffer, checkpoint_magic, sizeof(checkpoint_magic));
+    append_raw(buffer, &checkpoint_version);
+    uint64_t n_items = items_.size();
+    append_raw(buffer, &n_items);
+    for (auto &item : items_) {
+        uint64_t key_size = item.first.size();
+        uint64_t size = item.second.size();
+        append_raw(buffer, &key_size);
+        append_raw(buffer, item.first.data(), key_size);
+        append_raw(buffer, &size);
+        append_raw(buffer, item.second.data(), size);
+    }
+
+    if (async) {
+        pending_write_ = std::async(std::launch::async,
+                [file_name](std::vector<char> data) { write_buffer(file_name, data); },
+                std::move(buffer));
+    } else {
+        write_buffer(file_name, buffer);
+    }
+}
+
+
+void Checkpoint::wait()
+{
+    if (pending_write_.valid()) {
+        START_TIMER("Checkpoint::wait");
+        pending_write_.get();
+    }
+}
+
+
+void Checkpoint::read(const std::string &file_name)
+{
+    START_TIMER("Checkpoint::read");
+    this->wait();
+    file_name_ = file_name;
+    items_.clear();
+
+    std::ifstream in(file_name, std::ios::binary);
+    if (! in.is_open()) THROW( FilePath::ExcFileOpen() << FilePath::EI_Path(file_name) );
+
+    char magic[sizeof(checkpoint_magic)];
+    unsigned int version;
+    uint64_t n_items;
+    if ( !read_raw(in, magic, sizeof(magic)) || std::strncmp(magic, checkpoint_magic, sizeof(magic)) != 0
+            || !read_raw(in, &version) || version != checkpoint_version || !read_raw(in, &n_items) )
+        THROW( ExcCheckpointFile() << EI_File(file_name) );
+
+    for (uint64_t i=0; i<n_items; ++i) {
+        uint64_t key_size, size;
+        if ( !read_raw(in, &key_size) ) THROW( ExcCheckpointFile() << EI_File(file_name) );
+        std::string key(key_size, ' ');
+        if ( !read_raw(in, &key[0], key_size) || !read_raw(in, &size) ) THROW( ExcCheckpointFile() << EI_File(file_name) );
+        std::vector<double> &values = items_[key];
+        values.resize(size);
+        if ( !read_raw(in, values.data(), size) ) THROW( ExcCheckpointFile() << EI_File(file_name) );
+    }
+}
+
+
+void Checkpoint::set_restart_time(double time)
+{
+    restart_time_ = time;
+}
+
+
+bool Checkpoint::is_restart()
+{
+    return restart_time_ > -std::numeric_limits<double>::infinity();
+}
+
+
+double Checkpoint::restart_time()
+{
+    return restart_time_;
+}
+
+
+bool Checkpoint::before_restart(double time)
+{
+    if (! is_restart()) return false;
+    return time - restart_time_ <= 1e-6 * std::fabs(restart_time_);
+}
+
+
+std::string Checkpoint::restart_output_content(const std::string &file_name,
+        std::function<double(const std::string &)> line_time)
+{
+    std::ifstream in(file_name);
+    if (! in.is_open()) return "";
+
+    std::stringstream content;
+    std::string line;
+    while (std::getline(in, line)) {
+        double time = line_time(line);
+        if (!std::isnan(time) && !before_restart(time)) break;
+        content << line << "\n";
+    }
+    return content.str();
+}
@@ -0,0 +1,166 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    checkpoint.hh
+ * @brief   Binary snapshot of simulation state used for restart.
+ */
+
+#ifndef CHECKPOINT_HH_
+#define CHECKPOINT_HH_
+
+#include <functional>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+#include <petscvec.h>
+#include "system/exceptions.hh"
+
+
+/**
+ * @brief Binary snapshot of the state of the simulation on one MPI process.
+ *
+ * Checkpoint is a collection of named items, every item is a vector of doubles (integer and bool values
+ * are stored as doubles too). Equations store their state under keys prefixed by address of their input
+ * record, so the keys are unique and they are same in the restarted simulation.
+ *
+ * Every process writes and reads its own file, therefore the restarted simulation must run
+ * on the same number of processes. Writing of the file can be asynchronous, the items are serialized
+ * to memory buffer by @p write and the buffer is written to the file by separate thread.
+ *
+ * Static restart time is set if the simulation is restarted from a checkpoint. Output streams use it
+ * to continue their files instead of rewriting them, see @p restart_output_content.
+ */
+class Checkpoint {
+public:
+    TYPEDEF_ERR_INFO( EI_Key, std::string);
+    TYPEDEF_ERR_INFO( EI_File, std::string);
+    TYPEDEF_ERR_INFO( EI_Size, unsigned int);
+    TYPEDEF_ERR_INFO( EI_ExpectedSize, unsigned int);
+    DECLARE_EXCEPTION( ExcMissingItem, << "Missing item " << EI_Key::qval << " in checkpoint file " << EI_File::qval << ".\n" );
+    DECLARE_EXCEPTION( ExcItemSize, << "Item " << EI_Key::qval << " in checkpoint file " << EI_File::qval
+            << " has size " << EI_Size::val << ", expected size is " << EI_ExpectedSize::val << ".\n"
+            << "The checkpoint was probably written by a different problem or different number of processes.\n" );
+    DECLARE_EXCEPTION( ExcCheckpointFile, << "Invalid or corrupted checkpoint file " << EI_File::qval << ".\n" );
+    DECLARE_EXCEPTION( ExcCheckpointProcesses, << "Checkpoint file " << EI_File::qval << " was written by " << EI_Size::val
+            << " processes, the simulation runs on " << EI_ExpectedSize::val << " processes.\n" );
+
+    /// Constructor of empty checkpoint.
+    Checkpoint();
+
+    /// Destructor, waits for asynchronous writing.
+    ~Checkpoint();
+
+    /// Return file name of checkpoint of given process.
+    static std::string rank_file_name(const std::string &base_name, int rank);
+
+    /// Set time of the checkpoint.
+    inline void set_time(double time)
+    { this->save("time", time); }
+
+    /// Return time of the checkpoint.
+    inline double time() const
+    { return this->load_value("time"); }
+
+    /// Store vector of values under given key, previous item with the same key is replaced.
+    void save(const std::string &key, const std::vector<double> &values);
+
+    /// Store single value under given key.
+    void save(const std::string &key, double value);
+
+    /// Store all (local and ghost) values of a vector (e.g. VectorMPI).
+    template <class VectorType>
+    void save_vector(const std::string &key, const VectorType &vec) {
+        std::vector<double> values(vec.size());
+        for (unsigned int i=0; i<values.size(); ++i) values[i] = vec.get(i);
+        this->save(key, values);
+    }
+
+    /// Store local part of PETSc vector.
+    void save_petsc_vec(const std::string &key, Vec vec);
+
+    /// Return true if item of given key exists.
+    bool has(const std::string &key) const;
+
+    /// Return values of given key, throws if the item does not exist.
+    const std::vector<double> &load(const std::string &key) const;
+
+    /// Return single value of given key.
+    double load_value(const std::string &key) const;
+
+    /// Set values of a vector, size of the item must match size of the vector.
+    template <class VectorType>
+    void load_vector(const std::string &key, VectorType &vec) const {
+        const std::vector<double> &values = this->load(key, vec.size());
+        for (unsigned int i=0; i<values.size(); ++i) vec.set(i, values[i]);
+    }
+
+    /// Set local part of PETSc vector, size of the item must match local size of the vector.
+    void load_petsc_vec(const std::string &key, Vec vec) const;
+
+    /**
+     * Serialize all items and write them to the file. If @p async is true, the file is written by
+     * separate thread and the method returns immediately. Data are written to temporary file, which is
+     * renamed at the end, so an interrupted writing never damages the previous checkpoint.
+     */
+    void write(const std::string &file_name, bool async);
+
+    /// Wait until asynchronous writing is finished, rethrows exception of the writer.
+    void wait();
+
+    /// Read all items from given file.
+    void read(const std::string &file_name);
+
+    /// Set time of restart, called when the simulation is restarted from a checkpoint.
+    static void set_restart_time(double time);
+
+    /// Return true if the simulation is restarted from a checkpoint.
+    static bool is_restart();
+
+    /// Return time of restart, -infinity if the simulation is not restarted.
+    static double restart_time();
+
+    /**
+     * Return true if given time is not greater than restart time, i.e. results of this time were
+     * produced by the simulation before restart. Small relative tolerance covers rounding of times in text files.
+     */
+    static bool before_restart(double time);
+
+    /**
+     * Return content of existing text output file, that belongs to times not greater than restart time.
+     * Function @p line_time returns time of a line, or NaN for lines without time (header lines,
+     * continuation of the record of the last time). Reading stops at the first line with time greater than
+     * restart time. Empty string is returned if the file does not exist.
+     */
+    static std::string restart_output_content(const std::string &file_name,
+            std::function<double(const std::string &)> line_time);
+
+private:
+    /// Return values of given key and check their size.
+    const std::vector<double> &load(const std::string &key, unsigned int size) const;
+
+    /// Named items.
+    std::map<std::string, std::vector<double> > items_;
+
+    /// File name of the last read or written file (for error messages).
+    std::string file_name_;
+
+    /// Result of asynchronous writing.
+    std::future<void> pending_write_;
+
+    /// Time of restart.
+    static double restart_time_;
+};
+
+
+#endif /* CHECKPOINT_HH_ */
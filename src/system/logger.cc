@@ -22,6 +22,7 @@
 #include "system/file_path.hh"
 
 #include <iomanip>
+#include <mutex>
 
 
 /// Helper function, use for shorten the code point path
@@ -74,6 +75,10 @@ Logger::Logger(MsgType type)
 
 Logger::~Logger()
 {
+	// messages can be logged also from I/O threads (see OutputTime), print them as a whole
+	static std::mutex print_mutex;
+	std::lock_guard<std::mutex> lock(print_mutex);
+
 	// print output to streams
 	print_to_screen(std::cout, cout_stream_, StreamMask::cout);
 	print_to_screen(std::cerr, cerr_stream_, StreamMask::cerr);
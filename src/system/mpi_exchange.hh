@@ -0,0 +1,66 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    mpi_exchange.hh
+ * @brief   Exchange of vectors between all processes.
+ */
+
+#ifndef MPI_EXCHANGE_HH_
+#define MPI_EXCHANGE_HH_
+
+#include <mpi.h>
+#include <vector>
+
+
+/**
+ * Send vector @p send_data[proc] to every process proc (collective, all processes of @p comm must call it).
+ *
+ * Received data are concatenated to @p recv_data in order of sending processes,
+ * @p recv_counts holds number of values received from every process.
+ * Reply to received data sent by the same function in the same order arrives in order of requests.
+ */
+template <class T>
+void mpi_exchange(MPI_Comm comm, MPI_Datatype type, const std::vector< std::vector<T> > &send_data,
+        std::vector<T> &recv_data, std::vector<int> &recv_counts)
+{
+    int n_procs;
+    MPI_Comm_size(comm, &n_procs);
+    std::vector<int> send_counts(n_procs), send_displs(n_procs+1, 0), recv_displs(n_procs+1, 0);
+    for (int proc=0; proc<n_procs; ++proc) {
+        send_counts[proc] = send_data[proc].size();
+        send_displs[proc+1] = send_displs[proc] + send_counts[proc];
+    }
+    recv_counts.resize(n_procs);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+    for (int proc=0; proc<n_procs; ++proc)
+        recv_displs[proc+1] = recv_displs[proc] + recv_counts[proc];
+
+    std::vector<T> send_buffer;
+    send_buffer.reserve(send_displs[n_procs]);
+    for (auto &data : send_data) send_buffer.insert(send_buffer.end(), data.begin(), data.end());
+    recv_data.resize(recv_displs[n_procs]);
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(), type,
+                  recv_data.data(), recv_counts.data(), recv_displs.data(), type, comm);
+}
+
+
+/// Same as previous, number of values received from every process is not returned.
+template <class T>
+void mpi_exchange(MPI_Comm comm, MPI_Datatype type, const std::vector< std::vector<T> > &send_data, std::vector<T> &recv_data)
+{
+    std::vector<int> recv_counts;
+    mpi_exchange(comm, type, send_data, recv_data, recv_counts);
+}
+
+
+#endif /* MPI_EXCHANGE_HH_ */
@@ -491,6 +491,12 @@ void Profiler::add_calls(unsigned int n_calls) {
 
 
 
+void Profiler::set_calls(unsigned int n_calls) {
+    timers_[actual_node].call_count = n_calls;
+}
+
+
+
 void Profiler::notify_malloc(const size_t size, const long p) {
     MemoryAlloc::malloc_map()[p] = static_cast<int>(size);
     timers_[actual_node].total_allocated_ += size;
@@ -187,6 +187,21 @@ using namespace std;
 #endif
 
 
+/**
+ * \def SET_CALLS(n_calls)
+ *
+ * @brief Set number of calls of actual timer.
+ *
+ * Can be used to report a value (e.g. chosen size of some buffer) in the profiler: the last value set
+ * is reported as number of calls of the timer, regardless how many times the timer was started.
+ */
+#ifdef FLOW123D_DEBUG_PROFILER
+#define SET_CALLS(n_calls) Profiler::instance()->set_calls(n_calls)
+#else
+#define SET_CALLS(n_calls)
+#endif
+
+
 #ifdef FLOW123D_DEBUG_PROFILER
 #define CUMUL_TIMER(tag) Profiler::instance()->find_timer(tag).cumulative_time()
 #else
@@ -571,6 +586,10 @@ public:
      * timer was started. You should use macro ADD_CALLS above.
      */
     void add_calls(unsigned int n_calls);
+    /**
+     * Sets the total number of calls of the current timer to @p n_calls. You should use macro SET_CALLS above.
+     */
+    void set_calls(unsigned int n_calls);
     /**
      * Notification about allocation of given size.
      * Increase total allocated memory in current profiler frame.
@@ -0,0 +1,185 @@
+/*!
+ *
+﻿ * Copyright (C) 2015 Technical University of Liberec.  All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License version 3 as published by the
+ * Free Software Foundation. (http://www.gnu.org/licenses/gpl-3.0.en.html)
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ *
+ * @file    thread_pool.hh
+ * @brief
+ */
+
+#ifndef THREAD_POOL_HH_
+#define THREAD_POOL_HH_
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "system/asserts.hh"
+
+
+/**
+ * @brief Simple pool of worker threads shared by shared-memory parallel parts of code.
+ *
+ * Pool creates given number of threads in constructor and keeps them alive until
+ * destruction. Tasks are processed in FIFO order.
+ *
+ * Allows to:
+ *  1. Enqueue an asynchronous task (method submit), result (or exception) is passed
+ *     through returned std::future.
+ *  2. Run a block of tasks and wait for all of them (method parallel_for), the calling
+ *     thread processes tasks too.
+ *
+ * Pool with zero workers is valid, all tasks are then processed by calling thread
+ * (submit runs the task immediately).
+ */
+class ThreadPool {
+public:
+    /**
+     * Identification of parallel_for task processed by a thread.
+     *
+     * Member block is serial number of parallel_for call (zero outside of any parallel_for),
+     * member task is index of the task in the block.
+     */
+    struct TaskId {
+        unsigned long block;
+        unsigned int task;
+    };
+
+    /// Return identification of parallel_for task processed by calling thread.
+    static inline TaskId current_task() {
+        return current_task_;
+    }
+
+    /// Constructor, starts @p n_workers worker threads.
+    ThreadPool(unsigned int n_workers)
+    : stop_(false)
+    {
+        for (unsigned int i=0; i<n_workers; ++i)
+            workers_.emplace_back( [this] { this->worker_loop(); } );
+    }
+
+    ThreadPool(ThreadPool const&) = delete;             ///< We don't need copy constructor.
+    void operator=(ThreadPool const&) = delete;         ///< We don't need assignment operator.
+
+    /// Destructor, finishes queued tasks and joins worker threads.
+    ~ThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto &worker : workers_) worker.join();
+    }
+
+    /// Return number of worker threads.
+    inline unsigned int n_workers() const {
+        return workers_.size();
+    }
+
+    /**
+     * Enqueue task and return future holding its result.
+     *
+     * Exceptions thrown by task are rethrown by std::future::get.
+     */
+    template <class Func>
+    std::future< typename std::result_of<Func()>::type > submit(Func &&func) {
+        typedef typename std::result_of<Func()>::type ReturnType;
+        auto task = std::make_shared< std::packaged_task<ReturnType()> >( std::forward<Func>(func) );
+        std::future<ReturnType> result = task->get_future();
+        if (workers_.size() == 0) {
+            (*task)();
+            return result;
+        }
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            ASSERT(!stop_).error("Enqueue of task to stopped ThreadPool.\n");
+            tasks_.emplace_back( [task]() { (*task)(); } );
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+    /**
+     * Call @p func(i_task) for all i_task in [0, n_tasks) and wait for finishing of all calls.
+     *
+     * Task 0 is processed by calling thread. First exception thrown by any task is rethrown
+     * after all tasks are finished. During the call, tasks can be identified by current_task.
+     */
+    void parallel_for(unsigned int n_tasks, const std::function<void(unsigned int)> &func) {
+        if (n_tasks == 0) return;
+        unsigned long block = ++n_blocks_;
+        auto run_task = [&func, block](unsigned int i) {
+            TaskId prev_task = current_task_;
+            current_task_ = TaskId{block, i};
+            try {
+                func(i);
+            } catch (...) {
+                current_task_ = prev_task;
+                throw;
+            }
+            current_task_ = prev_task;
+        };
+
+        std::vector< std::future<void> > results;
+        results.reserve(n_tasks-1);
+        for (unsigned int i=1; i<n_tasks; ++i)
+            results.push_back( this->submit( [&run_task, i]() { run_task(i); } ) );
+
+        std::exception_ptr first_exc = nullptr;
+        try {
+            run_task(0);
+        } catch (...) {
+            first_exc = std::current_exception();
+        }
+        for (auto &res : results) {
+            try {
+                res.get();
+            } catch (...) {
+                if (!first_exc) first_exc = std::current_exception();
+            }
+        }
+        if (first_exc) std::rethrow_exception(first_exc);
+    }
+
+private:
+    /// Main loop of worker thread.
+    void worker_loop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (stop_ && tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers_;               ///< Worker threads.
+    std::deque< std::function<void()> > tasks_;      ///< Queue of waiting tasks.
+    std::mutex queue_mutex_;                         ///< Guards tasks_ and stop_.
+    std::condition_variable condition_;              ///< Wakes workers if new task is available.
+    bool stop_;                                      ///< Flag set in destructor, stops workers.
+
+    inline static std::atomic<unsigned long> n_blocks_{0};  ///< Number of parallel_for calls of all pools.
+    inline static thread_local TaskId current_task_{0, 0};  ///< Task processed by the thread.
+};
+
+
+#endif /* THREAD_POOL_HH_ */
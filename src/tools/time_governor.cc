@@ -21,6 +21,7 @@
 #include "input/accessors.hh"
 #include "time_governor.hh"
 #include "time_marks.hh"
+#include "system/checkpoint.hh"
 #include "unit_si.hh"
 #include "unit_converter.hh"
 
@@ -787,6 +788,56 @@ void TimeGovernor::view(const char *name) const
 
 
 
+void TimeGovernor::save_state(Checkpoint &checkpoint, const std::string &prefix) const
+{
+    std::vector<double> steps;
+    for (const TimeStep &step : recent_steps_) {
+        steps.push_back(step.index_);
+        steps.push_back(step.length_);
+        steps.push_back(step.end_);
+    }
+    checkpoint.save(prefix + "/recent_steps", steps);
+    checkpoint.save(prefix + "/constraints", {
+            end_of_fixed_dt_interval_, fixed_time_step_, (double)is_time_step_fixed_, (double)time_step_changed_,
+            upper_constraint_, lower_constraint_, last_upper_constraint_, last_lower_constraint_,
+            max_time_step_, min_time_step_, (double)dt_limits_pos_ });
+}
+
+
+
+void TimeGovernor::load_state(const Checkpoint &checkpoint, const std::string &prefix)
+{
+    const std::vector<double> &steps = checkpoint.load(prefix + "/recent_steps");
+    ASSERT_PERMANENT(steps.size() > 0 && steps.size() % 3 == 0)(steps.size()).error("Invalid time steps in checkpoint.");
+    TimeStep step_template = recent_steps_.back();
+    recent_steps_.clear();
+    for (unsigned int i=0; i<steps.size(); i+=3) {
+        TimeStep step(step_template);
+        step.index_ = (unsigned int)steps[i];
+        step.length_ = steps[i+1];
+        step.end_ = steps[i+2];
+        recent_steps_.push_back(step);
+    }
+
+    const std::vector<double> &c = checkpoint.load(prefix + "/constraints");
+    ASSERT_PERMANENT_EQ(c.size(), 11);
+    end_of_fixed_dt_interval_ = c[0];
+    fixed_time_step_ = c[1];
+    is_time_step_fixed_ = (c[2] != 0.0);
+    time_step_changed_ = (c[3] != 0.0);
+    upper_constraint_ = c[4];
+    lower_constraint_ = c[5];
+    last_upper_constraint_ = c[6];
+    last_lower_constraint_ = c[7];
+    max_time_step_ = c[8];
+    min_time_step_ = c[9];
+    dt_limits_pos_ = (unsigned int)c[10];
+    upper_constraint_message_ = "Restored from checkpoint.";
+    lower_constraint_message_ = "Restored from checkpoint.";
+}
+
+
+
 double TimeGovernor::read_time(Input::Iterator<Input::Tuple> time_it, double default_time) const {
 	return time_unit_conversion_->read_time(time_it, default_time);
 }
@@ -38,6 +38,8 @@
 #include "system/exceptions.hh"
 #include "tools/time_marks.hh"
 
+class Checkpoint;
+
 namespace Input {
     class Record;
     class Tuple;
@@ -242,6 +244,9 @@ private:
     double end_;
     /// Conversion unit of all time values within the equation.
     std::shared_ptr<TimeUnitConversion> time_unit_conversion_;
+
+    /// Allows restore of recent time steps from checkpoint.
+    friend class TimeGovernor;
 };
 
 std::ostream& operator<<(std::ostream& out, const TimeStep& t_step);
@@ -607,6 +612,18 @@ public:
      */
     void view(const char *name="") const;
 
+    /**
+     * Store recent time steps and current time step constraints to the checkpoint,
+     * keys are prefixed by @p prefix.
+     */
+    void save_state(Checkpoint &checkpoint, const std::string &prefix) const;
+
+    /**
+     * Restore state stored by @p save_state. The time governor must be constructed from the same input
+     * as the saved one (end time, time step limits), time marks are not restored since they are given by input.
+     */
+    void load_state(const Checkpoint &checkpoint, const std::string &prefix);
+
     /**
      * Read and return time value multiplied by coefficient of given unit or global coefficient of equation
      * stored in time_unit_conversion_. If time Tuple is not defined (e. g. Tuple is optional key) return
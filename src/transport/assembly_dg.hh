@@ -41,6 +41,9 @@ public:
 
     static constexpr const char * name() { return "MassAssemblyDG"; }
 
+    /// Integrals can be evaluated in threads, see ThreadSafeIntegrals.
+    static constexpr bool thread_safe_integrals = true;
+
     /// Constructor.
     MassAssemblyDG(EqFields *eq_fields, EqData *eq_data)
     : AssemblyBase<dim>(eq_data->dg_order), eq_fields_(eq_fields), eq_data_(eq_data) {
@@ -83,21 +86,23 @@ public:
 
         for (unsigned int sbi=0; sbi<eq_data_->n_substances(); ++sbi)
         {
-            // assemble the local mass matrix
-            for (unsigned int i=0; i<ndofs_; i++)
-            {
-                for (unsigned int j=0; j<ndofs_; j++)
+            // assemble the local mass matrix, only substances with own matrix (see EqData::matrix_group)
+            bool own_matrix = (eq_data_->matrix_group[sbi] == sbi);
+            if (own_matrix)
+                for (unsigned int i=0; i<ndofs_; i++)
                 {
-                    local_matrix_[i*ndofs_+j] = 0;
-                    k=0;
-                    for (auto p : this->bulk_points(element_patch_idx) )
+                    for (unsigned int j=0; j<ndofs_; j++)
                     {
-                        local_matrix_[i*ndofs_+j] += (eq_fields_->mass_matrix_coef(p)+eq_fields_->retardation_coef[sbi](p)) *
-                                fe_values_.shape_value(j,k)*fe_values_.shape_value(i,k)*fe_values_.JxW(k);
-                        k++;
+                        local_matrix_[i*ndofs_+j] = 0;
+                        k=0;
+                        for (auto p : this->bulk_points(element_patch_idx) )
+                        {
+                            local_matrix_[i*ndofs_+j] += (eq_fields_->mass_matrix_coef(p)+eq_fields_->retardation_coef[sbi](p)) *
+                                    fe_values_.shape_value(j,k)*fe_values_.shape_value(i,k)*fe_values_.JxW(k);
+                            k++;
+                        }
                     }
                 }
-            }
 
             for (unsigned int i=0; i<ndofs_; i++)
             {
@@ -112,10 +117,12 @@ public:
                 }
             }
 
+            auto lock = this->lock_shared_data();
             eq_data_->balance_->add_mass_values(eq_data_->subst_idx()[sbi], cell, cell.get_loc_dof_indices(),
                                                local_mass_balance_vector_, 0);
 
-            eq_data_->ls_dt[sbi]->mat_set_values(ndofs_, &(dof_indices_[0]), ndofs_, &(dof_indices_[0]), &(local_matrix_[0]));
+            if (own_matrix)
+                eq_data_->ls_dt[sbi]->mat_set_values(ndofs_, &(dof_indices_[0]), ndofs_, &(dof_indices_[0]), &(local_matrix_[0]));
             VecSetValues(eq_data_->ret_vec[sbi], ndofs_, &(dof_indices_[0]), &(local_retardation_balance_vector_[0]), ADD_VALUES);
         }
     }
@@ -243,6 +250,9 @@ public:
 
     static constexpr const char * name() { return "StiffnessAssemblyDG"; }
 
+    /// Integrals can be evaluated in threads, see ThreadSafeIntegrals.
+    static constexpr bool thread_safe_integrals = true;
+
     /// Constructor.
     StiffnessAssemblyDG(EqFields *eq_fields, EqData *eq_data)
     : AssemblyBase<dim>(eq_data->dg_order), eq_fields_(eq_fields), eq_data_(eq_data) {
@@ -329,6 +339,7 @@ public:
         // assemble the local stiffness matrix
         for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++)
         {
+            if (eq_data_->matrix_group[sbi] != sbi) continue; // matrix of other substance is used
             for (unsigned int i=0; i<ndofs_; i++)
                 for (unsigned int j=0; j<ndofs_; j++)
                     local_matrix_[i*ndofs_+j] = 0;
@@ -348,6 +359,7 @@ public:
                 }
                 k++;
             }
+            auto lock = this->lock_shared_data();
             eq_data_->ls[sbi]->mat_set_values(ndofs_, &(dof_indices_[0]), ndofs_, &(dof_indices_[0]), &(local_matrix_[0]));
         }
     }
@@ -369,6 +381,7 @@ public:
 
         for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++)
         {
+            if (eq_data_->matrix_group[sbi] != sbi) continue; // matrix of other substance is used
             std::fill(local_matrix_.begin(), local_matrix_.end(), 0);
 
             double side_flux = advective_flux(eq_fields_->advection_coef[sbi], this->boundary_points(cell_side), fe_values_side_);
@@ -427,6 +440,7 @@ public:
                 k++;
             }
 
+            auto lock = this->lock_shared_data();
             eq_data_->ls[sbi]->mat_set_values(ndofs_, &(dof_indices_[0]), ndofs_, &(dof_indices_[0]), &(local_matrix_[0]));
         }
     }
@@ -453,6 +467,7 @@ public:
         // fluxes and penalty
         for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++)
         {
+            if (eq_data_->matrix_group[sbi] != sbi) continue; // matrix of other substance is used
             vector<double> fluxes(edge_side_range.begin()->n_edge_sides());
             double pflux = 0, nflux = 0; // calculate the total in- and out-flux through the edge
             sid=0;
@@ -585,6 +600,7 @@ public:
                                     }
                                 }
                             }
+                            auto lock = this->lock_shared_data();
                             eq_data_->ls[sbi]->mat_set_values(fe_values_vec_[sd[n]].n_dofs(), &(side_dof_indices_[sd[n]][0]), fe_values_vec_[sd[m]].n_dofs(), &(side_dof_indices_[sd[m]][0]), &(local_matrix_[0]));
                         }
                     }
@@ -628,6 +644,7 @@ public:
         unsigned int k;
         for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++) // Optimize: SWAP LOOPS
         {
+            if (eq_data_->matrix_group[sbi] != sbi) continue; // matrix of other substance is used
             for (unsigned int i=0; i<n_dofs[0]+n_dofs[1]; i++)
                 for (unsigned int j=0; j<n_dofs[0]+n_dofs[1]; j++)
                     local_matrix_[i*(n_dofs[0]+n_dofs[1])+j] = 0;
@@ -666,6 +683,7 @@ public:
                 }
                 k++;
             }
+            auto lock = this->lock_shared_data();
             eq_data_->ls[sbi]->mat_set_values(n_dofs[0]+n_dofs[1], &(side_dof_indices_vb_[0]), n_dofs[0]+n_dofs[1], &(side_dof_indices_vb_[0]), &(local_matrix_[0]));
         }
     }
@@ -717,6 +735,9 @@ public:
 
     static constexpr const char * name() { return "SourcesAssemblyDG"; }
 
+    /// Integrals can be evaluated in threads, see ThreadSafeIntegrals.
+    static constexpr bool thread_safe_integrals = true;
+
     /// Constructor.
     SourcesAssemblyDG(EqFields *eq_fields, EqData *eq_data)
     : AssemblyBase<dim>(eq_data->dg_order), eq_fields_(eq_fields), eq_data_(eq_data) {
@@ -774,7 +795,6 @@ public:
                     local_rhs_[i] += source*fe_values_.shape_value(i,k);
                 k++;
             }
-            eq_data_->ls[sbi]->rhs_set_values(ndofs_, &(dof_indices_[0]), &(local_rhs_[0]));
 
             for (unsigned int i=0; i<ndofs_; i++)
             {
@@ -787,6 +807,8 @@ public:
 
                 local_source_balance_rhs_[i] += local_rhs_[i];
             }
+            auto lock = this->lock_shared_data();
+            eq_data_->ls[sbi]->rhs_set_values(ndofs_, &(dof_indices_[0]), &(local_rhs_[0]));
             eq_data_->balance_->add_source_values(eq_data_->subst_idx()[sbi], elm.region().bulk_idx(),
                                                  cell.get_loc_dof_indices(),
                                                  local_source_balance_vector_, local_source_balance_rhs_);
@@ -842,6 +864,9 @@ public:
 
     static constexpr const char * name() { return "BdrConditionAssemblyDG"; }
 
+    /// Integrals can be evaluated in threads, see ThreadSafeIntegrals.
+    static constexpr bool thread_safe_integrals = true;
+
     /// Constructor.
     BdrConditionAssemblyDG(EqFields *eq_fields, EqData *eq_data)
     : AssemblyBase<dim>(eq_data->dg_order), eq_fields_(eq_fields), eq_data_(eq_data) {
@@ -1008,6 +1033,7 @@ public:
                     k++;
                 }
             }
+            auto lock = this->lock_shared_data();
             eq_data_->ls[sbi]->rhs_set_values(ndofs_, &(dof_indices_[0]), &(local_rhs_[0]));
 
             eq_data_->balance_->add_flux_values(eq_data_->subst_idx()[sbi], cell_side,
@@ -16,11 +16,13 @@
  * @brief   Transport
  */
 
+#include <algorithm>
 #include <memory>
 
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
 #include "system/index_types.hh"
+#include "system/checkpoint.hh"
 
 #include "mesh/mesh.h"
 #include "mesh/partitioning.hh"
@@ -50,6 +52,7 @@
 #include "fields/generic_field.hh"
 
 #include "reaction/isotherm.hh" // SorptionType enum
+#include "reaction/reaction_term.hh"
 
 #include "fem/fe_p.hh"
 #include "fem/fe_values.hh"
@@ -141,7 +144,8 @@ ConvectionTransport::ConvectionTransport(Mesh &init_mesh, const Input::Record in
     eq_data_->dh_ = make_shared<DOFHandlerMultiDim>(init_mesh);
     shared_ptr<DiscreteSpace> ds = make_shared<EqualOrderDiscreteSpace>( &init_mesh, fe);
     eq_data_->dh_->distribute_dofs(ds);
-    vcumulative_corr = nullptr;
+    vpconc = nullptr;
+    tm_pconc_block_ = nullptr;
 
 }
 
@@ -207,9 +211,10 @@ ConvectionTransport::~ConvectionTransport()
 {
     unsigned int sbi;
 
-    if (vcumulative_corr) {
+    if (vpconc) {
         //Destroy mpi vectors at first
         chkerr(MatDestroy(&eq_data_->tm));
+        if (tm_pconc_block_) chkerr(MatDestroy(&tm_pconc_block_));
         chkerr(VecDestroy(&eq_data_->mass_diag));
         chkerr(VecDestroy(&vpmass_diag));
 
@@ -217,13 +222,12 @@ ConvectionTransport::~ConvectionTransport()
             // mpi vectors
         	chkerr(VecDestroy(&vpconc[sbi]));
         	chkerr(VecDestroy(&eq_data_->bcvcorr[sbi]));
-        	chkerr(VecDestroy(&vcumulative_corr[sbi]));
         }
+        chkerr(MatDestroy(&pconc_block_));
 
         // arrays of mpi vectors
         delete vpconc;
         delete eq_data_->bcvcorr;
-        delete vcumulative_corr;
         
         // assembly objects
         delete mass_assembly_;
@@ -258,27 +262,30 @@ void ConvectionTransport::alloc_transport_structs_mpi() {
 
     vpconc = new Vec[n_subst];
     eq_data_->bcvcorr = new Vec[n_subst];
-    vcumulative_corr = new Vec[n_subst];
     eq_data_->tm_diag.reserve(eq_data_->n_substances());
     eq_data_->corr_vec.reserve(eq_data_->n_substances());
-    
+
+    // previous concentrations are stored in columns of one dense matrix,
+    // so that transport matrix is applied to all substances at once
+    PetscScalar *pconc_array;
+    PetscInt pconc_lda;
+    MatCreateDense(PETSC_COMM_WORLD, lsize, PETSC_DECIDE, mesh_->n_elements(), n_subst, NULL, &pconc_block_);
+    MatDenseGetLDA(pconc_block_, &pconc_lda);
+    MatDenseGetArray(pconc_block_, &pconc_array);
 
     for (sbi = 0; sbi < n_subst; sbi++) {
         VecCreateMPI(PETSC_COMM_WORLD, lsize, mesh_->n_elements(), &eq_data_->bcvcorr[sbi]);
         VecZeroEntries(eq_data_->bcvcorr[sbi]);
 
-        VecCreateMPI(PETSC_COMM_WORLD, lsize, mesh_->n_elements(), &vpconc[sbi]);
+        VecCreateMPIWithArray(PETSC_COMM_WORLD, 1, lsize, mesh_->n_elements(), pconc_array + sbi*pconc_lda, &vpconc[sbi]);
         VecZeroEntries(vpconc[sbi]);
 
         // SOURCES
-        VecCreateMPI(PETSC_COMM_WORLD, lsize, mesh_->n_elements(), &vcumulative_corr[sbi]);
-        
         eq_data_->corr_vec.emplace_back(lsize, PETSC_COMM_WORLD);
         
         eq_data_->tm_diag.emplace_back(lsize, PETSC_COMM_WORLD);
-
-        VecZeroEntries(vcumulative_corr[sbi]);
     }
+    MatDenseRestoreArray(pconc_block_, &pconc_array);
 
 
     MatCreateAIJ(PETSC_COMM_WORLD, lsize, lsize, mesh_->n_elements(),
@@ -437,6 +444,10 @@ void ConvectionTransport::update_solution() {
         //choose between fresh scaling with new dt or rescaling to a new dt
         double dt = (!eq_data_->is_convection_matrix_scaled) ? dt_new : dt_scaled;
         
+        // freshly assembled matrix may have different nonzero pattern, product is created again
+        if (!eq_data_->is_convection_matrix_scaled && tm_pconc_block_)
+            chkerr(MatDestroy(&tm_pconc_block_));
+
         MatScale(eq_data_->tm, dt);
         eq_data_->is_convection_matrix_scaled = true;
     }
@@ -454,40 +465,83 @@ void ConvectionTransport::update_solution() {
     
 
     // Compute new concentrations for every substance.
-    
-    for (unsigned int sbi = 0; sbi < n_substances(); sbi++) {
-      // one step in MOBILE phase
-      START_TIMER("mat mult");
-      Vec vconc = eq_fields_->conc_mobile_fe[sbi]->vec().petsc_vec();
-      
-      // tm_diag is a diagonal part of transport matrix, which depends on substance data (sources_sigma)
-      // Wwe need keep transport matrix independent of substance, therefore we keep this diagonal part
-      // separately in a vector tm_diag.
-      // Computation: first, we compute this diagonal addition D*pconc and save it temporaly into RHS
-        
-      // RHS = D*pconc, where D is diagonal matrix represented by a vector
-      VecPointwiseMult(vcumulative_corr[sbi], eq_data_->tm_diag[sbi].petsc_vec(), vconc); //w = x.*y
-      
-      // Then we add boundary terms ans other source terms into RHS.
-      // RHS = 1.0 * bcvcorr + 1.0 * corr_vec + 1.0 * rhs
-      VecAXPBYPCZ(vcumulative_corr[sbi], 1.0, 1.0, 1.0, eq_data_->bcvcorr[sbi], eq_data_->corr_vec[sbi].petsc_vec());   //z = ax + by + cz
-      
-      // Then we set the new previous concentration.
-      VecCopy(vconc, vpconc[sbi]); // pconc = conc
-      // And finally proceed with transport matrix multiplication.
-      if (eq_data_->is_mass_diag_changed) {
-        VecPointwiseMult(vconc, vconc, vpmass_diag);         // vconc*=vpmass_diag
-        MatMultAdd(eq_data_->tm, vpconc[sbi], vconc, vconc);           // vconc+=tm*vpconc
-        VecAXPY(vconc, 1, vcumulative_corr[sbi]);            // vconc+=vcumulative_corr
-        VecPointwiseDivide(vconc, vconc, eq_data_->mass_diag); // vconc/=mass_diag
-      } else {
-        MatMultAdd(eq_data_->tm, vpconc[sbi], vcumulative_corr[sbi], vconc);  // vconc =tm*vpconc+vcumulative_corr
-        VecPointwiseDivide(vconc, vconc, eq_data_->mass_diag);        // vconc/=mass_diag
-        VecAXPY(vconc, 1, vpconc[sbi]);                             // vconc+=vpconc
+    START_TIMER("mat mult");
+
+    // set the new previous concentrations (columns of pconc_block_): pconc = conc
+    for (unsigned int sbi = 0; sbi < n_substances(); sbi++)
+        VecCopy(eq_fields_->conc_mobile_fe[sbi]->vec().petsc_vec(), vpconc[sbi]);
+    PetscObjectStateIncrease((PetscObject)pconc_block_);
+
+    // apply transport matrix to all substances at once: tm_pconc = tm*pconc
+    if (tm_pconc_block_)
+        chkerr(MatMatMult(eq_data_->tm, pconc_block_, MAT_REUSE_MATRIX, PETSC_DEFAULT, &tm_pconc_block_));
+    else
+        chkerr(MatMatMult(eq_data_->tm, pconc_block_, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &tm_pconc_block_));
+
+    const PetscScalar *tm_pconc_array, *mass_diag, *pmass_diag;
+    PetscInt tm_pconc_lda;
+    unsigned int lsize = mesh_->get_el_ds()->lsize();
+    MatDenseGetLDA(tm_pconc_block_, &tm_pconc_lda);
+    MatDenseGetArrayRead(tm_pconc_block_, &tm_pconc_array);
+    VecGetArrayRead(eq_data_->mass_diag, &mass_diag);
+    VecGetArrayRead(vpmass_diag, &pmass_diag);
+
+    unsigned int n_subst = n_substances();
+    std::vector<PetscScalar *> conc(n_subst);
+    std::vector<const PetscScalar *> pconc(n_subst), tm_diag(n_subst), bcvcorr(n_subst), corr_vec(n_subst);
+    for (unsigned int sbi = 0; sbi < n_subst; sbi++) {
+      VecGetArray(eq_fields_->conc_mobile_fe[sbi]->vec().petsc_vec(), &conc[sbi]);
+      VecGetArrayRead(vpconc[sbi], &pconc[sbi]);
+      VecGetArrayRead(eq_data_->tm_diag[sbi].petsc_vec(), &tm_diag[sbi]);
+      VecGetArrayRead(eq_data_->bcvcorr[sbi], &bcvcorr[sbi]);
+      VecGetArrayRead(eq_data_->corr_vec[sbi].petsc_vec(), &corr_vec[sbi]);
+    }
+    if (fused_reaction_) fused_reaction_->begin_block_reaction();
+
+    // Local elements are processed in blocks, the fused reaction is applied to the block
+    // while its concentrations are still in cache.
+    for (unsigned int begin = 0; begin < lsize; begin += fused_block_size) {
+      unsigned int end = std::min(begin + fused_block_size, lsize);
+      for (unsigned int sbi = 0; sbi < n_subst; sbi++) {
+        // one step in MOBILE phase
+        // tm_diag is a diagonal part of transport matrix, which depends on substance data (sources_sigma)
+        // Wwe need keep transport matrix independent of substance, therefore we keep this diagonal part
+        // separately in a vector tm_diag.
+        // The remaining operations are fused into one pass over local elements:
+        //   cumulative_corr = tm_diag*pconc + bcvcorr + corr_vec
+        //   conc = (pmass_diag*pconc + tm*pconc + cumulative_corr) / mass_diag      (mass matrix changed)
+        //   conc = (tm*pconc + cumulative_corr) / mass_diag + pconc                 (otherwise)
+        PetscScalar *c = conc[sbi];
+        const PetscScalar *pc = pconc[sbi], *tmd = tm_diag[sbi], *bc = bcvcorr[sbi], *cv = corr_vec[sbi];
+        const PetscScalar *tm_pconc = tm_pconc_array + sbi*tm_pconc_lda;
+
+        if (eq_data_->is_mass_diag_changed) {
+            for (unsigned int i = begin; i < end; i++) {
+                double cumulative_corr = bc[i] + cv[i] + tmd[i]*pc[i];
+                c[i] = (pmass_diag[i]*pc[i] + tm_pconc[i] + cumulative_corr) / mass_diag[i];
+            }
+        } else {
+            for (unsigned int i = begin; i < end; i++) {
+                double cumulative_corr = bc[i] + cv[i] + tmd[i]*pc[i];
+                c[i] = (tm_pconc[i] + cumulative_corr) / mass_diag[i] + pc[i];
+            }
+        }
       }
+      if (fused_reaction_) fused_reaction_->compute_reaction_block(conc, begin, end);
+    }
 
-      END_TIMER("mat mult");
+    for (unsigned int sbi = 0; sbi < n_subst; sbi++) {
+      VecRestoreArrayRead(eq_data_->corr_vec[sbi].petsc_vec(), &corr_vec[sbi]);
+      VecRestoreArrayRead(eq_data_->bcvcorr[sbi], &bcvcorr[sbi]);
+      VecRestoreArrayRead(eq_data_->tm_diag[sbi].petsc_vec(), &tm_diag[sbi]);
+      VecRestoreArrayRead(vpconc[sbi], &pconc[sbi]);
+      VecRestoreArray(eq_fields_->conc_mobile_fe[sbi]->vec().petsc_vec(), &conc[sbi]);
     }
+
+    VecRestoreArrayRead(vpmass_diag, &pmass_diag);
+    VecRestoreArrayRead(eq_data_->mass_diag, &mass_diag);
+    MatDenseRestoreArrayRead(tm_pconc_block_, &tm_pconc_array);
+    END_TIMER("mat mult");
     
     for (unsigned int sbi=0; sbi<n_substances(); ++sbi)
       balance_->calculate_cumulative(sbi, vpconc[sbi]);
@@ -496,6 +550,13 @@ void ConvectionTransport::update_solution() {
 }
 
 
+bool ConvectionTransport::set_fused_reaction(std::shared_ptr<ReactionTerm> reaction)
+{
+    fused_reaction_ = reaction;
+    return true;
+}
+
+
 void ConvectionTransport::set_target_time(double target_time)
 {
 
@@ -524,6 +585,28 @@ ConvectionTransport::FieldFEScalarVec& ConvectionTransport::get_p0_interpolation
 }
 
 
+void ConvectionTransport::save_state(Checkpoint &checkpoint)
+{
+    EquationBase::save_state(checkpoint);
+    std::string prefix = checkpoint_prefix();
+    for (unsigned int sbi=0; sbi<n_substances(); sbi++)
+        checkpoint.save_vector(prefix + "/conc_mobile/" + std::to_string(sbi), eq_fields_->conc_mobile_fe[sbi]->vec());
+    checkpoint.save_petsc_vec(prefix + "/mass_diag", eq_data_->mass_diag);
+    checkpoint.save_petsc_vec(prefix + "/pmass_diag", vpmass_diag);
+}
+
+
+void ConvectionTransport::load_state(const Checkpoint &checkpoint)
+{
+    EquationBase::load_state(checkpoint);
+    std::string prefix = checkpoint_prefix();
+    for (unsigned int sbi=0; sbi<n_substances(); sbi++)
+        checkpoint.load_vector(prefix + "/conc_mobile/" + std::to_string(sbi), eq_fields_->conc_mobile_fe[sbi]->vec());
+    checkpoint.load_petsc_vec(prefix + "/mass_diag", eq_data_->mass_diag);
+    checkpoint.load_petsc_vec(prefix + "/pmass_diag", vpmass_diag);
+}
+
+
 void ConvectionTransport::output_data() {
 
     eq_fields_->output_fields.set_time(time().step(), LimitSide::right);
@@ -223,6 +223,9 @@ public:
     /// Not used in this class.
 	void update_after_reactions(bool) override {};
 
+    /// Reaction is applied in @p update_solution on blocks of elements.
+    bool set_fused_reaction(std::shared_ptr<ReactionTerm> reaction) override;
+
     /**
      * Set time interval which is considered as one time step by TransportOperatorSplitting.
      * In particular the velocity field doesn't change over this interval.
@@ -257,6 +260,12 @@ public:
     void set_output_stream(std::shared_ptr<OutputTime> stream) override
     { output_stream_ = stream; }
 
+    /// Store concentrations and mass matrix diagonals.
+    void save_state(Checkpoint &checkpoint) override;
+
+    /// Restore state stored by @p save_state.
+    void load_state(const Checkpoint &checkpoint) override;
+
 
 	/**
 	 * Getters.
@@ -309,8 +318,19 @@ private:
     Vec vpmass_diag;  // diagonal entries in mass matrix from last time (cross_section * porosity)
 
     ///
-    Vec *vpconc; // previous concentration vector
-    Vec *vcumulative_corr;
+    Vec *vpconc; // previous concentration vector, columns of pconc_block_
+
+    /// Previous concentrations of all substances as dense multi-vector (one column per substance).
+    Mat pconc_block_;
+
+    /// Product of transport matrix and pconc_block_, recreated when transport matrix is assembled.
+    Mat tm_pconc_block_;
+
+    /// Reaction applied on blocks of elements right after their transport update (optional).
+    std::shared_ptr<ReactionTerm> fused_reaction_;
+
+    /// Number of elements of a block processed by transport update and fused reaction.
+    static const unsigned int fused_block_size = 256;
 
 	/// Record with input specification.
 	const Input::Record input_rec;
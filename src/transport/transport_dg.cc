@@ -18,6 +18,7 @@
 
 #include "system/index_types.hh"
 #include "system/sys_profiler.hh"
+#include "system/checkpoint.hh"
 #include "transport/transport_dg.hh"
 
 #include "io/output_time.hh"
@@ -26,6 +27,7 @@
 #include "fem/fe_p.hh"
 #include "fem/fe_rt.hh"
 #include "fem/dh_cell_accessor.hh"
+#include "fem/sparsity_pattern.hh"
 #include "fields/field_fe.hh"
 #include "la/linsys_PETSC.hh"
 #include "coupling/balance.hh"
@@ -93,6 +95,10 @@ const Record & TransportDG<Model>::get_input_type() {
         .declare_key("init_projection", Bool(), Default("true"),
                 "If true, use DG projection of the initial condition field."
                 "Otherwise, evaluate initial condition field directly (well suited for reading native data).")
+        .declare_key("shared_matrix", Bool(), Default("false"),
+                "If true, substances with equal input of all coefficients of the system matrix (e.g. 'diff_m', 'disp_l', 'sorption_coefficient', 'bc_type') "
+                "share the matrix, which is assembled only once, and are solved together as a block of right-hand sides with single preconditioner. "
+                "Linear system of every other substance is assembled and solved separately.")
         .declare_key("output",
                 EqFields().output_fields.make_output_type(equation_name, ""),
                 IT::Default("{ \"fields\": [ " + Model::ModelEqData::default_output_field() + "] }"),
@@ -152,6 +158,7 @@ TransportDG<Model>::TransportDG(Mesh & init_mesh, const Input::Record in_rec)
         : Model(init_mesh, in_rec),
           input_rec(in_rec),
           allocation_done(false),
+          system_matrix_dt_(0.0),
           mass_assembly_(nullptr)
 {
     // Can not use name() + "constructor" here, since START_TIMER only accepts const char *
@@ -250,10 +257,12 @@ void TransportDG<Model>::initialize()
     for (unsigned int sbi = 0; sbi < eq_data_->n_substances(); sbi++) {
         eq_data_->ls[sbi] = new LinSys_PETSC(eq_data_->dh_->distr().get(), petsc_default_opts);
         ( (LinSys_PETSC *)eq_data_->ls[sbi] )->set_from_input( input_rec.val<Input::Record>("solver") );
+        ( (LinSys_PETSC *)eq_data_->ls[sbi] )->set_coo_assembly();
         eq_data_->ls[sbi]->set_solution(eq_data_->output_vec[sbi].petsc_vec());
 
         eq_data_->ls_dt[sbi] = new LinSys_PETSC(eq_data_->dh_->distr().get(), petsc_default_opts);
         ( (LinSys_PETSC *)eq_data_->ls_dt[sbi] )->set_from_input( input_rec.val<Input::Record>("solver") );
+        ( (LinSys_PETSC *)eq_data_->ls_dt[sbi] )->set_coo_assembly();
         
         eq_data_->conc_fe[sbi] = create_field_fe< 3, FieldValue<3>::Scalar >(eq_data_->dh_p0);
         
@@ -262,6 +271,8 @@ void TransportDG<Model>::initialize()
 
 
     init_projection = input_rec.val<bool>("init_projection");
+    shared_matrix_ = input_rec.val<bool>("shared_matrix");
+    this->set_matrix_groups();
 
     // create assemblation object, finite element structures and distribute DOFs
 	mass_assembly_ = new GenericAssembly< MassAssemblyDim >(eq_fields_.get(), eq_data_.get());
@@ -373,27 +384,35 @@ void TransportDG<Model>::zero_time_step()
 template<class Model>
 void TransportDG<Model>::preallocate()
 {
-    // preallocate system matrix
+    START_TIMER("DG-preallocate");
+    // sparsity of system matrix follows from bulk, edge and coupling integrals, mass matrix is block diagonal
+    SparsityPattern stiffness_sparsity(eq_data_->dh_);
+    stiffness_sparsity.add_couplings(SparsityPattern::cell | SparsityPattern::edge | SparsityPattern::dimjoin);
+    stiffness_sparsity.finalize();
+    SparsityPattern mass_sparsity(eq_data_->dh_);
+    mass_sparsity.add_couplings(SparsityPattern::cell);
+    mass_sparsity.finalize();
+
+    // substances sharing matrices of other substance use their linear systems only for right hand side
+    std::vector<LongIdx> empty_nz(stiffness_sparsity.on_nz().size(), 0);
+
     for (unsigned int i=0; i<eq_data_->n_substances(); i++)
     {
         // preallocate system matrix
-    	eq_data_->ls[i]->start_allocation();
+        if (eq_data_->matrix_group[i] == i)
+            ((LinSys_PETSC *)eq_data_->ls[i])->preallocate_matrix(stiffness_sparsity.on_nz(), stiffness_sparsity.off_nz());
+        else
+            ((LinSys_PETSC *)eq_data_->ls[i])->preallocate_matrix(empty_nz, empty_nz);
         stiffness_matrix[i] = NULL;
         rhs[i] = NULL;
 
-        // preallocate mass matrix
-        eq_data_->ls_dt[i]->start_allocation();
+        // preallocate mass matrix, substances sharing matrices of other substance don't need it
+        if (eq_data_->matrix_group[i] == i)
+            ((LinSys_PETSC *)eq_data_->ls_dt[i])->preallocate_matrix(mass_sparsity.on_nz(), mass_sparsity.off_nz());
         mass_matrix[i] = NULL;
         VecZeroEntries(eq_data_->ret_vec[i]);
-    }
-    stiffness_assembly_->assemble(eq_data_->dh_);
-    mass_assembly_->assemble(eq_data_->dh_);
-    sources_assembly_->assemble(eq_data_->dh_);
-    bdr_cond_assembly_->assemble(eq_data_->dh_);
-    for (unsigned int i=0; i<eq_data_->n_substances(); i++)
-    {
-      VecAssemblyBegin(eq_data_->ret_vec[i]);
-      VecAssemblyEnd(eq_data_->ret_vec[i]);
+        VecAssemblyBegin(eq_data_->ret_vec[i]);
+        VecAssemblyEnd(eq_data_->ret_vec[i]);
     }
 
     allocation_done = true;
@@ -413,28 +432,41 @@ void TransportDG<Model>::update_solution()
     eq_fields_->set_time(Model::time_->step(), LimitSide::left);
     END_TIMER("data reinit");
 
+    bool matrices_changed = false;
+    const std::vector<unsigned int> &matrix_group = eq_data_->matrix_group;
+
     // assemble mass matrix
     if (mass_matrix[0] == NULL || eq_fields_->subset(FieldFlag::in_time_term).changed() )
     {
+        matrices_changed = true;
         for (unsigned int i=0; i<eq_data_->n_substances(); i++)
         {
-        	eq_data_->ls_dt[i]->start_add_assembly();
-        	eq_data_->ls_dt[i]->mat_zero_entries();
+            if (matrix_group[i] == i)
+            {
+                eq_data_->ls_dt[i]->start_add_assembly();
+                eq_data_->ls_dt[i]->mat_zero_entries();
+            }
             VecZeroEntries(eq_data_->ret_vec[i]);
         }
         mass_assembly_->assemble(eq_data_->dh_);
         for (unsigned int i=0; i<eq_data_->n_substances(); i++)
         {
-        	eq_data_->ls_dt[i]->finish_assembly();
             VecAssemblyBegin(eq_data_->ret_vec[i]);
             VecAssemblyEnd(eq_data_->ret_vec[i]);
+            if (matrix_group[i] == i) eq_data_->ls_dt[i]->finish_assembly();
+        }
+        for (unsigned int i=0; i<eq_data_->n_substances(); i++)
+        {
             // construct mass_vec for initial time
-            if (mass_matrix[i] == NULL)
+            if (mass_vec[i] == NULL)
             {
                 VecDuplicate(eq_data_->ls[i]->get_solution(), &mass_vec[i]);
-                MatMult(*(eq_data_->ls_dt[i]->get_matrix()), eq_data_->ls[i]->get_solution(), mass_vec[i]);
-                MatConvert(*( eq_data_->ls_dt[i]->get_matrix() ), MATSAME, MAT_INITIAL_MATRIX, &mass_matrix[i]);
+                MatMult(*(eq_data_->ls_dt[matrix_group[i]]->get_matrix()), eq_data_->ls[i]->get_solution(), mass_vec[i]);
             }
+            if (matrix_group[i] != i) continue;
+
+            if (mass_matrix[i] == NULL)
+                MatConvert(*( eq_data_->ls_dt[i]->get_matrix() ), MATSAME, MAT_INITIAL_MATRIX, &mass_matrix[i]);
             else
                 MatCopy(*( eq_data_->ls_dt[i]->get_matrix() ), mass_matrix[i], DIFFERENT_NONZERO_PATTERN);
         }
@@ -445,16 +477,19 @@ void TransportDG<Model>::update_solution()
             || eq_fields_->subset(FieldFlag::in_main_matrix).changed()
             || eq_fields_->flow_flux.changed())
     {
+        matrices_changed = true;
         // new fluxes can change the location of Neumann boundary,
         // thus stiffness matrix must be reassembled
         for (unsigned int i=0; i<eq_data_->n_substances(); i++)
         {
+            if (matrix_group[i] != i) continue;
             eq_data_->ls[i]->start_add_assembly();
             eq_data_->ls[i]->mat_zero_entries();
         }
         stiffness_assembly_->assemble(eq_data_->dh_);
         for (unsigned int i=0; i<eq_data_->n_substances(); i++)
         {
+            if (matrix_group[i] != i) continue;
         	eq_data_->ls[i]->finish_assembly();
 
             if (stiffness_matrix[i] == NULL)
@@ -501,25 +536,46 @@ void TransportDG<Model>::update_solution()
     *   A^k = A + 1/dt M.
     *
     */
+    // system matrices are kept if neither matrices nor time step changed, so that preconditioners can be reused
+    bool system_matrix_changed = matrices_changed || (Model::time_->dt() != system_matrix_dt_);
+    system_matrix_dt_ = Model::time_->dt();
+
     Mat m;
     START_TIMER("solve");
     for (unsigned int i=0; i<eq_data_->n_substances(); i++)
     {
-        MatConvert(stiffness_matrix[i], MATSAME, MAT_INITIAL_MATRIX, &m);
-        MatAXPY(m, 1./Model::time_->dt(), mass_matrix[i], SUBSET_NONZERO_PATTERN);
-        eq_data_->ls[i]->set_matrix(m, DIFFERENT_NONZERO_PATTERN);
-        Vec w;
-        VecDuplicate(rhs[i], &w);
-        VecWAXPY(w, 1./Model::time_->dt(), mass_vec[i], rhs[i]);
-        eq_data_->ls[i]->set_rhs(w);
+        // substances sharing matrix are solved together with the first substance of the group
+        if (matrix_group[i] != i) continue;
+
+        if (system_matrix_changed) {
+            MatConvert(stiffness_matrix[i], MATSAME, MAT_INITIAL_MATRIX, &m);
+            MatAXPY(m, 1./Model::time_->dt(), mass_matrix[i], SUBSET_NONZERO_PATTERN);
+            eq_data_->ls[i]->set_matrix(m, DIFFERENT_NONZERO_PATTERN);
+            chkerr(MatDestroy(&m));
+        }
 
-        VecDestroy(&w);
-        chkerr(MatDestroy(&m));
+        std::vector<Vec> group_rhs, group_solutions;
+        for (unsigned int j=i; j<eq_data_->n_substances(); j++)
+        {
+            if (matrix_group[j] != i) continue;
+            Vec w;
+            VecDuplicate(rhs[j], &w);
+            VecWAXPY(w, 1./Model::time_->dt(), mass_vec[j], rhs[j]);
+            eq_data_->ls[j]->set_rhs(w);
+            VecDestroy(&w);
+            group_rhs.push_back(*eq_data_->ls[j]->get_rhs());
+            group_solutions.push_back(eq_data_->ls[j]->get_solution());
+        }
 
-        eq_data_->ls[i]->solve();
+        if (group_rhs.size() == 1)
+            eq_data_->ls[i]->solve();
+        else
+            ((LinSys_PETSC *)eq_data_->ls[i])->solve_multi(group_rhs, group_solutions);
 
         // update mass_vec due to possible changes in mass matrix
-        MatMult(*(eq_data_->ls_dt[i]->get_matrix()), eq_data_->ls[i]->get_solution(), mass_vec[i]);
+        for (unsigned int j=i; j<eq_data_->n_substances(); j++)
+            if (matrix_group[j] == i)
+                MatMult(*(eq_data_->ls_dt[i]->get_matrix()), eq_data_->ls[j]->get_solution(), mass_vec[j]);
     }
     END_TIMER("solve");
 
@@ -609,18 +665,47 @@ void TransportDG<Model>::calculate_cumulative_balance()
 
 
 
+template<class Model>
+void TransportDG<Model>::set_matrix_groups()
+{
+    std::vector<unsigned int> &matrix_group = eq_data_->matrix_group;
+    matrix_group.resize(eq_data_->n_substances());
+    FieldSet main_matrix_fields = eq_fields_->subset(FieldFlag::in_main_matrix);
+    FieldSet time_term_fields = eq_fields_->subset(FieldFlag::in_time_term);
+    unsigned int n_groups = 0;
+    for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++)
+    {
+        // substance joins the first group whose leader has the same input of all matrix coefficients
+        matrix_group[sbi] = sbi;
+        if (shared_matrix_)
+            for (unsigned int leader=0; leader<sbi; leader++)
+                if (matrix_group[leader] == leader
+                        && main_matrix_fields.equal_components(leader, sbi)
+                        && time_term_fields.equal_components(leader, sbi))
+                {
+                    matrix_group[sbi] = leader;
+                    break;
+                }
+        if (matrix_group[sbi] == sbi) n_groups++;
+    }
+    if (n_groups < eq_data_->n_substances())
+        MessageOut().fmt("Substances with common coefficients of transport share system matrix, {} substances use {} system matrices.\n",
+                eq_data_->n_substances(), n_groups);
+}
+
+
+
 template<class Model>
 void TransportDG<Model>::set_initial_condition()
 {
     if(init_projection)
     {
+        // projection matrix is block diagonal
+        SparsityPattern sparsity(eq_data_->dh_);
+        sparsity.add_couplings(SparsityPattern::cell);
+        sparsity.finalize();
         for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++)
-            eq_data_->ls[sbi]->start_allocation();
-        
-        init_assembly_->assemble(eq_data_->dh_);
-
-        for (unsigned int sbi=0; sbi<eq_data_->n_substances(); sbi++)
-            eq_data_->ls[sbi]->start_add_assembly();
+            ((LinSys_PETSC *)eq_data_->ls[sbi])->preallocate_matrix(sparsity.on_nz(), sparsity.off_nz());
 
         init_assembly_->assemble(eq_data_->dh_);
 
@@ -635,6 +720,29 @@ void TransportDG<Model>::set_initial_condition()
 }
 
 
+template<class Model>
+void TransportDG<Model>::save_state(Checkpoint &checkpoint)
+{
+    Model::save_state(checkpoint);
+    std::string prefix = this->checkpoint_prefix();
+    for (unsigned int sbi=0; sbi<eq_data_->n_substances(); ++sbi)
+        checkpoint.save_vector(prefix + "/solution/" + std::to_string(sbi), eq_data_->output_vec[sbi]);
+    checkpoint.save(prefix + "/ret_sources_prev", ret_sources_prev);
+}
+
+
+template<class Model>
+void TransportDG<Model>::load_state(const Checkpoint &checkpoint)
+{
+    Model::load_state(checkpoint);
+    std::string prefix = this->checkpoint_prefix();
+    for (unsigned int sbi=0; sbi<eq_data_->n_substances(); ++sbi)
+        checkpoint.load_vector(prefix + "/solution/" + std::to_string(sbi), eq_data_->output_vec[sbi]);
+    ret_sources_prev = checkpoint.load(prefix + "/ret_sources_prev");
+    // mass_vec is created from the restored solution at the first time step (mass matrix is not assembled yet)
+}
+
+
 template<class Model>
 void TransportDG<Model>::update_after_reactions(bool solution_changed)
 {
@@ -663,7 +771,7 @@ void TransportDG<Model>::update_after_reactions(bool solution_changed)
     }
     // update mass_vec for the case that mass matrix changes in next time step
     for (unsigned int sbi=0; sbi<eq_data_->n_substances(); ++sbi)
-        MatMult(*(eq_data_->ls_dt[sbi]->get_matrix()), eq_data_->ls[sbi]->get_solution(), mass_vec[sbi]);
+        MatMult(*(eq_data_->ls_dt[eq_data_->matrix_group[sbi]]->get_matrix()), eq_data_->ls[sbi]->get_solution(), mass_vec[sbi]);
 }
 
 
@@ -189,6 +189,13 @@ public:
     	/// Linear algebra system for the time derivative (actually it is used only for handling the matrix structures).
     	LinSys **ls_dt;
 
+    	/**
+    	 * Index of substance whose matrices (in @p ls and @p ls_dt) are used for the given substance.
+    	 *
+    	 * Matrices are assembled only for substances with matrix_group[sbi]==sbi, see TransportDG::set_matrix_groups.
+    	 */
+    	std::vector<unsigned int> matrix_group;
+
     	/// @name Auxiliary fields used during assembly
     	// @{
 
@@ -277,6 +284,12 @@ public:
 
 	void update_after_reactions(bool solution_changed);
 
+	/// Store solution and retardation sources.
+	void save_state(Checkpoint &checkpoint) override;
+
+	/// Restore state stored by @p save_state.
+	void load_state(const Checkpoint &checkpoint) override;
+
     /// Access to balance object of Model
     inline std::shared_ptr<Balance> balance() const {
         return Model::balance_;
@@ -314,6 +327,15 @@ private:
 	 */
 	void set_initial_condition();
 
+	/**
+	 * @brief Find substances with identical stiffness and mass matrices before their assembly.
+	 *
+	 * Matrices depend on substance only through MultiFields of the matrix and time terms. Substances
+	 * whose input of all these fields is equal are grouped and share matrices of the first substance
+	 * of the group, other substances have their own matrices (see EqData::matrix_group).
+	 */
+	void set_matrix_groups();
+
     
     
     void output_region_statistics();
@@ -382,7 +404,13 @@ private:
     /// Indicates whether matrices have been preallocated.
     bool allocation_done;
 
+    /// Time step used in the current system matrices of linear systems.
+    double system_matrix_dt_;
+
 	bool init_projection;
+
+	/// Substances with identical matrices are solved together (input key 'shared_matrix').
+	bool shared_matrix_;
     // @}
 
     /// general assembly objects, hold assembly objects of appropriate dimension
@@ -21,6 +21,7 @@
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
 #include "system/index_types.hh"
+#include "system/checkpoint.hh"
 
 #include "transport/transport_operator_splitting.hh"
 #include <petscmat.h>
@@ -267,6 +268,24 @@ void TransportOperatorSplitting::zero_time_step()
 
 
 
+void TransportOperatorSplitting::save_state(Checkpoint &checkpoint)
+{
+    EquationBase::save_state(checkpoint);
+    convection->save_state(checkpoint);
+    if (reaction) reaction->save_state(checkpoint);
+}
+
+
+
+void TransportOperatorSplitting::load_state(const Checkpoint &checkpoint)
+{
+    EquationBase::load_state(checkpoint);
+    convection->load_state(checkpoint);
+    if (reaction) reaction->load_state(checkpoint);
+}
+
+
+
 void TransportOperatorSplitting::update_solution() {
 
 	vector<double> source(convection->n_substances()), region_mass(mesh_->region_db().bulk_size());
@@ -275,6 +294,12 @@ void TransportOperatorSplitting::update_solution() {
     time_->view("TOS");    //show time governor
 
     convection->set_target_time(time_->t());
+
+    // Reaction acting on every element independently is applied by the transport on blocks of elements,
+    // not possible with cumulative balance, which needs mass after the transport step.
+    std::shared_ptr<ReactionTerm> block_reaction = nullptr;
+    if (reaction && reaction->allows_block_reaction() && !balance_->cumulative()) block_reaction = reaction;
+    bool fused_reaction = convection->set_fused_reaction(block_reaction) && block_reaction;
     
     START_TIMER("TOS-one step");
     int steps=0;
@@ -313,7 +338,10 @@ void TransportOperatorSplitting::update_solution() {
 	    	END_TIMER("TOS-balance");
 	    }
 
-        if(reaction) {
+        if(fused_reaction) {
+        	convection->update_after_reactions(true);
+        }
+        else if(reaction) {
         	convection->compute_p0_interpolation();
         	reaction->update_solution();
         	convection->update_after_reactions(true);
@@ -109,6 +109,14 @@ public:
     /// Perform changes to transport solution after reaction step.
     virtual void update_after_reactions(bool solution_changed) = 0;
 
+    /**
+     * Set reaction that is applied on blocks of elements right after their transport update
+     * (nullptr switches it off). Return false if the transport model does not support it,
+     * then the reaction must be computed separately after the transport step.
+     */
+    virtual bool set_fused_reaction(std::shared_ptr<ReactionTerm>)
+    { return false; }
+
     /// Setter for output stream.
     virtual void set_output_stream(std::shared_ptr<OutputTime> stream) = 0;
 
@@ -228,6 +236,9 @@ public:
     void compute_internal_step();
     void output_data() override;
 
+    void save_state(Checkpoint &checkpoint) override;
+    void load_state(const Checkpoint &checkpoint) override;
+
    
 
 private:
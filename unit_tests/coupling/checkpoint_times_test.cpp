@@ -0,0 +1,97 @@
+/*
+ * checkpoint_times_test.cpp
+ *
+ *  Tests meeting of equations with different time steps at checkpoint times
+ *  and skipping of a checkpoint time passed by an equation.
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+#include <input/input_type.hh>
+#include <input/reader_to_storage.hh>
+#include <input/accessors.hh>
+#include "coupling/hc_explicit_sequential.hh"
+#include "tools/time_governor.hh"
+#include "tools/time_marks.hh"
+
+
+/**
+ * Auxiliary function to declare and read test input.
+ */
+Input::Record read_input(const string &json_input)
+{
+    static Input::Type::Record in_rec = Input::Type::Record("RootInput", "Root record.")
+        .declare_key("time", TimeGovernor::get_input_type(), Input::Type::Default::obligatory(), "")
+        .close();
+
+    Input::ReaderToStorage json_reader(json_input, in_rec, Input::FileFormat::format_JSON);
+    static Input::Record rec;
+    rec = json_reader.get_root_interface<Input::Record>();
+    return rec.val<Input::Record>("time");
+}
+
+
+TEST(CheckpointTimes, init) {
+    CheckpointTimes checkpoints;
+    checkpoints.init({1.5, 0.0, 1.0, 0.5}, 0.5);
+    EXPECT_EQ(std::vector<double>({0.0, 0.5, 1.0, 1.5}), checkpoints.times());
+    // times up to the start time are not written
+    EXPECT_EQ(2, checkpoints.next_index());
+}
+
+
+TEST(CheckpointTimes, different_time_steps) {
+    TimeGovernor::marks().reinit();
+    TimeGovernor fast( read_input("{time = { end_time = 2.0, max_dt = 0.3 } }"), TimeMark::none_type, false );
+    TimeGovernor slow( read_input("{time = { end_time = 2.0, max_dt = 0.7 } }"), TimeMark::none_type, false );
+    std::vector<TimeGovernor *> equations = { &fast, &slow };
+    std::vector<const TimeGovernor *> times = { &fast, &slow };
+
+    CheckpointTimes checkpoints;
+    checkpoints.init({1.0, 1.5}, 0.0);
+    for (double t : checkpoints.times())
+        for (TimeGovernor *tg : equations)
+            TimeGovernor::marks().add( TimeMark(t, tg->equation_fixed_mark_type()) );
+
+    // simplified coupling loop: check the checkpoint, then step all equations not held at it
+    std::vector<double> written;
+    bool slow_waited = false;
+    while (! fast.is_end() || ! slow.is_end()) {
+        if (checkpoints.reached(times)) {
+            double t_chk = checkpoints.times()[checkpoints.next_index()];
+            EXPECT_DOUBLE_EQ(t_chk, fast.t());
+            EXPECT_DOUBLE_EQ(t_chk, slow.t());
+            written.push_back(t_chk);
+            checkpoints.advance();
+        }
+        if (checkpoints.hold(slow) && ! checkpoints.hold(fast)) slow_waited = true;
+        for (TimeGovernor *tg : equations)
+            if (! tg->is_end() && ! checkpoints.hold(*tg)) tg->next_time();
+    }
+
+    EXPECT_EQ(std::vector<double>({1.0, 1.5}), written);
+    EXPECT_TRUE(slow_waited);
+    EXPECT_EQ(2, checkpoints.next_index());
+}
+
+
+TEST(CheckpointTimes, passed_checkpoint) {
+    TimeGovernor::marks().reinit();
+    // checkpoint time is not a fixed time mark of the equation, so it is not held there
+    TimeGovernor tg( read_input("{time = { end_time = 2.0, max_dt = 0.4 } }"), TimeMark::none_type, false );
+    std::vector<const TimeGovernor *> times = { &tg };
+
+    CheckpointTimes checkpoints;
+    checkpoints.init({1.0, 1.9}, 0.0);
+    while (tg.t() <= 1.0) {
+        EXPECT_FALSE(checkpoints.hold(tg));
+        tg.next_time();
+    }
+
+    // checkpoint is skipped with a warning, the next one is waited for
+    EXPECT_FALSE(checkpoints.reached(times));
+    EXPECT_EQ(1, checkpoints.next_index());
+    EXPECT_FALSE(checkpoints.reached(times));
+    EXPECT_EQ(1, checkpoints.next_index());
+}
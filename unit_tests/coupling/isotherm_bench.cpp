@@ -0,0 +1,112 @@
+/*
+ * isotherm_bench.cpp
+ *
+ *  Speed tests of evaluation of sorption isotherms, compares direct computation
+ *  by nonlinear solver with batched interpolation table lookup.
+ */
+
+#define TEST_USE_PETSC
+#define FEAL_OVERRIDE_ASSERTS
+#include <flow_gtest_mpi.hh>
+#include <random>
+
+#include "reaction/isotherm.hh"
+#include "system/file_path.hh"
+#include "system/sys_profiler.hh"
+
+
+class IsothermBenchmark : public testing::Test {
+public:
+    /// Number of evaluated concentration pairs (elements).
+    static const unsigned int n_values = 100000;
+    /// Number of repeats of evaluation.
+    static const unsigned int n_runs = 10;
+    /// Size of interpolation table.
+    static const unsigned int n_table_steps = 1000;
+
+    IsothermBenchmark()
+    : c_aqua_(n_values), c_sorbed_(n_values)
+    {
+        string root_dir=string(UNIT_TESTS_BIN_DIR) + "/coupling";
+        FilePath::set_io_dirs(".",root_dir,"",".");
+        Profiler::instance();
+        Profiler::set_memory_monitoring(false, false);
+
+        // small part of total masses exceeds the table and uses fallback to nonlinear solver
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> aqua_distribution(0.0, 1.1*table_limit_);
+        std::uniform_real_distribution<double> sorbed_distribution(0.0, 0.66*table_limit_);
+        for (unsigned int i=0; i<n_values; ++i) {
+            c_aqua_[i] = aqua_distribution(generator);
+            c_sorbed_[i] = sorbed_distribution(generator);
+        }
+    }
+
+    ~IsothermBenchmark()
+    {
+        Profiler::uninitialize();
+    }
+
+    /// Perform profiler output.
+    void profiler_output(std::string file_name) {
+        FilePath fp(file_name + "_profiler.json", FilePath::output_file);
+        Profiler::instance()->output(MPI_COMM_WORLD, fp.filename());
+    }
+
+    /// Compare direct computation and interpolation of given isotherm.
+    void run_benchmark(Isotherm::SorptionType type, double mult_coef, double second_coef) {
+        Isotherm isotherm;
+        isotherm.reinit(type, false, 1.0, 0.25, 0.75, 0.0, mult_coef, second_coef);
+
+        std::vector<double> compute_aqua, compute_sorbed;
+        START_TIMER("compute");
+        for (unsigned int i_run=0; i_run<n_runs; ++i_run) {
+            compute_aqua = c_aqua_;
+            compute_sorbed = c_sorbed_;
+            for (unsigned int i=0; i<n_values; ++i)
+                isotherm.compute(compute_aqua[i], compute_sorbed[i]);
+        }
+        END_TIMER("compute");
+
+        START_TIMER("make_table");
+        isotherm.make_table(n_table_steps, table_limit_);
+        END_TIMER("make_table");
+        EXPECT_TRUE(isotherm.is_precomputed());
+
+        std::vector<double> interp_aqua, interp_sorbed;
+        START_TIMER("interpolate");
+        for (unsigned int i_run=0; i_run<n_runs; ++i_run) {
+            interp_aqua = c_aqua_;
+            interp_sorbed = c_sorbed_;
+            isotherm.interpolate(interp_aqua, interp_sorbed);
+        }
+        END_TIMER("interpolate");
+
+        for (unsigned int i=0; i<n_values; ++i) {
+            EXPECT_NEAR(compute_aqua[i], interp_aqua[i], 1e-4);
+            EXPECT_NEAR(compute_sorbed[i], interp_sorbed[i], 1e-4);
+        }
+    }
+
+    /// Limit aqueous concentration of interpolation table.
+    const double table_limit_ = 1.0;
+
+    std::vector<double> c_aqua_;
+    std::vector<double> c_sorbed_;
+};
+
+
+TEST_F(IsothermBenchmark, langmuir) {
+    START_TIMER("langmuir");
+    run_benchmark(Isotherm::langmuir, 0.6, 0.4);
+    END_TIMER("langmuir");
+    profiler_output("isotherm_langmuir");
+}
+
+
+TEST_F(IsothermBenchmark, freundlich) {
+    START_TIMER("freundlich");
+    run_benchmark(Isotherm::freundlich, 0.6, 0.4);
+    END_TIMER("freundlich");
+    profiler_output("isotherm_freundlich");
+}
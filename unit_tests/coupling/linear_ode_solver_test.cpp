@@ -0,0 +1,82 @@
+/*
+ * linear_ode_solver_test.cpp
+ *
+ *  Tests batched update of LinearODESolver (block of initial vectors) against
+ *  update of single vectors and reuse of cached solution matrices.
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+#include "arma_expect.hh"
+
+#include "reaction/linear_ode_solver.hh"
+
+
+class LinearODESolverTest : public LinearODESolver {
+public:
+    unsigned int cache_size() const
+    { return solution_cache_.size(); }
+
+    const arma::mat &solution_matrix() const
+    { return solution_matrix_; }
+};
+
+
+// decay chain of three substances
+static arma::mat decay_matrix() {
+    return arma::mat({ {-0.5,  0.0,  0.0},
+                       { 0.5, -0.2,  0.0},
+                       { 0.0,  0.2, -0.1} });
+}
+
+
+TEST(LinearODESolver, block_update) {
+    LinearODESolverTest solver;
+    solver.set_system_matrix( decay_matrix() );
+    solver.set_step(0.3);
+
+    // one initial vector per row (concentrations on one element)
+    arma::mat conc_block = { {1.0, 0.0, 0.0},
+                             {0.5, 2.0, 0.1},
+                             {0.0, 0.0, 3.0},
+                             {1.2, 0.7, 0.4} };
+    arma::mat expected(arma::size(conc_block));
+    for (unsigned int i=0; i<conc_block.n_rows; ++i) {
+        arma::vec init_vec = conc_block.row(i).t(), output_vec;
+        solver.update_solution(init_vec, output_vec);
+        expected.row(i) = output_vec.t();
+    }
+
+    solver.update_solution(conc_block);
+    EXPECT_ARMA_EQ(expected, conc_block);
+}
+
+
+TEST(LinearODESolver, solution_cache) {
+    LinearODESolverTest solver;
+    arma::vec init_vec = {1.0, 0.5, 0.0}, output_vec;
+    solver.set_system_matrix( decay_matrix() );
+
+    solver.set_step(0.3);
+    solver.update_solution(init_vec, output_vec);
+    EXPECT_EQ(1, solver.cache_size());
+    arma::mat first_solution = solver.solution_matrix();
+    EXPECT_ARMA_EQ( arma::expmat(0.3 * decay_matrix()), first_solution );
+
+    solver.set_step(0.1);
+    solver.update_solution(init_vec, output_vec);
+    EXPECT_EQ(2, solver.cache_size());
+
+    // repeated time step is taken from cache, no new item
+    solver.set_step(0.3);
+    arma::mat conc_block = init_vec.t();
+    solver.update_solution(conc_block);
+    EXPECT_EQ(2, solver.cache_size());
+    EXPECT_TRUE( arma::approx_equal(first_solution, solver.solution_matrix(), "absdiff", 0.0) );
+
+    // changed system matrix with the same step is a new item
+    solver.set_system_matrix( 2.0 * decay_matrix() );
+    solver.update_solution(conc_block);
+    EXPECT_EQ(3, solver.cache_size());
+}
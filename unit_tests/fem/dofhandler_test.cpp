@@ -1,6 +1,7 @@
 #define TEST_USE_PETSC
 #include <flow_gtest_mpi.hh>
 #include <cmath>
+#include <algorithm>
 #include "fem/fe_p.hh"
 #include "fem/fe_rt.hh"
 #include "fem/fe_system.hh"
@@ -358,3 +359,67 @@ TEST(DHAccessors, dh_cell_accessors) {
     delete mesh;
     Profiler::uninitialize();
 }
+
+
+// DOF handler distributed on mesh read by DistributedGmshMeshReader (own and ghost elements only)
+// must number dofs consistently with the mesh read as a whole.
+TEST(DOFHandler, distributed_mesh) {
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+    Profiler::instance();
+    Mesh * mesh = mesh_full_constructor("{mesh_file=\"mesh/test_108_elem.msh\"}");
+    Mesh * distr_mesh = mesh_full_constructor("{mesh_file=\"mesh/test_108_elem.msh\", distributed_reading=true}");
+    EXPECT_TRUE( distr_mesh->is_distributed() );
+
+    // gathers global dof indices of all local cells on all processes
+    auto gather_dofs = [](DOFHandlerMultiDim &dh, std::vector<LongIdx> &all_dofs) {
+        std::vector<LongIdx> loc_dofs, dof_indices(dh.max_elem_dofs());
+        for (DHCellAccessor cell : dh.local_range()) {
+            unsigned int n_dofs = cell.get_dof_indices(dof_indices);
+            loc_dofs.insert(loc_dofs.end(), dof_indices.begin(), dof_indices.begin()+n_dofs);
+        }
+        int np, n_loc = loc_dofs.size();
+        MPI_Comm_size(MPI_COMM_WORLD, &np);
+        std::vector<int> counts(np), offsets(np, 0);
+        MPI_Allgather(&n_loc, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+        for (int i=1; i<np; ++i) offsets[i] = offsets[i-1] + counts[i-1];
+        all_dofs.resize(offsets[np-1] + counts[np-1]);
+        MPI_Allgatherv(loc_dofs.data(), n_loc, MPI_LONG_IDX, all_dofs.data(), counts.data(), offsets.data(),
+                MPI_LONG_IDX, MPI_COMM_WORLD);
+        std::sort(all_dofs.begin(), all_dofs.end());
+        all_dofs.erase( std::unique(all_dofs.begin(), all_dofs.end()), all_dofs.end() );
+    };
+
+    {
+        // continuous P1: dofs shared by processes through ghost elements
+        MixedPtr<FE_P> fe(1);
+        DOFHandlerMultiDim dh(*mesh), distr_dh(*distr_mesh);
+        dh.distribute_dofs( std::make_shared<EqualOrderDiscreteSpace>(mesh, fe) );
+        distr_dh.distribute_dofs( std::make_shared<EqualOrderDiscreteSpace>(distr_mesh, fe) );
+        EXPECT_EQ( dh.n_global_dofs(), distr_dh.n_global_dofs() );
+
+        std::vector<LongIdx> all_dofs;
+        gather_dofs(distr_dh, all_dofs);
+        EXPECT_EQ( distr_dh.n_global_dofs(), all_dofs.size() );
+        EXPECT_EQ( 0, all_dofs.front() );
+        EXPECT_EQ( distr_dh.n_global_dofs()-1, all_dofs.back() );
+    }
+
+    {
+        // discontinuous P0: one dof per element of whole mesh
+        MixedPtr<FE_P_disc> fe(0);
+        DOFHandlerMultiDim distr_dh(*distr_mesh);
+        distr_dh.distribute_dofs( std::make_shared<EqualOrderDiscreteSpace>(distr_mesh, fe) );
+        EXPECT_EQ( mesh->n_elements(), distr_dh.n_global_dofs() );
+
+        std::vector<LongIdx> all_dofs;
+        gather_dofs(distr_dh, all_dofs);
+        EXPECT_EQ( mesh->n_elements(), all_dofs.size() );
+    }
+
+    // Sequential dof handler (DOFHandlerMultiDim::sequential) asserts on distributed mesh
+    // and output of serial data is not supported, see key 'distributed_reading' of Mesh input.
+
+    delete distr_mesh;
+    delete mesh;
+    Profiler::uninitialize();
+}
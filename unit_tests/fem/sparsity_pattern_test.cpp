@@ -0,0 +1,110 @@
+#define TEST_USE_PETSC
+#include <flow_gtest_mpi.hh>
+#include <numeric>
+#include "fem/fe_p.hh"
+#include "mesh/mesh.h"
+#include <mesh_constructor.hh>
+#include "fem/dofhandler.hh"
+#include "fem/sparsity_pattern.hh"
+#include "la/distribution.hh"
+#include "tools/mixed.hh"
+#include "system/sys_profiler.hh"
+
+
+/*
+ * simple mesh consisting of 4 triangles and 1 line element (see dofhandler_test.cpp)
+ *
+ *  1: 35
+ *  2: 123
+ *  3: 134
+ *  4: 235
+ *  5: 345
+ *
+ * Discontinuous P0 element has one DOF per cell, couplings are:
+ *  - cell:    5 diagonal entries
+ *  - edge:    pairs (2,3), (2,4), (3,5), (4,5) in both directions
+ *  - dimjoin: pairs (1,4), (1,5) in both directions
+ */
+class SparsityPatternTest : public testing::Test {
+protected:
+    SparsityPatternTest()
+    {
+        FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+        Profiler::instance();
+
+        mesh_ = mesh_full_constructor("{ mesh_file=\"fem/small_mesh.msh\", optimize_mesh=false }");
+        MixedPtr<FE_P_disc> fe(0);
+        std::shared_ptr<DiscreteSpace> ds = std::make_shared<EqualOrderDiscreteSpace>(mesh_, fe);
+        dh_ = std::make_shared<DOFHandlerMultiDim>(*mesh_);
+        dh_->distribute_dofs(ds);
+    }
+
+    ~SparsityPatternTest()
+    {
+        dh_.reset();
+        delete mesh_;
+    }
+
+    // return global number of nonzero entries, check sizes of local data
+    LongIdx n_global_nonzeros(const SparsityPattern &sparsity)
+    {
+        EXPECT_EQ(dh_->lsize(), sparsity.on_nz().size());
+        EXPECT_EQ(dh_->lsize(), sparsity.off_nz().size());
+        LongIdx n_local = std::accumulate(sparsity.on_nz().begin(), sparsity.on_nz().end(), 0)
+                        + std::accumulate(sparsity.off_nz().begin(), sparsity.off_nz().end(), 0);
+        LongIdx n_global;
+        MPI_Allreduce(&n_local, &n_global, 1, MPI_LONG_IDX, MPI_SUM, MPI_COMM_WORLD);
+        return n_global;
+    }
+
+    Mesh *mesh_;
+    std::shared_ptr<DOFHandlerMultiDim> dh_;
+};
+
+
+TEST_F(SparsityPatternTest, cell_couplings) {
+    SparsityPattern sparsity(dh_);
+    sparsity.add_couplings(SparsityPattern::cell);
+    sparsity.finalize();
+
+    EXPECT_EQ(5, n_global_nonzeros(sparsity));
+    for (unsigned int i=0; i<dh_->lsize(); ++i) {
+        EXPECT_EQ(1, sparsity.on_nz()[i]);
+        EXPECT_EQ(0, sparsity.off_nz()[i]);
+    }
+}
+
+
+TEST_F(SparsityPatternTest, all_couplings) {
+    SparsityPattern edge_sparsity(dh_);
+    edge_sparsity.add_couplings(SparsityPattern::cell | SparsityPattern::edge);
+    edge_sparsity.finalize();
+    EXPECT_EQ(13, n_global_nonzeros(edge_sparsity));
+
+    SparsityPattern sparsity(dh_);
+    sparsity.add_couplings(SparsityPattern::cell | SparsityPattern::edge | SparsityPattern::dimjoin);
+    sparsity.finalize();
+    EXPECT_EQ(17, n_global_nonzeros(sparsity));
+
+    if (dh_->distr()->np() == 1)
+        for (unsigned int i=0; i<dh_->lsize(); ++i)
+            EXPECT_EQ(0, sparsity.off_nz()[i]);
+}
+
+
+TEST_F(SparsityPatternTest, explicit_couplings) {
+    // repeated couplings are counted only once, also if they are added by other process
+    SparsityPattern sparsity(dh_);
+    std::vector<LongIdx> all_dofs(dh_->n_global_dofs());
+    std::iota(all_dofs.begin(), all_dofs.end(), 0);
+    std::vector<LongIdx> first_dof = { 0 };
+    sparsity.add(first_dof, all_dofs);
+    sparsity.add(first_dof, all_dofs);
+    sparsity.finalize();
+
+    EXPECT_EQ(5, n_global_nonzeros(sparsity));
+    if (dh_->distr()->is_local(0)) {
+        EXPECT_EQ((LongIdx)dh_->lsize(), sparsity.on_nz()[0]);
+        EXPECT_EQ((LongIdx)(dh_->n_global_dofs() - dh_->lsize()), sparsity.off_nz()[0]);
+    }
+}
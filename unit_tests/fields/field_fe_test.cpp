@@ -22,6 +22,7 @@
 #include "fields/field_values.hh"
 #include "fields/field_set.hh"
 #include "fields/field_fe.hh"
+#include "io/reader_cache.hh"
 #include "tools/unit_si.hh"
 #include "fields/bc_field.hh"
 #include "quadrature/quadrature.hh"
@@ -370,6 +371,33 @@ TEST_F(FieldEvalFETest, interpolation_gauss) {
 }
 
 
+TEST_F(FieldEvalFETest, interpolation_map_cache) {
+    this->create_mesh("fields/interpolation_rect_small.msh");
+    FilePath source_file("fields/interpolation_rectangle.msh", FilePath::input_file);
+    unsigned int n_created = 0;
+    auto create_map = [&n_created](InterpolationMap &map) {
+        n_created++;
+        map.row_offset.push_back(0);
+    };
+
+    // incomplete operator is not stored
+    EXPECT_THROW( ReaderCache::interpolation_map(source_file, mesh_, 0,
+            [](InterpolationMap &) { THROW( ExcMessage() << EI_Message("failed creation") ); }), ExcMessage );
+
+    {
+        auto map_1 = ReaderCache::interpolation_map(source_file, mesh_, 0, create_map);
+        auto map_2 = ReaderCache::interpolation_map(source_file, mesh_, 0, create_map);
+        EXPECT_EQ(1, n_created);
+        EXPECT_EQ(map_1, map_2);
+        EXPECT_EQ(1, map_1->row_offset.size());
+    }
+
+    // operator is released with its last user
+    ReaderCache::interpolation_map(source_file, mesh_, 0, create_map);
+    EXPECT_EQ(2, n_created);
+}
+
+
 TEST_F(FieldEvalFETest, interpolation_gauss_unit_conversion) {
     string eq_data_input = R"YAML(
     data:
@@ -167,6 +167,42 @@ TEST_F(FieldModelTest, create) {
 }
 
 
+// Functor with resolution 'scalar * tensor'
+Tensor fn_tensor_product(Scalar a, Tensor t) {
+    return a * t;
+}
+
+
+// Test of FieldModel with tensor result (evaluated on component blocks of cache)
+TEST_F(FieldModelTest, create_tensor) {
+    Field<3, FieldValue<3>::Scalar > f_scal;
+    Field<3, FieldValue<3>::TensorFixed > f_tens;
+    TimeGovernor tg(0.0, 1.0);
+    this->init_field_caches();
+
+    auto f_product_ptr = Model<3, FieldValue<3>::TensorFixed>::create(fn_tensor_product, f_scal, f_tens);
+    Field<3, FieldValue<3>::TensorFixed > f_product;
+    f_product.set_mesh( *mesh );
+    f_product.set(f_product_ptr, 0.0);
+    f_product.set_time(tg.step(), LimitSide::right);
+
+    this->start_elements_update();
+    this->fill_cache_data();
+    Tensor tensor_val{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+    for (unsigned int i=0; i<n_items; ++i) {
+        f_scal.value_cache()->set(i) = 1.0 + i*0.5;
+        f_tens.value_cache()->set(i) = tensor_val + i;
+    }
+
+    f_product.cache_update(*this, 0);
+    for (unsigned int i=0; i<n_items; ++i) {
+        Tensor expected = (1.0 + i*0.5) * (tensor_val + i);
+        Tensor val = f_product.value_cache()->template mat<3, 3>(i);
+        EXPECT_ARMA_EQ(val, expected);
+    }
+}
+
+
 
 
 // Functor with resolution 'scalar * multi'
@@ -106,6 +106,72 @@ TEST_F(FieldEvalPythonTest, evaluate) {
 }
 
 
+TEST_F(FieldEvalPythonTest, constant_in_time) {
+    string eq_data_input = R"YAML(
+    data:
+      - region: BULK
+        time: 0.0
+        scalar_field: !FieldPython
+          source_file: ./fields/field_python_test.py
+          class: FieldPythonTest4
+          used_fields: ['X']
+          constant_in_time: true
+        tensor_field: !FieldPython
+          source_file: ./fields/field_python_test.py
+          class: FieldPythonTest4
+          used_fields: ['X']
+        scalar_ref: !FieldFormula
+          value: X[0] + X[1]
+        tensor_ref: !FieldFormula
+          value: "[ [X[0], 0.2, 0.3], [1.2, 0.4, 0.5], [1.3, 1.5, 0.6] ]"
+    )YAML";
+
+    this->create_mesh("mesh/cube_2x1.msh");
+    this->read_input(eq_data_input);
+
+    eq_data_->reallocate_cache();
+
+    FieldRef<ScalarField> ref_scalar(eq_data_->scalar_ref);
+    FieldRef<TensorField> ref_tensor(eq_data_->tensor_ref);
+    EXPECT_TRUE( eval_bulk_field(eq_data_->scalar_field, ref_scalar) );
+    EXPECT_TRUE( eval_bulk_field(eq_data_->tensor_field, ref_tensor) );
+    // second evaluation reads stored values of scalar field
+    EXPECT_TRUE( eval_bulk_field(eq_data_->scalar_field, ref_scalar) );
+}
+
+
+TEST_F(FieldEvalPythonTest, different_used_fields) {
+    // fields share instance of user class, each of them has its own used fields
+    string eq_data_input = R"YAML(
+    data:
+      - region: BULK
+        time: 0.0
+        scalar_field: !FieldPython
+          source_file: ./fields/field_python_test.py
+          class: FieldPythonTest5
+          used_fields: ['X']
+        vector_field: !FieldPython
+          source_file: ./fields/field_python_test.py
+          class: FieldPythonTest5
+          used_fields: ['scalar_ref']
+        scalar_ref: !FieldFormula
+          value: X[0]
+        vector_ref: !FieldFormula
+          value: "[X[0], 2*X[0], 0.0]"
+    )YAML";
+
+    this->create_mesh("mesh/cube_2x1.msh");
+    this->read_input(eq_data_input);
+
+    eq_data_->reallocate_cache();
+
+    FieldRef<ScalarField> ref_scalar(eq_data_->scalar_ref);
+    FieldRef<VectorField> ref_vector(eq_data_->vector_ref);
+    EXPECT_TRUE( eval_bulk_field(eq_data_->scalar_field, ref_scalar) );
+    EXPECT_TRUE( eval_bulk_field(eq_data_->vector_field, ref_vector) );
+}
+
+
 TEST_F(FieldEvalPythonTest, exc_nonexist_file) {
     string eq_data_input = R"YAML(
     data:
@@ -59,4 +59,31 @@ class FieldPythonTest3(flowpy.PythonFieldBase):
     def python_field(self):
         """ Evaluates expression: x """
         return self.X[0]
-        
\ No newline at end of file
+        
+
+
+class FieldPythonTest4(flowpy.PythonFieldBase):
+    pass
+
+    def scalar_field(self):
+        """ Evaluates expression: x + y """
+        return self.X[0] + self.X[1]
+
+    def tensor_field(self):
+        """ Evaluates expression: [[x, 0.2, 0.3], [1.2, 0.4, 0.5], [1.3, 1.5, 0.6]] """
+        xx = self.X[0]
+        part_00 = self.repl( np.array([[1.0, 0, 0], [0, 0, 0], [0, 0, 0]]) ) * xx
+        other   = self.repl( np.array([[0.0, 0.2, 0.3], [1.2, 0.4, 0.5], [1.3, 1.5, 0.6]]) ) * np.full((self._region_chunk_end-self._region_chunk_begin), 1.0)
+        return part_00 + other
+
+
+class FieldPythonTest5(flowpy.PythonFieldBase):
+    pass
+
+    def scalar_field(self):
+        """ Evaluates expression: x """
+        return self.X[0]
+
+    def vector_field(self):
+        """ Evaluates expression: [x, 2*x, 0], uses only scalar_ref field """
+        return self.repl( np.array([1.0, 2.0, 0.0]) ) * self.scalar_ref
@@ -0,0 +1,161 @@
+/*
+ * field_value_cache_speed_test.cpp
+ *
+ *  Tests speed of evaluation of FieldValueCache data point by point (armadillo values
+ *  of FieldModel and FieldConstant before vectorization) and by current implementation
+ *  of cache_update (FieldModel::cache_update evaluated on component blocks of Armor::Array).
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+#include <algorithm>
+#include <cmath>
+
+#include "system/global_defs.h"
+
+
+#ifdef FLOW123D_RUN_UNIT_BENCHMARKS
+
+#include <mesh_constructor.hh>
+#include "system/armor.hh"
+#include "system/sys_profiler.hh"
+#include "fields/field_value_cache.hh"
+#include "fields/field_model.hh"
+#include "fields/eval_points.hh"
+#include "mesh/mesh.h"
+#include "quadrature/quadrature_lib.hh"
+
+static const uint N_POINTS = 1200;   // typical size of patch
+static const uint REPEAT = 100000;
+
+using Scalar = double;
+using Vector = arma::vec3;
+using Tensor = arma::mat33;
+
+// Functors of FieldModels
+Scalar fn_norm(Vector v) {
+    return arma::norm(v, 2);
+}
+
+Tensor fn_scale(Scalar a, Tensor t) {
+    return 0.5 * a * t;
+}
+
+
+class FieldValueCacheSpeedTest : public testing::Test, public ElementCacheMap {
+public:
+    virtual void SetUp() {
+        Profiler::instance();
+        FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+        PetscInitialize(0,PETSC_NULL,PETSC_NULL,PETSC_NULL);
+        CacheMapElementNumber::set(N_POINTS);
+        mesh = mesh_full_constructor("{ mesh_file=\"mesh/cube_2x1.msh\", optimize_mesh=false }");
+
+        // all points in one region chunk
+        std::shared_ptr<EvalPoints> eval_points = std::make_shared<EvalPoints>();
+        QGauss q_bulk(3, 2);
+        eval_points->add_bulk<3>(q_bulk);
+        this->init(eval_points);
+        this->start_elements_update();
+        this->regions_starts_.emplace_back(0);
+        this->regions_starts_.emplace_back(1);
+        this->regions_starts_.make_permanent();
+        this->element_starts_.emplace_back(0);
+        this->element_starts_.emplace_back(N_POINTS);
+        this->element_starts_.make_permanent();
+        for (uint i=0; i<N_POINTS; ++i) this->eval_point_data_.emplace_back(1, 1, i, 0);
+        this->eval_point_data_.make_permanent();
+    }
+
+    virtual void TearDown() {
+        delete mesh;
+        Profiler::uninitialize();
+    }
+
+    Mesh *mesh;
+};
+
+
+TEST_F(FieldValueCacheSpeedTest, compare_speed) {
+    TimeGovernor tg(0.0, 1.0);
+    Field<3, FieldValue<3>::Scalar > f_scalar;
+    Field<3, FieldValue<3>::VectorFixed > f_vector;
+    Field<3, FieldValue<3>::TensorFixed > f_tensor;
+
+    Field<3, FieldValue<3>::Scalar > f_norm;
+    f_norm.set_mesh( *mesh );
+    f_norm.set(Model<3, FieldValue<3>::Scalar>::create(fn_norm, f_vector), 0.0);
+    f_norm.set_time(tg.step(), LimitSide::right);
+    Field<3, FieldValue<3>::TensorFixed > f_scale;
+    f_scale.set_mesh( *mesh );
+    f_scale.set(Model<3, FieldValue<3>::TensorFixed>::create(fn_scale, f_scalar, f_tensor), 0.0);
+    f_scale.set_time(tg.step(), LimitSide::right);
+
+    FieldValueCache<double> &scalar_cache = *f_scalar.value_cache();
+    FieldValueCache<double> &vector_cache = *f_vector.value_cache();
+    FieldValueCache<double> &tensor_cache = *f_tensor.value_cache();
+    FieldValueCache<double> scalar_result(1, 1, N_POINTS), tensor_result(3, 3, N_POINTS);
+    scalar_result.resize(N_POINTS);
+    tensor_result.resize(N_POINTS);
+
+    arma::mat33 const_tensor{0.1, 0.2, 0.3, 0.2, 0.4, 0.5, 0.3, 0.5, 0.6};
+    for (uint i=0; i<N_POINTS; ++i) {
+        scalar_cache.set(i) = 0.5 + i;
+        vector_cache.set(i) = arma::vec3{1.0*i, 2.0, 3.0};
+    }
+
+    // FieldConstant
+    {
+        START_TIMER("const_tensor_point_by_point");
+        for (uint j=0; j<REPEAT; ++j)
+            for (uint i=0; i<N_POINTS; ++i)
+                tensor_cache.set(i) = const_tensor;
+        END_TIMER("const_tensor_point_by_point");
+    }
+    {
+        START_TIMER("const_tensor_packed");
+        for (uint j=0; j<REPEAT; ++j)
+            for (uint i_comp=0; i_comp<9; ++i_comp) {
+                double *comp_data = tensor_cache(i_comp % 3, i_comp / 3);
+                std::fill(comp_data, comp_data + N_POINTS, const_tensor(i_comp));
+            }
+        END_TIMER("const_tensor_packed");
+    }
+
+    // FieldModel with scalar result: norm of vector
+    {
+        START_TIMER("model_scalar_point_by_point");
+        for (uint j=0; j<REPEAT; ++j)
+            for (uint i=0; i<N_POINTS; ++i)
+                scalar_result.set(i) = fn_norm(vector_cache.vec<3>(i));
+        END_TIMER("model_scalar_point_by_point");
+    }
+    {
+        START_TIMER("model_scalar_cache_update");
+        for (uint j=0; j<REPEAT; ++j)
+            f_norm.cache_update(*this, 0);
+        END_TIMER("model_scalar_cache_update");
+    }
+    EXPECT_DOUBLE_EQ( scalar_result.scalar(10), f_norm.value_cache()->scalar(10) );
+
+    // FieldModel with tensor result: scalar * tensor
+    {
+        START_TIMER("model_tensor_point_by_point");
+        for (uint j=0; j<REPEAT; ++j)
+            for (uint i=0; i<N_POINTS; ++i)
+                tensor_result.set(i) = fn_scale(scalar_cache.scalar(i), tensor_cache.mat<3,3>(i));
+        END_TIMER("model_tensor_point_by_point");
+    }
+    {
+        START_TIMER("model_tensor_cache_update");
+        for (uint j=0; j<REPEAT; ++j)
+            f_scale.cache_update(*this, 0);
+        END_TIMER("model_tensor_cache_update");
+    }
+    EXPECT_DOUBLE_EQ( tensor_result.mat<3,3>(10)(1,2), f_scale.value_cache()->mat<3,3>(10)(1,2) );
+
+    Profiler::instance()->output(cout);
+}
+
+#endif // FLOW123D_RUN_UNIT_BENCHMARKS
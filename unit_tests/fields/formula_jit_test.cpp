@@ -0,0 +1,71 @@
+/*
+ * formula_jit_test.cpp
+ *
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+#include <cmath>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+#include "fields/formula_jit.hh"
+
+
+TEST(FormulaJit, translate) {
+    {
+        FormulaJit::Translation tr = FormulaJit::translate("2*x + y**2 - t");
+        EXPECT_EQ("(((2.0 * v0[i]) + std::pow(v1[i], 2.0)) - t)", tr.expression);
+        EXPECT_EQ(2u, tr.variables.size());
+        EXPECT_EQ("x", tr.variables[0]);
+        EXPECT_EQ("y", tr.variables[1]);
+        EXPECT_TRUE(tr.has_time);
+    }
+    {
+        FormulaJit::Translation tr = FormulaJit::translate("sin(pi*z) if conc > 0.5 else max(conc, d)");
+        EXPECT_EQ(3u, tr.variables.size());
+        EXPECT_EQ("z", tr.variables[0]);
+        EXPECT_EQ("conc", tr.variables[1]);
+        EXPECT_EQ("d", tr.variables[2]);
+        EXPECT_FALSE(tr.has_time);
+    }
+
+    // unsupported formulas
+    EXPECT_THROW( FormulaJit::translate("[x, y, z]"), FormulaJit::ExcUnsupportedFormula );
+    EXPECT_THROW( FormulaJit::translate("foo(x)"), FormulaJit::ExcUnsupportedFormula );
+    EXPECT_THROW( FormulaJit::translate("abs(x) +"), FormulaJit::ExcUnsupportedFormula );
+}
+
+
+TEST(FormulaJit, evaluate) {
+    std::string formula = "x**2 + 0.5*sin(y) - t if x > 1 and not y > 3 else exp(-y) % 0.3";
+    FormulaJit::Translation tr = FormulaJit::translate(formula);
+    EXPECT_EQ(nullptr, FormulaJit::get_function(formula, tr)); // backend is disabled
+
+    // temporary cache directory, space in name checks passing of paths to compiler
+    boost::filesystem::path cache_dir = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("formula jit %%%%-%%%%-%%%%");
+    FormulaJit::set_cache_dir(cache_dir.string());
+    EXPECT_TRUE(FormulaJit::is_enabled());
+    FormulaJit::EvalFunction func = FormulaJit::get_function(formula, tr);
+    ASSERT_NE(nullptr, func);
+    EXPECT_EQ(func, FormulaJit::get_function(formula, tr)); // function is cached
+
+    std::vector<double> x = {0.0, 1.5, 2.0, 3.0, 4.0};
+    std::vector<double> y = {1.0, 2.0, 4.0, 0.5, 1.0};
+    std::vector<double> result(x.size(), -1.0);
+    std::vector<const double *> vars = {x.data(), y.data()};
+    double t = 0.25;
+    func(vars.data(), t, result.data(), 1, 4);
+
+    EXPECT_DOUBLE_EQ(-1.0, result[0]);
+    EXPECT_DOUBLE_EQ(-1.0, result[4]);
+    for (unsigned int i=1; i<4; ++i) {
+        double ref = (x[i] > 1 && !(y[i] > 3)) ? x[i]*x[i] + 0.5*std::sin(y[i]) - t : std::fmod(std::exp(-y[i]), 0.3);
+        EXPECT_DOUBLE_EQ(ref, result[i]);
+    }
+
+    FormulaJit::set_cache_dir("");
+    boost::filesystem::remove_all(cache_dir);
+}
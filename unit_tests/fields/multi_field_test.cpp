@@ -227,6 +227,9 @@ TEST_F(MultiFieldTest, const_full_test) {
 
     this->read_input(eq_data_input);
     this->set_dh_cell(4, 39);
+    EXPECT_FALSE( eq_data_->scalar_field.has_equal_components() );
+    EXPECT_FALSE( eq_data_->scalar_field.equal_components(0, 1) );
+    EXPECT_TRUE( eq_data_->scalar_field.equal_components(1, 1) );
 
     for (uint i_time=0; i_time<2; i_time++) { // test in 2 time steps: 0.25, 1.0
         eq_data_->set_time(tg.step(), LimitSide::right);
@@ -244,6 +247,31 @@ TEST_F(MultiFieldTest, const_full_test) {
 }
 
 
+TEST_F(MultiFieldTest, equal_components_test) {
+    string eq_data_input = R"YAML(
+    data:
+      - region: ALL
+        time: 0.0
+        scalar_field:
+          - !FieldConstant
+            value: 1
+          - !FieldConstant
+            value: 2
+          - !FieldConstant
+            value: 1
+      - region: ALL
+        time: 0.5
+        scalar_field: 3
+    )YAML";
+
+    this->read_input(eq_data_input);
+    EXPECT_FALSE( eq_data_->scalar_field.has_equal_components() );
+    EXPECT_TRUE( eq_data_->scalar_field.equal_components(0, 2) );
+    EXPECT_FALSE( eq_data_->scalar_field.equal_components(0, 1) );
+    EXPECT_FALSE( eq_data_->scalar_field.equal_components(1, 2) );
+}
+
+
 TEST_F(MultiFieldTest, const_base_test) {
     string eq_data_input = R"YAML(
     data:
@@ -255,6 +283,7 @@ TEST_F(MultiFieldTest, const_base_test) {
 
     this->read_input(eq_data_input);
     this->set_dh_cell(4, 39);
+    EXPECT_TRUE( eq_data_->scalar_field.has_equal_components() );
 
     for (uint i_time=0; i_time<2; i_time++) { // test in 2 time steps: 0.25, 1.0
         eq_data_->set_time(tg.step(), LimitSide::right);
@@ -282,6 +311,7 @@ TEST_F(MultiFieldTest, const_autoconv_test) {
 
     this->read_input(eq_data_input);
     this->set_dh_cell(4, 39);
+    EXPECT_TRUE( eq_data_->scalar_field.has_equal_components() );
 
     for (uint i_time=0; i_time<2; i_time++) { // test in 2 time steps: 0.25, 1.0
         eq_data_->set_time(tg.step(), LimitSide::right);
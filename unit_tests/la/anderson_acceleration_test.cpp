@@ -0,0 +1,125 @@
+/*
+ * anderson_acceleration_test.cpp
+ *
+ *  Tests Anderson acceleration on linear fixed point problem x = A*x + b with diagonal contraction A
+ *  and two blocks of very different scales, one of them possibly restricted to a subset of entries.
+ */
+
+#define TEST_USE_PETSC
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest_mpi.hh>
+#include <cmath>
+#include "la/anderson_acceleration.hh"
+#include "la/vector_mpi.hh"
+
+
+class AndersonTest : public testing::Test {
+public:
+    static const unsigned int block_size = 50;
+
+    AndersonTest()
+    : p_(block_size), u_(block_size)
+    {
+        MPI_Comm_rank(PETSC_COMM_WORLD, &rank_);
+    }
+
+    /// Contraction factor of i-th component, in interval [0.5, 0.95).
+    double contraction(unsigned int i) const
+    { return 0.5 + 0.45 * ((i + rank_*block_size) % 97) / 97.0; }
+
+    /// Exact solution of i-th component of block with given scale.
+    double solution(unsigned int i, double scale) const
+    { return scale * (1.0 + std::sin(i + rank_*block_size)); }
+
+    /// Evaluate G(x) = A*x + b in place, return max norm of G(x) - x relative to block scales.
+    double evaluate() {
+        double res = 0.0;
+        for (unsigned int i=0; i<block_size; ++i) {
+            double a = contraction(i);
+            double p_new = a * p_.get(i) + (1-a) * solution(i, p_scale);
+            double u_new = a * u_.get(i) + (1-a) * solution(i, u_scale);
+            res = std::max(res, std::fabs(p_new - p_.get(i)) / p_scale);
+            res = std::max(res, std::fabs(u_new - u_.get(i)) / u_scale);
+            p_.set(i, p_new);
+            u_.set(i, u_new);
+        }
+        double global_res;
+        MPI_Allreduce(&res, &global_res, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+        return global_res;
+    }
+
+    /// Perform fixed point iterations, possibly accelerated, return number of iterations.
+    unsigned int iterate(AndersonAcceleration *acceleration) {
+        p_.zero_entries();
+        u_.zero_entries();
+        if (acceleration) {
+            acceleration->add_block(p_);
+            acceleration->add_block(u_);
+            acceleration->restart();
+        }
+        unsigned int it = 0;
+        while (it < max_it) {
+            it++;
+            if (evaluate() < tolerance) break;
+            if (acceleration) acceleration->apply();
+        }
+        return it;
+    }
+
+    const double p_scale = 1e2;
+    const double u_scale = 1e-5;
+    const double tolerance = 1e-10;
+    const unsigned int max_it = 1000;
+
+    int rank_;
+    VectorMPI p_, u_;
+};
+
+
+TEST_F(AndersonTest, linear_contraction) {
+    unsigned int plain_it = iterate(nullptr);
+    EXPECT_LT(plain_it, max_it);
+
+    AndersonAcceleration secant(1);
+    unsigned int secant_it = iterate(&secant);
+    EXPECT_LT(secant_it, plain_it);
+
+    AndersonAcceleration anderson(5);
+    unsigned int anderson_it = iterate(&anderson);
+    EXPECT_LT(anderson_it, plain_it / 2);
+
+    AndersonAcceleration damped(5, 0.7);
+    unsigned int damped_it = iterate(&damped);
+    EXPECT_LT(damped_it, plain_it / 2);
+
+    for (unsigned int i=0; i<block_size; ++i) {
+        EXPECT_NEAR(solution(i, p_scale), p_.get(i), 1e-6 * p_scale);
+        EXPECT_NEAR(solution(i, u_scale), u_.get(i), 1e-6 * u_scale);
+    }
+}
+
+
+TEST_F(AndersonTest, partial_block) {
+    // accelerate only first half of p_ and whole u_, second half of p_ must follow plain iteration
+    std::vector<unsigned int> first_half;
+    for (unsigned int i=0; i<block_size/2; ++i) first_half.push_back(i);
+
+    p_.zero_entries();
+    u_.zero_entries();
+    AndersonAcceleration anderson(5);
+    anderson.add_block(p_, first_half);
+    anderson.add_block(u_);
+    anderson.restart();
+
+    for (unsigned int it=0; it<20; ++it) {
+        evaluate();
+        anderson.apply();
+        for (unsigned int i=block_size/2; i<block_size; ++i) {
+            double a = contraction(i);
+            EXPECT_NEAR((1 - std::pow(a, it+1)) * solution(i, p_scale), p_.get(i), 1e-12 * p_scale);
+        }
+    }
+
+    EXPECT_ASSERT_DEATH( { anderson.add_block(p_, {block_size}); }, "not locally owned");
+}
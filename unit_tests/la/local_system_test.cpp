@@ -9,6 +9,7 @@
 
 #include "flow_gtest.hh"
 #include "la/local_system.hh"
+#include "la/local_schur_batch.hh"
 #include <armadillo>
 #include "arma_expect.hh"
 #include "system/system.hh"
@@ -504,3 +505,49 @@ TEST(la, schur_complement) {
 //     reconstructed_solution.print();
     EXPECT_ARMA_EQ(res_sol.subvec(0,2), reconstructed_solution);
 }
+
+
+TEST(la, schur_complement_batch) {
+    arma::mat M1 = {{1, 1, -1, 1, 2}, {1, 2, 1, 2, 0}, {2, -1, 1, 3, 1},
+                    {1, 2, 3, 4, 1}, {2, 0, 1, 1, 2}};
+    arma::vec rhs1 = {1, -2, 1, 2, -1};
+    // zero diagonal entry in block A, pivoting is necessary
+    arma::mat M2 = {{0, 1, 2, 1, 0}, {1, 0, 1, 0, 1}, {2, 1, 3, 1, 1},
+                    {1, 0, 1, 2, 1}, {0, 1, 1, 1, 3}};
+    arma::vec rhs2 = {2, 0, -1, 1, 3};
+
+    // more systems than simd_width, last tile is not full
+    const unsigned int n_systems = LocalSchurBatch::simd_width + 2;
+    LocDofVec dofs = {0, 1, 2, 3, 4};
+    std::vector<LocalSystem> ls(n_systems), ref_ls(n_systems);
+    LocalSchurBatch batch(3, 2);
+    batch.resize(n_systems);
+    EXPECT_EQ(n_systems, batch.size());
+    for (unsigned int i=0; i<n_systems; ++i) {
+        batch.reset_system(i, ls[i], dofs);
+        const arma::mat &M = (i%2 == 0) ? M1 : M2;
+        const arma::vec &rhs = (i%2 == 0) ? rhs1 : rhs2;
+        for (unsigned int r=0; r<5; ++r) {
+            ls[i].add_value(r, (i+1) * rhs(r));
+            for (unsigned int c=0; c<5; ++c) ls[i].add_value(r, c, (i+1) * M(r, c));
+        }
+        ref_ls[i].reset(dofs, dofs);
+        ref_ls[i].set_matrix(ls[i].get_matrix());
+        ref_ls[i].set_rhs(ls[i].get_rhs());
+    }
+    batch.compute_schur_complement(true);
+
+    for (unsigned int i=0; i<n_systems; ++i) {
+        LocalSystem ref_schur, schur(2, 2);
+        ref_ls[i].compute_schur_complement(3, ref_schur, true);
+        batch.get_schur_complement(i, schur);
+        EXPECT_ARMA_EQ(ref_schur.get_matrix(), schur.get_matrix());
+        EXPECT_ARMA_EQ(ref_schur.get_rhs(), schur.get_rhs());
+
+        arma::vec schur_sol = arma::solve(-ref_schur.get_matrix(), -ref_schur.get_rhs());
+        arma::vec res_sol = arma::solve(ref_ls[i].get_matrix(), ref_ls[i].get_rhs());
+        arma::vec reconstructed_solution;
+        LocalSchurBatch::reconstruct_solution_schur(ls[i], 3, schur_sol, reconstructed_solution);
+        EXPECT_ARMA_EQ(res_sol.subvec(0,2), reconstructed_solution);
+    }
+}
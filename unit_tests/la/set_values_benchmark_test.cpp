@@ -10,6 +10,7 @@
 
 #include "system/system.hh"
 #include "system/sys_profiler.hh"
+#include "tools/thread_pool.hh"
 #include <armadillo>
 #include "mpi.h"
 
@@ -181,6 +182,197 @@ TEST_F(LinSys_PETSC_Test, set_local_system_mm) {
 
 
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Test COO assembly of overlapping m x m blocks along diagonal, repeated with unchanged pattern.
+TEST_F(LinSys_PETSC_Test, mat_set_values_coo) {
+    LinSys_PETSC *ls_petsc = new LinSys_PETSC(new Distribution(ls_size, MPI_COMM_WORLD));
+    ls_petsc->set_coo_assembly();
+    ls = ls_petsc;
+    this->allocate_linsys();
+
+    // 'local system' to be added
+    double vals[m*m];
+    for(int i = 0; i<m*m; i++) vals[i] = 1.0;
+    int rows[m];
+    const unsigned int n_coo_loops = n_loops / 1000;
+
+    for(unsigned int i_assembly = 0; i_assembly < 2; i_assembly++) {
+        ls->start_add_assembly();
+        ls->mat_zero_entries();
+
+        START_TIMER("LinSys_PETSC_mat_set_values_coo");
+
+        for(unsigned int q = 0; q < n_coo_loops; q++)
+            for(int i_block = 0; i_block <= ls_size-m; i_block++) {
+                for(int i = 0; i<m; i++) rows[i] = i_block + i;
+                ls->mat_set_values(m, rows, m, rows, vals);
+            }
+        ls->finish_assembly();
+
+        END_TIMER("LinSys_PETSC_mat_set_values_coo");
+    }
+
+    // check values of some entries, second assembly must not add to the first one
+    int check_rows[1] = { offset };
+    int check_cols[3] = { offset, offset+m-1, offset+m };
+    double check_vals[3];
+    MatGetValues(*ls->get_matrix(), 1, check_rows, 3, check_cols, check_vals);
+    EXPECT_DOUBLE_EQ( m*n_coo_loops, check_vals[0] );
+    EXPECT_DOUBLE_EQ( n_coo_loops, check_vals[1] );
+    EXPECT_DOUBLE_EQ( 0.0, check_vals[2] );
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Test COO assembly by tasks of ThreadPool, pattern must be same as in serial assembly.
+class LinSys_PETSC_Coo : public LinSys_PETSC {
+public:
+    LinSys_PETSC_Coo(const Distribution * rows_ds) : LinSys_PETSC(rows_ds) {}
+
+    std::vector<PetscInt> coo_pattern() const {
+        std::vector<PetscInt> pattern(coo_rows_);
+        pattern.insert(pattern.end(), coo_cols_.begin(), coo_cols_.end());
+        return pattern;
+    }
+};
+
+TEST_F(LinSys_PETSC_Test, mat_set_values_coo_threads) {
+    LinSys_PETSC_Coo *ls_petsc = new LinSys_PETSC_Coo(new Distribution(ls_size, MPI_COMM_WORLD));
+    ls_petsc->set_coo_assembly();
+    ls = ls_petsc;
+    this->allocate_linsys();
+
+    double vals[m*m];
+    for(int i = 0; i<m*m; i++) vals[i] = 1.0;
+    const unsigned int n_blocks = ls_size-m+1, n_tasks = 4;
+    ThreadPool pool(n_tasks-1);
+    std::mutex ls_mutex;
+
+    auto add_block = [&](int i_block) {
+        int rows[m];
+        for(int i = 0; i<m; i++) rows[i] = i_block + i;
+        std::lock_guard<std::mutex> lock(ls_mutex);
+        ls->mat_set_values(m, rows, m, rows, vals);
+    };
+
+    std::vector< std::vector<PetscInt> > patterns;
+    for(unsigned int i_assembly = 0; i_assembly < 3; i_assembly++) {
+        ls->start_add_assembly();
+        ls->mat_zero_entries();
+        if (i_assembly == 0) {
+            for(unsigned int i_block = 0; i_block < n_blocks; i_block++) add_block(i_block);
+        } else {
+            pool.parallel_for(n_tasks, [&](unsigned int i_task) {
+                for(unsigned int i_block = n_blocks*i_task/n_tasks; i_block < n_blocks*(i_task+1)/n_tasks; i_block++)
+                    add_block(i_block);
+            });
+        }
+        ls->finish_assembly();
+        patterns.push_back( ls_petsc->coo_pattern() );
+    }
+    EXPECT_EQ( patterns[0], patterns[1] );
+    EXPECT_EQ( patterns[0], patterns[2] );
+
+    int check_rows[1] = { offset };
+    int check_cols[3] = { offset, offset+m-1, offset+m };
+    double check_vals[3];
+    MatGetValues(*ls->get_matrix(), 1, check_rows, 3, check_cols, check_vals);
+    EXPECT_DOUBLE_EQ( m, check_vals[0] );
+    EXPECT_DOUBLE_EQ( 1.0, check_vals[1] );
+    EXPECT_DOUBLE_EQ( 0.0, check_vals[2] );
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Test solution of diagonal system for two right-hand sides at once.
+TEST_F(LinSys_PETSC_Test, solve_multi) {
+    Distribution *ds = new Distribution(ls_size, MPI_COMM_WORLD);
+    LinSys_PETSC *ls_petsc = new LinSys_PETSC(ds, "-ksp_type cg -pc_type jacobi");
+    ls_petsc->set_tolerances(1.0e-12, 1.0e-14, 1.0e4, 100);
+    ls = ls_petsc;
+    ls->start_allocation();
+    for(unsigned int i = ds->begin(); i<ds->end(); i++)
+        ls->mat_set_value(i, i, 0.0);
+    ls->start_add_assembly();
+    for(unsigned int i = ds->begin(); i<ds->end(); i++)
+        ls->mat_set_value(i, i, i+1.0);
+    ls->finish_assembly();
+
+    // rhs_k[i] = (k+1)*(i+1), so that solution_k[i] = k+1
+    std::vector<Vec> rhs_vecs(2), solutions(2);
+    for(unsigned int k = 0; k<2; k++) {
+        VecCreateMPI(MPI_COMM_WORLD, ds->lsize(), PETSC_DECIDE, &rhs_vecs[k]);
+        VecDuplicate(rhs_vecs[k], &solutions[k]);
+        VecZeroEntries(solutions[k]);
+        for(unsigned int i = ds->begin(); i<ds->end(); i++)
+            VecSetValue(rhs_vecs[k], i, (k+1.0)*(i+1.0), INSERT_VALUES);
+        VecAssemblyBegin(rhs_vecs[k]);
+        VecAssemblyEnd(rhs_vecs[k]);
+    }
+
+    ls_petsc->solve_multi(rhs_vecs, solutions);
+
+    for(unsigned int k = 0; k<2; k++) {
+        double *sol_array;
+        VecGetArray(solutions[k], &sol_array);
+        for(unsigned int i = 0; i<ds->lsize(); i++)
+            EXPECT_NEAR(k+1.0, sol_array[i], 1.0e-10);
+        VecRestoreArray(solutions[k], &sol_array);
+        VecDestroy(&rhs_vecs[k]);
+        VecDestroy(&solutions[k]);
+    }
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Test repeated solution of diagonal system by persistent KSP with reused preconditioner.
+TEST_F(LinSys_PETSC_Test, pc_reuse) {
+    Distribution *ds = new Distribution(ls_size, MPI_COMM_WORLD);
+    LinSys_PETSC *ls_petsc = new LinSys_PETSC(ds, "-ksp_type cg -pc_type jacobi");
+    ls_petsc->set_tolerances(1.0e-12, 1.0e-14, 1.0e4, 100);
+    // preconditioner of older matrix is used for one solve with changed matrix
+    ls_petsc->set_pc_reuse(1, 1.0e3);
+    ls = ls_petsc;
+    ls->set_solution();
+    ls->start_allocation();
+    for(unsigned int i = ds->begin(); i<ds->end(); i++)
+        ls->mat_set_value(i, i, 0.0);
+
+    // matrix[i,i] = scale*(i+1), rhs[i] = scale*sol*(i+1)
+    auto assemble_and_solve = [&](double scale, double sol, bool assemble_matrix) {
+        ls->start_add_assembly();
+        if (assemble_matrix) {
+            ls->mat_zero_entries();
+            for(unsigned int i = ds->begin(); i<ds->end(); i++)
+                ls->mat_set_value(i, i, scale*(i+1.0));
+        }
+        ls->rhs_zero_entries();
+        for(unsigned int i = ds->begin(); i<ds->end(); i++)
+            ls->rhs_set_value(i, scale*sol*(i+1.0));
+        ls->finish_assembly();
+        EXPECT_EQ(assemble_matrix, ls->is_matrix_changed());
+
+        LinSys::SolveInfo si = ls->solve();
+        EXPECT_GT(si.converged_reason, 0);
+        EXPECT_FALSE(ls->is_matrix_changed());
+        double *sol_array;
+        VecGetArray(ls->get_solution(), &sol_array);
+        for(unsigned int i = 0; i<ds->lsize(); i++)
+            EXPECT_NEAR(sol, sol_array[i], 1.0e-10);
+        VecRestoreArray(ls->get_solution(), &sol_array);
+    };
+
+    assemble_and_solve(1.0, 1.0, true);   // create KSP
+    assemble_and_solve(1.0, 2.0, false);  // only RHS changed
+    assemble_and_solve(2.0, 3.0, true);   // reuse preconditioner of older matrix
+    assemble_and_solve(3.0, 4.0, true);   // rebuild preconditioner
+}
+
+
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Test AIJ matrix direct PETSC assembly of an m x m continuous matrix, whole block at once.
 TEST_F(LinSys_PETSC_Test, PETSC_mat_set_values_mm) {
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <vector>
 #include "mesh/accessors.hh"
+#include "mesh/neighbours.h"
 #include "mesh/partitioning.hh"
 #include "input/reader_to_storage.hh"
 #include "system/sys_profiler.hh"
@@ -85,6 +86,27 @@ TEST(MeshTopology, make_neighbours_and_edges) {
     //check neighbours
     EXPECT_EQ(6, mesh->n_vb_neighbours() );
 
+    // neighbours of elements are stored contiguously, every neighbour is referenced once
+    unsigned int n_elm_neighs = 0;
+    for (auto ele : mesh->elements_range())
+        for (unsigned int i=0; i<ele->n_neighs_vb(); ++i) {
+            EXPECT_EQ(ele.idx(), ele->neigh_vb[i]->element().idx());
+            n_elm_neighs++;
+        }
+    EXPECT_EQ(mesh->n_vb_neighbours(), n_elm_neighs);
+
+    // boundary indices are stored contiguously only for elements with a boundary side
+    unsigned int n_bdr_sides = 0;
+    for (auto ele : mesh->elements_range())
+        for (unsigned int i=0; i<ele->n_sides(); ++i)
+            if (ele.side(i)->cond_idx() != undef_idx) {
+                EXPECT_EQ(ele.side(i)->edge_idx(), mesh->boundary(ele.side(i)->cond_idx()).edge().side(0)->edge_idx());
+                n_bdr_sides++;
+            }
+    EXPECT_GT(n_bdr_sides, 0);
+    EXPECT_GE(mesh->topology_memory_size(), mesh->n_elements() * sizeof(Element));
+    EXPECT_GT(mesh->per_element_topology_memory_size(), mesh->topology_memory_size());
+
     delete mesh;
     Profiler::uninitialize();
 }
@@ -0,0 +1,73 @@
+/*
+ * msh_distributedreader_test.cpp
+ *
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest_mpi.hh>
+#include <string>
+#include <mesh_constructor.hh>
+#include "arma_expect.hh"
+
+#include "system/sys_profiler.hh"
+#include "system/file_path.hh"
+
+#include "mesh/mesh.h"
+#include "mesh/bc_mesh.hh"
+#include "mesh/accessors.hh"
+#include "mesh/node_accessor.hh"
+#include "la/distribution.hh"
+#include "io/msh_distributedreader.hh"
+
+
+// Distributed mesh holds own elements and elements sharing a node with them, compare them with full mesh by ids.
+void compare_meshes(Mesh *mesh, Mesh *distr_mesh) {
+    EXPECT_TRUE( distr_mesh->is_distributed() );
+    EXPECT_EQ( mesh->n_elements(), distr_mesh->get_el_ds()->size() );
+
+    for (unsigned int i=0; i<distr_mesh->n_nodes(); ++i) {
+        int node_idx = mesh->node_index( distr_mesh->find_node_id(i) );
+        ASSERT_GE( node_idx, 0 );
+        EXPECT_ARMA_EQ( *mesh->node(node_idx), *distr_mesh->node(i) );
+    }
+    for (unsigned int i=0; i<distr_mesh->n_elements(); ++i) {
+        ElementAccessor<3> distr_elm = distr_mesh->element_accessor(i);
+        int elm_idx = mesh->elem_index( distr_mesh->find_elem_id(i) );
+        ASSERT_GE( elm_idx, 0 );
+        ElementAccessor<3> elm = mesh->element_accessor(elm_idx);
+        EXPECT_EQ( elm.region().id(), distr_elm.region().id() );
+        EXPECT_EQ( elm->pid(), distr_elm->pid() );
+        ASSERT_EQ( elm->n_nodes(), distr_elm->n_nodes() );
+        for (unsigned int j=0; j<elm->n_nodes(); ++j)
+            EXPECT_EQ( mesh->find_node_id(elm->node_idx(j)), distr_mesh->find_node_id(distr_elm->node_idx(j)) );
+    }
+    for (unsigned int i=0; i<distr_mesh->bc_mesh()->n_elements(); ++i)
+        EXPECT_GE( mesh->bc_mesh()->elem_index( distr_mesh->bc_mesh()->find_elem_id(i) ), 0 );
+
+    // ghost layer
+    auto &node_elements = mesh->node_elements();
+    for (unsigned int i_loc=0; i_loc<distr_mesh->get_el_ds()->lsize(); ++i_loc) {
+        ElementAccessor<3> distr_elm = distr_mesh->element_accessor( distr_mesh->get_el_4_loc()[i_loc] );
+        EXPECT_EQ( distr_elm.proc(), distr_mesh->get_el_ds()->myp() );
+        for (unsigned int j=0; j<distr_elm->n_nodes(); ++j) {
+            int node_idx = mesh->node_index( distr_mesh->find_node_id(distr_elm->node_idx(j)) );
+            for (unsigned int elm_idx : node_elements[node_idx])
+                EXPECT_GE( distr_mesh->elem_index( mesh->find_elem_id(elm_idx) ), 0 );
+        }
+    }
+}
+
+
+TEST(DistributedGmshMeshReader, read_mesh) {
+    Profiler::instance();
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+
+    for (std::string mesh_file : {"mesh/simplest_cube.msh", "mesh/test_108_elem.msh"}) {
+        Mesh * mesh = mesh_full_constructor("{mesh_file=\"" + mesh_file + "\"}");
+        Mesh * distr_mesh = mesh_full_constructor("{mesh_file=\"" + mesh_file + "\", distributed_reading=true}");
+        compare_meshes(mesh, distr_mesh);
+        delete mesh;
+        delete distr_mesh;
+    }
+}
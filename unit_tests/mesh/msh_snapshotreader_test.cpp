@@ -0,0 +1,111 @@
+/*
+ * msh_snapshotreader_test.cpp
+ *
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest_mpi.hh>
+#include <string>
+#include <fstream>
+#include <boost/filesystem.hpp>
+#include <mesh_constructor.hh>
+#include "arma_expect.hh"
+
+#include "system/sys_profiler.hh"
+#include "system/file_path.hh"
+
+#include "mesh/mesh.h"
+#include "mesh/bc_mesh.hh"
+#include "mesh/accessors.hh"
+#include "mesh/node_accessor.hh"
+#include "io/msh_snapshotreader.hh"
+
+
+TEST(SnapshotMeshReader, write_and_read) {
+    Profiler::instance();
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+
+    // work on copy of mesh file, snapshot is stored next to mesh file
+    std::string mesh_path = boost::filesystem::absolute("snapshot_cube.msh").string();
+    {
+        std::ifstream src(string(UNIT_TESTS_SRC_DIR) + "/mesh/simplest_cube.msh", std::ios::binary);
+        std::ofstream dst(mesh_path, std::ios::binary);
+        dst << src.rdbuf();
+    }
+    boost::filesystem::remove( SnapshotMeshReader::snapshot_path(FilePath(mesh_path, FilePath::input_file)) );
+    std::string mesh_input = "{mesh_file=\"" + mesh_path + "\", snapshot=true}";
+
+    FilePath file(mesh_path, FilePath::input_file);
+    EXPECT_FALSE( SnapshotMeshReader::is_valid(file, true) );
+    Mesh * mesh = mesh_full_constructor(mesh_input);
+    EXPECT_TRUE( SnapshotMeshReader::is_valid(file, true) );
+    // snapshot holds optimized mesh, it is not valid for other value of 'optimize_mesh'
+    EXPECT_FALSE( SnapshotMeshReader::is_valid(file, false) );
+
+    // readers of input data never use snapshot
+    auto reader = BaseMeshReader::reader_factory(file);
+    EXPECT_EQ( nullptr, std::dynamic_pointer_cast<SnapshotMeshReader>(reader) );
+
+    Mesh * snapshot_mesh = mesh_full_constructor(mesh_input);
+    EXPECT_EQ( mesh->n_nodes(), snapshot_mesh->n_nodes() );
+    EXPECT_EQ( mesh->n_elements(), snapshot_mesh->n_elements() );
+    EXPECT_EQ( mesh->bc_mesh()->n_elements(), snapshot_mesh->bc_mesh()->n_elements() );
+    EXPECT_EQ( mesh->node_permutations(), snapshot_mesh->node_permutations() );
+    EXPECT_EQ( mesh->element_permutations(), snapshot_mesh->element_permutations() );
+
+    for (unsigned int i=0; i<mesh->n_nodes(); ++i) {
+        EXPECT_EQ( mesh->find_node_id(i), snapshot_mesh->find_node_id(i) );
+        EXPECT_ARMA_EQ( *mesh->node(i), *snapshot_mesh->node(i) );
+    }
+    for (unsigned int i=0; i<mesh->n_elements(); ++i) {
+        ElementAccessor<3> elm = mesh->element_accessor(i);
+        ElementAccessor<3> snapshot_elm = snapshot_mesh->element_accessor(i);
+        EXPECT_EQ( mesh->find_elem_id(i), snapshot_mesh->find_elem_id(i) );
+        EXPECT_EQ( elm.region().id(), snapshot_elm.region().id() );
+        for (unsigned int j=0; j<elm->n_nodes(); ++j)
+            EXPECT_EQ( elm->node_idx(j), snapshot_elm->node_idx(j) );
+        EXPECT_EQ( elm->permutation_, snapshot_elm->permutation_ );
+        EXPECT_EQ( elm->n_neighs_vb(), snapshot_elm->n_neighs_vb() );
+        for (unsigned int j=0; j<elm->n_sides(); ++j) {
+            EXPECT_EQ( elm->edge_idx(j), snapshot_elm->edge_idx(j) );
+            EXPECT_EQ( elm.side(j)->is_boundary(), snapshot_elm.side(j)->is_boundary() );
+        }
+    }
+    for (unsigned int i=0; i<mesh->bc_mesh()->n_elements(); ++i) {
+        EXPECT_EQ( mesh->bc_mesh()->find_elem_id(i), snapshot_mesh->bc_mesh()->find_elem_id(i) );
+        EXPECT_EQ( mesh->bc_mesh()->element_accessor(i).region().id(), snapshot_mesh->bc_mesh()->element_accessor(i).region().id() );
+    }
+
+    // topology and BIH tree are read from snapshot
+    EXPECT_EQ( mesh->n_edges(), snapshot_mesh->n_edges() );
+    EXPECT_EQ( mesh->n_vb_neighbours(), snapshot_mesh->n_vb_neighbours() );
+    EXPECT_EQ( mesh->n_boundaries(), snapshot_mesh->n_boundaries() );
+    EXPECT_EQ( mesh->n_sides(), snapshot_mesh->n_sides() );
+    for (unsigned int i=0; i<mesh->n_edges(); ++i)
+        EXPECT_EQ( mesh->edge(i).n_sides(), snapshot_mesh->edge(i).n_sides() );
+    std::vector<unsigned int> found, snapshot_found;
+    for (arma::vec3 point : { arma::vec3{0.5, 0.5, 0.5}, arma::vec3{-0.5, 0.2, -0.8}, arma::vec3{0.0, 0.0, 0.0} }) {
+        mesh->get_bih_tree().find_point(point, found);
+        snapshot_mesh->get_bih_tree().find_point(point, snapshot_found);
+        EXPECT_EQ( found, snapshot_found );
+    }
+
+    // modification time is changed, content of file is compared by hash
+    std::time_t mtime = boost::filesystem::last_write_time(mesh_path);
+    boost::filesystem::last_write_time(mesh_path, mtime - 10);
+    EXPECT_TRUE( SnapshotMeshReader::is_valid(file, true) );
+
+    // snapshot is invalid after change of content of mesh file, even if size is kept
+    {
+        std::fstream f(mesh_path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekg(0, std::ios::end);
+        f.seekp(std::streamoff(f.tellg()) - 2);
+        f.put('#');
+    }
+    boost::filesystem::last_write_time(mesh_path, mtime);
+    EXPECT_FALSE( SnapshotMeshReader::is_valid(file, true) );
+
+    delete mesh;
+    delete snapshot_mesh;
+}
@@ -0,0 +1,163 @@
+/*
+ * output_hdf5_test.cpp
+ *
+ */
+
+#define TEST_USE_PETSC
+#define FEAL_OVERRIDE_ASSERTS
+#include <flow_gtest_mpi.hh>
+#include <mesh_constructor.hh>
+#include <fstream>
+#include <sstream>
+
+#include "config.h"
+
+#ifdef FLOW123D_HAVE_HDF5
+
+#include <hdf5.h>
+
+#include "io/output_time.hh"
+#include "io/output_hdf5.hh"
+#include "io/output_mesh.hh"
+#include "mesh/mesh.h"
+#include "input/reader_to_storage.hh"
+#include "system/logger_options.hh"
+#include "system/sys_profiler.hh"
+#include "fields/field.hh"
+
+FLOW123D_FORCE_LINK_IN_PARENT(field_constant)
+
+const string test_output_time_hdf5 = R"YAML(
+file: ./test_hdf5.xdmf
+format: !hdf5
+)YAML";
+
+
+class TestHDF5 : public testing::Test {
+protected:
+	TestHDF5()
+    {
+        Profiler::instance();
+    }
+
+    ~TestHDF5()
+    {
+        Profiler::uninitialize();
+    }
+};
+
+class TestOutputHDF5 : public OutputHDF5, public std::enable_shared_from_this<OutputHDF5> {
+public:
+	TestOutputHDF5()
+    : OutputHDF5()
+    {
+        LoggerOptions::get_instance().set_log_file("");
+
+        FilePath mesh_file( string(UNIT_TESTS_SRC_DIR) + "/fields/simplest_cube_3d.msh", FilePath::input_file);
+        this->_mesh = mesh_full_constructor("{ mesh_file=\"" + (string)mesh_file + "\", optimize_mesh=false }");
+
+        this->write_time = 0.0; // hack: unset condition in OutputTime::write_time_frame and output is not performed
+    }
+
+    ~TestOutputHDF5()
+    {
+        delete this->_mesh;
+        LoggerOptions::get_instance().reset();
+    }
+
+    // initialize mesh with given yaml input
+    void init_mesh(string input_yaml)
+    {
+    	auto in_rec = Input::ReaderToStorage(input_yaml, const_cast<Input::Type::Record &>(OutputTime::get_input_type()), Input::FileFormat::format_YAML)
+        				.get_root_interface<Input::Record>();
+        this->init_from_input("dummy_equation", in_rec, std::make_shared<TimeUnitConversion>());
+
+        // create parallel output mesh identical to computational mesh
+        output_mesh_ = std::make_shared<OutputMesh>(*(this->_mesh));
+        output_mesh_->create_sub_mesh();
+        output_mesh_->make_parallel_master_mesh();
+        this->set_output_data_caches(output_mesh_);
+    }
+
+	template <int spacedim, class Value>
+	void set_field_data(string field_name, string rval)
+    {
+		typedef typename Value::element_type ElemType;
+
+	    auto output_cache_base = this->prepare_compute_data<ElemType>(field_name, OutputTime::ELEM_DATA,
+	            (unsigned int)Value::NRows_, (unsigned int)Value::NCols_);
+	    std::shared_ptr<ElementDataCache<ElemType>> output_data_cache = std::dynamic_pointer_cast<ElementDataCache<ElemType>>(output_cache_base);
+	    arma::mat ret_value(rval);
+	    for (uint i=0; i<output_data_cache->n_values(); ++i)
+	        output_data_cache->store_value(i, ret_value.memptr() );
+	    this->update_time(0.0);
+	}
+
+	// read whole dataset of doubles from HDF5 file, return its dimensions
+	std::vector<hsize_t> read_dataset(std::string dataset, std::vector<double> &data)
+	{
+	    hid_t file = H5Fopen("./test_hdf5.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+	    EXPECT_GE(file, 0);
+	    hid_t dset = H5Dopen2(file, dataset.c_str(), H5P_DEFAULT);
+	    EXPECT_GE(dset, 0);
+	    hid_t space = H5Dget_space(dset);
+	    std::vector<hsize_t> dims(H5Sget_simple_extent_ndims(space));
+	    H5Sget_simple_extent_dims(space, dims.data(), NULL);
+	    data.resize(H5Sget_simple_extent_npoints(space));
+	    H5Dread(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+	    H5Sclose(space);
+	    H5Dclose(dset);
+	    H5Fclose(file);
+	    return dims;
+	}
+
+	std::string base_filename() {
+		return string(this->_base_filename);
+	}
+
+	Mesh *_mesh;
+	std::shared_ptr<OutputMeshBase> output_mesh_;
+};
+
+
+TEST_F(TestHDF5, write_data) {
+	std::shared_ptr<TestOutputHDF5> output_hdf5 = std::make_shared<TestOutputHDF5>();
+	output_hdf5->init_mesh(test_output_time_hdf5);
+	output_hdf5->set_field_data<3, FieldValue<0>::Scalar>("scalar_field", "0.5");
+	output_hdf5->set_field_data<3, FieldValue<3>::VectorFixed>("vector_field", "0.5 1.0 1.5");
+	output_hdf5->write_data();
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	if (output_hdf5->rank() == 0) {
+	    unsigned int n_elements = output_hdf5->_mesh->n_elements();
+	    std::vector<double> data;
+
+	    std::vector<hsize_t> dims = output_hdf5->read_dataset("/Mesh/Nodes", data);
+	    EXPECT_EQ(3, dims[1]);
+
+	    dims = output_hdf5->read_dataset("/Step_000000/scalar_field", data);
+	    EXPECT_EQ(n_elements, dims[0]);
+	    EXPECT_EQ(1, dims[1]);
+	    for (auto val : data) EXPECT_DOUBLE_EQ(0.5, val);
+
+	    dims = output_hdf5->read_dataset("/Step_000000/vector_field", data);
+	    EXPECT_EQ(n_elements, dims[0]);
+	    EXPECT_EQ(3, dims[1]);
+	    for (unsigned int i=0; i<n_elements; ++i) {
+	        EXPECT_DOUBLE_EQ(0.5, data[3*i]);
+	        EXPECT_DOUBLE_EQ(1.0, data[3*i+1]);
+	        EXPECT_DOUBLE_EQ(1.5, data[3*i+2]);
+	    }
+
+	    // XDMF file refers to datasets of HDF5 file
+	    EXPECT_EQ("./test_hdf5.xdmf", output_hdf5->base_filename());
+	    std::ifstream xdmf_file("./test_hdf5.xdmf");
+	    std::stringstream xdmf;
+	    xdmf << xdmf_file.rdbuf();
+	    EXPECT_NE(std::string::npos, xdmf.str().find("<Attribute Name=\"vector_field\" AttributeType=\"Vector\" Center=\"Cell\">"));
+	    EXPECT_NE(std::string::npos, xdmf.str().find("test_hdf5.h5:/Step_000000/scalar_field"));
+	    EXPECT_NE(std::string::npos, xdmf.str().find("test_hdf5.h5:/Mesh/Topology"));
+	}
+}
+
+#endif // FLOW123D_HAVE_HDF5
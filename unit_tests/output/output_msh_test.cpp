@@ -29,6 +29,13 @@ format: !gmsh
   variant: ascii
 )YAML";
 
+const string test_output_time_async = R"YAML(
+file: ./test_output_async.msh
+format: !gmsh
+  variant: ascii
+async_write: true
+)YAML";
+
 
 class TestMSH : public testing::Test {
 protected:
@@ -127,6 +134,10 @@ public:
 		this->current_step = step;
 	}
 
+	void set_write_time(double time) {
+		this->write_time = time;
+	}
+
 	std::string base_filename() {
 		return string(this->_base_filename);
 	}
@@ -157,3 +168,25 @@ TEST_F(TestMSH, write_data) {
     EXPECT_EQ("./test_output.msh", output_msh->base_filename());
     output_msh->check_result_file("./test_output.msh", "./test_output_gmsh_ref.msh");
 }
+
+
+TEST_F(TestMSH, write_time_frame_async) {
+	std::shared_ptr<TestOutputMSH> output_msh = std::make_shared<TestOutputMSH>();
+	output_msh->init_mesh(test_output_time_async);
+
+	// data of next frame are computed while previous frame is written
+	output_msh->set_write_time(-1.0);
+	output_msh->set_field_data<3, FieldValue<0>::Scalar> ("scalar_field", "0.5", "0.5");
+	output_msh->set_field_data<3, FieldValue<3>::VectorFixed> ("vector_field", "[0.5, 1.0, 1.5]", "0.5 1.0 1.5");
+	output_msh->set_field_data<3, FieldValue<3>::TensorFixed> ("tensor_field", "[[1, 2, 3], [4, 5, 6], [7, 8, 9]]", "1 2 3; 4 5 6; 7 8 9");
+	output_msh->write_time_frame();
+
+	output_msh->set_write_time(-1.0);
+	output_msh->set_field_data<3, FieldValue<0>::Scalar> ("scalar_field", "0.75", "0.75");
+	output_msh->set_field_data<3, FieldValue<3>::VectorFixed> ("vector_field", "[0.75, 1.5, 2.25]", "0.75 1.5 2.25");
+	output_msh->set_field_data<3, FieldValue<3>::TensorFixed> ("tensor_field", "[[1, 4, 7], [2, 5, 8], [3, 6, 9]]", "1 4 7; 2 5 8; 3 6 9");
+	output_msh->write_time_frame();
+	output_msh->wait_for_frame();
+
+    output_msh->check_result_file("./test_output_async.msh", "./test_output_gmsh_ref.msh");
+}
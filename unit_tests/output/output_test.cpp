@@ -238,7 +238,7 @@ public:
 	    delete my_mesh;
         Profiler::uninitialize();
 	}
-	int write_data(void) override {return 0;};
+	int write_frame(void) override {return 0;};
 	//int write_head(void) override {return 0;};
 	//int write_tail(void) override {return 0;};
 
@@ -346,6 +346,12 @@ public:
 		this->fix_main_file_extension(extension);
 	}
 
+	// simulate asynchronous writing of time frame that fails
+	void submit_failing_frame() {
+		if (!writer_) writer_ = std::make_unique<ThreadPool>(1);
+		pending_frame_ = writer_->submit( []() { throw std::runtime_error("write failed"); } );
+	}
+
 	Mesh * my_mesh;
 	std::vector<string> component_names;
 	std::shared_ptr<OutputMeshBase> output_mesh_;
@@ -384,6 +390,20 @@ TEST(TestOutputTime, fix_main_file_extension)
 }
 
 
+TEST(TestOutputTime, failed_async_frame)
+{
+    {
+        std::shared_ptr<TestOutputTime> output_time = std::make_shared<TestOutputTime>();
+        output_time->submit_failing_frame();
+        EXPECT_THROW( output_time->wait_for_frame(), std::runtime_error );
+        EXPECT_NO_THROW( output_time->wait_for_frame() ); // exception is passed only once
+
+        // destructor logs exception instead of terminate
+        output_time->submit_failing_frame();
+    }
+}
+
+
 #define FV FieldValue
 TEST(TestOutputTime, compute_field_data) {
 	std::shared_ptr<TestOutputTime> output_time = std::make_shared<TestOutputTime>();
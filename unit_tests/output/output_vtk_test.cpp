@@ -250,5 +250,21 @@ TEST_F(TestVTK, write_data_compressed) {
     output_vtk->check_result_file("test1/test1-000000.vtu", "test_output_vtk_zlib_ref.vtu");
 }
 
+TEST_F(TestVTK, write_data_compressed_threads) {
+	OutputVTK::set_compression_threads(3);
+	std::shared_ptr<TestOutputVTK> output_vtk = std::make_shared<TestOutputVTK>();
+
+	output_vtk->init_mesh(test_output_time_compressed);
+    output_vtk->set_current_step(0);
+    output_vtk->set_field_data<3, FieldValue<0>::Scalar>("scalar_field", "0.5", "0.5");
+    output_vtk->set_field_data<3, FieldValue<3>::VectorFixed>("vector_field", "[0.5, 1.0, 1.5]", "0.5 1.0 1.5");
+    output_vtk->set_field_data<3, FieldValue<3>::TensorFixed>("tensor_field", "[[1, 2, 3], [4, 5, 6], [7, 8, 9]]", "1 2 3; 4 5 6; 7 8 9");
+    output_vtk->write_data();
+
+    // threaded compression produces same file
+    output_vtk->check_result_file("test1/test1-000000.vtu", "test_output_vtk_zlib_ref.vtu");
+    OutputVTK::set_compression_threads(1);
+}
+
 #endif // FLOW123D_HAVE_ZLIB
 
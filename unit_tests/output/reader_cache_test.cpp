@@ -245,3 +245,62 @@ TEST(ReaderCache, get_reader) {
     }*/
     Profiler::uninitialize();
 }
+
+
+TEST(ReaderCache, interpolation_map) {
+	// has to introduce some flag for passing absolute path to 'test_units' in source tree
+	FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+	FilePath file_name("fields/simplest_cube_base_data.msh", FilePath::input_file);
+	const MeshBase *target_mesh = nullptr; // mesh is only used as key of operator
+
+	bool is_new;
+	auto map = ReaderCache::interpolation_map(file_name, target_mesh, 0, is_new);
+	EXPECT_TRUE(is_new);
+	EXPECT_EQ(0, map->n_rows());
+	map->add(3, 0.25);
+	map->add(4, 0.75);
+	map->close_row(0);
+
+	// same operator is shared, other type of interpolation gets new one
+	EXPECT_EQ(map, ReaderCache::interpolation_map(file_name, target_mesh, 0, is_new));
+	EXPECT_FALSE(is_new);
+	EXPECT_EQ(1, map->n_rows());
+	EXPECT_EQ(std::vector<unsigned int>({0, 2}), map->row_offset);
+	EXPECT_NE(map, ReaderCache::interpolation_map(file_name, target_mesh, 1, is_new));
+	EXPECT_TRUE(is_new);
+}
+
+
+TEST(ReaderCache, prefetch_element_data) {
+	Profiler::instance();
+
+    // has to introduce some flag for passing absolute path to 'test_units' in source tree
+    FilePath::set_io_dirs(".",UNIT_TESTS_SRC_DIR,"",".");
+
+    Input::Record i_rec = get_input_record("{ mesh_file=\"fields/simplest_cube_base_data.msh\", optimize_mesh=false }");
+    FilePath file_name = i_rec.val<FilePath>("mesh_file");
+    Mesh * mesh = new Mesh(i_rec);
+    GmshMeshReader reader(file_name);
+    reader.read_physical_names(mesh);
+    reader.read_raw_mesh(mesh);
+    reader.set_element_ids(*mesh);
+
+    const unsigned int n_entities = 15;  // n bulk elements in mesh
+    const unsigned int bdr_shift = 9;    // n bulk elements in mesh
+    const unsigned int n_comp = 3;       // n components
+
+    // reading of frame at time 0.0 starts reading of frame at time 1.0 in background
+    BaseMeshReader::set_prefetch_memory_limit(1024*1024);
+    for (double time : {0.0, 1.0}) {
+        BaseMeshReader::HeaderQuery header_params("vector_fixed", time, OutputTime::DiscreteSpace::ELEM_DATA);
+        auto header = reader.find_header(header_params);
+        typename ElementDataCache<int>::CacheData field_ = reader.get_element_data<int>(header, n_entities, n_comp, bdr_shift);
+        std::vector<int> &vec = *( field_.get() );
+        EXPECT_EQ(n_entities*n_comp, vec.size());
+        for (unsigned int j=0; j<bdr_shift*n_comp; j++) EXPECT_EQ( (int)time+1+(j%3), vec[j] );
+    }
+    BaseMeshReader::set_prefetch_memory_limit(0);
+
+    delete mesh;
+    Profiler::uninitialize();
+}
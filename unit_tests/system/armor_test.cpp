@@ -3,6 +3,7 @@
 #include "system/armor.hh"
 #include "system/logger.hh"
 #include <armadillo>
+#include <cstdint>
 
 
 //    /**
@@ -447,6 +448,29 @@ TEST(Armor_test, array) {
 }
 
 
+TEST(Armor_test, array_simd_layout) {
+    Armor::Array<double> arr(3, 3, 5);
+    for (uint i=0; i<5; ++i)
+        arr.set(i) = Armor::ArmaMat<double, 3, 3>{1.0*i, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    // each component is stored in aligned contiguous block
+    for (uint row=0; row<3; ++row)
+        for (uint col=0; col<3; ++col) {
+            EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(arr(row, col)) % Armor::Array<double>::simd_alignment);
+            EXPECT_DOUBLE_EQ( arr.mat<3,3>(4)(row, col), arr(row, col)[4] );
+        }
+    EXPECT_EQ(8u, Armor::Array<double>::aligned_size(5));
+    EXPECT_EQ(16u, Armor::Array<unsigned int>::aligned_size(16));
+
+    // copy of array with different reserved size
+    Armor::Array<double> arr_copy(3, 3, 20);
+    arr_copy = arr;
+    EXPECT_EQ(arr.size(), arr_copy.size());
+    for (uint i=0; i<5; ++i)
+        EXPECT_ARMA_EQ( (arr.mat<3,3>(i)), (arr_copy.mat<3,3>(i)) );
+}
+
+
 
 //void fn_armor_mat_fixed(const Armor::Mat<double, 3, 3> &x)
 //{}
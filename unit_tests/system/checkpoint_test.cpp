@@ -0,0 +1,80 @@
+/*
+ * checkpoint_test.cpp
+ *
+ *  Tests writing and reading of checkpoint files and reuse of output files on restart.
+ */
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include "system/checkpoint.hh"
+
+
+TEST(Checkpoint, write_read) {
+    std::vector<double> values = {1.0, -2.5, 1e-300, 3.0};
+    std::string file_name = Checkpoint::rank_file_name("test_checkpoint", 0);
+    EXPECT_EQ("test_checkpoint.0.chk", file_name);
+
+    for (bool async : {false, true}) {
+        {
+            Checkpoint chk;
+            chk.set_time(0.5);
+            chk.save("eq/vector", values);
+            chk.save("eq/value", 7);
+            chk.write(file_name, async);
+        }   // destructor waits for asynchronous write
+
+        Checkpoint chk;
+        chk.read(file_name);
+        EXPECT_DOUBLE_EQ(0.5, chk.time());
+        EXPECT_TRUE(chk.has("eq/vector"));
+        EXPECT_FALSE(chk.has("eq/none"));
+        EXPECT_EQ(values, chk.load("eq/vector"));
+        EXPECT_DOUBLE_EQ(7, chk.load_value("eq/value"));
+        EXPECT_THROW_WHAT( { chk.load("eq/none"); }, Checkpoint::ExcMissingItem, "eq/none");
+        EXPECT_THROW_WHAT( { chk.load_value("eq/vector"); }, Checkpoint::ExcItemSize, "eq/vector");
+    }
+    std::remove(file_name.c_str());
+}
+
+
+TEST(Checkpoint, corrupted_file) {
+    std::string file_name = "test_checkpoint_corrupted.chk";
+    {
+        std::ofstream out(file_name);
+        out << "not a checkpoint";
+    }
+    Checkpoint chk;
+    EXPECT_THROW( { chk.read(file_name); }, Checkpoint::ExcCheckpointFile);
+    std::remove(file_name.c_str());
+}
+
+
+TEST(Checkpoint, restart_output_content) {
+    std::string file_name = "test_checkpoint_output.txt";
+    {
+        std::ofstream out(file_name);
+        out << "# header\n" << "0 a\n" << "1 b\n" << "1 c\n" << "2 d\n" << "3 e\n";
+    }
+    auto line_time = [](const std::string &line) -> double {
+        if (line[0] == '#') return std::numeric_limits<double>::quiet_NaN();
+        return std::atof(line.c_str());
+    };
+
+    EXPECT_FALSE(Checkpoint::is_restart());
+    EXPECT_FALSE(Checkpoint::before_restart(0.0));
+
+    Checkpoint::set_restart_time(1.0);
+    EXPECT_TRUE(Checkpoint::is_restart());
+    EXPECT_TRUE(Checkpoint::before_restart(1.0));
+    EXPECT_FALSE(Checkpoint::before_restart(1.5));
+    EXPECT_EQ("# header\n0 a\n1 b\n1 c\n", Checkpoint::restart_output_content(file_name, line_time));
+    EXPECT_EQ("", Checkpoint::restart_output_content("non_existing_file.txt", line_time));
+
+    Checkpoint::set_restart_time(-std::numeric_limits<double>::infinity());
+    std::remove(file_name.c_str());
+}
@@ -219,6 +219,13 @@ TEST_F(ProfilerTest, test_one_timer) {test_one_timer();}
         EXPECT_EQ(1000, ACC);
     }
 
+    // test set_call, value is not accumulated over starts of timer
+    for (unsigned int i=0; i<2; i++) {
+        START_TIMER("set_call");
+        SET_CALLS(500);
+        EXPECT_EQ(500, ACC);
+    }
+
     // test absolute time
     {
         START_TIMER("one_second");
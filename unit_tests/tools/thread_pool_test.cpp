@@ -0,0 +1,53 @@
+/*
+ * thread_pool_test.cpp
+ *
+ */
+
+
+#define FEAL_OVERRIDE_ASSERTS
+
+#include <flow_gtest.hh>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "tools/thread_pool.hh"
+
+
+TEST(ThreadPool, submit) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.n_workers(), 3);
+
+    std::vector< std::future<unsigned int> > results;
+    for (unsigned int i=0; i<20; ++i)
+        results.push_back( pool.submit( [i]() { return i*i; } ) );
+    for (unsigned int i=0; i<20; ++i)
+        EXPECT_EQ(results[i].get(), i*i);
+}
+
+
+TEST(ThreadPool, parallel_for) {
+    for (unsigned int n_workers : {0, 1, 4}) {
+        ThreadPool pool(n_workers);
+        std::vector<unsigned int> data(100, 0);
+        std::atomic<unsigned int> n_calls(0);
+        pool.parallel_for(data.size(), [&data, &n_calls](unsigned int i) {
+            data[i] = 2*i;
+            n_calls++;
+        });
+        EXPECT_EQ(n_calls, data.size());
+        for (unsigned int i=0; i<data.size(); ++i)
+            EXPECT_EQ(data[i], 2*i);
+    }
+}
+
+
+TEST(ThreadPool, exception) {
+    ThreadPool pool(2);
+    EXPECT_THROW( pool.parallel_for(4, [](unsigned int i) {
+        if (i==3) throw std::runtime_error("Error in task.");
+    }), std::runtime_error );
+
+    auto result = pool.submit( []() -> int { throw std::runtime_error("Error in task."); } );
+    EXPECT_THROW( result.get(), std::runtime_error );
+}